@@ -9,6 +9,8 @@
 #include <TxPool/PoolType.h>
 #include <P2P/SyncStatus.h>
 #include <Core/Models/DTOs/BlockWithOutputs.h>
+#include <Core/Models/DTOs/OutputLocations.h>
+#include <BlockChain/OutputsByHeightCursor.h>
 #include <BlockChain/ChainType.h>
 #include <Core/Models/BlockHeader.h>
 #include <Core/Models/FullBlock.h>
@@ -17,6 +19,7 @@
 #include <Core/Traits/Lockable.h>
 #include <Crypto/BigInteger.h>
 #include <PMMR/HeaderMMR.h>
+#include <PMMR/TxHashSetReceiver.h>
 #include <filesystem.h>
 
 #include <vector>
@@ -55,6 +58,18 @@ public:
 
 	virtual fs::path SnapshotTxHashSet(BlockHeaderPtr pBlockHeader) = 0;
 	virtual EBlockChainStatus ProcessTransactionHashSet(const Hash& blockHash, const fs::path& path, SyncStatus& syncStatus) = 0;
+
+	//
+	// Creates a receiver that extracts the TxHashSet archive for the given block while it's being downloaded.
+	// Returns nullptr if no header is found matching the given block hash.
+	//
+	virtual ITxHashSetReceiverPtr CreateTxHashSetReceiver(const Hash& blockHash, SyncStatus& syncStatus) = 0;
+
+	//
+	// Loads and validates a TxHashSet once the receiver has received the entire archive.
+	//
+	virtual EBlockChainStatus ProcessTransactionHashSet(const Hash& blockHash, ITxHashSetReceiver& receiver, SyncStatus& syncStatus) = 0;
+
 	virtual EBlockChainStatus AddTransaction(TransactionPtr pTransaction, const EPoolType poolType) = 0;
 	virtual TransactionPtr GetTransactionByKernelHash(const Hash& kernelHash) const = 0;
 
@@ -95,6 +110,12 @@ public:
 	//
 	virtual std::vector<BlockHeaderPtr> GetBlockHeadersByHash(const std::vector<Hash>& blockHeaderHashes) const = 0;
 
+	//
+	// Returns up to maxHeaders serialized block headers of the given chain, starting at startHeight.
+	// The headers are read as stored, under a single lock, and stop at the first missing height.
+	//
+	virtual std::vector<std::vector<unsigned char>> GetRawBlockHeaders(const uint64_t startHeight, const uint64_t maxHeaders, const EChainType chainType) const = 0;
+
 	//
 	// Creates a compact block to represent the block with the given hash, if it exists.
 	//
@@ -112,6 +133,12 @@ public:
 	//
 	virtual std::unique_ptr<FullBlock> GetBlockByHash(const Hash& blockHash) const = 0;
 
+	//
+	// Returns the block matching the given hash, exactly as stored (serialized using EProtocolVersion::V1).
+	// This will be null if no matching block is found.
+	//
+	virtual std::unique_ptr<std::vector<unsigned char>> GetRawBlockByHash(const Hash& blockHash) const = 0;
+
 	//
 	// Returns the block containing the output commitment.
 	// This will be null if the output commitment is not found or the block doesn't exist in the DB.
@@ -123,9 +150,24 @@ public:
 	//
 	virtual bool HasBlock(const uint64_t height, const Hash& blockHash) const = 0;
 
+	//
+	// Snapshots the identifiers of the confirmed blocks from startHeight to maxHeight (inclusive), and returns a cursor for reading their outputs.
+	// The chain lock is only held while taking the snapshot, so block processing isn't stalled while the outputs are read.
+	//
+	virtual OutputsByHeightCursor::UPtr GetOutputsByHeightCursor(const uint64_t startHeight, const uint64_t maxHeight) const = 0;
 
+	//
+	// Returns the unspent outputs of the confirmed blocks from startHeight to maxHeight (inclusive).
+	// Equivalent to reading every page of GetOutputsByHeightCursor.
+	//
 	virtual std::vector<BlockWithOutputs> GetOutputsByHeight(const uint64_t startHeight, const uint64_t maxHeight) const = 0;
 
+	//
+	// Returns the locations of the given outputs that are unspent, and the confirmed height they were looked up at.
+	// The whole batch is read under one chain lock, so a block can't be applied part way through.
+	//
+	virtual OutputLocations GetOutputLocations(const std::vector<Commitment>& outputCommitments) const = 0;
+
 	//
 	// Returns the hashes of blocks(indexed by height) that are part of the candidate (header) chain, but whose bodies haven't been downloaded yet.
 	//
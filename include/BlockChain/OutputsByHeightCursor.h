@@ -0,0 +1,104 @@
+#pragma once
+
+// Copyright (c) 2018-2019 David Burkett
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <Core/Models/DTOs/BlockWithOutputs.h>
+#include <Core/Models/DTOs/BlockIdentifier.h>
+#include <Core/Traits/Lockable.h>
+#include <Database/BlockDb.h>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+//
+// Iterates over the outputs of a snapshot of confirmed blocks, one page at a time.
+// The snapshot is only the block identifiers, so no chain lock is held between pages.
+// Each page holds the block DB's read lock only while it reads the outputs of its blocks.
+//
+// If the chain reorgs after the snapshot was taken, outputs of blocks that are no longer confirmed are omitted,
+// since their positions will have been removed (or moved to another height) when the blocks were rewound.
+//
+class OutputsByHeightCursor
+{
+public:
+	using UPtr = std::unique_ptr<OutputsByHeightCursor>;
+
+	static constexpr size_t DEFAULT_PAGE_SIZE = 100;
+
+	OutputsByHeightCursor(const std::shared_ptr<const Locked<IBlockDB>>& pBlockDB, std::vector<BlockIdentifier>&& blocks)
+		: m_pBlockDB(pBlockDB), m_blocks(std::move(blocks)), m_nextBlock(0) { }
+
+	bool HasNext() const noexcept { return m_nextBlock < m_blocks.size(); }
+	size_t GetNumBlocks() const noexcept { return m_blocks.size(); }
+
+	//
+	// Returns the outputs of the next (up to) maxBlocks blocks.
+	// Only outputs that are still unspent are included.
+	//
+	std::vector<BlockWithOutputs> NextPage(const size_t maxBlocks)
+	{
+		const size_t endBlock = m_nextBlock + (std::min)(maxBlocks, m_blocks.size() - m_nextBlock);
+
+		std::vector<BlockWithOutputs> page;
+		page.reserve(endBlock - m_nextBlock);
+
+		auto pBlockDB = m_pBlockDB->Read();
+		while (m_nextBlock < endBlock)
+		{
+			const BlockIdentifier& block = m_blocks[m_nextBlock++];
+
+			std::unique_ptr<std::vector<TransactionOutput>> pOutputs = pBlockDB->GetBlockOutputs(block.GetHash());
+			if (pOutputs == nullptr)
+			{
+				continue;
+			}
+
+			std::vector<OutputDTO> outputsFound;
+			outputsFound.reserve(pOutputs->size());
+
+			for (TransactionOutput& output : *pOutputs)
+			{
+				std::unique_ptr<OutputLocation> pOutputLocation = pBlockDB->GetOutputPosition(output.GetCommitment());
+				if (pOutputLocation != nullptr && pOutputLocation->GetBlockHeight() == block.GetHeight())
+				{
+					outputsFound.emplace_back(OutputDTO(
+						false,
+						OutputIdentifier::FromOutput(output),
+						std::move(*pOutputLocation),
+						RangeProof(output.GetRangeProof())
+					));
+				}
+			}
+
+			page.emplace_back(BlockWithOutputs(BlockIdentifier(block), std::move(outputsFound)));
+		}
+
+		return page;
+	}
+
+	//
+	// Reads all remaining pages, releasing the block DB's lock between each.
+	//
+	std::vector<BlockWithOutputs> ReadAll(const size_t blocksPerPage = DEFAULT_PAGE_SIZE)
+	{
+		std::vector<BlockWithOutputs> blocks;
+		blocks.reserve(m_blocks.size() - m_nextBlock);
+
+		while (HasNext())
+		{
+			std::vector<BlockWithOutputs> page = NextPage((std::max)(blocksPerPage, (size_t)1));
+			std::move(page.begin(), page.end(), std::back_inserter(blocks));
+		}
+
+		return blocks;
+	}
+
+private:
+	std::shared_ptr<const Locked<IBlockDB>> m_pBlockDB;
+	std::vector<BlockIdentifier> m_blocks;
+	size_t m_nextBlock;
+};
@@ -3,6 +3,9 @@
 #include <deque>
 #include <vector>
 #include <thread>
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include <functional>
 #include <shared_mutex>
 #include <condition_variable>
@@ -86,35 +89,48 @@ public:
 		}
 	}
 
-	//T pop()
-	//{
-	//	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
-	//	while (m_deque.empty())
-	//	{
-	//		m_conditional.wait(writeLock);
-	//	}
-	//	auto item = m_deque.front();
-	//	m_deque.pop_front();
-	//	return item;
-	//}
-
-	//void pop(T& item)
-	//{
-	//	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
-	//	while (m_deque.empty())
-	//	{
-	//		m_conditional.wait(writeLock);
-	//	}
-	//	item = m_deque.front();
-	//	m_deque.pop_front();
-	//}
+	//
+	// Blocks until an item is available, the timeout expires, or terminate is set.
+	// Returns the popped front item, or null if the queue was still empty.
+	// Waiters are woken immediately by push_back, but terminate is only checked when the wait times out,
+	// so callers should pass a timeout that's acceptable as shutdown latency.
+	//
+	std::unique_ptr<T> pop_wait(const std::chrono::milliseconds& timeout, const std::atomic_bool& terminate)
+	{
+		std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+		if (!m_conditional.wait_for(writeLock, timeout, [this, &terminate] { return !m_deque.empty() || terminate; }))
+		{
+			return nullptr;
+		}
+
+		if (m_deque.empty())
+		{
+			return nullptr;
+		}
+
+		auto pItem = std::make_unique<T>(std::move(m_deque.front()));
+		m_deque.pop_front();
+		return pItem;
+	}
+
+	//
+	// Same as pop_wait, but leaves the items in the queue.
+	// Used by consumers that copy_front, process, and only then pop_front, so in-flight items still count for push_back_unique.
+	// Returns true if the queue is non-empty.
+	//
+	bool wait(const std::chrono::milliseconds& timeout, const std::atomic_bool& terminate) const
+	{
+		std::shared_lock<std::shared_mutex> readLock(m_mutex);
+		return m_conditional.wait_for(readLock, timeout, [this, &terminate] { return !m_deque.empty() || terminate; })
+			&& !m_deque.empty();
+	}
 
 	void push_back(const T& item)
 	{
 		std::unique_lock<std::shared_mutex> writeLock(m_mutex);
 		m_deque.push_back(item);
 		writeLock.unlock();
-		m_conditional.notify_one();
+		m_conditional.notify_all();
 	}
 
 	void push_back(T&& item)
@@ -122,7 +138,7 @@ public:
 		std::unique_lock<std::shared_mutex> writeLock(m_mutex);
 		m_deque.push_back(std::move(item));
 		writeLock.unlock();
-		m_conditional.notify_one();
+		m_conditional.notify_all();
 	}
 
 	bool push_back_unique(T&& item, std::function<bool(const T&, const T&)>& comparator)
@@ -138,11 +154,13 @@ public:
 		}
 
 		m_deque.push_back(std::move(item));
+		writeLock.unlock();
+		m_conditional.notify_all();
 		return true;
 	}
 
 private:
 	std::deque<T> m_deque;
 	mutable std::shared_mutex m_mutex;
-	std::condition_variable m_conditional;
+	mutable std::condition_variable_any m_conditional;
 };
\ No newline at end of file
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <functional>
+#include <shared_mutex>
+#include <unordered_set>
+#include <condition_variable>
+
+//
+// A ConcurrentQueue variant that keeps the key (eg. hash) of every queued item in an unordered_set,
+// so duplicate checks and lookups are O(1) instead of a scan of the whole queue.
+// An item's key is released once the item is popped.
+//
+template <typename K, typename T, typename Hasher = std::hash<K>>
+class KeyedConcurrentQueue
+{
+public:
+	using KeyFunc = std::function<K(const T&)>;
+
+	KeyedConcurrentQueue(const KeyFunc& getKey)
+		: m_getKey(getKey) { }
+
+	bool contains(const K& key) const
+	{
+		std::shared_lock<std::shared_mutex> readLock(m_mutex);
+		return m_keys.find(key) != m_keys.cend();
+	}
+
+	size_t size() const
+	{
+		std::shared_lock<std::shared_mutex> readLock(m_mutex);
+		return m_deque.size();
+	}
+
+	std::vector<T> copy_front(const size_t numItems) const
+	{
+		std::shared_lock<std::shared_mutex> readLock(m_mutex);
+
+		const size_t numToCopy = (std::min)(numItems, m_deque.size());
+		return std::vector<T>(m_deque.cbegin(), m_deque.cbegin() + numToCopy);
+	}
+
+	std::unique_ptr<T> copy_front() const
+	{
+		std::shared_lock<std::shared_mutex> readLock(m_mutex);
+
+		if (!m_deque.empty())
+		{
+			return std::make_unique<T>(m_deque.front());
+		}
+
+		return nullptr;
+	}
+
+	void pop_front(const size_t numItems)
+	{
+		std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+
+		size_t itemsPopped = 0;
+		while (itemsPopped < numItems && !m_deque.empty())
+		{
+			m_keys.erase(m_getKey(m_deque.front()));
+			m_deque.pop_front();
+			++itemsPopped;
+		}
+	}
+
+	//
+	// See ConcurrentQueue::pop_wait
+	//
+	std::unique_ptr<T> pop_wait(const std::chrono::milliseconds& timeout, const std::atomic_bool& terminate)
+	{
+		std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+		if (!m_conditional.wait_for(writeLock, timeout, [this, &terminate] { return !m_deque.empty() || terminate; }))
+		{
+			return nullptr;
+		}
+
+		if (m_deque.empty())
+		{
+			return nullptr;
+		}
+
+		auto pItem = std::make_unique<T>(std::move(m_deque.front()));
+		m_deque.pop_front();
+		m_keys.erase(m_getKey(*pItem));
+		return pItem;
+	}
+
+	//
+	// See ConcurrentQueue::wait
+	//
+	bool wait(const std::chrono::milliseconds& timeout, const std::atomic_bool& terminate) const
+	{
+		std::shared_lock<std::shared_mutex> readLock(m_mutex);
+		return m_conditional.wait_for(readLock, timeout, [this, &terminate] { return !m_deque.empty() || terminate; })
+			&& !m_deque.empty();
+	}
+
+	//
+	// Queues the item, unless an item with the same key is already queued.
+	// Returns true if the item was added.
+	//
+	bool push_back_unique(T&& item)
+	{
+		std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+
+		if (!m_keys.insert(m_getKey(item)).second)
+		{
+			return false;
+		}
+
+		m_deque.push_back(std::move(item));
+		writeLock.unlock();
+		m_conditional.notify_all();
+		return true;
+	}
+
+private:
+	KeyFunc m_getKey;
+	std::deque<T> m_deque;
+	std::unordered_set<K, Hasher> m_keys;
+	mutable std::shared_mutex m_mutex;
+	mutable std::condition_variable_any m_conditional;
+};
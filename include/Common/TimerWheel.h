@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <vector>
+
+//
+// A hashed timer wheel with a fixed number of slots, each covering one tick (1 second by default).
+// Advancing the wheel only visits the slots whose ticks have elapsed,
+// so the cost of firing timers is proportional to the number of due timers, not the number of scheduled ones.
+//
+// Timers further than one full rotation away share a slot with nearer timers, and are skipped over
+// (but still visited) until the rotation in which they are due.
+// Timers can't be cancelled. Consumers are expected to ignore items that are no longer relevant when they fire.
+//
+// Not thread-safe. Callers must provide their own locking.
+//
+template <typename T>
+class TimerWheel
+{
+public:
+	using Clock = std::chrono::system_clock;
+
+	TimerWheel(const size_t numSlots = 512, const Clock::duration& tickDuration = std::chrono::seconds(1))
+		: m_slots(numSlots), m_tickDuration(tickDuration), m_nextTick(ToTick(Clock::now())), m_numVisited(0) { }
+
+	TimerWheel(const Clock::time_point& start, const size_t numSlots = 512, const Clock::duration& tickDuration = std::chrono::seconds(1))
+		: m_slots(numSlots), m_tickDuration(tickDuration), m_nextTick(ToTick(start)), m_numVisited(0) { }
+
+	//
+	// Schedules the item to be returned by the first call to Advance at or after the given deadline.
+	// Deadlines are rounded up to the next tick. Deadlines in the past fire on the next call to Advance.
+	//
+	void Schedule(const Clock::time_point& deadline, const T& item)
+	{
+		uint64_t tick = ToTick(deadline);
+		if (FromTick(tick) < deadline)
+		{
+			++tick;
+		}
+
+		tick = (std::max)(tick, m_nextTick);
+		m_slots[tick % m_slots.size()].push_back(Entry{ tick, item });
+		m_deadlines.insert(tick);
+	}
+
+	//
+	// Removes and returns all items whose deadlines are at or before the given time.
+	//
+	std::vector<T> Advance(const Clock::time_point& now)
+	{
+		m_numVisited = 0;
+
+		std::vector<T> dueItems;
+		const uint64_t currentTick = ToTick(now);
+		if (currentTick < m_nextTick || m_deadlines.empty())
+		{
+			m_nextTick = (std::max)(m_nextTick, currentTick + 1);
+			return dueItems;
+		}
+
+		// Every slot gets visited at most once, no matter how far the wheel is advanced.
+		const uint64_t numTicks = (std::min)(currentTick - m_nextTick + 1, (uint64_t)m_slots.size());
+		for (uint64_t i = 0; i < numTicks; i++)
+		{
+			std::vector<Entry>& slot = m_slots[(m_nextTick + i) % m_slots.size()];
+			m_numVisited += slot.size();
+
+			auto iter = std::partition(slot.begin(), slot.end(), [currentTick](const Entry& entry) { return entry.tick > currentTick; });
+			for (auto dueIter = iter; dueIter != slot.end(); dueIter++)
+			{
+				m_deadlines.erase(m_deadlines.find(dueIter->tick));
+				dueItems.push_back(std::move(dueIter->item));
+			}
+
+			slot.erase(iter, slot.end());
+		}
+
+		m_nextTick = currentTick + 1;
+		return dueItems;
+	}
+
+	//
+	// Returns the earliest deadline of all scheduled items, rounded up to its tick.
+	//
+	std::optional<Clock::time_point> GetNextDeadline() const
+	{
+		if (m_deadlines.empty())
+		{
+			return std::nullopt;
+		}
+
+		return std::make_optional(FromTick(*m_deadlines.cbegin()));
+	}
+
+	size_t Size() const noexcept { return m_deadlines.size(); }
+	bool IsEmpty() const noexcept { return m_deadlines.empty(); }
+
+	//
+	// The number of entries examined by the last call to Advance.
+	//
+	size_t GetNumVisited() const noexcept { return m_numVisited; }
+
+private:
+	struct Entry
+	{
+		uint64_t tick;
+		T item;
+	};
+
+	uint64_t ToTick(const Clock::time_point& timePoint) const
+	{
+		return (uint64_t)(std::max)(Clock::duration::rep(0), timePoint.time_since_epoch().count() / m_tickDuration.count());
+	}
+
+	Clock::time_point FromTick(const uint64_t tick) const
+	{
+		return Clock::time_point(m_tickDuration * tick);
+	}
+
+	std::vector<std::vector<Entry>> m_slots;
+	std::multiset<uint64_t> m_deadlines;
+	Clock::duration m_tickDuration;
+	uint64_t m_nextTick;
+	size_t m_numVisited;
+};
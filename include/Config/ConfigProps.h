@@ -14,6 +14,9 @@ namespace ConfigProps
 
 		static const std::string MIN_PEERS = "MIN_PEERS";
 		static const std::string MAX_PEERS = "MAX_PEERS";
+		static const std::string BROADCAST_FANOUT = "BROADCAST_FANOUT";
+		static const std::string INBOUND_BURST = "INBOUND_BURST";
+		static const std::string INBOUND_PER_MINUTE = "INBOUND_PER_MINUTE";
 	}
 
 	namespace Dandelion
@@ -46,6 +49,7 @@ namespace ConfigProps
 		static const std::string WALLET = "WALLET";
 
 		static const std::string DATABASE = "DATABASE";
+		static const std::string DATABASE_SYNCHRONOUS = "DATABASE_SYNCHRONOUS";
 		static const std::string MIN_CONFIRMATIONS = "MIN_CONFIRMATIONS";
 	}
 
@@ -13,6 +13,14 @@ public:
 	int GetMaxConnections() const { return m_maxConnections; }
 	int GetMinConnections() const { return m_minConnections; }
 
+	// Number of random peers that non-block messages (eg. transactions) are relayed to.
+	// Blocks are always relayed to every connected peer.
+	int GetBroadcastFanout() const { return m_broadcastFanout; }
+
+	// Inbound connections accepted from a single IP: up to 'burst' at once, then 'per minute' sustained.
+	int GetInboundBurst() const { return m_inboundBurst; }
+	int GetInboundPerMinute() const { return m_inboundPerMinute; }
+
 	//
 	// Constructor
 	//
@@ -20,6 +28,9 @@ public:
 	{
 		m_maxConnections = 50;
 		m_minConnections = 15;
+		m_broadcastFanout = 8;
+		m_inboundBurst = 3;
+		m_inboundPerMinute = 6;
 
 		if (json.isMember(ConfigProps::P2P::P2P))
 		{
@@ -34,10 +45,28 @@ public:
 			{
 				m_minConnections = p2pJSON.get(ConfigProps::P2P::MIN_PEERS, 15).asInt();
 			}
+
+			if (p2pJSON.isMember(ConfigProps::P2P::BROADCAST_FANOUT))
+			{
+				m_broadcastFanout = p2pJSON.get(ConfigProps::P2P::BROADCAST_FANOUT, 8).asInt();
+			}
+
+			if (p2pJSON.isMember(ConfigProps::P2P::INBOUND_BURST))
+			{
+				m_inboundBurst = p2pJSON.get(ConfigProps::P2P::INBOUND_BURST, 3).asInt();
+			}
+
+			if (p2pJSON.isMember(ConfigProps::P2P::INBOUND_PER_MINUTE))
+			{
+				m_inboundPerMinute = p2pJSON.get(ConfigProps::P2P::INBOUND_PER_MINUTE, 6).asInt();
+			}
 		}
 	}
 
 private:
 	int m_maxConnections;
 	int m_minConnections;
+	int m_broadcastFanout;
+	int m_inboundBurst;
+	int m_inboundPerMinute;
 };
\ No newline at end of file
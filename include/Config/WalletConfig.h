@@ -32,18 +32,24 @@ public:
 		FileUtil::CreateDirectories(m_walletPath);
 
 		m_databaseType = "SQLITE";
+		m_databaseSynchronous = "NORMAL";
 		m_minimumConfirmations = 10;
 		if (json.isMember(ConfigProps::Wallet::WALLET))
 		{
 			const Json::Value& walletJSON = json[ConfigProps::Wallet::WALLET];
 
 			m_databaseType = walletJSON.get(ConfigProps::Wallet::DATABASE, "SQLITE").asString();
+			m_databaseSynchronous = walletJSON.get(ConfigProps::Wallet::DATABASE_SYNCHRONOUS, "NORMAL").asString();
 			m_minimumConfirmations = walletJSON.get(ConfigProps::Wallet::MIN_CONFIRMATIONS, 10).asUInt();
 		}
 	}
 
 	const fs::path& GetWalletDirectory() const { return m_walletPath; }
 	const std::string& GetDatabaseType() const { return m_databaseType; }
+
+	// The sqlite "synchronous" level (OFF, NORMAL, FULL, or EXTRA) used with the wallet's WAL journal.
+	// NORMAL can lose the most recent commits on power loss, but never corrupts the database.
+	const std::string& GetDatabaseSynchronous() const { return m_databaseSynchronous; }
 	uint32_t GetListenPort() const { return m_listenPort; }
 	uint32_t GetOwnerPort() const { return m_ownerPort; }
 	uint32_t GetPublicKeyVersion() const { return m_publicKeyVersion; }
@@ -53,6 +59,7 @@ public:
 private:
 	fs::path m_walletPath;
 	std::string m_databaseType;
+	std::string m_databaseSynchronous;
 	uint32_t m_listenPort;
 	uint32_t m_ownerPort;
 	uint32_t m_publicKeyVersion;
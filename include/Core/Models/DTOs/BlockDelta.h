@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Core/Models/DTOs/BlockIdentifier.h>
+#include <Core/Models/FullBlock.h>
+#include <Crypto/Commitment.h>
+#include <vector>
+
+//
+// The changes a single block made to the UTXO set:
+// the commitments of the outputs it created, and of the inputs it spent.
+//
+class BlockDelta
+{
+public:
+	BlockDelta(BlockIdentifier&& blockIdentifier, std::vector<Commitment>&& created, std::vector<Commitment>&& spent)
+		: m_blockIdentifier(std::move(blockIdentifier)), m_created(std::move(created)), m_spent(std::move(spent))
+	{
+
+	}
+
+	static BlockDelta FromBlock(const FullBlock& block)
+	{
+		std::vector<Commitment> created;
+		created.reserve(block.GetOutputs().size());
+		for (const TransactionOutput& output : block.GetOutputs())
+		{
+			created.push_back(output.GetCommitment());
+		}
+
+		std::vector<Commitment> spent;
+		spent.reserve(block.GetInputs().size());
+		for (const TransactionInput& input : block.GetInputs())
+		{
+			spent.push_back(input.GetCommitment());
+		}
+
+		return BlockDelta(BlockIdentifier::FromHeader(*block.GetHeader()), std::move(created), std::move(spent));
+	}
+
+	const BlockIdentifier& GetBlockIdentifier() const { return m_blockIdentifier; }
+	const std::vector<Commitment>& GetCreated() const { return m_created; }
+	const std::vector<Commitment>& GetSpent() const { return m_spent; }
+
+private:
+	BlockIdentifier m_blockIdentifier;
+	std::vector<Commitment> m_created;
+	std::vector<Commitment> m_spent;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Core/Models/OutputLocation.h>
+#include <Core/Util/JsonUtil.h>
+#include <Crypto/Commitment.h>
+#include <json/json.h>
+#include <map>
+
+//
+// The locations of a batch of unspent outputs, along with the confirmed height they were looked up at.
+// Outputs that aren't unspent as of that height are left out.
+//
+class OutputLocations
+{
+public:
+	OutputLocations(const uint64_t height, std::map<Commitment, OutputLocation>&& locations)
+		: m_height(height), m_locations(std::move(locations))
+	{
+
+	}
+
+	uint64_t GetHeight() const { return m_height; }
+	const std::map<Commitment, OutputLocation>& GetLocations() const { return m_locations; }
+
+	Json::Value ToJSON() const
+	{
+		Json::Value outputsJson(Json::arrayValue);
+		for (const auto& entry : m_locations)
+		{
+			Json::Value outputJson;
+			outputJson["commit"] = entry.first.ToHex();
+			outputJson["block_height"] = entry.second.GetBlockHeight();
+			outputJson["mmr_index"] = entry.second.GetMMRIndex() + 1;
+			outputsJson.append(outputJson);
+		}
+
+		Json::Value json;
+		json["height"] = m_height;
+		json["outputs"] = outputsJson;
+		return json;
+	}
+
+	static OutputLocations FromJSON(const Json::Value& json)
+	{
+		std::map<Commitment, OutputLocation> locations;
+		for (const Json::Value& outputJson : JsonUtil::GetRequiredField(json, "outputs"))
+		{
+			locations.insert({ JsonUtil::GetCommitment(outputJson, "commit"), OutputLocation::FromJSON(outputJson) });
+		}
+
+		return OutputLocations(JsonUtil::GetRequiredUInt64(json, "height"), std::move(locations));
+	}
+
+private:
+	uint64_t m_height;
+	std::map<Commitment, OutputLocation> m_locations;
+};
@@ -8,6 +8,7 @@
 #include <Core/Serialization/Serializer.h>
 #include <Core/Serialization/ByteBuffer.h>
 #include <Core/Traits/Serializable.h>
+#include <Core/Util/JsonUtil.h>
 
 class OutputLocation : public Traits::ISerializable
 {
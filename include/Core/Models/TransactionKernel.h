@@ -10,10 +10,12 @@
 #include <Crypto/Hash.h>
 #include <Core/Models/Features.h>
 #include <Crypto/Commitment.h>
+#include <Crypto/ParsedCommitment.h>
 #include <Crypto/Signature.h>
 #include <Core/Serialization/ByteBuffer.h>
 #include <Core/Serialization/Serializer.h>
 #include <json/json.h>
+#include <memory>
 
 ////////////////////////////////////////
 // TRANSACTION KERNEL
@@ -52,6 +54,9 @@ public:
 	uint64_t GetLockHeight() const { return m_lockHeight; }
 	const Commitment& GetExcessCommitment() const { return m_excessCommitment; }
 	const Signature& GetExcessSignature() const { return m_excessSignature; }
+
+	// Parsed on first use and shared between copies, so block and pool validation don't parse the excess again.
+	ParsedCommitment GetParsedExcessCommitment() const;
 	bool IsCoinbase() const { return (m_features & EKernelFeatures::COINBASE_KERNEL) == EKernelFeatures::COINBASE_KERNEL; }
 	Hash GetSignatureMessage() const;
 	static Hash GetSignatureMessage(const EKernelFeatures features, const uint64_t fee, const uint64_t lockHeight);
@@ -89,6 +94,7 @@ private:
 	Signature m_excessSignature;
 
 	mutable Hash m_hash;
+	mutable std::shared_ptr<const ParsedCommitment> m_pParsedExcess;
 };
 
 static struct
@@ -10,10 +10,12 @@
 #include <Core/Models/Features.h>
 #include <Core/Models/OutputIdentifier.h>
 #include <Crypto/Commitment.h>
+#include <Crypto/ParsedCommitment.h>
 #include <Crypto/RangeProof.h>
 #include <Core/Serialization/ByteBuffer.h>
 #include <Core/Serialization/Serializer.h>
 #include <json/json.h>
+#include <memory>
 
 ////////////////////////////////////////
 // TRANSACTION OUTPUT
@@ -50,6 +52,9 @@ public:
 	virtual const Commitment& GetCommitment() const override final { return m_commitment; }
 	const RangeProof& GetRangeProof() const { return m_rangeProof; }
 
+	// Parsed on first use and shared between copies, so block and pool validation don't parse the commitment again.
+	ParsedCommitment GetParsedCommitment() const;
+
 	bool IsCoinbase() const { return (m_features & EOutputFeatures::COINBASE_OUTPUT) == EOutputFeatures::COINBASE_OUTPUT; }
 
 	//
@@ -77,6 +82,7 @@ private:
 	RangeProof m_rangeProof;
 
 	mutable Hash m_hash;
+	mutable std::shared_ptr<const ParsedCommitment> m_pParsedCommitment;
 };
 
 static struct
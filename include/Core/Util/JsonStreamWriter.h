@@ -0,0 +1,280 @@
+#pragma once
+
+#include <json/json.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+//
+// Writes compact JSON directly into a sink, a buffer at a time, as it's being produced.
+// Unlike building a Json::Value and calling toStyledString(), the full document is never held in memory,
+// so the memory used is bounded by the buffer size (plus any single string larger than it).
+//
+// Commas and colons are inserted automatically. Ex:
+//     writer.BeginObject().Key("height").Value(height).Key("outputs").BeginArray();
+//     ...
+//     writer.EndArray().EndObject();
+//     writer.Flush();
+//
+// Flush() must be called once the document is complete. Nothing is flushed on destruction,
+// since a partially written document (ie. after an exception) shouldn't be sent.
+//
+class JsonStreamWriter
+{
+public:
+	using Sink = std::function<void(const char* pData, const size_t length)>;
+
+	static constexpr size_t DEFAULT_BUFFER_SIZE = 16 * 1024;
+
+	JsonStreamWriter(const Sink& sink, const size_t bufferSize = DEFAULT_BUFFER_SIZE)
+		: m_sink(sink), m_bufferSize(bufferSize), m_bytesWritten(0), m_afterKey(false)
+	{
+		m_buffer.reserve(bufferSize);
+	}
+
+	JsonStreamWriter& BeginObject()
+	{
+		BeforeValue();
+		Put('{');
+		m_firstInScope.push_back(true);
+		return *this;
+	}
+
+	JsonStreamWriter& EndObject()
+	{
+		m_firstInScope.pop_back();
+		Put('}');
+		return *this;
+	}
+
+	JsonStreamWriter& BeginArray()
+	{
+		BeforeValue();
+		Put('[');
+		m_firstInScope.push_back(true);
+		return *this;
+	}
+
+	JsonStreamWriter& EndArray()
+	{
+		m_firstInScope.pop_back();
+		Put(']');
+		return *this;
+	}
+
+	JsonStreamWriter& Key(const std::string& key)
+	{
+		BeforeValue();
+		PutString(key);
+		Put(':');
+		m_afterKey = true;
+		return *this;
+	}
+
+	JsonStreamWriter& Value(const std::string& value)
+	{
+		BeforeValue();
+		PutString(value);
+		return *this;
+	}
+
+	JsonStreamWriter& Value(const char* value)
+	{
+		return Value(std::string(value));
+	}
+
+	template<typename T, typename SFINAE = typename std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+	JsonStreamWriter& Value(const T value)
+	{
+		BeforeValue();
+		Put(std::to_string(value));
+		return *this;
+	}
+
+	JsonStreamWriter& Value(const bool value)
+	{
+		BeforeValue();
+		Put(value ? "true" : "false");
+		return *this;
+	}
+
+	JsonStreamWriter& Value(const double value)
+	{
+		BeforeValue();
+		Put(Json::valueToString(value));
+		return *this;
+	}
+
+	JsonStreamWriter& Null()
+	{
+		BeforeValue();
+		Put("null");
+		return *this;
+	}
+
+	//
+	// Writes an existing Json::Value, so models that already implement ToJSON() can be streamed one at a time.
+	//
+	JsonStreamWriter& Value(const Json::Value& json)
+	{
+		switch (json.type())
+		{
+			case Json::nullValue:
+				return Null();
+			case Json::intValue:
+				return Value((int64_t)json.asLargestInt());
+			case Json::uintValue:
+				return Value((uint64_t)json.asLargestUInt());
+			case Json::realValue:
+				return Value(json.asDouble());
+			case Json::stringValue:
+				return Value(json.asString());
+			case Json::booleanValue:
+				return Value(json.asBool());
+			case Json::arrayValue:
+			{
+				BeginArray();
+				for (const Json::Value& element : json)
+				{
+					Value(element);
+				}
+
+				return EndArray();
+			}
+			case Json::objectValue:
+			{
+				BeginObject();
+				for (auto iter = json.begin(); iter != json.end(); iter++)
+				{
+					Key(iter.name());
+					Value(*iter);
+				}
+
+				return EndObject();
+			}
+		}
+
+		return *this;
+	}
+
+	//
+	// Sends everything buffered so far to the sink.
+	//
+	void Flush()
+	{
+		if (!m_buffer.empty())
+		{
+			m_sink(m_buffer.data(), m_buffer.size());
+			m_bytesWritten += m_buffer.size();
+			m_buffer.clear();
+		}
+	}
+
+	size_t GetBytesWritten() const noexcept { return m_bytesWritten + m_buffer.size(); }
+
+private:
+	void BeforeValue()
+	{
+		if (m_afterKey)
+		{
+			m_afterKey = false;
+		}
+		else if (!m_firstInScope.empty())
+		{
+			if (m_firstInScope.back())
+			{
+				m_firstInScope.back() = false;
+			}
+			else
+			{
+				Put(',');
+			}
+		}
+	}
+
+	void Put(const char c)
+	{
+		if (m_buffer.size() >= m_bufferSize)
+		{
+			Flush();
+		}
+
+		m_buffer.push_back(c);
+	}
+
+	void Put(const char* pData, const size_t length)
+	{
+		if (m_buffer.size() + length > m_bufferSize)
+		{
+			Flush();
+
+			// Too big to ever fit, so bypass the buffer rather than growing it.
+			if (length > m_bufferSize)
+			{
+				m_sink(pData, length);
+				m_bytesWritten += length;
+				return;
+			}
+		}
+
+		m_buffer.insert(m_buffer.end(), pData, pData + length);
+	}
+
+	void Put(const std::string& str)
+	{
+		Put(str.data(), str.size());
+	}
+
+	// Escapes the same characters as jsoncpp: quotes, backslashes, and control characters.
+	void PutString(const std::string& str)
+	{
+		static const char* HEX = "0123456789abcdef";
+
+		Put('"');
+
+		size_t unescapedStart = 0;
+		for (size_t i = 0; i < str.size(); i++)
+		{
+			const unsigned char c = (unsigned char)str[i];
+			if (c >= 0x20 && c != '"' && c != '\\')
+			{
+				continue;
+			}
+
+			Put(str.data() + unescapedStart, i - unescapedStart);
+			unescapedStart = i + 1;
+
+			switch (c)
+			{
+				case '"': Put("\\\"", 2); break;
+				case '\\': Put("\\\\", 2); break;
+				case '\b': Put("\\b", 2); break;
+				case '\f': Put("\\f", 2); break;
+				case '\n': Put("\\n", 2); break;
+				case '\r': Put("\\r", 2); break;
+				case '\t': Put("\\t", 2); break;
+				default:
+				{
+					const char escaped[6] = { '\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xF] };
+					Put(escaped, 6);
+					break;
+				}
+			}
+		}
+
+		Put(str.data() + unescapedStart, str.size() - unescapedStart);
+		Put('"');
+	}
+
+	Sink m_sink;
+	size_t m_bufferSize;
+	std::vector<char> m_buffer;
+	size_t m_bytesWritten;
+
+	// One entry per open object/array, true until its first element is written.
+	std::vector<bool> m_firstInScope;
+	bool m_afterKey;
+};
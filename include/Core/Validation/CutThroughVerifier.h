@@ -1,32 +1,111 @@
 #pragma once
 
 #include <Core/Models/TransactionBody.h>
-#include <set>
+#include <algorithm>
+#include <cstring>
 
 class CutThroughVerifier
 {
 public:
+	enum class EStatus
+	{
+		VALID,
+		NOT_SORTED,
+		DUPLICATE,
+		CUT_THROUGH
+	};
+
 	static bool VerifyCutThrough(const TransactionBody& transactionBody)
 	{
-		return VerifyCutThrough(transactionBody.GetInputs(), transactionBody.GetOutputs());
+		return Verify(transactionBody) == EStatus::VALID;
 	}
 
-	static bool VerifyCutThrough(const std::vector<TransactionInput>& inputs, const std::vector<TransactionOutput>& outputs)
+	//
+	// Verifies that the inputs, outputs, and kernels are each strictly sorted by hash,
+	// and that no input spends an output from the same body.
+	//
+	// Cut-through is defined by commitment alone, since an input may spend an output using different features than it was created with.
+	// The output commitments are sorted once (as pointers, since outputs are sorted by hash, not commitment) and each input is looked up with a binary search.
+	//
+	static EStatus Verify(const TransactionBody& transactionBody)
 	{
-		std::set<Commitment> commitments;
-		for (auto output : outputs)
+		const std::vector<TransactionInput>& inputs = transactionBody.GetInputs();
+		const std::vector<TransactionOutput>& outputs = transactionBody.GetOutputs();
+
+		EStatus status = CheckSorted(inputs);
+		if (status == EStatus::VALID)
+		{
+			status = CheckSorted(outputs);
+		}
+
+		if (status == EStatus::VALID)
+		{
+			status = CheckSorted(transactionBody.GetKernels());
+		}
+
+		if (status != EStatus::VALID || inputs.empty() || outputs.empty())
 		{
-			commitments.insert(output.GetCommitment());
+			return status;
+		}
+
+		std::vector<const Commitment*> outputCommitments;
+		outputCommitments.reserve(outputs.size());
+		for (const TransactionOutput& output : outputs)
+		{
+			outputCommitments.push_back(&output.GetCommitment());
+		}
+
+		auto byCommitment = [](const Commitment* pLhs, const Commitment* pRhs) { return *pLhs < *pRhs; };
+		std::sort(outputCommitments.begin(), outputCommitments.end(), byCommitment);
+
+		for (const TransactionInput& input : inputs)
+		{
+			if (std::binary_search(outputCommitments.cbegin(), outputCommitments.cend(), &input.GetCommitment(), byCommitment))
+			{
+				return EStatus::CUT_THROUGH;
+			}
 		}
 
-		for (auto input : inputs)
+		return EStatus::VALID;
+	}
+
+private:
+	template<class T>
+	static EStatus CheckSorted(const std::vector<T>& items)
+	{
+		const Hash* pPrevious = nullptr;
+		for (const T& item : items)
 		{
-			if (commitments.count(input.GetCommitment()) > 0)
+			const EStatus status = CheckNext(pPrevious, item.GetHash());
+			if (status != EStatus::VALID)
 			{
-				return false;
+				return status;
 			}
+
+			pPrevious = &item.GetHash();
+		}
+
+		return EStatus::VALID;
+	}
+
+	static int Compare(const Hash& lhs, const Hash& rhs)
+	{
+		return std::memcmp(lhs.data(), rhs.data(), lhs.GetData().size());
+	}
+
+	static EStatus CheckNext(const Hash* pPrevious, const Hash& next)
+	{
+		if (pPrevious == nullptr)
+		{
+			return EStatus::VALID;
+		}
+
+		const int comparison = Compare(*pPrevious, next);
+		if (comparison == 0)
+		{
+			return EStatus::DUPLICATE;
 		}
 
-		return true;
+		return comparison < 0 ? EStatus::VALID : EStatus::NOT_SORTED;
 	}
-};
\ No newline at end of file
+};
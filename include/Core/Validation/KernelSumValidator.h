@@ -3,10 +3,10 @@
 #include <Core/Exceptions/BadDataException.h>
 #include <Crypto/Crypto.h>
 #include <Crypto/Commitment.h>
+#include <Crypto/ParsedCommitment.h>
 #include <Crypto/BlindingFactor.h>
 #include <Core/Models/BlockSums.h>
 #include <Core/Models/TransactionBody.h>
-#include <Common/Util/FunctionalUtil.h>
 #include <Infrastructure/Logger.h>
 #include <optional>
 
@@ -20,81 +20,168 @@ public:
 		const BlindingFactor& kernelOffset,
 		const std::optional<BlockSums>& blockSumsOpt)
 	{
-		// gather the commitments
-		auto getInputCommitments = [](TransactionInput& input) -> Commitment { return input.GetCommitment(); };
-		std::vector<Commitment> inputCommitments = FunctionalUtil::map<std::vector<Commitment>>(transactionBody.GetInputs(), getInputCommitments);
+		const ParsedBody parsed(transactionBody);
 
-		auto getOutputCommitments = [](TransactionOutput& output) -> Commitment { return output.GetCommitment(); };
-		std::vector<Commitment> outputCommitments = FunctionalUtil::map<std::vector<Commitment>>(transactionBody.GetOutputs(), getOutputCommitments);
-
-		auto getKernelCommitments = [](TransactionKernel& kernel) -> Commitment { return kernel.GetExcessCommitment(); };
-		std::vector<Commitment> kernelCommitments = FunctionalUtil::map<std::vector<Commitment>>(transactionBody.GetKernels(), getKernelCommitments);
-
-		return ValidateKernelSums(inputCommitments, outputCommitments, kernelCommitments, overage, kernelOffset, blockSumsOpt);
+		return ValidateKernelSums(parsed.inputs, parsed.outputs, parsed.kernels, overage, kernelOffset, blockSumsOpt);
 	}
 
 	static BlockSums ValidateKernelSums(
-		const std::vector<Commitment>& inputs,
-		const std::vector<Commitment>& outputs,
-		const std::vector<Commitment>& kernels,
+		const std::vector<ParsedCommitment>& inputs,
+		const std::vector<ParsedCommitment>& outputs,
+		const std::vector<ParsedCommitment>& kernels,
 		const int64_t overage,
 		const BlindingFactor& kernelOffset,
 		const std::optional<BlockSums>& blockSumsOpt)
 	{
-		std::vector<Commitment> inputCommitments = inputs;
-		std::vector<Commitment> outputCommitments = outputs;
-		if (overage > 0)
-		{
-			outputCommitments.push_back(Crypto::CommitTransparent(overage));
-		}
-		else if (overage < 0)
-		{
-			inputCommitments.push_back(Crypto::CommitTransparent(0 - overage));
-		}
-
+		Terms terms(inputs, outputs, kernels, overage, kernelOffset);
 		if (blockSumsOpt.has_value())
 		{
-			outputCommitments.push_back(blockSumsOpt.value().GetOutputSum());
+			terms.AddPrevious(blockSumsOpt.value());
 		}
 
-		// Sum all input|output|overage commitments.
-		Commitment utxoSum = Crypto::AddCommitments(outputCommitments, inputCommitments);
+		// The sums are needed for the BlockSums, so each is computed once and then checked against the offset.
+		const ParsedCommitment utxoSum = Crypto::AddParsedCommitments(terms.utxoPositive, terms.utxoNegative);
+		const ParsedCommitment kernelSum = Crypto::AddParsedCommitments(terms.kernels, {});
 
-		// Sum the kernel excesses accounting for the kernel offset.
-		std::vector<Commitment> kernelCommitments = kernels;
-		if (blockSumsOpt.has_value())
+		std::vector<const ParsedCommitment*> kernelSumPlusOffset({ &kernelSum });
+		if (terms.offsetOpt.has_value())
 		{
-			kernelCommitments.push_back(blockSumsOpt.value().GetKernelSum());
+			kernelSumPlusOffset.push_back(&terms.offsetOpt.value());
 		}
 
-		Commitment kernelSum = Crypto::AddCommitments(kernelCommitments, std::vector<Commitment>());
-		Commitment kernelSumPlusOffset = AddKernelOffset(kernelSum, kernelOffset);
-		if (utxoSum != kernelSumPlusOffset) {
+		if (!Crypto::VerifyCommitmentSum({ &utxoSum }, kernelSumPlusOffset))
+		{
 			LOG_ERROR_F(
-				"UTXO sum {} does not match kernel sum plus offset {}. Kernel sum is {} and offset is {}.",
-				utxoSum,
-				kernelSumPlusOffset,
-				kernelSum,
+				"UTXO sum {} does not match kernel sum {} plus offset {}.",
+				Crypto::SerializeCommitment(utxoSum),
+				Crypto::SerializeCommitment(kernelSum),
 				kernelOffset.ToHex()
 			);
 			throw BAD_DATA_EXCEPTION("UTXO sum does not match kernel sum plus offset");
 		}
 
-		return BlockSums(utxoSum, kernelSum);
+		return BlockSums(Crypto::SerializeCommitment(utxoSum), Crypto::SerializeCommitment(kernelSum));
 	}
 
-private:
-	static Commitment AddKernelOffset(const Commitment& kernelSum, const BlindingFactor& totalKernelOffset)
+	// Same check as ValidateKernelSums, for when the sums themselves aren't needed (ie. transactions).
+	// Outputs, inputs, overage, kernels, and offset are all balanced in a single multi-term sum.
+	static void VerifyKernelSums(
+		const TransactionBody& transactionBody,
+		const int64_t overage,
+		const BlindingFactor& kernelOffset)
 	{
-		// Add the commitments along with the commit to zero built from the offset
-		std::vector<Commitment> commitments;
-		commitments.push_back(kernelSum);
+		const ParsedBody parsed(transactionBody);
+		Terms terms(parsed.inputs, parsed.outputs, parsed.kernels, overage, kernelOffset);
 
-		if (totalKernelOffset.GetBytes() != CBigInteger<32>::ValueOf(0))
+		std::vector<const ParsedCommitment*> negative = terms.utxoNegative;
+		negative.insert(negative.end(), terms.kernels.cbegin(), terms.kernels.cend());
+		if (terms.offsetOpt.has_value())
 		{
-			commitments.push_back(Crypto::CommitBlinded((uint64_t)0, totalKernelOffset));
+			negative.push_back(&terms.offsetOpt.value());
 		}
 
-		return Crypto::AddCommitments(commitments, std::vector<Commitment>());
+		if (!Crypto::VerifyCommitmentSum(terms.utxoPositive, negative))
+		{
+			LOG_ERROR_F("UTXO sum does not match kernel sum plus offset {}.", kernelOffset.ToHex());
+			throw BAD_DATA_EXCEPTION("UTXO sum does not match kernel sum plus offset");
+		}
 	}
-};
\ No newline at end of file
+
+private:
+	// Inputs are parsed once per validation. Outputs and kernels reuse the commitments cached on them.
+	struct ParsedBody
+	{
+		ParsedBody(const TransactionBody& transactionBody)
+		{
+			inputs.reserve(transactionBody.GetInputs().size());
+			for (const TransactionInput& input : transactionBody.GetInputs())
+			{
+				inputs.push_back(Crypto::ParseCommitment(input.GetCommitment()));
+			}
+
+			outputs.reserve(transactionBody.GetOutputs().size());
+			for (const TransactionOutput& output : transactionBody.GetOutputs())
+			{
+				outputs.push_back(output.GetParsedCommitment());
+			}
+
+			kernels.reserve(transactionBody.GetKernels().size());
+			for (const TransactionKernel& kernel : transactionBody.GetKernels())
+			{
+				kernels.push_back(kernel.GetParsedExcessCommitment());
+			}
+		}
+
+		std::vector<ParsedCommitment> inputs;
+		std::vector<ParsedCommitment> outputs;
+		std::vector<ParsedCommitment> kernels;
+	};
+
+	// Points to every term of the kernel sum equation, so nothing is parsed or copied more than once.
+	struct Terms
+	{
+		Terms(
+			const std::vector<ParsedCommitment>& inputs,
+			const std::vector<ParsedCommitment>& outputs,
+			const std::vector<ParsedCommitment>& kernelExcesses,
+			const int64_t overage,
+			const BlindingFactor& kernelOffset)
+		{
+			utxoPositive.reserve(outputs.size() + 2);
+			utxoNegative.reserve(inputs.size() + 1);
+			kernels.reserve(kernelExcesses.size() + 1);
+
+			for (const ParsedCommitment& output : outputs)
+			{
+				utxoPositive.push_back(&output);
+			}
+
+			for (const ParsedCommitment& input : inputs)
+			{
+				utxoNegative.push_back(&input);
+			}
+
+			for (const ParsedCommitment& kernel : kernelExcesses)
+			{
+				kernels.push_back(&kernel);
+			}
+
+			if (overage > 0)
+			{
+				overageOpt = Crypto::ParseCommitment(Crypto::CommitTransparent(overage));
+				utxoPositive.push_back(&overageOpt.value());
+			}
+			else if (overage < 0)
+			{
+				overageOpt = Crypto::ParseCommitment(Crypto::CommitTransparent(0 - overage));
+				utxoNegative.push_back(&overageOpt.value());
+			}
+
+			if (kernelOffset.GetBytes() != CBigInteger<32>::ValueOf(0))
+			{
+				offsetOpt = Crypto::ParseCommitment(Crypto::CommitBlinded((uint64_t)0, kernelOffset));
+			}
+		}
+
+		void AddPrevious(const BlockSums& blockSums)
+		{
+			previousOutputSum = Crypto::ParseCommitment(blockSums.GetOutputSum());
+			utxoPositive.push_back(&previousOutputSum.value());
+
+			previousKernelSum = Crypto::ParseCommitment(blockSums.GetKernelSum());
+			kernels.push_back(&previousKernelSum.value());
+		}
+
+		// Not copyable, since the vectors point into the optionals.
+		Terms(const Terms&) = delete;
+		Terms& operator=(const Terms&) = delete;
+
+		std::vector<const ParsedCommitment*> utxoPositive;
+		std::vector<const ParsedCommitment*> utxoNegative;
+		std::vector<const ParsedCommitment*> kernels;
+		std::optional<ParsedCommitment> overageOpt;
+		std::optional<ParsedCommitment> offsetOpt;
+		std::optional<ParsedCommitment> previousOutputSum;
+		std::optional<ParsedCommitment> previousKernelSum;
+	};
+};
@@ -9,7 +9,6 @@ public:
 
 private:
 	void ValidateWeight(const TransactionBody& transactionBody, const bool withReward);
-	void VerifySorted(const TransactionBody& transactionBody);
-	void VerifyCutThrough(const TransactionBody& transactionBody);
+	void VerifySortedAndCutThrough(const TransactionBody& transactionBody);
 	void VerifyRangeProofs(const std::vector<TransactionOutput>& outputs);
 };
\ No newline at end of file
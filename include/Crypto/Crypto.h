@@ -11,6 +11,7 @@
 #include <vector>
 #include <memory>
 #include <Crypto/Commitment.h>
+#include <Crypto/ParsedCommitment.h>
 #include <Crypto/RangeProof.h>
 #include <Crypto/BlindingFactor.h>
 #include <Crypto/Signature.h>
@@ -98,6 +99,32 @@ public:
 		const std::vector<Commitment>& negative
 	);
 
+	//
+	// Parses the 33 byte commitment so it can be summed repeatedly without being parsed again.
+	//
+	static ParsedCommitment ParseCommitment(const Commitment& commitment);
+
+	//
+	// Serializes the parsed commitment back to its 33 byte form.
+	//
+	static Commitment SerializeCommitment(const ParsedCommitment& parsedCommitment);
+
+	//
+	// Adds the already parsed homomorphic pedersen commitments together.
+	//
+	static ParsedCommitment AddParsedCommitments(
+		const std::vector<const ParsedCommitment*>& positive,
+		const std::vector<const ParsedCommitment*>& negative
+	);
+
+	//
+	// Verifies the positive commitments minus the negative commitments sum to zero, without serializing anything.
+	//
+	static bool VerifyCommitmentSum(
+		const std::vector<const ParsedCommitment*>& positive,
+		const std::vector<const ParsedCommitment*>& negative
+	);
+
 	//
 	// Takes a vector of blinding factors and calculates an additional blinding value that adds to zero.
 	//
@@ -0,0 +1,31 @@
+#pragma once
+
+// Copyright (c) 2018-2019 David Burkett
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <array>
+
+//
+// A commitment that has already been parsed into secp256k1-zkp's internal representation.
+// Parsing a 33 byte commitment requires a field square root, so anything that's summed more than once should be parsed once and reused.
+// The 64 bytes are opaque outside of the Crypto module, and use the same layout as secp256k1_pedersen_commitment.
+//
+class ParsedCommitment
+{
+public:
+	ParsedCommitment() : m_bytes{ } { }
+	ParsedCommitment(const ParsedCommitment& other) = default;
+	ParsedCommitment(ParsedCommitment&& other) noexcept = default;
+	~ParsedCommitment() = default;
+
+	ParsedCommitment& operator=(const ParsedCommitment& other) = default;
+	ParsedCommitment& operator=(ParsedCommitment&& other) noexcept = default;
+
+	const unsigned char* data() const noexcept { return m_bytes.data(); }
+	unsigned char* data() noexcept { return m_bytes.data(); }
+	size_t size() const noexcept { return m_bytes.size(); }
+
+private:
+	std::array<unsigned char, 64> m_bytes;
+};
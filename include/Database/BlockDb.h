@@ -9,6 +9,7 @@
 #include <Core/Models/SpentOutput.h>
 #include <Core/Traits/Batchable.h>
 #include <unordered_map>
+#include <map>
 #include <memory>
 
 class IBlockDB : public Traits::IBatchable
@@ -18,18 +19,42 @@ public:
 
 	virtual BlockHeaderPtr GetBlockHeader(const Hash& hash) const = 0;
 
+	//
+	// Returns the serialized header, without deserializing it.
+	// This will be null if no matching header is found.
+	//
+	virtual std::unique_ptr<std::vector<unsigned char>> GetBlockHeaderBytes(const Hash& hash) const = 0;
+
 	virtual void AddBlockHeader(BlockHeaderPtr pBlockHeader) = 0;
 	virtual void AddBlockHeaders(const std::vector<BlockHeaderPtr>& blockHeaders) = 0;
 
 	virtual void AddBlock(const FullBlock& block) = 0;
 	virtual std::unique_ptr<FullBlock> GetBlock(const Hash& hash) const = 0;
 
+	//
+	// Returns the block exactly as stored (serialized using EProtocolVersion::V1), without deserializing it.
+	// This will be null if no matching block is found.
+	//
+	virtual std::unique_ptr<std::vector<unsigned char>> GetBlockBytes(const Hash& hash) const = 0;
+
+	//
+	// Returns only the outputs of the block, without deserializing the rest of it.
+	// This will be null if no matching block is found.
+	//
+	virtual std::unique_ptr<std::vector<TransactionOutput>> GetBlockOutputs(const Hash& hash) const = 0;
+
 	virtual void AddBlockSums(const Hash& blockHash, const BlockSums& blockSums) = 0;
 	virtual std::unique_ptr<BlockSums> GetBlockSums(const Hash& blockHash) const = 0;
 	virtual void ClearBlockSums() = 0;
 
 	virtual void AddOutputPosition(const Commitment& outputCommitment, const OutputLocation& location) = 0;
 	virtual std::unique_ptr<OutputLocation> GetOutputPosition(const Commitment& outputCommitment) const = 0;
+
+	//
+	// Returns the positions of all the given commitments at once, leaving out any that aren't found.
+	// Callers should hold a single read lock for the whole batch, so the results are consistent with each other.
+	//
+	virtual std::map<Commitment, OutputLocation> GetOutputPositions(const std::vector<Commitment>& outputCommitments) const = 0;
 	virtual void RemoveOutputPositions(const std::vector<Commitment>& outputCommitments) = 0;
 	virtual void ClearOutputPositions() = 0;
 
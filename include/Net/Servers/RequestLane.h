@@ -0,0 +1,90 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+//
+// Bounds how many requests of one kind (ie. expensive range queries) are handled at once.
+// Up to maxConcurrent requests run, up to maxQueued more wait for a free slot,
+// and any beyond that are turned away immediately instead of tying up more of the server's threads.
+//
+class RequestLane
+{
+public:
+	//
+	// Holds a slot in the lane until destroyed.
+	//
+	class Ticket
+	{
+	public:
+		Ticket(RequestLane& lane) : m_lane(lane) { }
+		~Ticket() { m_lane.Exit(); }
+
+		Ticket(const Ticket&) = delete;
+		Ticket& operator=(const Ticket&) = delete;
+
+	private:
+		RequestLane& m_lane;
+	};
+
+	RequestLane(const size_t maxConcurrent, const size_t maxQueued)
+		: m_maxConcurrent(maxConcurrent), m_maxQueued(maxQueued), m_running(0), m_queued(0) { }
+
+	//
+	// Waits for a free slot, unless the queue is already full.
+	// Returns null if the request should be rejected.
+	//
+	std::unique_ptr<Ticket> TryEnter()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (m_running >= m_maxConcurrent)
+		{
+			if (m_queued >= m_maxQueued)
+			{
+				return nullptr;
+			}
+
+			++m_queued;
+			m_slotFreed.wait(lock, [this] { return m_running < m_maxConcurrent; });
+			--m_queued;
+		}
+
+		++m_running;
+		return std::make_unique<Ticket>(*this);
+	}
+
+	//
+	// The most threads this lane can ever occupy (running + queued).
+	//
+	size_t GetMaxThreads() const noexcept { return m_maxConcurrent + m_maxQueued; }
+
+	//
+	// The number of requests currently waiting for a free slot.
+	//
+	size_t GetNumQueued() const
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		return m_queued;
+	}
+
+private:
+	void Exit()
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			--m_running;
+		}
+
+		m_slotFreed.notify_one();
+	}
+
+	const size_t m_maxConcurrent;
+	const size_t m_maxQueued;
+
+	mutable std::mutex m_mutex;
+	std::condition_variable m_slotFreed;
+	size_t m_running;
+	size_t m_queued;
+};
@@ -2,12 +2,15 @@
 
 #include <Infrastructure/Logger.h>
 #include <Net/Clients/HTTP/HTTPException.h>
+#include <Net/Servers/RequestLane.h>
+#include <Net/Util/HTTPUtil.h>
 #include <Common/Util/StringUtil.h>
 #include <cassert>
 #include <civetweb.h>
 #include <string>
 #include <optional>
 #include <memory>
+#include <vector>
 
 enum class EServerType
 {
@@ -15,16 +18,44 @@ enum class EServerType
 	PUBLIC
 };
 
+//
+// CHEAP requests (status, tip, single lookups) run directly on the server's threads.
+// EXPENSIVE requests (range queries, anything that holds chain/wallet locks for a while) must first be admitted to the expensive lane.
+//
+enum class ERequestCost
+{
+	CHEAP,
+	EXPENSIVE
+};
+
+//
+// The server's thread count is the expensive lane's running + queued limits, plus the threads reserved for cheap requests.
+// Since the expensive lane can never occupy more than its share, cheap requests always have a free thread.
+//
+struct ServerLimits
+{
+	size_t expensiveConcurrency = 4;
+	size_t expensiveQueueDepth = 6;
+	size_t reservedCheapThreads = 5;
+	uint32_t retryAfterSeconds = 1;
+
+	size_t GetNumThreads() const noexcept { return expensiveConcurrency + expensiveQueueDepth + reservedCheapThreads; }
+};
+
 class Server
 {
 public:
-	static std::shared_ptr<Server> Create(const EServerType type, const std::optional<uint16_t>& port)
+	static std::shared_ptr<Server> Create(
+		const EServerType type,
+		const std::optional<uint16_t>& port,
+		const ServerLimits& limits = ServerLimits())
 	{
 		std::string listenerAddr = type == EServerType::LOCAL ? "127.0.0.1" : "0.0.0.0";
 		std::string listeningPort = StringUtil::Format("{}:{}", listenerAddr, port.value_or(0));
+		const std::string numThreads = std::to_string(limits.GetNumThreads());
 
 		const char* pOptions[] = {
-			"num_threads", "15",
+			"num_threads", numThreads.c_str(),
 			"listening_ports", listeningPort.c_str(),
 			NULL
 		};
@@ -45,7 +76,7 @@ public:
 			throw HTTP_EXCEPTION("mg_get_server_ports failed.");
 		}
 
-		return std::shared_ptr<Server>(new Server(pCivetContext, (uint16_t)ports.port));
+		return std::shared_ptr<Server>(new Server(pCivetContext, (uint16_t)ports.port, limits));
 	}
 
 	virtual ~Server()
@@ -63,21 +94,62 @@ public:
 
 	uint16_t GetPortNumber() const noexcept { return m_portNumber; }
 
-	void AddListener(const std::string& uri, mg_request_handler handler, void* pCallbackData) noexcept
+	void AddListener(
+		const std::string& uri,
+		mg_request_handler handler,
+		void* pCallbackData,
+		const ERequestCost cost = ERequestCost::CHEAP) noexcept
 	{
-		mg_set_request_handler(m_pContext, uri.c_str(), handler, pCallbackData);
+		if (cost == ERequestCost::CHEAP)
+		{
+			mg_set_request_handler(m_pContext, uri.c_str(), handler, pCallbackData);
+		}
+		else
+		{
+			m_expensiveRoutes.push_back(std::make_unique<ExpensiveRoute>(ExpensiveRoute{ this, handler, pCallbackData }));
+			mg_set_request_handler(m_pContext, uri.c_str(), ExpensiveHandler, m_expensiveRoutes.back().get());
+		}
 	}
 
 private:
-	Server(mg_context* pContext, const uint16_t portNumber)
-		: m_pContext(pContext), m_portNumber(portNumber)
+	Server(mg_context* pContext, const uint16_t portNumber, const ServerLimits& limits)
+		: m_pContext(pContext),
+		m_portNumber(portNumber),
+		m_retryAfterSeconds(limits.retryAfterSeconds),
+		m_expensiveLane(limits.expensiveConcurrency, limits.expensiveQueueDepth)
 	{
 		assert(pContext != nullptr);
 		assert(portNumber > 0);
 	}
 
+	struct ExpensiveRoute
+	{
+		Server* pServer;
+		mg_request_handler handler;
+		void* pCallbackData;
+	};
+
+	static int ExpensiveHandler(mg_connection* pConnection, void* pRoute)
+	{
+		const ExpensiveRoute* pExpensiveRoute = (const ExpensiveRoute*)pRoute;
+		Server* pServer = pExpensiveRoute->pServer;
+
+		std::unique_ptr<RequestLane::Ticket> pTicket = pServer->m_expensiveLane.TryEnter();
+		if (pTicket == nullptr)
+		{
+			LOG_DEBUG("Expensive lane is full. Rejecting request.");
+			return HTTPUtil::BuildServiceUnavailableResponse(pConnection, pServer->m_retryAfterSeconds, "Server busy. Try again later.");
+		}
+
+		return pExpensiveRoute->handler(pConnection, pExpensiveRoute->pCallbackData);
+	}
+
 	mg_context* m_pContext;
 	uint16_t m_portNumber;
+
+	uint32_t m_retryAfterSeconds;
+	RequestLane m_expensiveLane;
+	std::vector<std::unique_ptr<ExpensiveRoute>> m_expensiveRoutes;
 };
 
 typedef std::shared_ptr<Server> ServerPtr;
\ No newline at end of file
@@ -15,10 +15,18 @@ class Socket : public Traits::IPrintable
 {
 public:
 	Socket(const SocketAddress& address);
+
+	//
+	// Wraps an already-connected socket (eg. one accepted asynchronously by a listener).
+	//
+	Socket(
+		const SocketAddress& address,
+		const std::shared_ptr<asio::io_context>& pContext,
+		const std::shared_ptr<asio::ip::tcp::socket>& pSocket
+	);
 	virtual ~Socket();
 
 	bool Connect(std::shared_ptr<asio::io_context> pContext);
-	bool Accept(std::shared_ptr<asio::io_context> pContext, asio::ip::tcp::acceptor& acceptor, const std::atomic_bool& terminate);
 
 	bool CloseSocket();
 	bool IsSocketOpen() const;
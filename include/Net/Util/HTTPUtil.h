@@ -7,8 +7,11 @@
 #include <Common/Util/StringUtil.h>
 #include <Core/Exceptions/DeserializationException.h>
 #include <Core/Util/JsonUtil.h>
+#include <Core/Util/JsonStreamWriter.h>
+#include <Infrastructure/Logger.h>
 #include <json/json.h>
 #include <cassert>
+#include <functional>
 #include <string>
 #include <optional>
 
@@ -173,6 +176,59 @@ public:
 		return 200;
 	}
 
+	//
+	// Streams the JSON produced by writeJSON using chunked transfer encoding, so the response is never fully built in memory.
+	// The headers aren't sent until the first chunk is ready, so if writeJSON throws before then,
+	// the exception is rethrown and the caller can still respond with an error.
+	//
+	static int BuildSuccessResponseStream(struct mg_connection* conn, const std::function<void(JsonStreamWriter&)>& writeJSON)
+	{
+		assert(conn != nullptr);
+
+		bool headersSent = false;
+		auto sendHeaders = [conn, &headersSent]() {
+			if (!headersSent)
+			{
+				mg_printf(conn,
+					"HTTP/1.1 200 OK\r\n"
+					"Content-Type: application/json\r\n"
+					"Transfer-Encoding: chunked\r\n"
+					"Connection: close\r\n\r\n");
+				headersSent = true;
+			}
+		};
+
+		JsonStreamWriter writer([conn, &sendHeaders](const char* pData, const size_t length) {
+			sendHeaders();
+			if (mg_send_chunk(conn, pData, (unsigned int)length) < 0)
+			{
+				throw HTTP_EXCEPTION("Failed to send chunk");
+			}
+		});
+
+		try
+		{
+			writeJSON(writer);
+			writer.Flush();
+		}
+		catch (std::exception& e)
+		{
+			if (!headersSent)
+			{
+				throw;
+			}
+
+			// Part of the body was already sent, so the only option is to end the response without its terminating chunk.
+			LOG_ERROR_F("Exception thrown while streaming response: {}", e.what());
+			return 500;
+		}
+
+		sendHeaders();
+		mg_send_chunk(conn, "", 0);
+
+		return 200;
+	}
+
 	static int BuildBadRequestResponse(struct mg_connection* conn, const std::string& response)
 	{
 		assert(conn != nullptr);
@@ -262,4 +318,24 @@ public:
 
 		return 500;
 	}
+
+	static int BuildServiceUnavailableResponse(struct mg_connection* conn, const uint32_t retryAfterSeconds, const std::string& response)
+	{
+		assert(conn != nullptr);
+
+		unsigned long len = (unsigned long)response.size();
+
+		mg_printf(conn,
+			"HTTP/1.1 503 Service Unavailable\r\n"
+			"Retry-After: %u\r\n"
+			"Content-Length: %lu\r\n"
+			"Content-Type: text/plain\r\n"
+			"Connection: close\r\n\r\n",
+			retryAfterSeconds,
+			len);
+
+		mg_write(conn, response.c_str(), len);
+
+		return 503;
+	}
 };
\ No newline at end of file
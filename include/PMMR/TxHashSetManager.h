@@ -2,6 +2,7 @@
 
 #include <Common/ImportExport.h>
 #include <PMMR/TxHashSet.h>
+#include <PMMR/TxHashSetReceiver.h>
 #include <Config/Config.h>
 #include <Database/BlockDb.h>
 #include <Core/Traits/Lockable.h>
@@ -13,6 +14,10 @@
 #define TXHASHSET_API IMPORT
 #endif
 
+// Forward Declarations
+class IBlockChainServer;
+class SyncStatus;
+
 class TXHASHSET_API TxHashSetManager : public Traits::IBatchable
 {
 public:
@@ -27,6 +32,18 @@ public:
 	void SetTxHashSet(ITxHashSetPtr pTxHashSet) { m_pTxHashSet = pTxHashSet; }
 
 	static ITxHashSetPtr LoadFromZip(const Config& config, const fs::path& zipFilePath, BlockHeaderPtr pHeader);
+
+	//
+	// Creates a receiver that extracts a TxHashSet archive for the given header as it's being downloaded.
+	// The kernel MMR is validated in the background as soon as it has been received.
+	//
+	static ITxHashSetReceiverPtr CreateReceiver(const Config& config, BlockHeaderPtr pHeader, const IBlockChainServer& blockChainServer, SyncStatus& syncStatus);
+
+	//
+	// Loads the TxHashSet extracted by the receiver into the TxHashSet folder. The current TxHashSet must be closed first.
+	// Returns nullptr if the archive was incomplete, or its kernel MMR was invalid.
+	//
+	static ITxHashSetPtr LoadFromReceiver(const Config& config, ITxHashSetReceiver& receiver, BlockHeaderPtr pHeader);
 	fs::path SaveSnapshot(std::shared_ptr<IBlockDB> pBlockDB, BlockHeaderPtr pHeader) const;
 
 	virtual void Commit() override final
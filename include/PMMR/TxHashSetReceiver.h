@@ -0,0 +1,44 @@
+#pragma once
+
+#include <filesystem.h>
+#include <cstdint>
+#include <memory>
+
+//
+// Extracts a zipped TxHashSet into a staging folder while it's still being downloaded.
+// As soon as the kernel MMR files are complete, the kernel MMR is validated on a background thread,
+// while the output and rangeproof files are still arriving.
+//
+// Create using TxHashSetManager::CreateReceiver, and load using TxHashSetManager::LoadFromReceiver
+// once the entire archive has been received.
+//
+class ITxHashSetReceiver
+{
+public:
+	virtual ~ITxHashSetReceiver() = default;
+
+	//
+	// Extracts the next chunk of the archive.
+	// Throws a FileException if the archive is malformed or can't be written to disk.
+	//
+	virtual void Receive(const uint8_t* pData, const size_t numBytes) = 0;
+
+	//
+	// Returns true once every expected TxHashSet file has been extracted.
+	//
+	virtual bool IsComplete() const = 0;
+
+	//
+	// Blocks until the background kernel MMR validation finishes.
+	// Returns false if the kernel MMR was invalid, or was never received.
+	//
+	virtual bool WaitForKernelValidation() = 0;
+
+	//
+	// Moves the extracted kernel, output and rangeproof folders into the given TxHashSet folder, replacing any existing ones.
+	// Any TxHashSet loaded from that folder must be closed first.
+	//
+	virtual void MoveTo(const fs::path& txHashSetPath) = 0;
+};
+
+typedef std::shared_ptr<ITxHashSetReceiver> ITxHashSetReceiverPtr;
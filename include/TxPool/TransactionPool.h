@@ -15,6 +15,9 @@
 #include <Config/Config.h>
 #include <PMMR/TxHashSetManager.h>
 #include <Crypto/Hash.h>
+#include <chrono>
+#include <functional>
+#include <optional>
 #include <vector>
 #include <set>
 
@@ -43,6 +46,8 @@ public:
 
 	//
 	// Retrieves txs from the mempool based on kernel short_ids from the compact block.
+	// Any short_ids not found in the mempool are looked up in the cache of recently seen txs,
+	// which includes txs that have since left the pool, and those from blocks on competing forks.
 	// Note: does not validate that we return the full set of required txs.
 	// The caller will need to validate that themselves.
 	//
@@ -77,6 +82,28 @@ public:
 		const FullBlock& block
 	) = 0;
 
+	//
+	// Re-adds the transactions from blocks disconnected during a reorg to the mempool,
+	// minus anything confirmed by the blocks of the new fork.
+	// Must be called once the new fork's blocks have been applied and reconciled.
+	// Transactions that are no longer valid on the new fork (eg. double-spent, or spending a rewound coinbase) are dropped.
+	//
+	virtual void ReconcileReorg(
+		std::shared_ptr<const IBlockDB> pBlockDB,
+		ITxHashSetConstPtr pTxHashSet,
+		const std::vector<FullBlock::CPtr>& rewoundBlocks,
+		const std::vector<FullBlock::CPtr>& confirmedBlocks
+	) = 0;
+
+	//
+	// Remembers the txs from blocks that were validated, but aren't part of the confirmed chain,
+	// so compact blocks containing the same txs can still be hydrated.
+	//
+	virtual void AddForkBlocks(
+		std::shared_ptr<const IBlockDB> pBlockDB,
+		const std::vector<FullBlock::CPtr>& blocks
+	) = 0;
+
 	// Dandelion
 	virtual TransactionPtr GetTransactionToStem(
 		std::shared_ptr<const IBlockDB> pBlockDB,
@@ -86,7 +113,13 @@ public:
 		std::shared_ptr<const IBlockDB> pBlockDB,
 		ITxHashSetConstPtr pTxHashSet
 	) = 0;
-	virtual std::vector<TransactionPtr> GetExpiredTransactions() const = 0;
+	virtual std::vector<TransactionPtr> GetExpiredTransactions() = 0;
+
+	//
+	// Returns the earliest patience or embargo deadline of the transactions in the stempool, if any.
+	// Dandelion can sleep until then, since no stempool entries will be due before it.
+	//
+	virtual std::optional<std::chrono::system_clock::time_point> GetNextDandelionDeadline() const = 0;
 
 	//
 	// Adds all JoinPool txs to the stem pool in preparation of fluffing.
@@ -102,8 +135,10 @@ namespace TxPoolAPI
 {
 	//
 	// Creates a new instance of the Transaction Pool.
+	// Dandelion timers are measured against the given clock, which tests can replace with a simulated one.
 	//
 	TX_POOL_API ITransactionPoolPtr CreateTransactionPool(
-		const Config& config
+		const Config& config,
+		const std::function<std::chrono::system_clock::time_point()>& clock = std::chrono::system_clock::now
 	);
 }
\ No newline at end of file
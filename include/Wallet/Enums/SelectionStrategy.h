@@ -7,7 +7,8 @@ enum class ESelectionStrategy
 {
 	SMALLEST,
 	CUSTOM,
-	ALL
+	ALL,
+	BRANCH_AND_BOUND
 };
 
 namespace SelectionStrategy
@@ -26,6 +27,10 @@ namespace SelectionStrategy
 		{
 			return ESelectionStrategy::ALL;
 		}
+		else if (input == "BRANCH_AND_BOUND")
+		{
+			return ESelectionStrategy::BRANCH_AND_BOUND;
+		}
 
 		throw DESERIALIZATION_EXCEPTION_F("Invalid selection strategy: {}", input);
 	}
@@ -44,6 +49,10 @@ namespace SelectionStrategy
 		{
 			return "ALL";
 		}
+		else if (strategy == ESelectionStrategy::BRANCH_AND_BOUND)
+		{
+			return "BRANCH_AND_BOUND";
+		}
 
 		throw DESERIALIZATION_EXCEPTION("Invalid selection strategy");
 	}
@@ -4,6 +4,7 @@
 #include <Wallet/PrivateExtKey.h>
 #include <Wallet/PublicExtKey.h>
 #include <Wallet/KeyChainPath.h>
+#include <Wallet/Keychain/KeyChainCache.h>
 
 #include <Config/Config.h>
 #include <Crypto/SecretKey.h>
@@ -19,11 +20,21 @@ class KeyChain
 {
 public:
 	// FUTURE: Add FromMnemonic, ToMnemonic, and GetSeed methods
-	static KeyChain FromSeed(const Config& config, const SecureVector& masterSeed);
+	//
+	// Creates a KeyChain for the given seed.
+	// If pCache is null, intermediate keys are only cached for the lifetime of the KeyChain (and its copies).
+	//
+	static KeyChain FromSeed(const Config& config, const SecureVector& masterSeed, const KeyChainCache::Ptr& pCache = nullptr);
 	static KeyChain FromRandom(const Config& config);
 
 	SecretKey DerivePrivateKey(const KeyChainPath& keyPath, const uint64_t amount) const;
 	SecretKey DerivePrivateKey(const KeyChainPath& keyPath) const;
+
+	//
+	// Derives the private keys of numChildren consecutive siblings, starting at parentPath/firstChildIndex.
+	// The parent is derived (or looked up) once, so each key only costs a single child derivation.
+	//
+	std::vector<SecretKey> DerivePrivateKeys(const KeyChainPath& parentPath, const uint32_t firstChildIndex, const uint32_t numChildren) const;
 	ed25519_keypair_t DeriveED25519Key(const KeyChainPath& keyPath) const;
 
 	std::unique_ptr<RewoundProof> RewindRangeProof(
@@ -41,11 +52,20 @@ public:
 	) const;
 
 private:
-	KeyChain(const Config& config, PrivateExtKey&& masterKey, SecretKey&& bulletProofNonce);
+	KeyChain(const Config& config, PrivateExtKey&& masterKey, SecretKey&& bulletProofNonce, const KeyChainCache::Ptr& pCache);
+
+	PrivateExtKey DeriveExtendedKey(const std::vector<uint32_t>& keyIndices) const;
 
 	SecretKey CreateNonce(const Commitment& commitment, const SecretKey& nonceHash) const;
 
 	const Config& m_config;
 	PrivateExtKey m_masterKey;
 	SecretKey m_bulletProofNonce;
+
+	// Per-wallet hashes used to derive EBulletproofType::ENHANCED nonces.
+	// Cached since they'd otherwise require an EC multiplication & hash for every output rewound.
+	SecretKey m_rewindNonceHash;
+	SecretKey m_privateNonceHash;
+
+	KeyChainCache::Ptr m_pCache;
 };
\ No newline at end of file
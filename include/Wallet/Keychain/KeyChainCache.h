@@ -0,0 +1,102 @@
+#pragma once
+
+#include <Wallet/PrivateExtKey.h>
+#include <Crypto/SecretKey.h>
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//
+// Bounded cache of intermediate extended private keys, keyed by their path prefix (eg. m/0/0 => { 0, 0 }).
+// Lets KeyChain compute only the final child step when deriving keys that share a parent.
+//
+// Keys are held as SecretKeys, which are erased when evicted or when the cache is cleared/destroyed.
+// A cache must only ever be shared between KeyChains created from the same seed.
+//
+class KeyChainCache
+{
+public:
+	using Ptr = std::shared_ptr<KeyChainCache>;
+
+	KeyChainCache(const size_t maxEntries = 256) : m_maxEntries(maxEntries) { }
+
+	std::unique_ptr<PrivateExtKey> Get(const std::vector<uint32_t>& path) const
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		auto iter = m_keys.find(path);
+		if (iter == m_keys.end())
+		{
+			return nullptr;
+		}
+
+		const CachedKey& cached = iter->second;
+		return std::make_unique<PrivateExtKey>(PrivateExtKey::Create(
+			cached.network,
+			cached.depth,
+			cached.parentFingerprint,
+			cached.childNumber,
+			SecretKey(cached.chainCode),
+			SecretKey(cached.privateKey)
+		));
+	}
+
+	void Put(const std::vector<uint32_t>& path, const PrivateExtKey& extendedKey)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		if (m_keys.find(path) != m_keys.end())
+		{
+			return;
+		}
+
+		while (!m_insertionOrder.empty() && m_keys.size() >= m_maxEntries)
+		{
+			m_keys.erase(m_insertionOrder.front());
+			m_insertionOrder.pop_front();
+		}
+
+		m_keys.emplace(path, CachedKey{
+			extendedKey.GetNetwork(),
+			extendedKey.GetDepth(),
+			extendedKey.GetParentFingerprint(),
+			extendedKey.GetChildNumber(),
+			extendedKey.GetChainCode(),
+			extendedKey.GetPrivateKey()
+		});
+		m_insertionOrder.push_back(path);
+	}
+
+	void Clear()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_keys.clear();
+		m_insertionOrder.clear();
+	}
+
+	size_t Size() const
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		return m_keys.size();
+	}
+
+private:
+	struct CachedKey
+	{
+		uint32_t network;
+		uint8_t depth;
+		uint32_t parentFingerprint;
+		uint32_t childNumber;
+		SecretKey chainCode;
+		SecretKey privateKey;
+	};
+
+	mutable std::mutex m_mutex;
+	std::map<std::vector<uint32_t>, CachedKey> m_keys;
+	std::deque<std::vector<uint32_t>> m_insertionOrder;
+	size_t m_maxEntries;
+};
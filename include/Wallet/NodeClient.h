@@ -4,6 +4,8 @@
 #include <Core/Models/OutputLocation.h>
 #include <Core/Models/Transaction.h>
 #include <Core/Models/DTOs/BlockWithOutputs.h>
+#include <Core/Models/DTOs/BlockDelta.h>
+#include <Core/Models/DTOs/OutputLocations.h>
 #include <Core/Models/DTOs/OutputRange.h>
 #include <TxPool/PoolType.h>
 #include <stdint.h>
@@ -33,11 +35,23 @@ public:
 	//
 	virtual std::map<Commitment, OutputLocation> GetOutputsByCommitment(const std::vector<Commitment>& commitments) const = 0;
 
+	//
+	// Returns the location of each requested output that is *unspent*, along with the confirmed chain height they were looked up at.
+	// Use this instead of GetOutputsByCommitment and GetChainHeight when the two need to agree.
+	//
+	virtual OutputLocations GetOutputLocations(const std::vector<Commitment>& commitments) const = 0;
+
 	//
 	// Returns a vector containing block ids and their outputs for the given range.
 	//
 	virtual std::vector<BlockWithOutputs> GetBlockOutputs(const uint64_t startHeight, const uint64_t maxHeight) const = 0;
 
+	//
+	// Returns the outputs created and inputs spent by each confirmed block in the given range, in height order.
+	// Stops early at the first block that isn't available (ie. pruned), so callers must check what was returned.
+	//
+	virtual std::vector<BlockDelta> GetBlockDeltas(const uint64_t startHeight, const uint64_t maxHeight) const = 0;
+
 	//
 	// Returns a list of outputs starting at the given insertion index.
 	//
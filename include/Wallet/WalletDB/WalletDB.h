@@ -1,11 +1,13 @@
 #pragma once
 
+#include <optional>
 #include <string>
 #include <vector>
 
 #include <uuid.h>
 #include <Core/Traits/Batchable.h>
 #include <Core/Traits/Lockable.h>
+#include <Crypto/Hash.h>
 #include <Wallet/WalletDB/Models/EncryptedSeed.h>
 #include <Wallet/KeyChainPath.h>
 #include <Wallet/WalletDB/Models/SlateContextEntity.h>
@@ -37,13 +39,25 @@ public:
 	virtual void AddOutputs(const SecureVector& masterSeed, const std::vector<OutputDataEntity>& outputs) = 0;
 	virtual std::vector<OutputDataEntity> GetOutputs(const SecureVector& masterSeed) const = 0;
 
+	//
+	// Changes whenever outputs are added or updated, or a write is rolled back.
+	// Lets callers tell whether anything they derived from GetOutputs is still current.
+	//
+	virtual uint64_t GetOutputsVersion() const = 0;
+
 	virtual void AddTransaction(const SecureVector& masterSeed, const WalletTx& walletTx) = 0;
 	virtual std::vector<WalletTx> GetTransactions(const SecureVector& masterSeed) const = 0;
 	virtual std::unique_ptr<WalletTx> GetTransactionById(const SecureVector& masterSeed, const uint32_t walletTxId) const = 0;
 
 	virtual uint32_t GetNextTransactionId() = 0;
 	virtual uint64_t GetRefreshBlockHeight() const = 0;
-	virtual void UpdateRefreshBlockHeight(const uint64_t refreshBlockHeight) = 0;
+
+	//
+	// Hash of the block at the refresh height, as of the last refresh.
+	// Lets the refresher tell whether a reorg has replaced that block since.
+	//
+	virtual std::optional<Hash> GetRefreshBlockHash() const = 0;
+	virtual void UpdateRefreshBlock(const uint64_t refreshBlockHeight, const std::optional<Hash>& refreshBlockHashOpt) = 0;
 	virtual uint64_t GetRestoreLeafIndex() const = 0;
 	virtual void UpdateRestoreLeafIndex(const uint64_t lastLeafIndex) = 0;
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <exception>
+#include <string>
 
 #define WALLET_STORE_EXCEPTION(msg) WalletStoreException(msg, __func__)
 
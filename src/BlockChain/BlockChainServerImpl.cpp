@@ -208,6 +208,36 @@ EBlockChainStatus BlockChainServer::ProcessTransactionHashSet(const Hash& blockH
 	return EBlockChainStatus::INVALID;
 }
 
+ITxHashSetReceiverPtr BlockChainServer::CreateTxHashSetReceiver(const Hash& blockHash, SyncStatus& syncStatus)
+{
+	auto pHeader = m_pChainState->Read()->GetBlockHeaderByHash(blockHash);
+	if (pHeader == nullptr)
+	{
+		LOG_ERROR_F("Header not found for hash {}.", blockHash);
+		return nullptr;
+	}
+
+	return TxHashSetManager::CreateReceiver(m_config, pHeader, *this, syncStatus);
+}
+
+EBlockChainStatus BlockChainServer::ProcessTransactionHashSet(const Hash& blockHash, ITxHashSetReceiver& receiver, SyncStatus& syncStatus)
+{
+	try
+	{
+		const bool success = TxHashSetProcessor(m_config, *this, m_pChainState).ProcessTxHashSet(blockHash, receiver, syncStatus);
+		if (success)
+		{
+			return EBlockChainStatus::SUCCESS;
+		}
+	}
+	catch (std::exception& e)
+	{
+		LOG_ERROR_F("Failed to process TxHashSet: {}", e.what());
+	}
+
+	return EBlockChainStatus::INVALID;
+}
+
 EBlockChainStatus BlockChainServer::AddTransaction(TransactionPtr pTransaction, const EPoolType poolType)
 {
 	try
@@ -296,6 +326,11 @@ std::vector<BlockHeaderPtr> BlockChainServer::GetBlockHeadersByHash(const std::v
 	return headers;
 }
 
+std::vector<std::vector<unsigned char>> BlockChainServer::GetRawBlockHeaders(const uint64_t startHeight, const uint64_t maxHeaders, const EChainType chainType) const
+{
+	return m_pChainState->Read()->GetBlockHeaderBytes(startHeight, maxHeaders, chainType);
+}
+
 BlockHeaderPtr BlockChainServer::GetBlockHeaderByHeight(const uint64_t height, const EChainType chainType) const
 {
 	return m_pChainState->Read()->GetBlockHeaderByHeight(height, chainType);
@@ -343,32 +378,53 @@ std::unique_ptr<FullBlock> BlockChainServer::GetBlockByHash(const Hash& hash) co
 	return m_pChainState->Read()->GetBlockByHash(hash);
 }
 
+std::unique_ptr<std::vector<unsigned char>> BlockChainServer::GetRawBlockByHash(const Hash& hash) const
+{
+	return m_pChainState->Read()->GetBlockBytesByHash(hash);
+}
+
 std::unique_ptr<FullBlock> BlockChainServer::GetBlockByHeight(const uint64_t height) const
 {
 	return m_pChainState->Read()->GetBlockByHeight(height);
 }
 
-std::vector<BlockWithOutputs> BlockChainServer::GetOutputsByHeight(const uint64_t startHeight, const uint64_t maxHeight) const
+OutputsByHeightCursor::UPtr BlockChainServer::GetOutputsByHeightCursor(const uint64_t startHeight, const uint64_t maxHeight) const
 {
-	auto pChainStateReader = m_pChainState->Read();
-	const uint64_t highestHeight = (std::min)(pChainStateReader->GetHeight(EChainType::CONFIRMED), maxHeight);
+	std::vector<BlockIdentifier> blocks;
 
-	std::vector<BlockWithOutputs> blocksWithOutputs;
-	blocksWithOutputs.reserve(highestHeight - startHeight + 1);
-
-	uint64_t height = startHeight;
-	while (height <= highestHeight)
 	{
-		std::unique_ptr<BlockWithOutputs> pBlockWithOutputs = pChainStateReader->GetBlockWithOutputs(height);
-		if (pBlockWithOutputs != nullptr)
+		auto pChainStateReader = m_pChainState->Read();
+		auto pChainStore = pChainStateReader->GetChainStore();
+		std::shared_ptr<const Chain> pConfirmedChain = pChainStore->GetConfirmedChain();
+		const uint64_t highestHeight = (std::min)(pConfirmedChain->GetHeight(), maxHeight);
+
+		if (startHeight <= highestHeight)
 		{
-			blocksWithOutputs.push_back(*pBlockWithOutputs);
+			blocks.reserve(highestHeight - startHeight + 1);
 		}
 
-		++height;
+		for (uint64_t height = startHeight; height <= highestHeight; height++)
+		{
+			// The previous hash comes from the chain itself, so no headers need to be read while holding the lock.
+			const Hash& previousHash = height == 0
+				? m_config.GetEnvironment().GetGenesisBlock().GetHeader()->GetPreviousHash()
+				: pConfirmedChain->GetHash(height - 1);
+
+			blocks.emplace_back(BlockIdentifier(pConfirmedChain->GetHash(height), previousHash, height));
+		}
 	}
 
-	return blocksWithOutputs;
+	return std::make_unique<OutputsByHeightCursor>(m_pDatabase, std::move(blocks));
+}
+
+std::vector<BlockWithOutputs> BlockChainServer::GetOutputsByHeight(const uint64_t startHeight, const uint64_t maxHeight) const
+{
+	return GetOutputsByHeightCursor(startHeight, maxHeight)->ReadAll();
+}
+
+OutputLocations BlockChainServer::GetOutputLocations(const std::vector<Commitment>& outputCommitments) const
+{
+	return m_pChainState->Read()->GetOutputLocations(outputCommitments);
 }
 
 bool BlockChainServer::HasBlock(const uint64_t height, const Hash& hash) const
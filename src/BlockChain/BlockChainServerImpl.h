@@ -41,6 +41,8 @@ public:
 
 	fs::path SnapshotTxHashSet(BlockHeaderPtr pBlockHeader) final;
 	EBlockChainStatus ProcessTransactionHashSet(const Hash& blockHash, const fs::path& path, SyncStatus& syncStatus) final;
+	ITxHashSetReceiverPtr CreateTxHashSetReceiver(const Hash& blockHash, SyncStatus& syncStatus) final;
+	EBlockChainStatus ProcessTransactionHashSet(const Hash& blockHash, ITxHashSetReceiver& receiver, SyncStatus& syncStatus) final;
 	EBlockChainStatus AddTransaction(TransactionPtr pTransaction, const EPoolType poolType) final;
 	TransactionPtr GetTransactionByKernelHash(const Hash& kernelHash) const final;
 
@@ -49,14 +51,18 @@ public:
 	BlockHeaderPtr GetBlockHeaderByCommitment(const Commitment& outputCommitment) const final;
 	BlockHeaderPtr GetTipBlockHeader(const EChainType chainType) const final;
 	std::vector<BlockHeaderPtr> GetBlockHeadersByHash(const std::vector<CBigInteger<32>>& hashes) const final;
+	std::vector<std::vector<unsigned char>> GetRawBlockHeaders(const uint64_t startHeight, const uint64_t maxHeaders, const EChainType chainType) const final;
 
 	std::unique_ptr<CompactBlock> GetCompactBlockByHash(const Hash& hash) const final;
 	std::unique_ptr<FullBlock> GetBlockByCommitment(const Commitment& blockHash) const final;
 	std::unique_ptr<FullBlock> GetBlockByHash(const Hash& blockHash) const final;
+	std::unique_ptr<std::vector<unsigned char>> GetRawBlockByHash(const Hash& blockHash) const final;
 	std::unique_ptr<FullBlock> GetBlockByHeight(const uint64_t height) const final;
 	bool HasBlock(const uint64_t height, const Hash& blockHash) const final;
 
+	OutputsByHeightCursor::UPtr GetOutputsByHeightCursor(const uint64_t startHeight, const uint64_t maxHeight) const final;
 	std::vector<BlockWithOutputs> GetOutputsByHeight(const uint64_t startHeight, const uint64_t maxHeight) const final;
+	OutputLocations GetOutputLocations(const std::vector<Commitment>& outputCommitments) const final;
 	std::vector<std::pair<uint64_t, Hash>> GetBlocksNeeded(const uint64_t maxNumBlocks) const final;
 
 	bool ProcessNextOrphanBlock() final;
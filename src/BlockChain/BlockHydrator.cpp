@@ -2,6 +2,8 @@
 
 #include <Core/Util/TransactionUtil.h>
 #include <Core/Validation/CutThroughVerifier.h>
+#include <Infrastructure/Logger.h>
+#include <algorithm>
 #include <unordered_set>
 
 BlockHydrator::BlockHydrator(std::shared_ptr<const ITransactionPool> pTransactionPool)
@@ -24,10 +26,35 @@ std::unique_ptr<FullBlock> BlockHydrator::Hydrate(const CompactBlock& compactBlo
 		std::set<ShortId> shortIdsSet(shortIds.cbegin(), shortIds.cend());
 		std::vector<TransactionPtr> transactions = m_pTransactionPool->GetTransactionsByShortId(hash, nonce, shortIdsSet);
 
-		if (transactions.size() == shortIds.size())
+		// Aggregated txs (eg. fluffed txs or fork block bodies) can only be used if the block contains all of their kernels.
+		// The block can be hydrated once every short id is covered.
+		std::vector<TransactionPtr> blockTransactions;
+		std::set<ShortId> shortIdsFound;
+		for (const TransactionPtr& pTransaction : transactions)
 		{
-			return Hydrate(compactBlock, transactions);
+			std::vector<ShortId> kernelShortIds;
+			for (const TransactionKernel& kernel : pTransaction->GetKernels())
+			{
+				kernelShortIds.push_back(ShortId::Create(kernel.GetHash(), hash, nonce));
+			}
+
+			const bool inBlock = std::all_of(
+				kernelShortIds.cbegin(), kernelShortIds.cend(),
+				[&shortIdsSet](const ShortId& shortId) { return shortIdsSet.count(shortId) > 0; }
+			);
+			if (inBlock)
+			{
+				blockTransactions.push_back(pTransaction);
+				shortIdsFound.insert(kernelShortIds.cbegin(), kernelShortIds.cend());
+			}
 		}
+
+		if (shortIdsFound.size() == shortIdsSet.size())
+		{
+			return Hydrate(compactBlock, blockTransactions);
+		}
+
+		LOG_DEBUG_F("Missing {} of {} transactions for compact block {}", shortIdsSet.size() - shortIdsFound.size(), shortIdsSet.size(), hash);
 	}
 
 	return std::unique_ptr<FullBlock>(nullptr);
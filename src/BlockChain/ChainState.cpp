@@ -130,11 +130,49 @@ BlockHeaderPtr ChainState::GetBlockHeaderByCommitment(const Commitment& outputCo
 	return BlockHeaderPtr(nullptr);
 }
 
+OutputLocations ChainState::GetOutputLocations(const std::vector<Commitment>& outputCommitments) const
+{
+	return OutputLocations(GetHeight(EChainType::CONFIRMED), GetBlockDB()->GetOutputPositions(outputCommitments));
+}
+
+std::vector<std::vector<unsigned char>> ChainState::GetBlockHeaderBytes(const uint64_t startHeight, const uint64_t maxHeaders, const EChainType chainType) const
+{
+	std::vector<std::vector<unsigned char>> headers;
+	headers.reserve(maxHeaders);
+
+	auto pChainStore = GetChainStore();
+	auto pChain = pChainStore->GetChain(chainType);
+	auto pBlockDB = GetBlockDB();
+	for (uint64_t height = startHeight; height < startHeight + maxHeaders; height++)
+	{
+		auto pBlockIndex = pChain->GetByHeight(height);
+		if (pBlockIndex == nullptr)
+		{
+			break;
+		}
+
+		std::unique_ptr<std::vector<unsigned char>> pHeaderBytes = pBlockDB->GetBlockHeaderBytes(pBlockIndex->GetHash());
+		if (pHeaderBytes == nullptr)
+		{
+			break;
+		}
+
+		headers.emplace_back(std::move(*pHeaderBytes));
+	}
+
+	return headers;
+}
+
 std::unique_ptr<FullBlock> ChainState::GetBlockByHash(const Hash& hash) const
 {
 	return GetBlockDB()->GetBlock(hash);
 }
 
+std::unique_ptr<std::vector<unsigned char>> ChainState::GetBlockBytesByHash(const Hash& hash) const
+{
+	return GetBlockDB()->GetBlockBytes(hash);
+}
+
 std::unique_ptr<FullBlock> ChainState::GetBlockByHeight(const uint64_t height) const
 {
 	auto pBlockIndex = GetChainStore()->GetChain(EChainType::CONFIRMED)->GetByHeight(height);
@@ -151,34 +189,6 @@ std::shared_ptr<const FullBlock> ChainState::GetOrphanBlock(const uint64_t heigh
 	return m_pOrphanPool->GetOrphanBlock(height, hash);
 }
 
-std::unique_ptr<BlockWithOutputs> ChainState::GetBlockWithOutputs(const uint64_t height) const
-{
-	auto pBlockIndex = GetChainStore()->GetChain(EChainType::CONFIRMED)->GetByHeight(height);
-	if (pBlockIndex != nullptr)
-	{
-		std::unique_ptr<FullBlock> pBlock = GetBlockDB()->GetBlock(pBlockIndex->GetHash());
-		if (pBlock != nullptr)
-		{
-			std::vector<OutputDTO> outputsFound;
-			outputsFound.reserve(pBlock->GetTransactionBody().GetOutputs().size());
-
-			const std::vector<TransactionOutput>& outputs = pBlock->GetTransactionBody().GetOutputs();
-			for (const TransactionOutput& output : outputs)
-			{
-				std::unique_ptr<OutputLocation> pOutputLocation = GetBlockDB()->GetOutputPosition(output.GetCommitment());
-				if (pOutputLocation != nullptr)
-				{
-					outputsFound.emplace_back(OutputDTO(false, OutputIdentifier::FromOutput(output), *pOutputLocation, output.GetRangeProof()));
-				}
-			}
-
-			return std::make_unique<BlockWithOutputs>(BlockWithOutputs(BlockIdentifier::FromHeader(*pBlock->GetBlockHeader()), std::move(outputsFound)));
-		}
-	}
-
-	return std::unique_ptr<BlockWithOutputs>(nullptr);
-}
-
 std::vector<std::pair<uint64_t, Hash>> ChainState::GetBlocksNeeded(const uint64_t maxNumBlocks) const
 {
 	std::vector<std::pair<uint64_t, Hash>> blocksNeeded;
@@ -8,6 +8,7 @@
 #include <BlockChain/ChainType.h>
 #include <BlockChain/Chain.h>
 #include <Core/Models/DTOs/BlockWithOutputs.h>
+#include <Core/Models/DTOs/OutputLocations.h>
 #include <PMMR/HeaderMMR.h>
 #include <PMMR/TxHashSetManager.h>
 #include <Crypto/Hash.h>
@@ -39,13 +40,14 @@ public:
 	BlockHeaderPtr GetBlockHeaderByHash(const Hash& hash) const;
 	BlockHeaderPtr GetBlockHeaderByHeight(const uint64_t height, const EChainType chainType) const;
 	BlockHeaderPtr GetBlockHeaderByCommitment(const Commitment& outputCommitment) const;
+	OutputLocations GetOutputLocations(const std::vector<Commitment>& outputCommitments) const;
+	std::vector<std::vector<unsigned char>> GetBlockHeaderBytes(const uint64_t startHeight, const uint64_t maxHeaders, const EChainType chainType) const;
 
 	std::unique_ptr<FullBlock> GetBlockByHash(const Hash& hash) const;
+	std::unique_ptr<std::vector<unsigned char>> GetBlockBytesByHash(const Hash& hash) const;
 	std::unique_ptr<FullBlock> GetBlockByHeight(const uint64_t height) const;
 	std::shared_ptr<const FullBlock> GetOrphanBlock(const uint64_t height, const Hash& hash) const;
 
-	std::unique_ptr<BlockWithOutputs> GetBlockWithOutputs(const uint64_t height) const;
-
 	std::vector<std::pair<uint64_t, Hash>> GetBlocksNeeded(const uint64_t maxNumBlocks) const;
 
 	virtual void Commit() override final;
@@ -96,6 +96,7 @@ EBlockChainStatus BlockProcessor::ProcessBlockInternal(const FullBlock& block)
 
 		ValidateAndAddBlock(block, pBatch);
 		pConfirmedChain->AddBlock(block.GetHash(), block.GetHeight());
+		pBatch->GetTransactionPool()->ReconcileBlock(pBatch->GetBlockDB(), pBatch->GetTxHashSetManager()->GetTxHashSet(), block);
 		pBatch->Commit();
 
 		return EBlockChainStatus::SUCCESS;
@@ -172,7 +173,20 @@ void BlockProcessor::HandleReorg(Writer<ChainState> pBatch, const std::vector<Fu
 		throw BLOCK_CHAIN_EXCEPTION("Failed to find header.");
 	}
 
-	// TODO: Add rewound transactions back to TxPool
+	// Collect the blocks being disconnected, so their transactions can be added back to the TxPool.
+	auto pConfirmedChain = pBatch->GetChainStore()->GetConfirmedChain();
+	std::vector<FullBlock::CPtr> rewoundBlocks;
+	for (uint64_t height = pCommonHeader->GetHeight() + 1; height <= pConfirmedChain->GetHeight(); height++)
+	{
+		std::shared_ptr<const FullBlock> pRewoundBlock = pBlockDB->GetBlock(pConfirmedChain->GetHash(height));
+		if (pRewoundBlock == nullptr)
+		{
+			LOG_WARNING_F("Block not found at height {}. Its transactions won't be re-added.", height);
+			continue;
+		}
+
+		rewoundBlocks.push_back(pRewoundBlock);
+	}
 
 	pTxHashSet->Rewind(pBlockDB, *pCommonHeader);
 
@@ -183,13 +197,21 @@ void BlockProcessor::HandleReorg(Writer<ChainState> pBatch, const std::vector<Fu
 
 	if (reorgBlocks.back()->GetTotalDifficulty() > totalDifficulty)
 	{
-		auto pConfirmedChain = pBatch->GetChainStore()->GetConfirmedChain();
 		pConfirmedChain->Rewind(reorgBlocks.front()->GetHeight() - 1);
 		for (const FullBlock::CPtr& pBlock : reorgBlocks)
 		{
 			pConfirmedChain->AddBlock(pBlock->GetHash(), pBlock->GetHeight());
 		}
 
+		// Reconcile against the new fork first, so only the rewound txs it doesn't confirm are re-added.
+		auto pTxPool = pBatch->GetTransactionPool();
+		for (const FullBlock::CPtr& pBlock : reorgBlocks)
+		{
+			pTxPool->ReconcileBlock(pBlockDB, pTxHashSet, *pBlock);
+		}
+
+		pTxPool->ReconcileReorg(pBlockDB, pTxHashSet, rewoundBlocks, reorgBlocks);
+
 		pBatch->Commit();
 	}
 	else
@@ -204,6 +226,9 @@ void BlockProcessor::HandleReorg(Writer<ChainState> pBatch, const std::vector<Fu
 		}
 
 		pBlockDB->Commit();
+
+		// The pool is left as is, but the fork's txs are remembered in case a compact block for it arrives.
+		pBatch->GetTransactionPool()->AddForkBlocks(pBlockDB, reorgBlocks);
 	}
 }
 
@@ -212,7 +237,6 @@ void BlockProcessor::ValidateAndAddBlock(const FullBlock& block, Writer<ChainSta
 	auto pOrphanPool = pBatch->GetOrphanPool();
 	auto pBlockDB = pBatch->GetBlockDB();
 	auto pTxHashSet = pBatch->GetTxHashSetManager()->GetTxHashSet();
-	auto pTxPool = pBatch->GetTransactionPool();
 
 	const Hash& previousHash = block.GetPreviousHash();
 	auto pPreviousHeader = pBlockDB->GetBlockHeader(previousHash);
@@ -234,5 +258,4 @@ void BlockProcessor::ValidateAndAddBlock(const FullBlock& block, Writer<ChainSta
 	pBlockDB->AddBlockSums(block.GetHash(), blockSums);
 	pBlockDB->AddBlock(block);
 	pOrphanPool->RemoveOrphan(block.GetHeight(), block.GetHash());
-	pTxPool->ReconcileBlock(pBlockDB, pTxHashSet, block);
 }
\ No newline at end of file
@@ -38,11 +38,39 @@ bool TxHashSetProcessor::ProcessTxHashSet(const Hash& blockHash, const fs::path&
 		return false;
 	}
 
+	return ValidateAndStore(pHeader, pTxHashSet, syncStatus);
+}
+
+bool TxHashSetProcessor::ProcessTxHashSet(const Hash& blockHash, ITxHashSetReceiver& receiver, SyncStatus& syncStatus)
+{
+	auto pHeader = m_pChainState->Read()->GetBlockHeaderByHash(blockHash);
+	if (pHeader == nullptr)
+	{
+		LOG_ERROR_F("Header not found for hash {}.", blockHash);
+		return false;
+	}
+
+	// 1. Close Existing TxHashSet
+	m_pChainState->Write()->GetTxHashSetManager()->Close();
+
+	// 2. Move the already extracted TxHashSet into place
+	ITxHashSetPtr pTxHashSet = TxHashSetManager::LoadFromReceiver(m_config, receiver, pHeader);
+	if (pTxHashSet == nullptr)
+	{
+		LOG_ERROR_F("Failed to load TxHashSet for {}", *pHeader);
+		return false;
+	}
+
+	return ValidateAndStore(pHeader, pTxHashSet, syncStatus);
+}
+
+bool TxHashSetProcessor::ValidateAndStore(BlockHeaderPtr pHeader, ITxHashSetPtr pTxHashSet, SyncStatus& syncStatus)
+{
 	// 3. Validate entire TxHashSet
 	auto pBlockSums = pTxHashSet->ValidateTxHashSet(*pHeader, m_blockChainServer, syncStatus);
 	if (pBlockSums == nullptr)
 	{
-		LOG_ERROR_F("Validation of {} failed.", path);
+		LOG_ERROR_F("Validation of TxHashSet for {} failed.", *pHeader);
 		return false;
 	}
 
@@ -63,7 +91,7 @@ bool TxHashSetProcessor::ProcessTxHashSet(const Hash& blockHash, const fs::path&
 	LOG_DEBUG("Updating confirmed chain.");
 	if (!UpdateConfirmedChain(pChainStateBatch, *pHeader))
 	{
-		LOG_ERROR_F("Failed to update confirmed chain for {}.", path);
+		LOG_ERROR_F("Failed to update confirmed chain for {}.", *pHeader);
 		pChainStateBatch->GetTxHashSetManager()->Close();
 		return false;
 	}
@@ -3,6 +3,7 @@
 #include "../ChainState.h"
 
 #include <PMMR/TxHashSet.h>
+#include <PMMR/TxHashSetReceiver.h>
 #include <Config/Config.h>
 #include <Crypto/Hash.h>
 #include <P2P/SyncStatus.h>
@@ -20,8 +21,10 @@ public:
 	TxHashSetProcessor(const Config& config, IBlockChainServer& blockChainServer, std::shared_ptr<Locked<ChainState>> pChainState);
 
 	bool ProcessTxHashSet(const Hash& blockHash, const fs::path& path, SyncStatus& syncStatus);
+	bool ProcessTxHashSet(const Hash& blockHash, ITxHashSetReceiver& receiver, SyncStatus& syncStatus);
 
 private:
+	bool ValidateAndStore(BlockHeaderPtr pHeader, ITxHashSetPtr pTxHashSet, SyncStatus& syncStatus);
 	bool UpdateConfirmedChain(Writer<ChainState> pLockedState, const BlockHeader& blockHeader);
 
 	const Config& m_config;
@@ -12,6 +12,14 @@ TransactionInput::TransactionInput(const EOutputFeatures features, Commitment&&
 	m_hash = Crypto::Blake2b(serializer.GetBytes());
 }
 
+TransactionInput::TransactionInput(const EOutputFeatures features, const Commitment& commitment)
+	: m_features(features), m_commitment(commitment)
+{
+	Serializer serializer;
+	Serialize(serializer);
+	m_hash = Crypto::Blake2b(serializer.GetBytes());
+}
+
 void TransactionInput::Serialize(Serializer& serializer) const
 {
 	// Serialize OutputFeatures
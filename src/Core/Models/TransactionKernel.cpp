@@ -165,4 +165,16 @@ Hash TransactionKernel::GetSignatureMessage() const
 const Hash& TransactionKernel::GetHash() const
 {
 	return m_hash;
+}
+
+ParsedCommitment TransactionKernel::GetParsedExcessCommitment() const
+{
+	std::shared_ptr<const ParsedCommitment> pParsed = std::atomic_load(&m_pParsedExcess);
+	if (pParsed == nullptr)
+	{
+		pParsed = std::make_shared<const ParsedCommitment>(Crypto::ParseCommitment(m_excessCommitment));
+		std::atomic_store(&m_pParsedExcess, pParsed);
+	}
+
+	return *pParsed;
 }
\ No newline at end of file
@@ -74,4 +74,16 @@ TransactionOutput TransactionOutput::FromJSON(const Json::Value& transactionOutp
 const Hash& TransactionOutput::GetHash() const
 {
 	return m_hash;
+}
+
+ParsedCommitment TransactionOutput::GetParsedCommitment() const
+{
+	std::shared_ptr<const ParsedCommitment> pParsed = std::atomic_load(&m_pParsedCommitment);
+	if (pParsed == nullptr)
+	{
+		pParsed = std::make_shared<const ParsedCommitment>(Crypto::ParseCommitment(m_commitment));
+		std::atomic_store(&m_pParsedCommitment, pParsed);
+	}
+
+	return *pParsed;
 }
\ No newline at end of file
@@ -1,21 +1,19 @@
 #include <Core/Validation/TransactionBodyValidator.h>
 
 #include <Core/Validation/KernelSignatureValidator.h>
+#include <Core/Validation/CutThroughVerifier.h>
 #include <Core/Exceptions/BadDataException.h>
 #include <Consensus/BlockWeight.h>
-#include <Consensus/Sorting.h>
 #include <Infrastructure/Logger.h>
 #include <Common/Util/HexUtil.h>
 #include <Crypto/Crypto.h>
-#include <set>
 
 // Validates all relevant parts of a transaction body. 
 // Checks the excess value against the signature as well as range proofs for each output.
 void TransactionBodyValidator::Validate(const TransactionBody& transactionBody, const bool withReward)
 {
 	ValidateWeight(transactionBody, withReward);
-	VerifySorted(transactionBody);
-	VerifyCutThrough(transactionBody);
+	VerifySortedAndCutThrough(transactionBody);
 	VerifyRangeProofs(transactionBody.GetOutputs());
 	
 	if (!KernelSignatureValidator::VerifyKernelSignatures(transactionBody.GetKernels()))
@@ -39,42 +37,19 @@ void TransactionBodyValidator::ValidateWeight(const TransactionBody& transaction
 	}
 }
 
-void TransactionBodyValidator::VerifySorted(const TransactionBody& transactionBody)
+// Verify that inputs, outputs, and kernels are sorted without duplicates, and that no input is spending an output from the same block.
+void TransactionBodyValidator::VerifySortedAndCutThrough(const TransactionBody& transactionBody)
 {
-	// TODO: Check for duplicates?
-	const bool sorted = Consensus::IsSorted(transactionBody.GetInputs())
-		&& Consensus::IsSorted(transactionBody.GetOutputs())
-		&& Consensus::IsSorted(transactionBody.GetKernels());
-	if (!sorted)
+	switch (CutThroughVerifier::Verify(transactionBody))
 	{
-		throw BAD_DATA_EXCEPTION("Inputs, outputs, and/or kernels not sorted.");
-	}
-}
-
-// Verify that no input is spending an output from the same block.
-void TransactionBodyValidator::VerifyCutThrough(const TransactionBody& transactionBody)
-{
-	const std::vector<TransactionOutput>& outputs = transactionBody.GetOutputs();
-	const std::vector<TransactionInput>& inputs = transactionBody.GetInputs();
-
-	// Create set with output commitments
-	std::set<Commitment> commitments;
-	std::transform(
-		outputs.cbegin(),
-		outputs.cend(),
-		std::inserter(commitments, commitments.end()),
-		[](const TransactionOutput& output) { return output.GetCommitment(); }
-	);
-
-	// Verify none of the input commitments are in the commitments set
-	const bool invalid = std::any_of(
-		inputs.cbegin(),
-		inputs.cend(),
-		[&commitments](const TransactionInput& input) { return commitments.find(input.GetCommitment()) != commitments.cend(); }
-	);
-	if (invalid)
-	{
-		throw BAD_DATA_EXCEPTION("Cut-through not performed correctly.");
+		case CutThroughVerifier::EStatus::VALID:
+			return;
+		case CutThroughVerifier::EStatus::NOT_SORTED:
+			throw BAD_DATA_EXCEPTION("Inputs, outputs, and/or kernels not sorted.");
+		case CutThroughVerifier::EStatus::DUPLICATE:
+			throw BAD_DATA_EXCEPTION("Duplicate inputs, outputs, and/or kernels.");
+		case CutThroughVerifier::EStatus::CUT_THROUGH:
+			throw BAD_DATA_EXCEPTION("Cut-through not performed correctly.");
 	}
 }
 
@@ -60,7 +60,7 @@ void TransactionValidator::ValidateKernelSums(const Transaction& transaction) co
 	
 	try
 	{
-		KernelSumValidator::ValidateKernelSums(transaction.GetBody(), overage, transaction.GetOffset(), std::nullopt);
+		KernelSumValidator::VerifyKernelSums(transaction.GetBody(), overage, transaction.GetOffset());
 	}
 	catch (std::exception& e)
 	{
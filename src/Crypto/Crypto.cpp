@@ -120,6 +120,26 @@ Commitment Crypto::AddCommitments(const std::vector<Commitment>& positive, const
 	return Pedersen::GetInstance().PedersenCommitSum(sanitizedPositive, sanitizedNegative);
 }
 
+ParsedCommitment Crypto::ParseCommitment(const Commitment& commitment)
+{
+	return Pedersen::GetInstance().ParseCommitment(commitment);
+}
+
+Commitment Crypto::SerializeCommitment(const ParsedCommitment& parsedCommitment)
+{
+	return Pedersen::GetInstance().SerializeCommitment(parsedCommitment);
+}
+
+ParsedCommitment Crypto::AddParsedCommitments(const std::vector<const ParsedCommitment*>& positive, const std::vector<const ParsedCommitment*>& negative)
+{
+	return Pedersen::GetInstance().PedersenCommitSum(positive, negative);
+}
+
+bool Crypto::VerifyCommitmentSum(const std::vector<const ParsedCommitment*>& positive, const std::vector<const ParsedCommitment*>& negative)
+{
+	return Pedersen::GetInstance().VerifyCommitmentSum(positive, negative);
+}
+
 BlindingFactor Crypto::AddBlindingFactors(const std::vector<BlindingFactor>& positive, const std::vector<BlindingFactor>& negative)
 {
 	BlindingFactor zeroBlindingFactor(ZERO_HASH);
@@ -44,38 +44,46 @@ Commitment Pedersen::PedersenCommitSum(const std::vector<Commitment>& positive,
 {
 	std::shared_lock<std::shared_mutex> readLock(m_mutex);
 
-	std::vector<secp256k1_pedersen_commitment*> positiveCommitments = Pedersen::ConvertCommitments(*m_pContext, positive);
-	std::vector<secp256k1_pedersen_commitment*> negativeCommitments = Pedersen::ConvertCommitments(*m_pContext, negative);
-
-	secp256k1_pedersen_commitment commitment;
-	const int result = secp256k1_pedersen_commit_sum(
-		m_pContext,
-		&commitment,
-		positiveCommitments.empty() ? nullptr : &positiveCommitments[0],
-		positiveCommitments.size(),
-		negativeCommitments.empty() ? nullptr : &negativeCommitments[0],
-		negativeCommitments.size()
-	);
-
-	Pedersen::CleanupCommitments(positiveCommitments);
-	Pedersen::CleanupCommitments(negativeCommitments);
-
-	if (result != 1)
+	std::vector<ParsedCommitment> parsed;
+	parsed.reserve(positive.size() + negative.size());
+	for (const Commitment& commitment : positive)
 	{
-		LOG_ERROR_F("secp256k1_pedersen_commit_sum returned result: {}", result);
-		throw CryptoException("secp256k1_pedersen_commit_sum error");
+		parsed.push_back(Parse(commitment));
 	}
 
+	for (const Commitment& commitment : negative)
+	{
+		parsed.push_back(Parse(commitment));
+	}
 
-	std::vector<unsigned char> serializedCommitment(33);
-	const int serializeResult = secp256k1_pedersen_commitment_serialize(m_pContext, &serializedCommitment[0], &commitment);
-	if (serializeResult != 1)
+	std::vector<const ParsedCommitment*> positivePointers;
+	std::vector<const ParsedCommitment*> negativePointers;
+	for (size_t i = 0; i < parsed.size(); i++)
 	{
-		LOG_ERROR_F("secp256k1_pedersen_commitment_serialize returned result: {}", serializeResult);
-		throw CryptoException("secp256k1_pedersen_commitment_serialize error");
+		(i < positive.size() ? positivePointers : negativePointers).push_back(&parsed[i]);
 	}
 
-	return Commitment(CBigInteger<33>(std::move(serializedCommitment)));
+	return Serialize(Sum(positivePointers, negativePointers));
+}
+
+ParsedCommitment Pedersen::PedersenCommitSum(const std::vector<const ParsedCommitment*>& positive, const std::vector<const ParsedCommitment*>& negative) const
+{
+	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+
+	return Sum(positive, negative);
+}
+
+bool Pedersen::VerifyCommitmentSum(const std::vector<const ParsedCommitment*>& positive, const std::vector<const ParsedCommitment*>& negative) const
+{
+	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+
+	return secp256k1_pedersen_verify_tally(
+		m_pContext,
+		ToSecp(positive),
+		positive.size(),
+		ToSecp(negative),
+		negative.size()
+	) == 1;
 }
 
 BlindingFactor Pedersen::PedersenBlindSum(const std::vector<BlindingFactor>& positive, const std::vector<BlindingFactor>& negative) const
@@ -159,6 +167,81 @@ Commitment Pedersen::ToCommitment(const PublicKey& publicKey) const
 
 }
 
+ParsedCommitment Pedersen::ParseCommitment(const Commitment& commitment) const
+{
+	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+
+	return Parse(commitment);
+}
+
+Commitment Pedersen::SerializeCommitment(const ParsedCommitment& parsedCommitment) const
+{
+	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+
+	return Serialize(parsedCommitment);
+}
+
+ParsedCommitment Pedersen::Parse(const Commitment& commitment) const
+{
+	ParsedCommitment parsed;
+	const int result = secp256k1_pedersen_commitment_parse(m_pContext, (secp256k1_pedersen_commitment*)parsed.data(), commitment.data());
+	if (result != 1)
+	{
+		LOG_ERROR_F("secp256k1_pedersen_commitment_parse failed for {}", commitment);
+		throw CryptoException("secp256k1_pedersen_commitment_parse failed with error: " + std::to_string(result));
+	}
+
+	return parsed;
+}
+
+Commitment Pedersen::Serialize(const ParsedCommitment& parsedCommitment) const
+{
+	Commitment commitment;
+	const int result = secp256k1_pedersen_commitment_serialize(m_pContext, commitment.data(), (const secp256k1_pedersen_commitment*)parsedCommitment.data());
+	if (result != 1)
+	{
+		LOG_ERROR_F("secp256k1_pedersen_commitment_serialize returned result: {}", result);
+		throw CryptoException("secp256k1_pedersen_commitment_serialize error");
+	}
+
+	return commitment;
+}
+
+ParsedCommitment Pedersen::Sum(const std::vector<const ParsedCommitment*>& positive, const std::vector<const ParsedCommitment*>& negative) const
+{
+	ParsedCommitment sum;
+	const int result = secp256k1_pedersen_commit_sum(
+		m_pContext,
+		(secp256k1_pedersen_commitment*)sum.data(),
+		ToSecp(positive),
+		positive.size(),
+		ToSecp(negative),
+		negative.size()
+	);
+	if (result != 1)
+	{
+		LOG_ERROR_F("secp256k1_pedersen_commit_sum returned result: {}", result);
+		throw CryptoException("secp256k1_pedersen_commit_sum error");
+	}
+
+	return sum;
+}
+
+const secp256k1_pedersen_commitment* const* Pedersen::ToSecp(const std::vector<const ParsedCommitment*>& parsedCommitments)
+{
+	static_assert(sizeof(ParsedCommitment) == sizeof(secp256k1_pedersen_commitment), "ParsedCommitment must match secp256k1_pedersen_commitment");
+
+	// Only the count is looked at when it's 0, but the array itself must still be non-null.
+	static const secp256k1_pedersen_commitment* const EMPTY[1] = { nullptr };
+	if (parsedCommitments.empty())
+	{
+		return EMPTY;
+	}
+
+	// ParsedCommitment's only member is the secp256k1_pedersen_commitment's data, so the pointers can be reinterpreted in place.
+	return reinterpret_cast<const secp256k1_pedersen_commitment* const*>(parsedCommitments.data());
+}
+
 std::vector<secp256k1_pedersen_commitment*> Pedersen::ConvertCommitments(const secp256k1_context& context, const std::vector<Commitment>& commitments)
 {
 	std::vector<secp256k1_pedersen_commitment*> convertedCommitments(commitments.size(), NULL);
@@ -5,6 +5,7 @@
 #include <Crypto/BlindingFactor.h>
 #include <Crypto/SecretKey.h>
 #include <Crypto/Commitment.h>
+#include <Crypto/ParsedCommitment.h>
 #include <Crypto/PublicKey.h>
 #include <shared_mutex>
 
@@ -18,12 +19,17 @@ public:
 
 	Commitment PedersenCommit(const uint64_t value, const BlindingFactor& blindingFactor) const;
 	Commitment PedersenCommitSum(const std::vector<Commitment>& positive, const std::vector<Commitment>& negative) const;
+	ParsedCommitment PedersenCommitSum(const std::vector<const ParsedCommitment*>& positive, const std::vector<const ParsedCommitment*>& negative) const;
+	bool VerifyCommitmentSum(const std::vector<const ParsedCommitment*>& positive, const std::vector<const ParsedCommitment*>& negative) const;
 	BlindingFactor PedersenBlindSum(const std::vector<BlindingFactor>& positive, const std::vector<BlindingFactor>& negative) const;
 
 	SecretKey BlindSwitch(const SecretKey& secretKey, const uint64_t amount) const;
 
 	Commitment ToCommitment(const PublicKey& publicKey) const;
 
+	ParsedCommitment ParseCommitment(const Commitment& commitment) const;
+	Commitment SerializeCommitment(const ParsedCommitment& parsedCommitment) const;
+
 	static std::vector<secp256k1_pedersen_commitment*> ConvertCommitments(const secp256k1_context& context, const std::vector<Commitment>& commitments);
 	static void CleanupCommitments(std::vector<secp256k1_pedersen_commitment*>& commitments);
 
@@ -31,6 +37,14 @@ private:
 	Pedersen();
 	~Pedersen();
 
+	// These assume the caller holds m_mutex.
+	ParsedCommitment Parse(const Commitment& commitment) const;
+	Commitment Serialize(const ParsedCommitment& parsedCommitment) const;
+	ParsedCommitment Sum(const std::vector<const ParsedCommitment*>& positive, const std::vector<const ParsedCommitment*>& negative) const;
+
+	// Never returns null, even for an empty vector, since secp256k1 declares its commitment arrays nonnull.
+	static const secp256k1_pedersen_commitment* const* ToSecp(const std::vector<const ParsedCommitment*>& parsedCommitments);
+
 	mutable std::shared_mutex m_mutex;
 	secp256k1_context* m_pContext;
 };
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "BlockDBImpl.h"
+#include "BlockOutputs.h"
 #include "RocksDB/RocksDBFactory.h"
 
 #include <Database/DatabaseException.h>
@@ -20,17 +21,36 @@ std::shared_ptr<BlockDB> BlockDB::OpenDB(const Config& config)
 	ColumnFamilyDescriptor OUTPUT_POS_COLUMN = ColumnFamilyDescriptor("OUTPUT_POS", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
 	ColumnFamilyDescriptor INPUT_BITMAP_COLUMN = ColumnFamilyDescriptor("INPUT_BITMAP", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
 	ColumnFamilyDescriptor SPENT_OUTPUTS_COLUMN = ColumnFamilyDescriptor("SPENT_OUTPUTS", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
+	ColumnFamilyDescriptor BLOCK_OUTPUTS_COLUMN = ColumnFamilyDescriptor("BLOCK_OUTPUTS", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
 
-	std::vector<ColumnFamilyDescriptor> tableNames = { ColumnFamilyDescriptor(), BLOCK_COLUMN, HEADER_COLUMN, BLOCK_SUMS_COLUMN, OUTPUT_POS_COLUMN, INPUT_BITMAP_COLUMN, SPENT_OUTPUTS_COLUMN };
+	std::vector<ColumnFamilyDescriptor> tableNames = { ColumnFamilyDescriptor(), BLOCK_COLUMN, HEADER_COLUMN, BLOCK_SUMS_COLUMN, OUTPUT_POS_COLUMN, INPUT_BITMAP_COLUMN, SPENT_OUTPUTS_COLUMN, BLOCK_OUTPUTS_COLUMN };
 	std::shared_ptr<RocksDB> pRocksDB = RocksDBFactory::Open(dbPath, tableNames);
 	pRocksDB->DeleteAll("INPUT_BITMAP");
 
-	return std::make_shared<BlockDB>(config, pRocksDB);
+	OutputPositionIndex outputPositions;
+	pRocksDB->ForEach("OUTPUT_POS", [&outputPositions](const rocksdb::Slice& key, const rocksdb::Slice& value) {
+		CBigInteger<33> commitmentBytes((const unsigned char*)key.data());
+		ByteBuffer byteBuffer(std::vector<unsigned char>(value.data(), value.data() + value.size()));
+		outputPositions.Put(Commitment(std::move(commitmentBytes)), OutputLocation::Deserialize(byteBuffer));
+	});
+	LOG_INFO_F("Loaded {} output positions", outputPositions.Size());
+
+	return std::make_shared<BlockDB>(config, pRocksDB, std::move(outputPositions));
 }
 
 void BlockDB::Commit()
 {
-	m_pRocksDB->Commit();
+	try
+	{
+		m_pRocksDB->Commit();
+	}
+	catch (...)
+	{
+		RollbackOutputPositions();
+		throw;
+	}
+
+	m_outputPositionsUndo.clear();
 
 	for (auto pHeader : m_uncommitted)
 	{
@@ -43,9 +63,27 @@ void BlockDB::Commit()
 void BlockDB::Rollback() noexcept
 {
 	m_uncommitted.clear();
+	RollbackOutputPositions();
 	m_pRocksDB->Rollback();
 }
 
+void BlockDB::RollbackOutputPositions() noexcept
+{
+	for (auto iter = m_outputPositionsUndo.rbegin(); iter != m_outputPositionsUndo.rend(); iter++)
+	{
+		if (iter->second != nullptr)
+		{
+			m_outputPositions.Put(iter->first, *iter->second);
+		}
+		else
+		{
+			m_outputPositions.Erase(iter->first);
+		}
+	}
+
+	m_outputPositionsUndo.clear();
+}
+
 BlockHeaderPtr BlockDB::GetBlockHeader(const Hash& hash) const
 {
 	if (m_blockHeadersCache.Cached(hash))
@@ -63,6 +101,17 @@ BlockHeaderPtr BlockDB::GetBlockHeader(const Hash& hash) const
 	return nullptr;
 }
 
+std::unique_ptr<std::vector<unsigned char>> BlockDB::GetBlockHeaderBytes(const Hash& hash) const
+{
+	if (m_blockHeadersCache.Cached(hash))
+	{
+		return std::make_unique<std::vector<unsigned char>>(m_blockHeadersCache.Get(hash)->Serialized());
+	}
+
+	rocksdb::Slice key((const char*)hash.data(), hash.size());
+	return m_pRocksDB->GetRaw("HEADER", key);
+}
+
 void BlockDB::AddBlockHeader(BlockHeaderPtr pBlockHeader)
 {
 	LOG_TRACE_F("Adding header {}", *pBlockHeader);
@@ -107,6 +156,7 @@ void BlockDB::AddBlock(const FullBlock& block)
 	const std::vector<unsigned char>& hash = block.GetHash().GetData();
 	rocksdb::Slice key((const char*)hash.data(), hash.size());
 	m_pRocksDB->Put("BLOCK", DBEntry<FullBlock>(key, block));
+	m_pRocksDB->Put("BLOCK_OUTPUTS", DBEntry<BlockOutputs>(key, std::make_unique<BlockOutputs>(block.GetOutputs())));
 }
 
 std::unique_ptr<FullBlock> BlockDB::GetBlock(const Hash& hash) const
@@ -115,6 +165,32 @@ std::unique_ptr<FullBlock> BlockDB::GetBlock(const Hash& hash) const
 	return m_pRocksDB->Get<FullBlock>("BLOCK", key);
 }
 
+std::unique_ptr<std::vector<unsigned char>> BlockDB::GetBlockBytes(const Hash& hash) const
+{
+	rocksdb::Slice key((const char*)hash.data(), hash.size());
+	return m_pRocksDB->GetRaw("BLOCK", key);
+}
+
+std::unique_ptr<std::vector<TransactionOutput>> BlockDB::GetBlockOutputs(const Hash& hash) const
+{
+	rocksdb::Slice key((const char*)hash.data(), hash.size());
+
+	auto pBlockOutputs = m_pRocksDB->Get<BlockOutputs>("BLOCK_OUTPUTS", key);
+	if (pBlockOutputs != nullptr)
+	{
+		return std::make_unique<std::vector<TransactionOutput>>(std::move(pBlockOutputs->GetOutputs()));
+	}
+
+	// Blocks stored before BLOCK_OUTPUTS existed aren't indexed, so fall back to the full block.
+	auto pBlock = m_pRocksDB->Get<FullBlock>("BLOCK", key);
+	if (pBlock != nullptr)
+	{
+		return std::make_unique<std::vector<TransactionOutput>>(pBlock->GetOutputs());
+	}
+
+	return nullptr;
+}
+
 void BlockDB::AddBlockSums(const Hash& blockHash, const BlockSums& blockSums)
 {
 	LOG_TRACE_F("Adding BlockSums for block {}", blockHash);
@@ -141,12 +217,33 @@ void BlockDB::AddOutputPosition(const Commitment& outputCommitment, const Output
 	rocksdb::Slice key((const char*)outputCommitment.data(), outputCommitment.size());
 
 	m_pRocksDB->Put("OUTPUT_POS", DBEntry<OutputLocation>(key, location));
+
+	if (m_pRocksDB->IsTransactional())
+	{
+		m_outputPositionsUndo.emplace_back(outputCommitment, m_outputPositions.Get(outputCommitment));
+	}
+
+	m_outputPositions.Put(outputCommitment, location);
 }
 
 std::unique_ptr<OutputLocation> BlockDB::GetOutputPosition(const Commitment& outputCommitment) const
 {
-	rocksdb::Slice key((const char*)outputCommitment.data(), outputCommitment.size());
-	return m_pRocksDB->Get<OutputLocation>("OUTPUT_POS", key);
+	return m_outputPositions.Get(outputCommitment);
+}
+
+std::map<Commitment, OutputLocation> BlockDB::GetOutputPositions(const std::vector<Commitment>& outputCommitments) const
+{
+	std::map<Commitment, OutputLocation> positions;
+	for (const Commitment& commitment : outputCommitments)
+	{
+		std::unique_ptr<OutputLocation> pLocation = m_outputPositions.Get(commitment);
+		if (pLocation != nullptr)
+		{
+			positions.insert({ commitment, *pLocation });
+		}
+	}
+
+	return positions;
 }
 
 void BlockDB::RemoveOutputPositions(const std::vector<Commitment>& outputCommitments)
@@ -159,6 +256,15 @@ void BlockDB::RemoveOutputPositions(const std::vector<Commitment>& outputCommitm
 	);
 
 	m_pRocksDB->Delete("OUTPUT_POS", keys);
+
+	for (const Commitment& commitment : outputCommitments)
+	{
+		std::unique_ptr<OutputLocation> pRemoved = m_outputPositions.Erase(commitment);
+		if (pRemoved != nullptr && m_pRocksDB->IsTransactional())
+		{
+			m_outputPositionsUndo.emplace_back(commitment, std::move(pRemoved));
+		}
+	}
 }
 
 void BlockDB::ClearOutputPositions()
@@ -166,6 +272,15 @@ void BlockDB::ClearOutputPositions()
 	LOG_WARNING("Deleting all output positions.");
 
 	m_pRocksDB->DeleteAll("OUTPUT_POS");
+
+	if (m_pRocksDB->IsTransactional())
+	{
+		m_outputPositions.ForEach([this](const Commitment& commitment, const OutputLocation& location) {
+			m_outputPositionsUndo.emplace_back(commitment, std::make_unique<OutputLocation>(location));
+		});
+	}
+
+	m_outputPositions.Clear();
 }
 
 void BlockDB::AddSpentPositions(const Hash& blockHash, const std::vector<SpentOutput>& outputPositions)
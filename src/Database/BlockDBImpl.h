@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RocksDB/RocksDB.h"
+#include "OutputPositionIndex.h"
 
 #include <Database/BlockDb.h>
 #include <Config/Config.h>
@@ -11,8 +12,8 @@
 class BlockDB : public IBlockDB
 {
 public:
-	BlockDB(const Config& config, const std::shared_ptr<RocksDB>& pRocksDB)
-		: m_config(config), m_pRocksDB(pRocksDB), m_blockHeadersCache(128) { }
+	BlockDB(const Config& config, const std::shared_ptr<RocksDB>& pRocksDB, OutputPositionIndex&& outputPositions)
+		: m_config(config), m_pRocksDB(pRocksDB), m_blockHeadersCache(128), m_outputPositions(std::move(outputPositions)) { }
 	virtual ~BlockDB() = default;
 
 	static std::shared_ptr<BlockDB> OpenDB(const Config& config);
@@ -20,15 +21,22 @@ public:
 	void Commit() final;
 	void Rollback() noexcept final;
 	void OnInitWrite() final { m_pRocksDB->OnInitWrite(); }
-	void OnEndWrite() final { m_pRocksDB->OnEndWrite(); }
+	void OnEndWrite() final
+	{
+		m_outputPositionsUndo.clear();
+		m_pRocksDB->OnEndWrite();
+	}
 
 	BlockHeaderPtr GetBlockHeader(const Hash& hash) const final;
+	std::unique_ptr<std::vector<unsigned char>> GetBlockHeaderBytes(const Hash& hash) const final;
 
 	void AddBlockHeader(BlockHeaderPtr pBlockHeader) final;
 	void AddBlockHeaders(const std::vector<BlockHeaderPtr>& blockHeaders) final;
 
 	void AddBlock(const FullBlock& block) final;
 	std::unique_ptr<FullBlock> GetBlock(const Hash& hash) const final;
+	std::unique_ptr<std::vector<unsigned char>> GetBlockBytes(const Hash& hash) const final;
+	std::unique_ptr<std::vector<TransactionOutput>> GetBlockOutputs(const Hash& hash) const final;
 
 	void AddBlockSums(const Hash& blockHash, const BlockSums& blockSums) final;
 	std::unique_ptr<BlockSums> GetBlockSums(const Hash& blockHash) const final;
@@ -36,6 +44,7 @@ public:
 
 	void AddOutputPosition(const Commitment& outputCommitment, const OutputLocation& location) final;
 	std::unique_ptr<OutputLocation> GetOutputPosition(const Commitment& outputCommitment) const final;
+	std::map<Commitment, OutputLocation> GetOutputPositions(const std::vector<Commitment>& outputCommitments) const final;
 	void RemoveOutputPositions(const std::vector<Commitment>& outputCommitments) final;
 	void ClearOutputPositions() final;
 
@@ -44,6 +53,8 @@ public:
 	void ClearSpentPositions() final;
 
 private:
+	void RollbackOutputPositions() noexcept;
+
 	//Status Read(ColumnFamilyHandle* pFamilyHandle, const Slice& key, std::string* pValue) const;
 	//Status Write(ColumnFamilyHandle* pFamilyHandle, const Slice& key, const Slice& value);
 	//Status Delete(ColumnFamilyHandle* pFamilyHandle, const Slice& key);
@@ -54,4 +65,9 @@ private:
 	FIFOCache<Hash, BlockHeaderPtr> m_blockHeadersCache;
 
 	std::vector<BlockHeaderPtr> m_uncommitted;
+
+	// In-memory copy of the OUTPUT_POS table. Changes are applied immediately (writers hold the exclusive lock),
+	// and the previous values are kept so they can be restored if the batch is rolled back.
+	OutputPositionIndex m_outputPositions;
+	std::vector<std::pair<Commitment, std::unique_ptr<OutputLocation>>> m_outputPositionsUndo;
 };
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Core/Serialization/Serializer.h>
+#include <Core/Serialization/ByteBuffer.h>
+#include <Core/Traits/Serializable.h>
+#include <Core/Models/TransactionOutput.h>
+#include <cstdint>
+#include <vector>
+
+//
+// The outputs of a single block, stored separately from the block (in BLOCK_OUTPUTS)
+// so they can be read without deserializing the inputs, kernels, and header.
+//
+class BlockOutputs : public Traits::ISerializable
+{
+public:
+	BlockOutputs(std::vector<TransactionOutput>&& outputs)
+		: m_outputs(std::move(outputs)) { }
+	BlockOutputs(const std::vector<TransactionOutput>& outputs)
+		: m_outputs(outputs) { }
+
+	//
+	// Getters
+	//
+	const std::vector<TransactionOutput>& GetOutputs() const noexcept { return m_outputs; }
+	std::vector<TransactionOutput>& GetOutputs() noexcept { return m_outputs; }
+
+	//
+	// Serialization/Deserialization
+	//
+	void Serialize(Serializer& serializer) const final
+	{
+		serializer.Append<uint8_t>(/* version= */ 0);
+		serializer.Append<uint32_t>((uint32_t)m_outputs.size());
+
+		for (const TransactionOutput& output : m_outputs)
+		{
+			output.Serialize(serializer);
+		}
+	}
+
+	static BlockOutputs Deserialize(ByteBuffer& byteBuffer)
+	{
+		const uint8_t version = byteBuffer.ReadU8();
+		assert(version == 0);
+
+		const uint32_t numOutputs = byteBuffer.ReadU32();
+
+		std::vector<TransactionOutput> outputs;
+		outputs.reserve(numOutputs);
+
+		for (uint32_t i = 0; i < numOutputs; i++)
+		{
+			outputs.push_back(TransactionOutput::Deserialize(byteBuffer));
+		}
+
+		return BlockOutputs(std::move(outputs));
+	}
+
+private:
+	std::vector<TransactionOutput> m_outputs;
+};
@@ -0,0 +1,153 @@
+#include "OutputPositionIndex.h"
+
+#include <Crypto/RandomNumberGenerator.h>
+#include <cstring>
+
+static const size_t MIN_CAPACITY = 16;
+
+OutputPositionIndex::OutputPositionIndex(const size_t expectedSize)
+	: m_mask(0), m_size(0), m_seed(RandomNumberGenerator::GenerateRandom(0, UINT64_MAX))
+{
+	Rehash(MIN_CAPACITY);
+	Reserve(expectedSize);
+}
+
+void OutputPositionIndex::Put(const Commitment& commitment, const OutputLocation& location)
+{
+	// Keep the load factor at or below 3/4.
+	if ((m_size + 1) * 4 > m_entries.size() * 3)
+	{
+		Rehash(m_entries.size() * 2);
+	}
+
+	Entry& entry = m_entries[FindSlot(commitment.data())];
+	if (!entry.occupied)
+	{
+		std::memcpy(entry.commitment.data(), commitment.data(), entry.commitment.size());
+		entry.occupied = true;
+		++m_size;
+	}
+
+	entry.mmrIndex = location.GetMMRIndex();
+	entry.blockHeight = location.GetBlockHeight();
+}
+
+std::unique_ptr<OutputLocation> OutputPositionIndex::Get(const Commitment& commitment) const
+{
+	const Entry& entry = m_entries[FindSlot(commitment.data())];
+	if (entry.occupied)
+	{
+		return std::make_unique<OutputLocation>(entry.mmrIndex, entry.blockHeight);
+	}
+
+	return nullptr;
+}
+
+std::unique_ptr<OutputLocation> OutputPositionIndex::Erase(const Commitment& commitment)
+{
+	size_t hole = FindSlot(commitment.data());
+	if (!m_entries[hole].occupied)
+	{
+		return nullptr;
+	}
+
+	auto pLocation = std::make_unique<OutputLocation>(m_entries[hole].mmrIndex, m_entries[hole].blockHeight);
+
+	// Backward-shift deletion: pull later entries of the probe sequence into the hole,
+	// so lookups never need tombstones.
+	size_t next = hole;
+	while (true)
+	{
+		next = (next + 1) & m_mask;
+		if (!m_entries[next].occupied)
+		{
+			break;
+		}
+
+		const size_t home = Hash(m_entries[next].commitment.data());
+		const bool homeBetween = (hole <= next) ? (hole < home && home <= next) : (hole < home || home <= next);
+		if (!homeBetween)
+		{
+			m_entries[hole] = m_entries[next];
+			hole = next;
+		}
+	}
+
+	m_entries[hole].occupied = false;
+	--m_size;
+
+	return pLocation;
+}
+
+void OutputPositionIndex::Clear()
+{
+	m_entries.clear();
+	m_size = 0;
+	Rehash(MIN_CAPACITY);
+}
+
+void OutputPositionIndex::Reserve(const size_t numEntries)
+{
+	size_t capacity = m_entries.size();
+	while (numEntries * 4 > capacity * 3)
+	{
+		capacity *= 2;
+	}
+
+	if (capacity != m_entries.size())
+	{
+		Rehash(capacity);
+	}
+}
+
+void OutputPositionIndex::ForEach(const std::function<void(const Commitment&, const OutputLocation&)>& callback) const
+{
+	for (const Entry& entry : m_entries)
+	{
+		if (entry.occupied)
+		{
+			CBigInteger<33> commitmentBytes(entry.commitment.data());
+			callback(Commitment(std::move(commitmentBytes)), OutputLocation(entry.mmrIndex, entry.blockHeight));
+		}
+	}
+}
+
+size_t OutputPositionIndex::Hash(const uint8_t* pCommitment) const noexcept
+{
+	// Commitments are curve points, so their bytes are already uniformly distributed.
+	// The random seed & finalizer just keep crafted commitments from clustering in the table.
+	uint64_t hash;
+	std::memcpy(&hash, pCommitment + 1, sizeof(uint64_t));
+	hash ^= m_seed;
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+
+	return (size_t)hash & m_mask;
+}
+
+size_t OutputPositionIndex::FindSlot(const uint8_t* pCommitment) const noexcept
+{
+	size_t slot = Hash(pCommitment);
+	while (m_entries[slot].occupied && std::memcmp(m_entries[slot].commitment.data(), pCommitment, 33) != 0)
+	{
+		slot = (slot + 1) & m_mask;
+	}
+
+	return slot;
+}
+
+void OutputPositionIndex::Rehash(const size_t capacity)
+{
+	std::vector<Entry> entries(capacity, Entry{ {}, false, 0, 0 });
+	entries.swap(m_entries);
+	m_mask = capacity - 1;
+
+	for (const Entry& entry : entries)
+	{
+		if (entry.occupied)
+		{
+			m_entries[FindSlot(entry.commitment.data())] = entry;
+		}
+	}
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <Crypto/Commitment.h>
+#include <Core/Models/OutputLocation.h>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+//
+// A compact, in-memory index from output commitment to OutputLocation (mmr index & block height).
+// Implemented as an open-addressing hash table with linear probing and backward-shift deletion,
+// storing the raw 33-byte commitments inline so lookups never allocate.
+//
+// This is not thread-safe. BlockDB relies on its Locked<> wrapper for synchronization.
+//
+class OutputPositionIndex
+{
+public:
+	OutputPositionIndex(const size_t expectedSize = 0);
+
+	//
+	// Inserts or replaces the location of the given commitment.
+	//
+	void Put(const Commitment& commitment, const OutputLocation& location);
+
+	//
+	// Returns the location of the given commitment.
+	// This will be null if the commitment is not indexed.
+	//
+	std::unique_ptr<OutputLocation> Get(const Commitment& commitment) const;
+
+	//
+	// Removes the commitment from the index.
+	// Returns the location it was indexed at, or null if it wasn't indexed.
+	//
+	std::unique_ptr<OutputLocation> Erase(const Commitment& commitment);
+
+	void Clear();
+	void Reserve(const size_t numEntries);
+	size_t Size() const noexcept { return m_size; }
+
+	void ForEach(const std::function<void(const Commitment&, const OutputLocation&)>& callback) const;
+
+private:
+	struct Entry
+	{
+		std::array<uint8_t, 33> commitment;
+		bool occupied;
+		uint64_t mmrIndex;
+		uint64_t blockHeight;
+	};
+
+	size_t Hash(const uint8_t* pCommitment) const noexcept;
+	size_t FindSlot(const uint8_t* pCommitment) const noexcept;
+	void Rehash(const size_t capacity);
+
+	std::vector<Entry> m_entries;
+	size_t m_mask;
+	size_t m_size;
+	uint64_t m_seed;
+};
@@ -14,6 +14,7 @@
 #include <rocksdb/utilities/transaction.h>
 #include <filesystem.h>
 #include <cassert>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -35,9 +36,11 @@ public:
 
 	bool IsTransactional() const noexcept { return m_pTransaction != nullptr; }
 
-	template<typename T,
-		typename SFINAE = typename std::enable_if_t<std::is_base_of_v<Traits::ISerializable, T>>>
-	std::unique_ptr<T> Get(const RocksDBTable& table, const rocksdb::Slice& key) const
+	//
+	// Returns the serialized value exactly as stored, without deserializing it.
+	// This will be null if no matching row is found.
+	//
+	std::unique_ptr<std::vector<unsigned char>> GetRaw(const RocksDBTable& table, const rocksdb::Slice& key) const
 	{
 		rocksdb::Status status;
 		std::string itemStr;
@@ -52,9 +55,7 @@ public:
 
 		if (status.ok())
 		{
-			std::vector<unsigned char> data(itemStr.data(), itemStr.data() + itemStr.size());
-			ByteBuffer byteBuffer(std::move(data));
-			return std::make_unique<T>(T::Deserialize(byteBuffer));
+			return std::make_unique<std::vector<unsigned char>>(itemStr.data(), itemStr.data() + itemStr.size());
 		}
 		else if (status.IsNotFound())
 		{
@@ -74,6 +75,25 @@ public:
 		}
 	}
 
+	std::unique_ptr<std::vector<unsigned char>> GetRaw(const std::string& tableName, const rocksdb::Slice& key) const
+	{
+		return GetRaw(GetTable(tableName), key);
+	}
+
+	template<typename T,
+		typename SFINAE = typename std::enable_if_t<std::is_base_of_v<Traits::ISerializable, T>>>
+	std::unique_ptr<T> Get(const RocksDBTable& table, const rocksdb::Slice& key) const
+	{
+		std::unique_ptr<std::vector<unsigned char>> pBytes = GetRaw(table, key);
+		if (pBytes != nullptr)
+		{
+			ByteBuffer byteBuffer(std::move(*pBytes));
+			return std::make_unique<T>(T::Deserialize(byteBuffer));
+		}
+
+		return nullptr;
+	}
+
 	template<typename T,
 		typename SFINAE = typename std::enable_if_t<std::is_base_of_v<Traits::ISerializable, T>>>
 	std::unique_ptr<T> Get(const std::string& tableName, const rocksdb::Slice& key) const
@@ -261,6 +281,26 @@ public:
 		DeleteAll(GetTable(tableName));
 	}
 
+	//
+	// Iterates over every committed row in the table, in key order.
+	//
+	void ForEach(const std::string& tableName, const std::function<void(const rocksdb::Slice&, const rocksdb::Slice&)>& callback) const
+	{
+		const RocksDBTable& table = GetTable(tableName);
+
+		std::unique_ptr<rocksdb::Iterator> it(m_pTransactionDB->GetBaseDB()->NewIterator(rocksdb::ReadOptions(), table.GetHandle()));
+		for (it->SeekToFirst(); it->Valid(); it->Next())
+		{
+			callback(it->key(), it->value());
+		}
+
+		if (!it->status().ok())
+		{
+			LOG_ERROR_F("Error while iterating table {}. Error: {}", table, it->status().getState());
+			throw DATABASE_EXCEPTION_F("Error while iterating table {}", table);
+		}
+	}
+
 	void Commit() final
 	{
 		assert(m_pTransaction != nullptr);
@@ -20,6 +20,23 @@ Socket::Socket(const SocketAddress& address)
 
 }
 
+Socket::Socket(
+	const SocketAddress& address,
+	const std::shared_ptr<asio::io_context>& pContext,
+	const std::shared_ptr<asio::ip::tcp::socket>& pSocket)
+	: m_pSocket(pSocket),
+	m_pContext(pContext),
+	m_address(address),
+	m_socketOpen(pSocket->is_open()),
+	m_blocking(true),
+	m_receiveBufferSize(0),
+	m_receiveTimeout(DEFAULT_TIMEOUT),
+	m_sendTimeout(DEFAULT_TIMEOUT)
+{
+	setsockopt(m_pSocket->native_handle(), SOL_SOCKET, SO_RCVTIMEO, (char*)& DEFAULT_TIMEOUT, sizeof(DEFAULT_TIMEOUT));
+	setsockopt(m_pSocket->native_handle(), SOL_SOCKET, SO_SNDTIMEO, (char*)& DEFAULT_TIMEOUT, sizeof(DEFAULT_TIMEOUT));
+}
+
 Socket::~Socket()
 {
 	m_pSocket.reset();
@@ -76,54 +93,6 @@ bool Socket::Connect(std::shared_ptr<asio::io_context> pContext)
 	return m_socketOpen;
 }
 
-bool Socket::Accept(std::shared_ptr<asio::io_context> pContext, asio::ip::tcp::acceptor& acceptor, const std::atomic_bool& terminate)
-{
-	m_pContext = pContext;
-	m_pSocket = std::make_shared<asio::ip::tcp::socket>(*pContext);
-	acceptor.async_accept(*m_pSocket, [this, pContext](const asio::error_code & ec)
-		{
-			m_errorCode = ec;
-			if (!ec)
-			{
-				if (setsockopt(m_pSocket->native_handle(), SOL_SOCKET, SO_RCVTIMEO, (char*)& DEFAULT_TIMEOUT, sizeof(DEFAULT_TIMEOUT)) == SOCKET_ERROR)
-				{
-					return false;
-				}
-
-				if (setsockopt(m_pSocket->native_handle(), SOL_SOCKET, SO_SNDTIMEO, (char*)& DEFAULT_TIMEOUT, sizeof(DEFAULT_TIMEOUT)) == SOCKET_ERROR)
-				{
-					return false;
-				}
-
-				const std::string address = m_pSocket->remote_endpoint().address().to_string();
-				m_address = SocketAddress(address, m_pSocket->remote_endpoint().port());
-				m_socketOpen = true;
-				return true;
-			}
-			else
-			{
-				asio::error_code ignoreError;
-				m_pSocket->close(ignoreError);
-				return false;
-			}
-		}
-	);
-
-	while (!m_errorCode && !m_socketOpen)
-	{
-		if (terminate)
-		{
-			break;
-		}
-
-		pContext->run_one_for(std::chrono::milliseconds(100));
-	}
-
-	pContext->reset();
-
-	return m_socketOpen;
-}
-
 bool Socket::CloseSocket()
 {
 	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
@@ -57,30 +57,22 @@ std::vector<uint64_t> BlockLocator::GetLocatorHeights(const SyncStatus& syncStat
 	return heights;
 }
 
-std::vector<BlockHeaderPtr> BlockLocator::LocateHeaders(const std::vector<Hash>& locatorHashes) const
+std::vector<std::vector<unsigned char>> BlockLocator::LocateHeaders(const std::vector<Hash>& locatorHashes) const
 {
-	std::vector<BlockHeaderPtr> blockHeaders;
-
 	auto pCommonHeader = FindCommonHeader(locatorHashes);
 	if (pCommonHeader != nullptr)
 	{
 		const uint64_t totalHeight = m_pBlockChainServer->GetHeight(EChainType::CANDIDATE);
 		const uint64_t headerHeight = pCommonHeader->GetHeight();
-		const uint64_t numHeadersToSend = (std::min)(totalHeight - headerHeight, (uint64_t)P2P::MAX_BLOCK_HEADERS);
-
-		for (int i = 1; i <= numHeadersToSend; i++)
+		if (totalHeight > headerHeight)
 		{
-			auto pHeader = m_pBlockChainServer->GetBlockHeaderByHeight(headerHeight + i, EChainType::CANDIDATE);
-			if (pHeader == nullptr)
-			{
-				break;
-			}
+			const uint64_t numHeadersToSend = (std::min)(totalHeight - headerHeight, (uint64_t)P2P::MAX_BLOCK_HEADERS);
 
-			blockHeaders.push_back(pHeader);
+			return m_pBlockChainServer->GetRawBlockHeaders(headerHeight + 1, numHeadersToSend, EChainType::CANDIDATE);
 		}
 	}
 	
-	return blockHeaders;
+	return {};
 }
 
 BlockHeaderPtr BlockLocator::FindCommonHeader(const std::vector<Hash>& locatorHashes) const
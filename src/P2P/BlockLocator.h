@@ -11,7 +11,12 @@ public:
 	BlockLocator(IBlockChainServerPtr pBlockChainServer);
 
 	std::vector<Hash> GetLocators(const SyncStatus& syncStatus) const;
-	std::vector<BlockHeaderPtr> LocateHeaders(const std::vector<Hash>& locatorHashes) const;
+
+	//
+	// Returns the serialized headers following the most recent locator found on the candidate chain.
+	// The headers are returned exactly as stored, so they can be framed directly into a Headers message.
+	//
+	std::vector<std::vector<unsigned char>> LocateHeaders(const std::vector<Hash>& locatorHashes) const;
 
 private:
 	std::vector<uint64_t> GetLocatorHeights(const SyncStatus& syncStatus) const;
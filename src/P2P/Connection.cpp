@@ -94,7 +94,12 @@ bool Connection::IsConnectionActive() const
 
 void Connection::Send(const IMessage& message)
 {
-	m_sendQueue.push_back(message.Clone());
+	m_sendQueue.push_back(std::make_shared<const SerializedMessage>(message.Clone()));
+}
+
+void Connection::Send(const SerializedMessage::Ptr& pMessage)
+{
+	m_sendQueue.push_back(pMessage);
 }
 
 bool Connection::ExceedsRateLimit() const
@@ -111,23 +116,23 @@ void Connection::Thread_ProcessConnection(std::shared_ptr<Connection> pConnectio
 {
 	try
 	{
-		EDirection direction = EDirection::INBOUND;
-		bool connected = pConnection->GetSocket()->IsSocketOpen();
-		if (!connected)
+		bool handshakeSuccess = false;
+		if (pConnection->m_connectedPeer.GetDirection() == EDirection::INBOUND)
 		{
-			pConnection->m_pContext = std::make_shared<asio::io_context>();
-			direction = EDirection::OUTBOUND;
-			connected = pConnection->m_pSocket->Connect(pConnection->m_pContext);
+			// Inbound connections are only created by the Seeder's listener once their handshake has completed.
+			handshakeSuccess = pConnection->GetSocket()->IsSocketOpen();
 		}
-
-		bool handshakeSuccess = false;
-		if (connected)
+		else
 		{
-			handshakeSuccess = pConnection->m_pHandShake->PerformHandshake(
-				*pConnection->m_pSocket,
-				pConnection->m_connectedPeer,
-				direction
-			);
+			pConnection->m_pContext = std::make_shared<asio::io_context>();
+			if (pConnection->m_pSocket->Connect(pConnection->m_pContext))
+			{
+				handshakeSuccess = pConnection->m_pHandShake->PerformHandshake(
+					*pConnection->m_pSocket,
+					pConnection->m_connectedPeer,
+					EDirection::OUTBOUND
+				);
+			}
 		}
 
 		if (handshakeSuccess)
@@ -214,11 +219,14 @@ void Connection::Thread_ProcessConnection(std::shared_ptr<Connection> pConnectio
 			}
 
 			// Send the next message in the queue, if one exists.
-			auto pMessageToSend = pConnection->m_sendQueue.copy_front();
+			// When idle, this waits briefly in place of sleeping, and wakes as soon as a message is queued.
+			auto pMessageToSend = pConnection->m_sendQueue.pop_wait(
+				std::chrono::milliseconds(messageSentOrReceived ? 0 : 5),
+				pConnection->m_terminate
+			);
 			if (pMessageToSend != nullptr)
 			{
-				IMessagePtr pMessage = *pMessageToSend;
-				pConnection->m_sendQueue.pop_front(1);
+				SerializedMessage::Ptr pMessage = *pMessageToSend;
 
 				pConnection->m_pMessageSender->Send(
 					*pConnection->m_pSocket,
@@ -235,8 +243,6 @@ void Connection::Thread_ProcessConnection(std::shared_ptr<Connection> pConnectio
 				{
 					break;
 				}
-
-				ThreadUtil::SleepFor(std::chrono::milliseconds(5), pConnection->m_terminate);
 			}
 		}
 		catch (const DeserializationException&)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Messages/Message.h"
+#include "Messages/SerializedMessage.h"
 
 #include <Common/ConcurrentQueue.h>
 #include <BlockChain/BlockChainServer.h>
@@ -60,6 +61,7 @@ public:
 	bool IsConnectionActive() const;
 
 	void Send(const IMessage& message);
+	void Send(const SerializedMessage::Ptr& pMessage);
 
 	SocketPtr GetSocket() const { return m_pSocket; }
 	PeerPtr GetPeer() { return m_connectedPeer.GetPeer(); }
@@ -92,7 +94,7 @@ private:
 	std::shared_ptr<asio::io_context> m_pContext;
 	mutable SocketPtr m_pSocket;
 
-	ConcurrentQueue<IMessagePtr> m_sendQueue;
+	ConcurrentQueue<SerializedMessage::Ptr> m_sendQueue;
 };
 
 typedef std::shared_ptr<Connection> ConnectionPtr;
\ No newline at end of file
@@ -15,8 +15,10 @@
 #include <Common/Util/ThreadUtil.h>
 #include <Crypto/RandomNumberGenerator.h>
 
-ConnectionManager::ConnectionManager()
+ConnectionManager::ConnectionManager(const size_t broadcastFanout)
 	: m_connections(std::make_shared<std::vector<ConnectionPtr>>()),
+	m_broadcastFanout(broadcastFanout),
+	m_terminate(false),
 	m_numOutbound(0),
 	m_numInbound(0)
 {
@@ -32,6 +34,7 @@ void ConnectionManager::Shutdown()
 {
 	try
 	{
+		m_terminate = true;
 		ThreadUtil::Join(m_broadcastThread);
 
 		PruneConnections(false);
@@ -46,9 +49,10 @@ void ConnectionManager::Shutdown()
 	}
 }
 
-std::shared_ptr<ConnectionManager> ConnectionManager::Create()
+std::shared_ptr<ConnectionManager> ConnectionManager::Create(const Config& config)
 {
-	auto pConnectionManager = std::shared_ptr<ConnectionManager>(new ConnectionManager());
+	const size_t broadcastFanout = (size_t)std::max(config.GetP2PConfig().GetBroadcastFanout(), 1);
+	auto pConnectionManager = std::shared_ptr<ConnectionManager>(new ConnectionManager(broadcastFanout));
 	pConnectionManager->m_broadcastThread = std::thread(Thread_Broadcast, std::ref(*pConnectionManager));
 	return pConnectionManager;
 }
@@ -188,7 +192,7 @@ bool ConnectionManager::SendMessageToPeer(const IMessage& message, PeerConstPtr
 
 void ConnectionManager::BroadcastMessage(const IMessage& message, const uint64_t sourceId)
 {
-	m_sendQueue.push_back(MessageToBroadcast(sourceId, message.Clone()));
+	m_sendQueue.push_back(MessageToBroadcast(sourceId, std::make_shared<const SerializedMessage>(message.Clone())));
 }
 
 void ConnectionManager::AddConnection(ConnectionPtr pConnection)
@@ -307,28 +311,60 @@ ConnectionPtr ConnectionManager::GetMostWorkPeer(const std::vector<ConnectionPtr
 	return mostWorkPeers[index];
 }
 
+std::vector<ConnectionPtr> ConnectionManager::GetBroadcastTargets(
+	const std::vector<ConnectionPtr>& connections,
+	const SerializedMessage& message,
+	const uint64_t sourceId) const
+{
+	std::vector<ConnectionPtr> targets;
+	std::copy_if(
+		connections.cbegin(),
+		connections.cend(),
+		std::back_inserter(targets),
+		[sourceId](const ConnectionPtr& pConnection) { return pConnection->GetId() != sourceId; }
+	);
+
+	const MessageTypes::EMessageType messageType = message.GetMessageType();
+	const bool isBlock = messageType == MessageTypes::Header
+		|| messageType == MessageTypes::CompactBlockMsg
+		|| messageType == MessageTypes::Block;
+	if (isBlock || targets.size() <= m_broadcastFanout)
+	{
+		return targets;
+	}
+
+	// Partial Fisher-Yates shuffle to pick m_broadcastFanout random peers.
+	for (size_t i = 0; i < m_broadcastFanout; i++)
+	{
+		const size_t j = (size_t)RandomNumberGenerator::GenerateRandom(i, targets.size() - 1);
+		std::swap(targets[i], targets[j]);
+	}
+
+	targets.resize(m_broadcastFanout);
+	return targets;
+}
+
 void ConnectionManager::Thread_Broadcast(ConnectionManager& connectionManager)
 {
-	while (!ShutdownManagerAPI::WasShutdownRequested()) 
+	while (!ShutdownManagerAPI::WasShutdownRequested() && !connectionManager.m_terminate) 
 	{
-		std::unique_ptr<MessageToBroadcast> pBroadcastMessage = connectionManager.m_sendQueue.copy_front();
+		std::unique_ptr<MessageToBroadcast> pBroadcastMessage = connectionManager.m_sendQueue.pop_wait(
+			std::chrono::milliseconds(100),
+			connectionManager.m_terminate
+		);
 		if (pBroadcastMessage != nullptr)
 		{
-			connectionManager.m_sendQueue.pop_front(1);
-
-			// TODO: This should only broadcast to 8(?) peers. Should maybe be configurable.
 			auto pConnections = connectionManager.m_connections.Read();
-			for (ConnectionPtr pConnection : *pConnections)
+			const std::vector<ConnectionPtr> targets = connectionManager.GetBroadcastTargets(
+				*pConnections,
+				*pBroadcastMessage->m_pMessage,
+				pBroadcastMessage->m_sourceId
+			);
+
+			for (const ConnectionPtr& pConnection : targets)
 			{
-				if (pConnection->GetId() != pBroadcastMessage->m_sourceId)
-				{
-					pConnection->Send(*pBroadcastMessage->m_pMessage);
-				}
+				pConnection->Send(pBroadcastMessage->m_pMessage);
 			}
 		}
-		else
-		{
-			ThreadUtil::SleepFor(std::chrono::milliseconds(100), ShutdownManagerAPI::WasShutdownRequested());
-		}
 	}
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Connection.h"
+#include "Messages/SerializedMessage.h"
 
 #include <Common/ConcurrentQueue.h>
 #include <Core/Traits/Lockable.h>
@@ -12,7 +13,7 @@
 class ConnectionManager
 {
 public:
-	static std::shared_ptr<ConnectionManager> Create();
+	static std::shared_ptr<ConnectionManager> Create(const Config& config);
 	~ConnectionManager();
 
 	void Shutdown();
@@ -32,32 +33,43 @@ public:
 
 	PeerPtr SendMessageToMostWorkPeer(const IMessage& message, const bool preferGrinPP = false);
 	bool SendMessageToPeer(const IMessage& message, PeerConstPtr pPeer);
+
+	//
+	// Queues the message to be relayed to peers other than the source.
+	// Blocks (and their headers/compact blocks) go to every peer, while everything else goes to
+	// a random subset of P2PConfig::GetBroadcastFanout() peers. The message is serialized once and shared by all recipients.
+	//
 	void BroadcastMessage(const IMessage& message, const uint64_t sourceId);
 
 	void PruneConnections(const bool bInactiveOnly);
 	void AddConnection(ConnectionPtr pConnection);
 
 private:
-	ConnectionManager();
+	ConnectionManager(const size_t broadcastFanout);
 
 	ConnectionPtr GetMostWorkPeer(const std::vector<ConnectionPtr>& connections, const bool preferGrinPP) const;
+	std::vector<ConnectionPtr> GetBroadcastTargets(const std::vector<ConnectionPtr>& connections, const SerializedMessage& message, const uint64_t sourceId) const;
 	static void Thread_Broadcast(ConnectionManager& connectionManager);
 	
 	Locked<std::vector<ConnectionPtr>> m_connections;
 
 	struct MessageToBroadcast
 	{
-		MessageToBroadcast(uint64_t sourceId, std::shared_ptr<IMessage> pMessage)
+		MessageToBroadcast(uint64_t sourceId, SerializedMessage::Ptr pMessage)
 			: m_sourceId(sourceId), m_pMessage(pMessage)
 		{
 
 		}
 		uint64_t m_sourceId;
-		std::shared_ptr<IMessage> m_pMessage;
+		SerializedMessage::Ptr m_pMessage;
 	};
 
 	ConcurrentQueue<MessageToBroadcast> m_sendQueue;
 	std::thread m_broadcastThread;
+	const size_t m_broadcastFanout;
+
+	// Stops the broadcast thread without requiring a node-wide shutdown (ie. when only this ConnectionManager is destroyed).
+	std::atomic_bool m_terminate;
 
 	std::atomic<size_t> m_numOutbound;
 	std::atomic<size_t> m_numInbound;
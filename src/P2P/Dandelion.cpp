@@ -61,7 +61,7 @@ std::shared_ptr<Dandelion> Dandelion::Create(
 // With Dandelion, transactions can be broadcasted in stem or fluff phase.
 // When sent in stem phase, the transaction is relayed to only 1 node: the dandelion relay.
 // In order to maintain reliability a timer is started for each transaction sent in stem phase.
-// This function will monitor the stempool and test if the timer is expired for each transaction. 
+// This function will wake up whenever one of those timers is due, and process only the transactions whose timers expired. 
 // In that case  the transaction will be sent in fluff phase (to multiple peers) instead of sending only to the peer relay.
 void Dandelion::Thread_Monitor(Dandelion& dandelion)
 {
@@ -71,9 +71,18 @@ void Dandelion::Thread_Monitor(Dandelion& dandelion)
 	const DandelionConfig& config = dandelion.m_config.GetNodeConfig().GetDandelion();
 	while (!dandelion.m_terminate)
 	{
-		// This is the patience timer, we loop every n secs.
-		const uint8_t patience = config.GetPatienceSeconds();
-		ThreadUtil::SleepFor(std::chrono::seconds(patience), dandelion.m_terminate);
+		// Each stempool entry has its own patience & embargo timers, so sleep until the next one is due.
+		// The patience timer still bounds the sleep, since new entries are never due sooner than that.
+		// Timers have a resolution of 1 second, so never wake more often than that (eg. while entries can't be processed yet).
+		const auto now = std::chrono::system_clock::now();
+		auto wakeTime = now + std::chrono::seconds(config.GetPatienceSeconds());
+		const auto nextDeadlineOpt = dandelion.m_pTransactionPool->GetNextDandelionDeadline();
+		if (nextDeadlineOpt.has_value() && nextDeadlineOpt.value() < wakeTime)
+		{
+			wakeTime = (std::max)(nextDeadlineOpt.value(), now + std::chrono::seconds(1));
+		}
+
+		ThreadUtil::SleepFor(wakeTime - now, dandelion.m_terminate);
 
 		try
 		{
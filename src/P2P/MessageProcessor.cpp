@@ -16,7 +16,9 @@
 #include "Messages/GetHeadersMessage.h"
 #include "Messages/HeaderMessage.h"
 #include "Messages/HeadersMessage.h"
+#include "Messages/RawHeadersMessage.h"
 #include "Messages/BlockMessage.h"
+#include "Messages/RawBlockMessage.h"
 #include "Messages/GetBlockMessage.h"
 #include "Messages/CompactBlockMessage.h"
 #include "Messages/GetCompactBlockMessage.h"
@@ -175,10 +177,10 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(
 				const GetHeadersMessage getHeadersMessage = GetHeadersMessage::Deserialize(byteBuffer);
 				const std::vector<Hash>& hashes = getHeadersMessage.GetHashes();
 
-				std::vector<BlockHeaderPtr> blockHeaders = BlockLocator(m_pBlockChainServer).LocateHeaders(hashes);
+				std::vector<std::vector<unsigned char>> blockHeaders = BlockLocator(m_pBlockChainServer).LocateHeaders(hashes);
 				LOG_DEBUG_F("Sending {} headers to {}.", blockHeaders.size(), formattedIPAddress);
-                
-				const HeadersMessage headersMessage(std::move(blockHeaders));
+
+				const RawHeadersMessage headersMessage(std::move(blockHeaders));
 				return MessageSender(m_config).Send(socket, headersMessage, protocolVersion) ? EStatus::SUCCESS : EStatus::SOCKET_FAILURE;
 			}
 			case Header:
@@ -234,6 +236,20 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(
 			case GetBlock:
 			{
 				const GetBlockMessage getBlockMessage = GetBlockMessage::Deserialize(byteBuffer);
+
+				// Blocks are stored using V1 serialization, so they can be sent as-is to V1 peers.
+				if (protocolVersion == EProtocolVersion::V1)
+				{
+					std::unique_ptr<std::vector<unsigned char>> pSerializedBlock = m_pBlockChainServer->GetRawBlockByHash(getBlockMessage.GetHash());
+					if (pSerializedBlock != nullptr)
+					{
+						const RawBlockMessage blockMessage(std::move(*pSerializedBlock));
+						return MessageSender(m_config).Send(socket, blockMessage, protocolVersion) ? EStatus::SUCCESS : EStatus::SOCKET_FAILURE;
+					}
+
+					return EStatus::RESOURCE_NOT_FOUND;
+				}
+
 				std::unique_ptr<FullBlock> pBlock = m_pBlockChainServer->GetBlockByHash(getBlockMessage.GetHash());
 				if (pBlock != nullptr)
 				{
@@ -296,11 +312,30 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(
 				const CompactBlockMessage compactBlockMessage = CompactBlockMessage::Deserialize(byteBuffer);
 				const CompactBlock& compactBlock = compactBlockMessage.GetCompactBlock();
 
-				const EBlockChainStatus added = m_pBlockChainServer->AddCompactBlock(compactBlock);
-				if (added == EBlockChainStatus::SUCCESS)
+				// Relay the header as soon as it's validated, so peers can start requesting the block
+				// while it's still being hydrated here.
+				const EBlockChainStatus headerStatus = m_pBlockChainServer->AddBlockHeader(compactBlock.GetBlockHeader());
+				if (headerStatus == EBlockChainStatus::INVALID)
+				{
+					return EStatus::BAN_PEER;
+				}
+
+				const bool headerRelayed = (headerStatus == EBlockChainStatus::SUCCESS);
+				if (headerRelayed)
 				{
 					const HeaderMessage headerMessage(compactBlock.GetBlockHeader());
 					m_connectionManager.BroadcastMessage(headerMessage, connectionId);
+				}
+
+				const EBlockChainStatus added = m_pBlockChainServer->AddCompactBlock(compactBlock);
+				if (added == EBlockChainStatus::SUCCESS)
+				{
+					if (!headerRelayed)
+					{
+						const HeaderMessage headerMessage(compactBlock.GetBlockHeader());
+						m_connectionManager.BroadcastMessage(headerMessage, connectionId);
+					}
+
 					return EStatus::SUCCESS;
 				}
 				else if (added == EBlockChainStatus::TRANSACTIONS_MISSING)
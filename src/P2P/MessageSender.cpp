@@ -10,19 +10,23 @@ MessageSender::MessageSender(const Config& config)
 
 bool MessageSender::Send(Socket& socket, const IMessage& message, const EProtocolVersion protocolVersion) const
 {
-	Serializer serializer(protocolVersion);
-	serializer.AppendByteVector(m_config.GetEnvironment().GetMagicBytes());
-	serializer.Append<uint8_t>((uint8_t)message.GetMessageType());
+	if (message.GetMessageType() != MessageTypes::Ping && message.GetMessageType() != MessageTypes::Pong)
+	{
+		LOG_TRACE_F("Sending message ({}) to ({})", MessageTypes::ToString(message.GetMessageType()), socket);
+	}
 
-	Serializer bodySerializer(protocolVersion);
-	message.SerializeBody(bodySerializer);
-	serializer.Append<uint64_t>(bodySerializer.size());
-	serializer.AppendByteVector(bodySerializer.GetBytes());
+	return socket.Send(
+		SerializedMessage::Serialize(m_config.GetEnvironment().GetMagicBytes(), message, protocolVersion),
+		true
+	);
+}
 
+bool MessageSender::Send(Socket& socket, const SerializedMessage& message, const EProtocolVersion protocolVersion) const
+{
 	if (message.GetMessageType() != MessageTypes::Ping && message.GetMessageType() != MessageTypes::Pong)
 	{
 		LOG_TRACE_F("Sending message ({}) to ({})", MessageTypes::ToString(message.GetMessageType()), socket);
 	}
 
-	return socket.Send(serializer.GetBytes(), true);
+	return socket.Send(*message.GetBytes(m_config.GetEnvironment().GetMagicBytes(), protocolVersion), true);
 }
\ No newline at end of file
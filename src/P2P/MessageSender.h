@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Messages/Message.h"
+#include "Messages/SerializedMessage.h"
 
 #include <Net/Socket.h>
 #include <Config/Config.h>
@@ -11,7 +12,8 @@ public:
 	MessageSender(const Config& config);
 
 	bool Send(Socket& socket, const IMessage& message, const EProtocolVersion protocolVersion) const;
+	bool Send(Socket& socket, const SerializedMessage& message, const EProtocolVersion protocolVersion) const;
 
 private:
 	const Config& m_config;
-};
\ No newline at end of file
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Message.h"
+
+#include <vector>
+
+//
+// A Block message whose body is the block exactly as stored in the database.
+// Only valid for peers using EProtocolVersion::V1, since that is the format blocks are stored in.
+//
+class RawBlockMessage : public IMessage
+{
+public:
+	//
+	// Constructors
+	//
+	RawBlockMessage(std::vector<unsigned char>&& serializedBlock)
+		: m_serializedBlock(std::move(serializedBlock))
+	{
+
+	}
+	RawBlockMessage(const RawBlockMessage& other) = default;
+	RawBlockMessage(RawBlockMessage&& other) noexcept = default;
+
+	//
+	// Destructor
+	//
+	virtual ~RawBlockMessage() = default;
+
+	//
+	// Operators
+	//
+	RawBlockMessage& operator=(const RawBlockMessage& other) = default;
+	RawBlockMessage& operator=(RawBlockMessage&& other) noexcept = default;
+
+	//
+	// Clone
+	//
+	virtual IMessagePtr Clone() const override final { return IMessagePtr(new RawBlockMessage(*this)); }
+
+	//
+	// Getters
+	//
+	virtual MessageTypes::EMessageType GetMessageType() const override final { return MessageTypes::Block; }
+	const std::vector<unsigned char>& GetSerializedBlock() const { return m_serializedBlock; }
+
+protected:
+	virtual void SerializeBody(Serializer& serializer) const override final
+	{
+		serializer.AppendByteVector(m_serializedBlock);
+	}
+
+private:
+	std::vector<unsigned char> m_serializedBlock;
+};
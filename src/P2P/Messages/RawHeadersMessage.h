@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Message.h"
+
+#include <vector>
+
+//
+// A Headers message built from already-serialized headers, as stored in the database.
+// Header serialization doesn't depend on the protocol version, so this is valid for all peers.
+//
+class RawHeadersMessage : public IMessage
+{
+public:
+	//
+	// Constructors
+	//
+	RawHeadersMessage(std::vector<std::vector<unsigned char>>&& serializedHeaders)
+		: m_serializedHeaders(std::move(serializedHeaders))
+	{
+
+	}
+	RawHeadersMessage(const RawHeadersMessage& other) = default;
+	RawHeadersMessage(RawHeadersMessage&& other) noexcept = default;
+
+	//
+	// Destructor
+	//
+	virtual ~RawHeadersMessage() = default;
+
+	//
+	// Operators
+	//
+	RawHeadersMessage& operator=(const RawHeadersMessage& other) = default;
+	RawHeadersMessage& operator=(RawHeadersMessage&& other) noexcept = default;
+
+	//
+	// Clone
+	//
+	virtual IMessagePtr Clone() const override final { return IMessagePtr(new RawHeadersMessage(*this)); }
+
+	//
+	// Getters
+	//
+	virtual MessageTypes::EMessageType GetMessageType() const override final { return MessageTypes::Headers; }
+	const std::vector<std::vector<unsigned char>>& GetSerializedHeaders() const { return m_serializedHeaders; }
+
+protected:
+	virtual void SerializeBody(Serializer& serializer) const override final
+	{
+		serializer.Append<uint16_t>((uint16_t)m_serializedHeaders.size());
+		for (const std::vector<unsigned char>& serializedHeader : m_serializedHeaders)
+		{
+			serializer.AppendByteVector(serializedHeader);
+		}
+	}
+
+private:
+	std::vector<std::vector<unsigned char>> m_serializedHeaders;
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Message.h"
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//
+// An immutable, shareable wrapper around an IMessage that serializes the message at most once per protocol version.
+// Broadcasts push the same SerializedMessage into every recipient's send queue,
+// so the message is only cloned & serialized once, regardless of the number of peers.
+//
+class SerializedMessage
+{
+public:
+	using Ptr = std::shared_ptr<const SerializedMessage>;
+
+	//
+	// Constructors
+	//
+	SerializedMessage(IMessagePtr&& pMessage)
+		: m_pMessage(std::move(pMessage)) { }
+	SerializedMessage(const SerializedMessage& other) = delete;
+	SerializedMessage(SerializedMessage&& other) = delete;
+
+	//
+	// Destructor
+	//
+	~SerializedMessage() = default;
+
+	//
+	// Operators
+	//
+	SerializedMessage& operator=(const SerializedMessage& other) = delete;
+	SerializedMessage& operator=(SerializedMessage&& other) = delete;
+
+	//
+	// Getters
+	//
+	MessageTypes::EMessageType GetMessageType() const { return m_pMessage->GetMessageType(); }
+	const IMessage& GetMessage() const noexcept { return *m_pMessage; }
+
+	//
+	// Returns the full wire encoding (header + body) of the message for the given protocol version.
+	// The magic bytes are fixed for the lifetime of the node, so only the protocol version is part of the cache key.
+	//
+	std::shared_ptr<const std::vector<unsigned char>> GetBytes(const std::vector<uint8_t>& magicBytes, const EProtocolVersion protocolVersion) const
+	{
+		const size_t index = protocolVersion == EProtocolVersion::V1 ? 0 : 1;
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (m_serialized[index] == nullptr)
+		{
+			m_serialized[index] = std::make_shared<const std::vector<unsigned char>>(
+				Serialize(magicBytes, *m_pMessage, protocolVersion)
+			);
+		}
+
+		return m_serialized[index];
+	}
+
+	static std::vector<unsigned char> Serialize(const std::vector<uint8_t>& magicBytes, const IMessage& message, const EProtocolVersion protocolVersion)
+	{
+		Serializer bodySerializer(protocolVersion);
+		message.SerializeBody(bodySerializer);
+
+		Serializer serializer(magicBytes.size() + 9 + bodySerializer.size(), protocolVersion);
+		serializer.AppendByteVector(magicBytes);
+		serializer.Append<uint8_t>((uint8_t)message.GetMessageType());
+		serializer.Append<uint64_t>(bodySerializer.size());
+		serializer.AppendByteVector(bodySerializer.GetBytes());
+
+		return serializer.GetBytes();
+	}
+
+private:
+	std::shared_ptr<const IMessage> m_pMessage;
+
+	mutable std::mutex m_mutex;
+	mutable std::array<std::shared_ptr<const std::vector<unsigned char>>, 2> m_serialized;
+};
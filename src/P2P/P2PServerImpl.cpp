@@ -51,11 +51,11 @@ std::shared_ptr<P2PServer> P2PServer::Create(
 		pDatabase->GetPeerDB()
 	);
 
-	// Connection Manager
-	ConnectionManagerPtr pConnectionManager = ConnectionManager::Create();
-
 	const Config& config = pContext->GetConfig();
 
+	// Connection Manager
+	ConnectionManagerPtr pConnectionManager = ConnectionManager::Create(config);
+
 	// Pipeline
 	std::shared_ptr<Pipeline> pPipeline = Pipeline::Create(
 		config,
@@ -8,7 +8,10 @@
 #include <BlockChain/BlockChainServer.h>
 
 BlockPipe::BlockPipe(const Config& config, IBlockChainServerPtr pBlockChainServer)
-	: m_config(config), m_pBlockChainServer(pBlockChainServer), m_terminate(false)
+	: m_config(config),
+	m_pBlockChainServer(pBlockChainServer),
+	m_blocksToProcess([](const BlockEntry& blockEntry) { return blockEntry.m_block.GetHash(); }),
+	m_terminate(false)
 {
 }
 
@@ -36,6 +39,11 @@ void BlockPipe::Thread_ProcessNewBlocks(BlockPipe& pipeline)
 
 	while (!pipeline.m_terminate)
 	{
+		if (!pipeline.m_blocksToProcess.wait(std::chrono::milliseconds(100), pipeline.m_terminate))
+		{
+			continue;
+		}
+
 		std::vector<BlockEntry> blocksToProcess = pipeline.m_blocksToProcess.copy_front(8); // TODO: Use number of CPU threads.
 		if (!blocksToProcess.empty())
 		{
@@ -56,10 +64,6 @@ void BlockPipe::Thread_ProcessNewBlocks(BlockPipe& pipeline)
 
 			pipeline.m_blocksToProcess.pop_front(blocksToProcess.size());
 		}
-		else
-		{
-			ThreadUtil::SleepFor(std::chrono::milliseconds(5), pipeline.m_terminate);
-		}
 	}
 
 	LOG_TRACE("END");
@@ -100,20 +104,10 @@ void BlockPipe::Thread_PostProcessBlocks(BlockPipe& pipeline)
 
 bool BlockPipe::AddBlockToProcess(PeerPtr pPeer, const FullBlock& block)
 {
-	std::function<bool(const BlockEntry&, const BlockEntry&)> comparator = [](const BlockEntry& blockEntry1, const BlockEntry& blockEntry2)
-	{
-		return blockEntry1.m_block.GetHash() == blockEntry2.m_block.GetHash();
-	};
-
-	return m_blocksToProcess.push_back_unique(BlockEntry(pPeer, block), comparator);
+	return m_blocksToProcess.push_back_unique(BlockEntry(pPeer, block));
 }
 
 bool BlockPipe::IsProcessingBlock(const Hash& hash) const
 {
-	std::function<bool(const BlockEntry&, const Hash&)> comparator = [](const BlockEntry& blockEntry, const Hash& hash)
-	{
-		return blockEntry.m_block.GetHash() == hash;
-	};
-
-	return m_blocksToProcess.contains<Hash>(hash, comparator);
+	return m_blocksToProcess.contains(hash);
 }
\ No newline at end of file
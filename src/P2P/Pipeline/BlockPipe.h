@@ -4,7 +4,7 @@
 #include <P2P/Peer.h>
 #include <Core/Models/FullBlock.h>
 #include <BlockChain/BlockChainServer.h>
-#include <Common/ConcurrentQueue.h>
+#include <Common/KeyedConcurrentQueue.h>
 #include <string>
 #include <cstdint>
 #include <atomic>
@@ -49,7 +49,7 @@ private:
 	static void Thread_ProcessNewBlocks(BlockPipe& pipeline);
 	static void ProcessNewBlock(BlockPipe& pipeline, const BlockEntry& blockEntry);
 	std::thread m_blockThread;
-	ConcurrentQueue<BlockEntry> m_blocksToProcess;
+	KeyedConcurrentQueue<Hash, BlockEntry> m_blocksToProcess;
 
 	// Process Next Block
 	std::thread m_processThread;
@@ -7,7 +7,11 @@
 #include <BlockChain/BlockChainServer.h>
 
 TransactionPipe::TransactionPipe(const Config& config, ConnectionManagerPtr pConnectionManager, IBlockChainServerPtr pBlockChainServer)
-	: m_config(config), m_pConnectionManager(pConnectionManager), m_pBlockChainServer(pBlockChainServer), m_terminate(false)
+	: m_config(config),
+	m_pConnectionManager(pConnectionManager),
+	m_pBlockChainServer(pBlockChainServer),
+	m_transactionsToProcess([](const TxEntry& txEntry) { return txEntry.pTransaction->GetHash(); }),
+	m_terminate(false)
 {
 
 }
@@ -36,6 +40,11 @@ void TransactionPipe::Thread_ProcessTransactions(TransactionPipe& pipeline)
 	{
 		try
 		{
+			if (!pipeline.m_transactionsToProcess.wait(std::chrono::milliseconds(100), pipeline.m_terminate))
+			{
+				continue;
+			}
+
 			std::unique_ptr<TxEntry> pTxEntry = pipeline.m_transactionsToProcess.copy_front();
 			if (pTxEntry != nullptr)
 			{
@@ -58,10 +67,6 @@ void TransactionPipe::Thread_ProcessTransactions(TransactionPipe& pipeline)
 
 				pipeline.m_transactionsToProcess.pop_front(1);
 			}
-			else
-			{
-				ThreadUtil::SleepFor(std::chrono::milliseconds(5), pipeline.m_terminate);
-			}
 		}
 		catch (std::exception& e)
 		{
@@ -74,10 +79,5 @@ void TransactionPipe::Thread_ProcessTransactions(TransactionPipe& pipeline)
 
 bool TransactionPipe::AddTransactionToProcess(const uint64_t connectionId, PeerPtr pPeer, TransactionPtr pTransaction, const EPoolType poolType)
 {
-	std::function<bool(const TxEntry&, const TxEntry&)> comparator = [](const TxEntry& txEntry1, const TxEntry& txEntry2)
-	{
-		return txEntry1.pTransaction->GetHash() == txEntry2.pTransaction->GetHash();
-	};
-
-	return m_transactionsToProcess.push_back_unique(TxEntry(connectionId, pPeer, pTransaction, poolType), comparator);
+	return m_transactionsToProcess.push_back_unique(TxEntry(connectionId, pPeer, pTransaction, poolType));
 }
\ No newline at end of file
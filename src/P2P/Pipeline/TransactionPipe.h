@@ -7,7 +7,7 @@
 #include <TxPool/PoolType.h>
 #include <Core/Models/Transaction.h>
 #include <BlockChain/BlockChainServer.h>
-#include <Common/ConcurrentQueue.h>
+#include <Common/KeyedConcurrentQueue.h>
 #include <string>
 #include <cstdint>
 #include <atomic>
@@ -53,7 +53,7 @@ private:
 		EPoolType poolType;
 	};
 
-	ConcurrentQueue<TxEntry> m_transactionsToProcess;
+	KeyedConcurrentQueue<Hash, TxEntry> m_transactionsToProcess;
 
 	std::atomic_bool m_terminate;
 };
\ No newline at end of file
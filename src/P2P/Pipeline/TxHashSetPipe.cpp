@@ -9,8 +9,7 @@
 #include <Infrastructure/ThreadManager.h>
 #include <Infrastructure/Logger.h>
 #include <BlockChain/BlockChainServer.h>
-
-#include <filesystem.h>
+#include <Core/Exceptions/FileException.h>
 
 static const int BUFFER_SIZE = 256 * 1024;
 
@@ -66,17 +65,19 @@ bool TxHashSetPipe::ReceiveTxHashSet(PeerPtr pPeer, Socket& socket, const TxHash
 	socket.SetReceiveTimeout(10 * 1000);
 	socket.SetReceiveBufferSize(BUFFER_SIZE);
 
-	const std::string fileName = StringUtil::Format(
-		"txhashset_{}.zip",
-		HASH::ShortHash(txHashSetArchiveMessage.GetBlockHash())
-	);
-	const fs::path txHashSetPath =  fs::temp_directory_path() / fileName;
-
 	try
 	{
-		std::ofstream fout;
-		fout.open(txHashSetPath, std::ios::binary | std::ios::out | std::ios::trunc);
+		ITxHashSetReceiverPtr pReceiver = m_pBlockChainServer->CreateTxHashSetReceiver(txHashSetArchiveMessage.GetBlockHash(), *m_pSyncStatus);
+		if (pReceiver == nullptr)
+		{
+			LOG_ERROR_F("Received TxHashSet from Peer ({}) for unknown block {}", pPeer, txHashSetArchiveMessage.GetBlockHash());
+			m_processing = false;
+			m_pSyncStatus->UpdateStatus(ESyncStatus::TXHASHSET_SYNC_FAILED);
+
+			return false;
+		}
 
+		// Each chunk is extracted as soon as it's received, so the archive itself is never written to disk.
 		size_t bytesReceived = 0;
 		std::vector<unsigned char> buffer(BUFFER_SIZE, 0);
 		while (bytesReceived < txHashSetArchiveMessage.GetZippedSize())
@@ -87,21 +88,31 @@ bool TxHashSetPipe::ReceiveTxHashSet(PeerPtr pPeer, Socket& socket, const TxHash
 			if (!received || ShutdownManagerAPI::WasShutdownRequested())
 			{
 				LOG_ERROR("Transmission ended abruptly");
-				fout.close();
-				FileUtil::RemoveFile(txHashSetPath);
 				m_processing = false;
 				m_pSyncStatus->UpdateStatus(ESyncStatus::TXHASHSET_SYNC_FAILED);
 
 				return false;
 			}
 
-			fout.write((char*)&buffer[0], bytesToRead);
+			pReceiver->Receive(buffer.data(), bytesToRead);
 			bytesReceived += bytesToRead;
 
 			m_pSyncStatus->UpdateDownloaded(bytesReceived);
 		}
 
-		fout.close();
+		LOG_INFO("Downloading successful");
+
+		ThreadUtil::Join(m_txHashSetThread);
+
+		m_txHashSetThread = std::thread(Thread_ProcessTxHashSet, std::ref(*this), pPeer, txHashSetArchiveMessage.GetBlockHash(), pReceiver);
+	}
+	catch (FileException& e)
+	{
+		LOG_ERROR_F("Failed to extract TxHashSet from {}: {}", *pPeer, e.what());
+		m_processing = false;
+		m_pSyncStatus->UpdateStatus(ESyncStatus::TXHASHSET_SYNC_FAILED);
+
+		return false;
 	}
 	catch (...)
 	{
@@ -111,16 +122,10 @@ bool TxHashSetPipe::ReceiveTxHashSet(PeerPtr pPeer, Socket& socket, const TxHash
 		throw;
 	}
 
-	LOG_INFO("Downloading successful");
-
-	ThreadUtil::Join(m_txHashSetThread);
-
-	m_txHashSetThread = std::thread(Thread_ProcessTxHashSet, std::ref(*this), pPeer, txHashSetArchiveMessage.GetBlockHash(), txHashSetPath.u8string());
-
 	return true;
 }
 
-void TxHashSetPipe::Thread_ProcessTxHashSet(TxHashSetPipe& pipeline, PeerPtr pPeer, const Hash blockHash, const fs::path path)
+void TxHashSetPipe::Thread_ProcessTxHashSet(TxHashSetPipe& pipeline, PeerPtr pPeer, const Hash blockHash, ITxHashSetReceiverPtr pReceiver)
 {
 	try
 	{
@@ -132,7 +137,7 @@ void TxHashSetPipe::Thread_ProcessTxHashSet(TxHashSetPipe& pipeline, PeerPtr pPe
 		pSyncStatus->UpdateProcessingStatus(0);
 		pSyncStatus->UpdateStatus(ESyncStatus::PROCESSING_TXHASHSET);
 
-		const EBlockChainStatus processStatus = pipeline.m_pBlockChainServer->ProcessTransactionHashSet(blockHash, path, *pSyncStatus);
+		const EBlockChainStatus processStatus = pipeline.m_pBlockChainServer->ProcessTransactionHashSet(blockHash, *pReceiver, *pSyncStatus);
 		if (processStatus == EBlockChainStatus::INVALID)
 		{
 			LOG_ERROR("Invalid TxHashSet received.");
@@ -152,5 +157,7 @@ void TxHashSetPipe::Thread_ProcessTxHashSet(TxHashSetPipe& pipeline, PeerPtr pPe
 		LOG_ERROR("Exception thrown in thread.");
 	}
 
+	// Release the receiver (and its staging folder) before another TxHashSet can be received.
+	pReceiver.reset();
 	pipeline.m_processing = false;
 }
@@ -5,6 +5,7 @@
 #include <Net/Socket.h>
 #include <P2P/Peer.h>
 #include <BlockChain/BlockChainServer.h>
+#include <PMMR/TxHashSetReceiver.h>
 #include <Common/Util/FileUtil.h>
 #include <string>
 #include <cstdint>
@@ -26,7 +27,7 @@ public:
 	~TxHashSetPipe();
 
 	//
-	// Downloads a TxHashSet and kicks off a new thread to process it.
+	// Downloads a TxHashSet, extracting it as it arrives, and kicks off a new thread to process it.
 	// Caller should ban peer if false is returned.
 	//
 	bool ReceiveTxHashSet(PeerPtr pPeer, Socket& socket, const TxHashSetArchiveMessage& txHashSetArchiveMessage);
@@ -42,7 +43,7 @@ private:
 	IBlockChainServerPtr m_pBlockChainServer;
 	SyncStatusPtr m_pSyncStatus;
 
-	static void Thread_ProcessTxHashSet(TxHashSetPipe& pipeline, PeerPtr pPeer, const Hash blockHash, const fs::path path);
+	static void Thread_ProcessTxHashSet(TxHashSetPipe& pipeline, PeerPtr pPeer, const Hash blockHash, ITxHashSetReceiverPtr pReceiver);
 	std::thread m_txHashSetThread;
 
 	std::atomic_bool m_processing;
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <Net/IPAddress.h>
+
+#include <algorithm>
+#include <chrono>
+#include <list>
+#include <map>
+
+//
+// Per-IP token bucket for inbound connections.
+// Each IP address can open up to 'burst' connections at once, after which
+// it's limited to 'connectionsPerMinute' sustained connections.
+//
+// At most 'maxTrackedAddresses' buckets are kept. Once full, the least recently used bucket is forgotten,
+// so memory stays bounded and every lookup stays O(log n), no matter how many addresses connect.
+//
+// Not thread-safe. The listener only ever uses it from the thread running its io_context.
+//
+class ConnectionRateLimiter
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	ConnectionRateLimiter(const double burst, const double connectionsPerMinute, const size_t maxTrackedAddresses = 10'000)
+		: m_burst(burst), m_tokensPerSecond(connectionsPerMinute / 60.0), m_maxTrackedAddresses((std::max)(maxTrackedAddresses, (size_t)1)) { }
+
+	//
+	// Takes a token from the address's bucket, returning false if the bucket is empty.
+	//
+	bool TryAcquire(const IPAddress& address, const Clock::time_point& now = Clock::now())
+	{
+		auto iter = m_bucketsByAddress.find(address);
+		if (iter == m_bucketsByAddress.end())
+		{
+			if (m_buckets.size() >= m_maxTrackedAddresses)
+			{
+				m_bucketsByAddress.erase(m_buckets.back().address);
+				m_buckets.pop_back();
+			}
+
+			m_buckets.push_front(Bucket{ address, m_burst, now });
+			iter = m_bucketsByAddress.emplace(address, m_buckets.begin()).first;
+		}
+		else
+		{
+			m_buckets.splice(m_buckets.begin(), m_buckets, iter->second);
+		}
+
+		Bucket& bucket = *iter->second;
+		Refill(bucket, now);
+		if (bucket.tokens < 1.0)
+		{
+			return false;
+		}
+
+		bucket.tokens -= 1.0;
+		return true;
+	}
+
+	size_t GetNumTrackedAddresses() const noexcept { return m_buckets.size(); }
+
+private:
+	struct Bucket
+	{
+		IPAddress address;
+		double tokens;
+		Clock::time_point lastRefill;
+	};
+
+	void Refill(Bucket& bucket, const Clock::time_point& now) const
+	{
+		const double elapsedSeconds = std::chrono::duration<double>(now - bucket.lastRefill).count();
+		bucket.tokens = (std::min)(m_burst, bucket.tokens + (elapsedSeconds * m_tokensPerSecond));
+		bucket.lastRefill = now;
+	}
+
+	double m_burst;
+	double m_tokensPerSecond;
+	size_t m_maxTrackedAddresses;
+
+	// Most recently used first.
+	std::list<Bucket> m_buckets;
+	std::map<IPAddress, std::list<Bucket>::iterator> m_bucketsByAddress;
+};
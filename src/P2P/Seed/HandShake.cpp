@@ -3,6 +3,7 @@
 #include "../Messages/HandMessage.h"
 #include "../Messages/ShakeMessage.h"
 #include "../Messages/BanReasonMessage.h"
+#include "../Messages/SerializedMessage.h"
 #include "../MessageRetriever.h"
 #include "../MessageSender.h"
 #include "../ConnectionManager.h"
@@ -107,20 +108,11 @@ bool HandShake::PerformInboundHandshake(Socket& socket, ConnectedPeer& connected
 	{
 		if (pReceivedMessage->GetMessageHeader().GetMessageType() == MessageTypes::Hand)
 		{
-			ByteBuffer byteBuffer(pReceivedMessage->GetPayload());
-			const HandMessage handMessage = HandMessage::Deserialize(byteBuffer);
-
-			if (handMessage.GetNonce() != NONCE && !m_connectionManager.IsConnected(connectedPeer.GetPeer()->GetIPAddress()))
+			const std::optional<uint32_t> versionOpt = ProcessHandMessage(*pReceivedMessage, connectedPeer);
+			if (versionOpt.has_value())
 			{
-				connectedPeer.UpdateCapabilities(handMessage.GetCapabilities());
-				connectedPeer.UpdateUserAgent(handMessage.GetUserAgent());
-				connectedPeer.UpdateTotals(handMessage.GetTotalDifficulty(), 0);
-
-				const uint32_t version = (std::min)(P2P::PROTOCOL_VERSION, handMessage.GetVersion());
-				connectedPeer.UpdateVersion(version);
-
 				// Send Shake Message
-				if (TransmitShakeMessage(socket, version))
+				if (TransmitShakeMessage(socket, versionOpt.value()))
 				{
 					return true;
 				}
@@ -130,14 +122,6 @@ bool HandShake::PerformInboundHandshake(Socket& socket, ConnectedPeer& connected
 					return false;
 				}
 			}
-			else if (handMessage.GetNonce() == NONCE)
-			{
-				LOG_DEBUG_F("Connected to self ({}). Nonce: {}", socket, NONCE);
-			}
-			else
-			{
-				LOG_DEBUG_F("Already connected to ({})", connectedPeer);
-			}
 		}
 		else
 		{
@@ -150,6 +134,143 @@ bool HandShake::PerformInboundHandshake(Socket& socket, ConnectedPeer& connected
 	return false;
 }
 
+namespace
+{
+	// Everything the steps of an asynchronous inbound handshake need to share.
+	// All steps run on the socket's io_context, so no locking is needed.
+	struct InboundHandshakeState
+	{
+		InboundHandshakeState(const std::shared_ptr<asio::ip::tcp::socket>& pSocket_, const ConnectedPeer& connectedPeer_)
+			: pSocket(pSocket_), connectedPeer(connectedPeer_), timer(pSocket_->get_executor()), buffer(11), finished(false) { }
+
+		void Fail()
+		{
+			if (!finished)
+			{
+				finished = true;
+				timer.cancel();
+
+				asio::error_code ignoreError;
+				pSocket->close(ignoreError);
+			}
+		}
+
+		std::shared_ptr<asio::ip::tcp::socket> pSocket;
+		ConnectedPeer connectedPeer;
+		asio::steady_timer timer;
+		std::vector<unsigned char> buffer;
+		bool finished;
+	};
+}
+
+void HandShake::PerformInboundHandshakeAsync(
+	const std::shared_ptr<asio::ip::tcp::socket>& pSocket,
+	const ConnectedPeer& connectedPeer,
+	const InboundCallback& callback) const
+{
+	auto pState = std::make_shared<InboundHandshakeState>(pSocket, connectedPeer);
+
+	// Same timeout as a blocking MessageRetriever::RetrieveMessage.
+	pState->timer.expires_after(std::chrono::seconds(8));
+	pState->timer.async_wait([pState](const asio::error_code& ec) {
+		if (!ec)
+		{
+			LOG_TRACE_F("Hand message not received from ({})", pState->connectedPeer);
+			pState->Fail();
+		}
+	});
+
+	// Get Hand Message
+	asio::async_read(*pSocket, asio::buffer(pState->buffer), [this, pState, callback](const asio::error_code& ec, size_t) {
+		if (ec || pState->finished)
+		{
+			pState->Fail();
+			return;
+		}
+
+		ByteBuffer headerBuffer(std::move(pState->buffer));
+		MessageHeader messageHeader = MessageHeader::Deserialize(headerBuffer);
+		if (!messageHeader.IsValid(m_config) || messageHeader.GetMessageType() != MessageTypes::Hand)
+		{
+			LOG_DEBUG_F("First message from ({}) was of type ({})", pState->connectedPeer, MessageTypes::ToString(messageHeader.GetMessageType()));
+			pState->Fail();
+			return;
+		}
+
+		pState->buffer = std::vector<unsigned char>(messageHeader.GetMessageLength());
+		asio::async_read(*pState->pSocket, asio::buffer(pState->buffer), [this, pState, messageHeader, callback](const asio::error_code& ec, size_t) mutable {
+			if (ec || pState->finished)
+			{
+				pState->Fail();
+				return;
+			}
+
+			std::optional<uint32_t> versionOpt = std::nullopt;
+			try
+			{
+				const RawMessage rawMessage(std::move(messageHeader), std::move(pState->buffer));
+				versionOpt = ProcessHandMessage(rawMessage, pState->connectedPeer);
+			}
+			catch (const DeserializationException&)
+			{
+				LOG_DEBUG_F("Failed to deserialize handshake from {}", pState->connectedPeer);
+			}
+
+			if (!versionOpt.has_value())
+			{
+				pState->Fail();
+				return;
+			}
+
+			// Send Shake Message
+			pState->buffer = SerializedMessage::Serialize(
+				m_config.GetEnvironment().GetMagicBytes(),
+				BuildShakeMessage(versionOpt.value()),
+				versionOpt.value() > 1 ? EProtocolVersion::V2 : EProtocolVersion::V1
+			);
+			asio::async_write(*pState->pSocket, asio::buffer(pState->buffer), [pState, callback](const asio::error_code& ec, size_t) {
+				if (ec || pState->finished)
+				{
+					LOG_DEBUG_F("Failed to transmit shake message to ({})", pState->connectedPeer);
+					pState->Fail();
+					return;
+				}
+
+				pState->finished = true;
+				pState->timer.cancel();
+				callback(pState->connectedPeer);
+			});
+		});
+	});
+}
+
+std::optional<uint32_t> HandShake::ProcessHandMessage(const RawMessage& handMessageRaw, ConnectedPeer& connectedPeer) const
+{
+	ByteBuffer byteBuffer(handMessageRaw.GetPayload());
+	const HandMessage handMessage = HandMessage::Deserialize(byteBuffer);
+
+	if (handMessage.GetNonce() == NONCE)
+	{
+		LOG_DEBUG_F("Connected to self ({}). Nonce: {}", connectedPeer, NONCE);
+		return std::nullopt;
+	}
+
+	if (m_connectionManager.IsConnected(connectedPeer.GetPeer()->GetIPAddress()))
+	{
+		LOG_DEBUG_F("Already connected to ({})", connectedPeer);
+		return std::nullopt;
+	}
+
+	connectedPeer.UpdateCapabilities(handMessage.GetCapabilities());
+	connectedPeer.UpdateUserAgent(handMessage.GetUserAgent());
+	connectedPeer.UpdateTotals(handMessage.GetTotalDifficulty(), 0);
+
+	const uint32_t version = (std::min)(P2P::PROTOCOL_VERSION, handMessage.GetVersion());
+	connectedPeer.UpdateVersion(version);
+
+	return std::make_optional(version);
+}
+
 bool HandShake::TransmitHandMessage(Socket& socket) const
 {
 	const IPAddress localHostIP = IPAddress::CreateV4({ 0x7F, 0x00, 0x00, 0x01 });
@@ -170,12 +291,18 @@ bool HandShake::TransmitHandMessage(Socket& socket) const
 }
 
 bool HandShake::TransmitShakeMessage(Socket& socket, const uint32_t protocolVersion) const
+{
+	const ShakeMessage shakeMessage = BuildShakeMessage(protocolVersion);
+
+	return MessageSender(m_config).Send(socket, shakeMessage, protocolVersion > 1 ? EProtocolVersion::V2 : EProtocolVersion::V1);
+}
+
+ShakeMessage HandShake::BuildShakeMessage(const uint32_t protocolVersion) const
 {
 	const Capabilities capabilities(Capabilities::FAST_SYNC_NODE); // LIGHT_CLIENT: Read P2P Config once light-clients are supported
 	Hash hash = m_config.GetEnvironment().GetGenesisHash();
 	const uint64_t totalDifficulty = m_pBlockChainServer->GetTotalDifficulty(EChainType::CONFIRMED);
 	const std::string& userAgent = P2P::USER_AGENT;
-	const ShakeMessage shakeMessage(protocolVersion, capabilities, std::move(hash), totalDifficulty, userAgent);
 
-	return MessageSender(m_config).Send(socket, shakeMessage, protocolVersion > 1 ? EProtocolVersion::V2 : EProtocolVersion::V1);
+	return ShakeMessage(protocolVersion, capabilities, std::move(hash), totalDifficulty, userAgent);
 }
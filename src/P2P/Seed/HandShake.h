@@ -5,13 +5,21 @@
 #include <Config/Config.h>
 #include <BlockChain/BlockChainServer.h>
 #include <P2P/ConnectedPeer.h>
+#include <asio.hpp>
+#include <functional>
+#include <memory>
+#include <optional>
 
 // Forward Declarations
 class Socket;
+class RawMessage;
+class ShakeMessage;
 
 class HandShake
 {
 public:
+	using InboundCallback = std::function<void(const ConnectedPeer& connectedPeer)>;
+
 	HandShake(
 		const Config& config,
 		ConnectionManager& connectionManager,
@@ -20,12 +28,27 @@ public:
 
 	bool PerformHandshake(Socket& socket, ConnectedPeer& connectedPeer, const EDirection direction) const;
 
+	//
+	// Performs the inbound handshake using asynchronous reads/writes on the socket's io_context, so no thread is tied up
+	// waiting on the peer. The callback is only called if the handshake succeeds. Otherwise, the socket is closed.
+	// The HandShake must outlive the io_context's processing of the handshake.
+	//
+	void PerformInboundHandshakeAsync(
+		const std::shared_ptr<asio::ip::tcp::socket>& pSocket,
+		const ConnectedPeer& connectedPeer,
+		const InboundCallback& callback
+	) const;
+
 private:
 	bool PerformOutboundHandshake(Socket& socket, ConnectedPeer& connectedPeer) const;
 	bool PerformInboundHandshake(Socket& socket, ConnectedPeer& connectedPeer) const;
 	bool TransmitHandMessage(Socket& socket) const;
 	bool TransmitShakeMessage(Socket& socket, const uint32_t protocolVersion) const;
 
+	// Validates the peer's hand message, returning the negotiated protocol version if the handshake can proceed.
+	std::optional<uint32_t> ProcessHandMessage(const RawMessage& handMessage, ConnectedPeer& connectedPeer) const;
+	ShakeMessage BuildShakeMessage(const uint32_t protocolVersion) const;
+
 	const Config& m_config;
 	ConnectionManager& m_connectionManager;
 	IBlockChainServerPtr m_pBlockChainServer;
@@ -0,0 +1,106 @@
+#include "Listener.h"
+
+#include <Infrastructure/Logger.h>
+
+Listener::Listener(
+	const std::shared_ptr<asio::io_context>& pContext,
+	ConnectionRateLimiter&& rateLimiter,
+	const AcceptHandler& handler)
+	: m_pContext(pContext),
+	m_acceptor(*pContext),
+	m_retryTimer(*pContext),
+	m_rateLimiter(std::move(rateLimiter)),
+	m_handler(handler),
+	m_numAccepted(0),
+	m_numRejected(0)
+{
+
+}
+
+Listener::Ptr Listener::Create(
+	const std::shared_ptr<asio::io_context>& pContext,
+	const asio::ip::tcp::endpoint& endpoint,
+	ConnectionRateLimiter&& rateLimiter,
+	const AcceptHandler& handler)
+{
+	auto pListener = std::shared_ptr<Listener>(new Listener(pContext, std::move(rateLimiter), handler));
+
+	pListener->m_acceptor.open(endpoint.protocol());
+	pListener->m_acceptor.set_option(asio::ip::tcp::acceptor::reuse_address(true));
+	pListener->m_acceptor.bind(endpoint);
+	pListener->m_acceptor.listen(asio::socket_base::max_listen_connections);
+
+	pListener->AcceptNext();
+	return pListener;
+}
+
+void Listener::Stop()
+{
+	asio::error_code ignoreError;
+	m_acceptor.close(ignoreError);
+	m_retryTimer.cancel(ignoreError);
+}
+
+void Listener::AcceptNext()
+{
+	auto pSocket = std::make_shared<asio::ip::tcp::socket>(*m_pContext);
+
+	std::weak_ptr<Listener> pWeak = shared_from_this();
+	m_acceptor.async_accept(*pSocket, [pWeak, pSocket](const asio::error_code& ec) {
+		auto pListener = pWeak.lock();
+		if (pListener == nullptr || ec == asio::error::operation_aborted || !pListener->m_acceptor.is_open())
+		{
+			return;
+		}
+
+		if (!ec)
+		{
+			asio::error_code endpointError;
+			const asio::ip::tcp::endpoint remoteEndpoint = pSocket->remote_endpoint(endpointError);
+			if (!endpointError && pListener->m_rateLimiter.TryAcquire(IPAddress(remoteEndpoint.address())))
+			{
+				++pListener->m_numAccepted;
+				try
+				{
+					pListener->m_handler(pSocket);
+				}
+				catch (std::exception& e)
+				{
+					LOG_ERROR_F("Failed to handle inbound connection: {}", e.what());
+				}
+			}
+			else
+			{
+				++pListener->m_numRejected;
+				LOG_DEBUG_F("Dropping inbound connection from {}", remoteEndpoint.address().to_string());
+
+				asio::error_code ignoreError;
+				pSocket->close(ignoreError);
+			}
+		}
+		else
+		{
+			// Accepting again straight away would just fail again (eg. EMFILE), spinning the io_context's thread.
+			LOG_WARNING_F("Failed to accept connection: {}", ec.message());
+			pListener->AcceptAfterDelay();
+			return;
+		}
+
+		pListener->AcceptNext();
+	});
+}
+
+void Listener::AcceptAfterDelay()
+{
+	std::weak_ptr<Listener> pWeak = shared_from_this();
+	m_retryTimer.expires_after(ACCEPT_RETRY_DELAY);
+	m_retryTimer.async_wait([pWeak](const asio::error_code& ec) {
+		auto pListener = pWeak.lock();
+		if (pListener == nullptr || ec == asio::error::operation_aborted || !pListener->m_acceptor.is_open())
+		{
+			return;
+		}
+
+		pListener->AcceptNext();
+	});
+}
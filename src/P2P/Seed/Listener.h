@@ -0,0 +1,65 @@
+#pragma once
+
+#include "ConnectionRateLimiter.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <asio.hpp>
+
+//
+// Accepts inbound connections asynchronously on a shared io_context.
+// Accepted sockets are passed to the AcceptHandler on whichever thread is running the io_context,
+// so no thread is created per connection. Connections from IPs that have exceeded their
+// ConnectionRateLimiter allowance are closed immediately, without reaching the handler.
+// If accepting fails (ie. the process is out of file descriptors), the next accept waits for ACCEPT_RETRY_DELAY.
+//
+class Listener : public std::enable_shared_from_this<Listener>
+{
+public:
+	using Ptr = std::shared_ptr<Listener>;
+	using AcceptHandler = std::function<void(const std::shared_ptr<asio::ip::tcp::socket>&)>;
+
+	static constexpr std::chrono::milliseconds ACCEPT_RETRY_DELAY{ 100 };
+
+	~Listener() = default;
+
+	//
+	// Binds to the endpoint and starts accepting. Throws if the endpoint can't be bound.
+	//
+	static Listener::Ptr Create(
+		const std::shared_ptr<asio::io_context>& pContext,
+		const asio::ip::tcp::endpoint& endpoint,
+		ConnectionRateLimiter&& rateLimiter,
+		const AcceptHandler& handler
+	);
+
+	//
+	// Stops accepting connections. Must be called from the io_context's thread, or after it has stopped running.
+	//
+	void Stop();
+
+	uint16_t GetPort() const { return m_acceptor.local_endpoint().port(); }
+	size_t GetNumAccepted() const noexcept { return m_numAccepted; }
+	size_t GetNumRejected() const noexcept { return m_numRejected; }
+
+private:
+	Listener(
+		const std::shared_ptr<asio::io_context>& pContext,
+		ConnectionRateLimiter&& rateLimiter,
+		const AcceptHandler& handler
+	);
+
+	void AcceptNext();
+	void AcceptAfterDelay();
+
+	std::shared_ptr<asio::io_context> m_pContext;
+	asio::ip::tcp::acceptor m_acceptor;
+	asio::steady_timer m_retryTimer;
+	ConnectionRateLimiter m_rateLimiter;
+	AcceptHandler m_handler;
+
+	std::atomic<size_t> m_numAccepted;
+	std::atomic<size_t> m_numRejected;
+};
@@ -7,6 +7,7 @@
 #include <Infrastructure/Logger.h>
 #include <Infrastructure/ThreadManager.h>
 #include <Crypto/RandomNumberGenerator.h>
+#include <unordered_set>
 
 PeerManager::PeerManager(const Context::Ptr& pContext, std::shared_ptr<Locked<IPeerDB>> pPeerDB)
 	: m_taskId(0), m_pContext(pContext), m_pPeerDB(pPeerDB)
@@ -26,11 +27,13 @@ std::shared_ptr<Locked<PeerManager>> PeerManager::Create(const Context::Ptr& pCo
 {
 	std::shared_ptr<PeerManager> pPeerManager(new PeerManager(pContext, pPeerDB));
 
-	pPeerManager->m_peersByAddress.clear();
 	const std::vector<PeerPtr> peers = pPeerDB->Read()->LoadAllPeers();
 	for (const PeerPtr& peer : peers)
 	{
-		pPeerManager->m_peersByAddress.emplace(peer->GetIPAddress(), PeerEntry(peer));
+		if (pPeerManager->m_peersByAddress.find(peer->GetIPAddress()) == pPeerManager->m_peersByAddress.end())
+		{
+			pPeerManager->AddPeer(PeerEntry(peer));
+		}
 	}
 
 	std::shared_ptr<Locked<PeerManager>> pLocked = std::make_shared<Locked<PeerManager>>(Locked<PeerManager>(pPeerManager));
@@ -50,6 +53,9 @@ std::shared_ptr<Locked<PeerManager>> PeerManager::Create(const Context::Ptr& pCo
 	return pLocked;
 }
 
+// Peers are modified directly (through their PeerPtr) by connections, syncers, etc.
+// so this periodic pass is where dirty peers get saved, and where any peers whose capabilities
+// changed since they were indexed get moved to the right bucket.
 void PeerManager::Thread_ManagePeers(PeerManager& peerManager)
 {
 	ThreadManagerAPI::SetCurrentThreadName("PEER_MANAGER");
@@ -65,7 +71,7 @@ void PeerManager::Thread_ManagePeers(PeerManager& peerManager)
 				std::chrono::system_clock::now() - std::chrono::hours(24 * 7)
 			);
 
-			for (auto iter : peerManager.m_peersByAddress)
+			for (auto& iter : peerManager.m_peersByAddress)
 			{
 				PeerEntry& peerEntry = iter.second;
 				if (peerEntry.m_peer->IsDirty())
@@ -76,12 +82,20 @@ void PeerManager::Thread_ManagePeers(PeerManager& peerManager)
 				else if (peerEntry.m_peer->GetLastContactTime() < minimumContactTime)
 				{
 					peersToDelete.push_back(peerEntry.m_peer);
+					continue;
+				}
+
+				if (GetBucket(peerEntry.m_peer->GetCapabilities()) != peerEntry.m_bucket)
+				{
+					peerManager.UnindexPeer(peerEntry);
+					peerManager.IndexPeer(peerEntry);
+					peerManager.SchedulePeer(peerEntry);
 				}
 			}
 
 			for (PeerPtr pPeer : peersToDelete)
 			{
-				peerManager.m_peersByAddress.erase(pPeer->GetIPAddress());
+				peerManager.RemovePeer(pPeer->GetIPAddress());
 			}
 		}
 
@@ -96,39 +110,19 @@ void PeerManager::Thread_ManagePeers(PeerManager& peerManager)
 	LOG_TRACE("END");
 }
 
-bool PeerManager::ArePeersNeeded(const Capabilities::ECapability& preferredCapability) const
+bool PeerManager::ArePeersNeeded(const Capabilities::ECapability& preferredCapability)
 {
 	const time_t currentTime = TimeUtil::Now();
-	const time_t maxBanTime = std::chrono::system_clock::to_time_t(
-		std::chrono::system_clock::now() - std::chrono::seconds(P2P::BAN_WINDOW)
-	);
 
-	uint64_t peersFound = 0;
-	for (auto iter = m_peersByAddress.begin(); iter != m_peersByAddress.end(); iter++)
+	// Only looks at the (at most 100) connectable peers at the top of the retry heaps, and then puts them back.
+	const std::vector<ScheduledPeer> connectablePeers = PopConnectablePeers(preferredCapability, 100, currentTime);
+	for (const ScheduledPeer& scheduledPeer : connectablePeers)
 	{
-		PeerEntry& peerEntry = iter->second;
-		const PeerPtr& peer = peerEntry.m_peer;
-
-		if (peer->GetLastBanTime() > maxBanTime)
-		{
-			continue;
-		}
-
-		const bool hasCapability = peer->GetCapabilities().HasCapability(preferredCapability);
-		if (hasCapability)
-		{
-			if (!peerEntry.m_peer->IsConnected() && std::difftime(currentTime, peerEntry.m_lastAttempt) > P2P::RETRY_WINDOW)
-			{
-				++peersFound;
-				if (peersFound >= 100)
-				{
-					return false;
-				}
-			}
-		}
+		const PeerEntry& peerEntry = m_peersByAddress.at(scheduledPeer.m_address);
+		m_buckets[peerEntry.m_bucket].m_retryHeap.push(scheduledPeer);
 	}
 
-	return peersFound < 100;
+	return connectablePeers.size() < 100;
 }
 
 PeerPtr PeerManager::GetPeer(const IPAddress& address)
@@ -140,7 +134,7 @@ PeerPtr PeerManager::GetPeer(const IPAddress& address)
 	}
 
 	PeerPtr pPeer = std::make_shared<Peer>(address);
-	m_peersByAddress.emplace(address, PeerEntry(pPeer));
+	AddPeer(PeerEntry(pPeer));
 	return pPeer;
 }
 
@@ -157,10 +151,12 @@ std::optional<PeerConstPtr> PeerManager::GetPeer(const IPAddress& address) const
 
 PeerPtr PeerManager::GetNewPeer(const Capabilities::ECapability& preferredCapability)
 {
-	std::vector<PeerPtr> peers = GetPeersWithCapability(preferredCapability, 1, true);
+	const time_t currentTime = TimeUtil::Now();
+
+	std::vector<ScheduledPeer> peers = PopConnectablePeers(preferredCapability, 1, currentTime);
 	if (peers.empty())
 	{
-		peers = GetPeersWithCapability(Capabilities::UNKNOWN, 1, true);
+		peers = PopConnectablePeers(Capabilities::UNKNOWN, 1, currentTime);
 	}
 	
 	if (peers.empty())
@@ -168,7 +164,11 @@ PeerPtr PeerManager::GetNewPeer(const Capabilities::ECapability& preferredCapabi
 		return nullptr;
 	}
 
-	return peers.front();
+	PeerEntry& peerEntry = m_peersByAddress.at(peers.front().m_address);
+	peerEntry.m_lastAttempt = currentTime;
+	ScheduleRetry(peerEntry, currentTime + P2P::RETRY_WINDOW + 1);
+
+	return peerEntry.m_peer;
 }
 
 std::vector<PeerPtr> PeerManager::GetAllPeers()
@@ -205,10 +205,10 @@ std::vector<PeerPtr> PeerManager::GetPeers(
 	const Capabilities::ECapability& preferredCapability,
 	const uint16_t maxPeers) const
 {
-	std::vector<PeerPtr> peers = GetPeersWithCapability(preferredCapability, maxPeers, false);
+	std::vector<PeerPtr> peers = GetPeersWithCapability(preferredCapability, maxPeers);
 	if (peers.empty())
 	{
-		peers = GetPeersWithCapability(Capabilities::UNKNOWN, maxPeers, false);
+		peers = GetPeersWithCapability(Capabilities::UNKNOWN, maxPeers);
 	}
 
 	return peers;
@@ -221,7 +221,7 @@ void PeerManager::AddFreshPeers(const std::vector<SocketAddress>& peerAddresses)
 		const IPAddress& ipAddress = socketAddress.GetIPAddress();
 		if (m_peersByAddress.find(ipAddress) == m_peersByAddress.end())
 		{
-			m_peersByAddress.emplace(ipAddress, PeerEntry(std::make_shared<Peer>(ipAddress)));
+			AddPeer(PeerEntry(std::make_shared<Peer>(ipAddress)));
 		}
 	}
 }
@@ -232,12 +232,13 @@ void PeerManager::BanPeer(const IPAddress& address, const EBanReason banReason)
 	if (iter != m_peersByAddress.end())
 	{
 		iter->second.m_peer->Ban(banReason);
+		SchedulePeer(iter->second);
 	}
 	else
 	{
 		PeerPtr peer = std::make_shared<Peer>(address, 0, Capabilities(0), "");
 		peer->Ban(banReason);
-		m_peersByAddress.emplace(address, PeerEntry(peer, TimeUtil::Now()));
+		AddPeer(PeerEntry(peer, TimeUtil::Now()));
 	}
 }
 
@@ -247,63 +248,229 @@ void PeerManager::UnbanPeer(const IPAddress& address)
 	if (iter != m_peersByAddress.end())
 	{
 		iter->second.m_peer->Unban();
+		SchedulePeer(iter->second);
 	}
 }
 
 std::vector<PeerPtr> PeerManager::GetPeersWithCapability(
 	const Capabilities::ECapability& preferredCapability,
-	const uint16_t maxPeers,
-	const bool connectingToPeer) const
+	const uint16_t maxPeers) const
 {
-	const size_t numPeers = m_peersByAddress.size();
-	if (numPeers == 0)
+	std::vector<const CapabilityBucket*> buckets;
+	size_t numPeers = 0;
+	for (const auto& iter : m_buckets)
 	{
-		return {};
+		if (Capabilities(iter.first).HasCapability(preferredCapability) && !iter.second.m_addresses.empty())
+		{
+			buckets.push_back(&iter.second);
+			numPeers += iter.second.m_addresses.size();
+		}
 	}
 
-	std::vector<PeerPtr> peersFound;
-	const time_t currentTime = TimeUtil::Now();
-	const time_t maxBanTime = std::chrono::system_clock::to_time_t(
-		std::chrono::system_clock::now() - std::chrono::seconds(P2P::BAN_WINDOW)
-	);
-	
-	auto iter = m_peersByAddress.begin();
-	std::advance(iter, RandomNumberGenerator::GenerateRandom(0, numPeers));
+	if (numPeers == 0 || maxPeers == 0)
+	{
+		return {};
+	}
 
-	for (size_t i = 0; i < numPeers; i++)
+	// Pick (up to) maxPeers distinct random positions across the matching buckets.
+	std::vector<size_t> positions;
+	if (numPeers <= maxPeers)
+	{
+		for (size_t i = 0; i < numPeers; i++)
+		{
+			positions.push_back(i);
+		}
+	}
+	else
 	{
-		iter++;
-		if (iter == m_peersByAddress.end())
+		std::unordered_set<size_t> chosen;
+		while (chosen.size() < maxPeers)
 		{
-			iter = m_peersByAddress.begin();
+			const size_t position = (size_t)RandomNumberGenerator::GenerateRandom(0, numPeers - 1);
+			if (chosen.insert(position).second)
+			{
+				positions.push_back(position);
+			}
 		}
+	}
 
-		PeerEntry& peerEntry = iter->second;
-		const PeerPtr& peer = peerEntry.m_peer;
+	std::vector<PeerPtr> peersFound;
+	for (size_t position : positions)
+	{
+		auto bucketIter = buckets.cbegin();
+		while (position >= (*bucketIter)->m_addresses.size())
+		{
+			position -= (*bucketIter)->m_addresses.size();
+			++bucketIter;
+		}
 
-		if (connectingToPeer && peer->GetLastBanTime() > maxBanTime)
+		// Capabilities can change after a peer is indexed, until the next ManagePeers pass moves it.
+		const PeerPtr& peer = m_peersByAddress.at((*bucketIter)->m_addresses[position]).m_peer;
+		if (peer->GetCapabilities().HasCapability(preferredCapability))
 		{
-			continue;
+			peersFound.push_back(peer);
 		}
+	}
+
+	return peersFound;
+}
+
+// Pops (up to) maxPeers peers that have the preferred capability, aren't banned or connected, and are past their retry time,
+// in order of retry time. Invalidated entries are dropped, and peers whose state changed are rescheduled along the way.
+// The caller is responsible for rescheduling the returned peers.
+std::vector<PeerManager::ScheduledPeer> PeerManager::PopConnectablePeers(
+	const Capabilities::ECapability& preferredCapability,
+	const size_t maxPeers,
+	const time_t currentTime)
+{
+	ReleaseExpiredBans(currentTime);
 
-		const bool hasCapability = peer->GetCapabilities().HasCapability(preferredCapability);
-		if (hasCapability)
+	std::vector<ScheduledPeer> peersFound;
+	while (peersFound.size() < maxPeers)
+	{
+		CapabilityBucket* pBucket = nullptr;
+		for (auto& iter : m_buckets)
 		{
-			if (!connectingToPeer || (!peerEntry.m_peer->IsConnected() && std::difftime(currentTime, peerEntry.m_lastAttempt) > P2P::RETRY_WINDOW))
+			CapabilityBucket& bucket = iter.second;
+			if (!bucket.m_retryHeap.empty() && Capabilities(iter.first).HasCapability(preferredCapability))
 			{
-				if (connectingToPeer)
-				{
-					peerEntry.m_lastAttempt = currentTime;
-				}
-
-				peersFound.push_back(peer);
-				if (peersFound.size() == maxPeers)
+				if (pBucket == nullptr || pBucket->m_retryHeap.top() > bucket.m_retryHeap.top())
 				{
-					return peersFound;
+					pBucket = &bucket;
 				}
 			}
 		}
+
+		if (pBucket == nullptr || pBucket->m_retryHeap.top().m_time > currentTime)
+		{
+			break;
+		}
+
+		const ScheduledPeer scheduledPeer = pBucket->m_retryHeap.top();
+		pBucket->m_retryHeap.pop();
+
+		auto iter = m_peersByAddress.find(scheduledPeer.m_address);
+		if (iter == m_peersByAddress.end() || iter->second.m_generation != scheduledPeer.m_generation)
+		{
+			continue;
+		}
+
+		PeerEntry& peerEntry = iter->second;
+		if (GetBucket(peerEntry.m_peer->GetCapabilities()) != peerEntry.m_bucket)
+		{
+			UnindexPeer(peerEntry);
+			IndexPeer(peerEntry);
+			SchedulePeer(peerEntry);
+		}
+		else if (peerEntry.m_peer->IsBanned())
+		{
+			SchedulePeer(peerEntry);
+		}
+		else if (peerEntry.m_peer->IsConnected())
+		{
+			ScheduleRetry(peerEntry, currentTime + P2P::RETRY_WINDOW + 1);
+		}
+		else
+		{
+			peersFound.push_back(scheduledPeer);
+		}
 	}
 
 	return peersFound;
+}
+
+void PeerManager::ReleaseExpiredBans(const time_t currentTime)
+{
+	while (!m_banExpiryHeap.empty() && m_banExpiryHeap.top().m_time <= currentTime)
+	{
+		const ScheduledPeer scheduledPeer = m_banExpiryHeap.top();
+		m_banExpiryHeap.pop();
+
+		auto iter = m_peersByAddress.find(scheduledPeer.m_address);
+		if (iter != m_peersByAddress.end() && iter->second.m_generation == scheduledPeer.m_generation)
+		{
+			SchedulePeer(iter->second);
+		}
+	}
+}
+
+PeerManager::PeerEntry& PeerManager::AddPeer(PeerEntry&& peerEntry)
+{
+	const IPAddress address = peerEntry.m_peer->GetIPAddress();
+	PeerEntry& added = m_peersByAddress.emplace(address, std::move(peerEntry)).first->second;
+	IndexPeer(added);
+	SchedulePeer(added);
+	return added;
+}
+
+void PeerManager::RemovePeer(const IPAddress& address)
+{
+	auto iter = m_peersByAddress.find(address);
+	if (iter != m_peersByAddress.end())
+	{
+		// Any heap entries for the peer are dropped once they reach the top.
+		UnindexPeer(iter->second);
+		m_peersByAddress.erase(iter);
+	}
+}
+
+void PeerManager::IndexPeer(PeerEntry& peerEntry)
+{
+	peerEntry.m_bucket = GetBucket(peerEntry.m_peer->GetCapabilities());
+
+	CapabilityBucket& bucket = m_buckets[peerEntry.m_bucket];
+	peerEntry.m_bucketIndex = bucket.m_addresses.size();
+	bucket.m_addresses.push_back(peerEntry.m_peer->GetIPAddress());
+}
+
+void PeerManager::UnindexPeer(PeerEntry& peerEntry)
+{
+	std::vector<IPAddress>& addresses = m_buckets[peerEntry.m_bucket].m_addresses;
+
+	// Swap with the last address in the bucket, so removal is O(1).
+	if (peerEntry.m_bucketIndex != addresses.size() - 1)
+	{
+		addresses[peerEntry.m_bucketIndex] = addresses.back();
+		m_peersByAddress.at(addresses[peerEntry.m_bucketIndex]).m_bucketIndex = peerEntry.m_bucketIndex;
+	}
+
+	addresses.pop_back();
+	++peerEntry.m_generation;
+}
+
+// Queues the peer in the ban-expiry heap if it's banned, or in its bucket's retry heap otherwise.
+void PeerManager::SchedulePeer(PeerEntry& peerEntry)
+{
+	if (peerEntry.m_peer->IsBanned())
+	{
+		++peerEntry.m_generation;
+		m_banExpiryHeap.push(ScheduledPeer{
+			peerEntry.m_peer->GetLastBanTime() + P2P::BAN_WINDOW,
+			0,
+			peerEntry.m_peer->GetIPAddress(),
+			peerEntry.m_generation
+		});
+	}
+	else
+	{
+		ScheduleRetry(peerEntry, peerEntry.m_lastAttempt + P2P::RETRY_WINDOW + 1);
+	}
+}
+
+void PeerManager::ScheduleRetry(PeerEntry& peerEntry, const time_t retryTime)
+{
+	// Peers with the same retry time (eg. ones that were never attempted) are returned in random order.
+	++peerEntry.m_generation;
+	m_buckets[peerEntry.m_bucket].m_retryHeap.push(ScheduledPeer{
+		retryTime,
+		RandomNumberGenerator::GenerateRandom(0, UINT64_MAX),
+		peerEntry.m_peer->GetIPAddress(),
+		peerEntry.m_generation
+	});
+}
+
+uint32_t PeerManager::GetBucket(const Capabilities& capabilities) noexcept
+{
+	// Unrecognized capability bits are ignored, so there are never more than a handful of buckets.
+	return (uint32_t)capabilities.GetCapability() & (uint32_t)Capabilities::ARCHIVE_NODE;
 }
\ No newline at end of file
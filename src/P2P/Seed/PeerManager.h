@@ -10,7 +10,10 @@
 #include <Config/Config.h>
 #include <Core/Traits/Lockable.h>
 
+#include <functional>
+#include <map>
 #include <optional>
+#include <queue>
 #include <unordered_map>
 #include <unordered_set>
 #include <memory>
@@ -23,7 +26,7 @@ public:
 	static std::shared_ptr<Locked<PeerManager>> Create(const Context::Ptr& pContext, std::shared_ptr<Locked<IPeerDB>> pPeerDB);
 	~PeerManager();
 
-	bool ArePeersNeeded(const Capabilities::ECapability& preferredCapability) const;
+	bool ArePeersNeeded(const Capabilities::ECapability& preferredCapability);
 
 	PeerPtr GetPeer(const IPAddress& address);
 	std::optional<PeerConstPtr> GetPeer(const IPAddress& address) const;
@@ -44,24 +47,71 @@ private:
 	struct PeerEntry
 	{
 		PeerEntry(PeerPtr pPeer)
-			: m_peer(pPeer), m_lastAttempt(0)//, m_connected(false), m_dirty(false)
+			: m_peer(pPeer), m_lastAttempt(0), m_bucket(0), m_bucketIndex(0), m_generation(0)
 		{
 
 		}
 
 		PeerEntry(PeerPtr pPeer, const time_t& lastAttempt)
-			: m_peer(pPeer), m_lastAttempt(lastAttempt)
+			: m_peer(pPeer), m_lastAttempt(lastAttempt), m_bucket(0), m_bucketIndex(0), m_generation(0)
 		{
 
 		}
 
 		PeerPtr m_peer;
 		time_t m_lastAttempt;
+
+		// The capability bucket (and position within it) the peer is indexed under.
+		uint32_t m_bucket;
+		size_t m_bucketIndex;
+
+		// Incremented whenever the peer is (re)scheduled, invalidating any older heap entries for it.
+		uint64_t m_generation;
+	};
+
+	//
+	// An entry in a retry heap or the ban-expiry heap.
+	// Entries are never removed from the middle of a heap. Instead, they're invalidated by
+	// bumping the peer's generation, and dropped once they make their way to the top.
+	//
+	struct ScheduledPeer
+	{
+		time_t m_time;
+		uint64_t m_tiebreaker;
+		IPAddress m_address;
+		uint64_t m_generation;
+
+		bool operator>(const ScheduledPeer& rhs) const noexcept
+		{
+			return m_time != rhs.m_time ? m_time > rhs.m_time : m_tiebreaker > rhs.m_tiebreaker;
+		}
+	};
+	using ScheduleHeap = std::priority_queue<ScheduledPeer, std::vector<ScheduledPeer>, std::greater<ScheduledPeer>>;
+
+	//
+	// All peers with the exact same (known) capabilities.
+	// Unbanned peers are queued in the bucket's retry heap, ordered by the time they can next be connected to.
+	//
+	struct CapabilityBucket
+	{
+		std::vector<IPAddress> m_addresses;
+		ScheduleHeap m_retryHeap;
 	};
 
 	static void Thread_ManagePeers(PeerManager& peerManager);
 
-	std::vector<PeerPtr> GetPeersWithCapability(const Capabilities::ECapability& preferredCapability, const uint16_t maxPeers, const bool connectingToPeer) const;
+	std::vector<PeerPtr> GetPeersWithCapability(const Capabilities::ECapability& preferredCapability, const uint16_t maxPeers) const;
+	std::vector<ScheduledPeer> PopConnectablePeers(const Capabilities::ECapability& preferredCapability, const size_t maxPeers, const time_t currentTime);
+	void ReleaseExpiredBans(const time_t currentTime);
+
+	PeerEntry& AddPeer(PeerEntry&& peerEntry);
+	void RemovePeer(const IPAddress& address);
+	void IndexPeer(PeerEntry& peerEntry);
+	void UnindexPeer(PeerEntry& peerEntry);
+	void SchedulePeer(PeerEntry& peerEntry);
+	void ScheduleRetry(PeerEntry& peerEntry, const time_t retryTime);
+
+	static uint32_t GetBucket(const Capabilities& capabilities) noexcept;
 
 	void SetTaskId(const uint64_t taskId) noexcept { m_taskId = taskId; }
 	uint64_t m_taskId;
@@ -70,4 +120,8 @@ private:
 	std::shared_ptr<Locked<IPeerDB>> m_pPeerDB;
 
 	mutable std::map<IPAddress, PeerEntry> m_peersByAddress;
+
+	// Secondary indexes, so peer selection doesn't need to scan every known peer.
+	std::map<uint32_t, CapabilityBucket> m_buckets;
+	ScheduleHeap m_banExpiryHeap;
 };
\ No newline at end of file
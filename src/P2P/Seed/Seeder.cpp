@@ -1,6 +1,8 @@
 #include "Seeder.h"
 #include "DNSSeeder.h"
 #include "PeerManager.h"
+#include "HandShake.h"
+#include "Listener.h"
 #include "../ConnectionManager.h"
 #include "../Messages/GetPeerAddressesMessage.h"
 
@@ -27,6 +29,7 @@ Seeder::Seeder(
 	m_pBlockChainServer(pBlockChainServer),
 	m_pMessageProcessor(pMessageProcessor),
 	m_pSyncStatus(pSyncStatus),
+	m_pHandShake(std::make_shared<HandShake>(pContext->GetConfig(), connectionManager, pBlockChainServer)),
 	m_pAsioContext(std::make_shared<asio::io_context>()),
 	m_terminate(false)
 {
@@ -37,6 +40,7 @@ Seeder::~Seeder()
 {
 	LOG_INFO("Shutting down seeder");
 	m_terminate = true;
+	m_pAsioContext->stop();
 	ThreadUtil::Join(m_listenerThread);
 	ThreadUtil::Join(m_seedThread);
 }
@@ -113,7 +117,8 @@ void Seeder::Thread_Seed(Seeder& seeder)
 }
 
 //
-// Continuously listens for new connections, and drops them if node already has maximum number of connections
+// Accepts new connections and performs their handshakes asynchronously on the listener's io_context.
+// Only peers that pass the handshake are promoted to a full Connection (with its own thread).
 // This function operates in its own thread.
 //
 void Seeder::Thread_Listener(Seeder& seeder)
@@ -123,44 +128,21 @@ void Seeder::Thread_Listener(Seeder& seeder)
 
 	try
 	{
+		const P2PConfig& p2pConfig = seeder.m_pContext->GetConfig().GetP2PConfig();
 		const uint16_t portNumber = seeder.m_pContext->GetConfig().GetEnvironment().GetP2PPort();
-		asio::ip::tcp::acceptor acceptor(*seeder.m_pAsioContext, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), portNumber));
-		asio::error_code errorCode;
-		acceptor.listen(asio::socket_base::max_listen_connections, errorCode);
 
-		if (!errorCode)
-		{
-			const int maximumConnections = seeder.m_pContext->GetConfig().GetP2PConfig().GetMaxConnections();
-			while (!seeder.m_terminate)
-			{
-				SocketPtr pSocket = SocketPtr(new Socket(SocketAddress(IPAddress(), portNumber)));
-				// FUTURE: Always accept, but then send peers and immediately drop
-				if (seeder.m_connectionManager.GetNumberOfActiveConnections() < maximumConnections)
-				{
-					const bool connectionAdded = pSocket->Accept(seeder.m_pAsioContext, acceptor, seeder.m_terminate);
-					if (connectionAdded)
-					{
-						auto pPeer = seeder.m_peerManager.Write()->GetPeer(pSocket->GetIPAddress());
-						ConnectionPtr pConnection = Connection::Create(
-							pSocket,
-							seeder.m_nextId++,
-							seeder.m_pContext->GetConfig(),
-							seeder.m_connectionManager,
-							seeder.m_pBlockChainServer,
-							ConnectedPeer(pPeer, EDirection::INBOUND, pSocket->GetPort()),
-							seeder.m_pMessageProcessor,
-							seeder.m_pSyncStatus
-						);
-					}
-				}
-				else
-				{
-					ThreadUtil::SleepFor(std::chrono::milliseconds(10), seeder.m_terminate);
-				}
-			}
+		Listener::Ptr pListener = Listener::Create(
+			seeder.m_pAsioContext,
+			asio::ip::tcp::endpoint(asio::ip::tcp::v4(), portNumber),
+			ConnectionRateLimiter(p2pConfig.GetInboundBurst(), p2pConfig.GetInboundPerMinute()),
+			[&seeder](const std::shared_ptr<asio::ip::tcp::socket>& pSocket) { seeder.OnInboundConnection(pSocket); }
+		);
 
-			acceptor.cancel();
-		}
+		// Runs until the Seeder is destroyed.
+		auto workGuard = asio::make_work_guard(*seeder.m_pAsioContext);
+		seeder.m_pAsioContext->run();
+
+		pListener->Stop();
 	}
 	catch (std::exception& e)
 	{
@@ -170,6 +152,52 @@ void Seeder::Thread_Listener(Seeder& seeder)
 	LOG_TRACE("END");
 }
 
+// Called on the listener's thread for every accepted socket that passed the rate limiter.
+void Seeder::OnInboundConnection(const std::shared_ptr<asio::ip::tcp::socket>& pSocket)
+{
+	// FUTURE: Always accept, but then send peers and immediately drop
+	const int maximumConnections = m_pContext->GetConfig().GetP2PConfig().GetMaxConnections();
+	if (m_connectionManager.GetNumberOfActiveConnections() >= maximumConnections)
+	{
+		asio::error_code ignoreError;
+		pSocket->close(ignoreError);
+		return;
+	}
+
+	asio::error_code errorCode;
+	const asio::ip::tcp::endpoint remoteEndpoint = pSocket->remote_endpoint(errorCode);
+	if (errorCode)
+	{
+		return;
+	}
+
+	const SocketAddress socketAddress(IPAddress(remoteEndpoint.address()), remoteEndpoint.port());
+	auto pPeer = m_peerManager.Write()->GetPeer(socketAddress.GetIPAddress());
+
+	m_pHandShake->PerformInboundHandshakeAsync(
+		pSocket,
+		ConnectedPeer(pPeer, EDirection::INBOUND, socketAddress.GetPortNumber()),
+		[this, pSocket, socketAddress](const ConnectedPeer& connectedPeer) {
+			if (m_terminate)
+			{
+				return;
+			}
+
+			SocketPtr pWrappedSocket(new Socket(socketAddress, m_pAsioContext, pSocket));
+			Connection::Create(
+				pWrappedSocket,
+				m_nextId++,
+				m_pContext->GetConfig(),
+				m_connectionManager,
+				m_pBlockChainServer,
+				connectedPeer,
+				m_pMessageProcessor,
+				m_pSyncStatus
+			);
+		}
+	);
+}
+
 ConnectionPtr Seeder::SeedNewConnection()
 {
 	PeerPtr pPeer = m_peerManager.Write()->GetNewPeer(Capabilities::FAST_SYNC_NODE);
@@ -18,6 +18,7 @@
 class Connection;
 class PeerManager;
 class Pipeline;
+class HandShake;
 
 class Seeder
 {
@@ -46,6 +47,7 @@ private:
 	static void Thread_Listener(Seeder& seeder);
 
 	ConnectionPtr SeedNewConnection();
+	void OnInboundConnection(const std::shared_ptr<asio::ip::tcp::socket>& pSocket);
 
 	Context::Ptr m_pContext;
 	ConnectionManager& m_connectionManager;
@@ -53,6 +55,7 @@ private:
 	IBlockChainServerPtr m_pBlockChainServer;
 	std::shared_ptr<MessageProcessor> m_pMessageProcessor;
 	SyncStatusConstPtr m_pSyncStatus;
+	std::shared_ptr<HandShake> m_pHandShake;
 
 	std::atomic<bool> m_terminate = true;
 
@@ -60,5 +63,5 @@ private:
 	std::thread m_seedThread;
 	std::thread m_listenerThread;
 	mutable std::atomic_bool m_usedDNS = false;
-	mutable uint64_t m_nextId = { 1 };
+	std::atomic<uint64_t> m_nextId = { 1 };
 };
\ No newline at end of file
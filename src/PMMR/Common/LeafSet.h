@@ -3,6 +3,7 @@
 #include "PruneList.h"
 #include "MMRUtil.h"
 #include "MMRHashUtil.h"
+#include "MMRPeaks.h"
 
 #include <string>
 #include <Crypto/Hash.h>
@@ -50,9 +51,8 @@ public:
 
 	Hash Root(const uint64_t numOutputs) const
 	{
-		const fs::path path = fs::temp_directory_path() / "UBMT";
-		std::shared_ptr<HashFile> pHashFile = HashFile::Load(path);
-		pHashFile->Rewind(0);
+		// Only the peaks are ever read back, so the UBMT is built in memory.
+		MMRPeaks peaks;
 
 		size_t index = 0;
 		std::vector<uint8_t> bytes(128);
@@ -64,10 +64,10 @@ public:
 				bytes[j] = m_pBitmap->GetByte(index++);
 			}
 
-			MMRHashUtil::AddHashes(pHashFile, bytes, nullptr);
+			peaks.Append(bytes);
 		}
 
-		return MMRHashUtil::Root(pHashFile, pHashFile->GetSize(), nullptr);
+		return peaks.Root();
 	}
 
 private:
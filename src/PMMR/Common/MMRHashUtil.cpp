@@ -38,6 +38,17 @@ void MMRHashUtil::AddHashes(
 	}
 }
 
+void MMRHashUtil::AddHashes(
+	std::shared_ptr<HashFile> pHashFile,
+	const std::vector<unsigned char>& serializedLeaf,
+	MMRPeaks& peaks)
+{
+	for (const Hash& hash : peaks.Append(serializedLeaf))
+	{
+		pHashFile->AddData(hash);
+	}
+}
+
 Hash MMRHashUtil::Root(
 	std::shared_ptr<const HashFile> pHashFile,
 	const uint64_t size,
@@ -2,6 +2,7 @@
 
 #include "HashFile.h"
 #include "PruneList.h"
+#include "MMRPeaks.h"
 
 #include <Crypto/Hash.h>
 #include <Core/Traits/Lockable.h>
@@ -19,6 +20,13 @@ public:
 		std::shared_ptr<const PruneList> pPruneList
 	);
 
+	// Same as above, but takes the left siblings from the cached peaks instead of reading them from the hash file.
+	static void AddHashes(
+		std::shared_ptr<HashFile> pHashFile,
+		const std::vector<unsigned char>& serializedLeaf,
+		MMRPeaks& peaks
+	);
+
 	static Hash Root(
 		std::shared_ptr<const HashFile> pHashFile,
 		const uint64_t size,
@@ -38,9 +46,9 @@ public:
 		const uint64_t numHashes
 	);
 
+	static Hash HashLeafWithIndex(const std::vector<unsigned char>& serializedLeaf, const uint64_t mmrIndex);
 	static Hash HashParentWithIndex(const Hash& leftChild, const Hash& rightChild, const uint64_t parentIndex);
 
 private:
-	static Hash HashLeafWithIndex(const std::vector<unsigned char>& serializedLeaf, const uint64_t mmrIndex);
 	static uint64_t GetShiftedIndex(const uint64_t mmrIndex, std::shared_ptr<const PruneList> pPruneList);
 };
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "MMRPeaks.h"
+#include "MMRUtil.h"
+#include "MMRHashUtil.h"
+
+MMRPeaks MMRPeaks::Load(
+	const std::shared_ptr<const HashFile>& pHashFile,
+	const uint64_t size,
+	const std::shared_ptr<const PruneList>& pPruneList)
+{
+	std::vector<Hash> hashes;
+	for (const uint64_t peakIndex : MMRUtil::GetPeakIndices(size))
+	{
+		const uint64_t shift = pPruneList != nullptr ? pPruneList->GetShift(peakIndex) : 0;
+		hashes.emplace_back(pHashFile->GetDataAt(peakIndex - shift));
+	}
+
+	return MMRPeaks(size, std::move(hashes));
+}
+
+std::vector<Hash> MMRPeaks::Append(const std::vector<unsigned char>& serializedLeaf)
+{
+	uint64_t position = m_size;
+
+	std::vector<Hash> added;
+	added.push_back(MMRHashUtil::HashLeafWithIndex(serializedLeaf, position));
+
+	// The left sibling of each new node is always the rightmost peak.
+	while (MMRUtil::GetHeight(position + 1) > 0)
+	{
+		++position;
+		added.push_back(MMRHashUtil::HashParentWithIndex(m_hashes.back(), added.back(), position));
+		m_hashes.pop_back();
+	}
+
+	m_hashes.push_back(added.back());
+	m_size = position + 1;
+
+	return added;
+}
+
+Hash MMRPeaks::Root() const
+{
+	Hash hash = ZERO_HASH;
+	for (auto iter = m_hashes.crbegin(); iter != m_hashes.crend(); iter++)
+	{
+		if (*iter != ZERO_HASH)
+		{
+			if (hash == ZERO_HASH)
+			{
+				hash = *iter;
+			}
+			else
+			{
+				hash = MMRHashUtil::HashParentWithIndex(*iter, hash, m_size);
+			}
+		}
+	}
+
+	return hash;
+}
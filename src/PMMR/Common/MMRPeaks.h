@@ -0,0 +1,49 @@
+#pragma once
+
+#include "HashFile.h"
+#include "PruneList.h"
+
+#include <Crypto/Hash.h>
+#include <vector>
+#include <memory>
+
+//
+// The hashes of an MMR's peaks, kept in memory so the root at the current size costs only a few hashes and no file reads.
+// Appending only ever merges the new node with the rightmost peaks, so the peaks are also all that's needed to append.
+//
+class MMRPeaks
+{
+public:
+	MMRPeaks() : m_size(0) { }
+
+	//
+	// Reads the peaks of an MMR with the given (unpruned) size from the hash file.
+	//
+	static MMRPeaks Load(
+		const std::shared_ptr<const HashFile>& pHashFile,
+		const uint64_t size,
+		const std::shared_ptr<const PruneList>& pPruneList
+	);
+
+	//
+	// Adds the leaf, merging it with any peaks of the same height.
+	// Returns the hashes of the new nodes in MMR order (the leaf first, followed by its new parents).
+	//
+	std::vector<Hash> Append(const std::vector<unsigned char>& serializedLeaf);
+
+	//
+	// Bags the peaks right to left, skipping any zero hashes, exactly like MMRHashUtil::Root.
+	//
+	Hash Root() const;
+
+	uint64_t GetSize() const noexcept { return m_size; }
+
+private:
+	MMRPeaks(const uint64_t size, std::vector<Hash>&& hashes)
+		: m_size(size), m_hashes(std::move(hashes)) { }
+
+	uint64_t m_size;
+
+	// Ordered left to right, so the peak that the next append merges with is at the back.
+	std::vector<Hash> m_hashes;
+};
@@ -7,6 +7,7 @@
 
 #include "MMRUtil.h"
 #include "MMRHashUtil.h"
+#include "MMRPeaks.h"
 
 #include <Core/File/DataFile.h>
 #include <Roaring.h>
@@ -30,7 +31,7 @@ public:
 		m_pPruneList(pPruneList),
 		m_pDataFile(pDataFile)
 	{
-
+		ReloadPeaks();
 	}
 
 	virtual ~PruneableMMR() = default;
@@ -50,7 +51,12 @@ public:
 		m_pDataFile->AddData(serializer.GetBytes());
 
 		// Add hashes
-		MMRHashUtil::AddHashes(m_pHashFile, serializer.GetBytes(), m_pPruneList);
+		if (m_peaks.GetSize() != mmrIndex)
+		{
+			ReloadPeaks();
+		}
+
+		MMRHashUtil::AddHashes(m_pHashFile, serializer.GetBytes(), m_peaks);
 	}
 
 	void Remove(const uint64_t mmrIndex)
@@ -81,10 +87,16 @@ public:
 		m_pHashFile->Rewind(size - m_pPruneList->GetShift(size - 1));
 		m_pDataFile->Rewind(MMRUtil::GetNumLeaves(size - 1) - m_pPruneList->GetLeafShift(size - 1));
 		m_pLeafSet->Rewind(MMRUtil::GetNumLeaves(size - 1), leavesToAdd);
+		ReloadPeaks();
 	}
 
 	Hash Root(const uint64_t size) const final
 	{
+		if (size == m_peaks.GetSize() && size == GetSize())
+		{
+			return m_peaks.Root();
+		}
+
 		return MMRHashUtil::Root(m_pHashFile, size, m_pPruneList);
 	}
 
@@ -176,12 +188,29 @@ public:
 			m_pDataFile->Rollback();
 			m_pLeafSet->Rollback();
 			SetDirty(false);
+
+			try
+			{
+				ReloadPeaks();
+			}
+			catch (std::exception& e)
+			{
+				// Append reloads the peaks when they don't match the size, and Root falls back to the hash file.
+				LOG_ERROR_F("Failed to reload peaks: {}", e.what());
+				m_peaks = MMRPeaks();
+			}
 		}
 	}
 
 private:
+	void ReloadPeaks()
+	{
+		m_peaks = MMRPeaks::Load(m_pHashFile, GetSize(), m_pPruneList);
+	}
+
 	std::shared_ptr<HashFile> m_pHashFile;
 	std::shared_ptr<LeafSet> m_pLeafSet;
 	std::shared_ptr<PruneList> m_pPruneList;
 	std::shared_ptr<DataFile<DATA_SIZE>> m_pDataFile;
+	MMRPeaks m_peaks;
 };
\ No newline at end of file
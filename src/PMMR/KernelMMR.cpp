@@ -10,7 +10,7 @@ KernelMMR::KernelMMR(std::shared_ptr<HashFile> pHashFile, std::shared_ptr<DataFi
 	: m_pHashFile(pHashFile),
 	m_pDataFile(pDataFile)
 {
-
+	ReloadPeaks();
 }
 
 std::shared_ptr<KernelMMR> KernelMMR::Load(const fs::path& txHashSetPath, const FullBlock& genesisBlock)
@@ -30,6 +30,11 @@ std::shared_ptr<KernelMMR> KernelMMR::Load(const fs::path& txHashSetPath, const
 
 Hash KernelMMR::Root(const uint64_t size) const
 {
+	if (size == m_peaks.GetSize() && size == m_pHashFile->GetSize())
+	{
+		return m_peaks.Root();
+	}
+
 	return MMRHashUtil::Root(m_pHashFile, size, nullptr);
 }
 
@@ -60,6 +65,7 @@ bool KernelMMR::Rewind(const uint64_t size)
 {
 	m_pHashFile->Rewind(size);
 	m_pDataFile->Rewind(MMRUtil::GetNumLeaves(size - 1));
+	ReloadPeaks();
 	return true;
 }
 
@@ -73,6 +79,17 @@ void KernelMMR::Rollback() noexcept
 {
 	m_pHashFile->Rollback();
 	m_pDataFile->Rollback();
+
+	try
+	{
+		ReloadPeaks();
+	}
+	catch (std::exception& e)
+	{
+		// ApplyKernel reloads the peaks when they don't match the size, and Root falls back to the hash file.
+		LOG_ERROR_F("Failed to reload peaks: {}", e.what());
+		m_peaks = MMRPeaks();
+	}
 }
 
 void KernelMMR::ApplyKernel(const TransactionKernel& kernel)
@@ -83,5 +100,10 @@ void KernelMMR::ApplyKernel(const TransactionKernel& kernel)
 	m_pDataFile->AddData(serializer.GetBytes());
 
 	// Add hashes
-	MMRHashUtil::AddHashes(m_pHashFile, serializer.GetBytes(), nullptr);
+	if (m_peaks.GetSize() != m_pHashFile->GetSize())
+	{
+		ReloadPeaks();
+	}
+
+	MMRHashUtil::AddHashes(m_pHashFile, serializer.GetBytes(), m_peaks);
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "Common/MMR.h"
 #include "Common/HashFile.h"
+#include "Common/MMRPeaks.h"
 
 #include <Core/File/DataFile.h>
 #include <Core/Models/TransactionKernel.h>
@@ -35,6 +36,9 @@ public:
 private:
 	KernelMMR(std::shared_ptr<HashFile> pHashFile, std::shared_ptr<DataFile<KERNEL_SIZE>> pDataFile);
 
+	void ReloadPeaks() { m_peaks = MMRPeaks::Load(m_pHashFile, m_pHashFile->GetSize(), nullptr); }
+
 	mutable std::shared_ptr<HashFile> m_pHashFile;
 	mutable std::shared_ptr<DataFile<KERNEL_SIZE>> m_pDataFile;
+	MMRPeaks m_peaks;
 };
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include <Infrastructure/Logger.h>
 #include <P2P/SyncStatus.h>
 #include <thread>
+#include <future>
 
 TxHashSet::TxHashSet(
 	const Config& config,
@@ -24,7 +25,8 @@ TxHashSet::TxHashSet(
 	m_pOutputPMMR(pOutputPMMR),
 	m_pRangeProofPMMR(pRangeProofPMMR),
 	m_pBlockHeader(pBlockHeader),
-	m_pBlockHeaderBackup(pBlockHeader)
+	m_pBlockHeaderBackup(pBlockHeader),
+	m_kernelsValidated(false)
 {
 
 }
@@ -86,7 +88,7 @@ std::unique_ptr<BlockSums> TxHashSet::ValidateTxHashSet(const BlockHeader& heade
 	try
 	{
 		LOG_INFO("Validating TxHashSet for block " + header.GetHash().ToHex());
-		pBlockSums = TxHashSetValidator(blockChainServer).Validate(*this, header, syncStatus);
+		pBlockSums = TxHashSetValidator(blockChainServer).Validate(*this, header, syncStatus, !m_kernelsValidated);
 		if (pBlockSums != nullptr)
 		{
 			LOG_INFO("Successfully validated TxHashSet");
@@ -163,13 +165,33 @@ bool TxHashSet::ApplyBlock(std::shared_ptr<IBlockDB> pBlockDB, const FullBlock&
 
 bool TxHashSet::ValidateRoots(const BlockHeader& blockHeader) const
 {
-	if (m_pKernelMMR->Root(blockHeader.GetKernelMMRSize()) != blockHeader.GetKernelRoot())
+	// The roots are independent, so they're computed concurrently. The UBMT root is the most expensive, since it covers the whole leafset.
+	const uint64_t outputMMRSize = blockHeader.GetOutputMMRSize();
+	std::future<Hash> outputRootFuture = std::async(std::launch::async, [this, outputMMRSize]() {
+		return m_pOutputPMMR->Root(outputMMRSize);
+	});
+	std::future<Hash> rangeProofRootFuture = std::async(std::launch::async, [this, outputMMRSize]() {
+		return m_pRangeProofPMMR->Root(outputMMRSize);
+	});
+
+	std::future<Hash> ubmtFuture;
+	if (blockHeader.GetVersion() >= 3)
+	{
+		ubmtFuture = std::async(std::launch::async, [this, outputMMRSize]() {
+			return m_pOutputPMMR->UBMTRoot(MMRUtil::GetNumLeaves(outputMMRSize - 1));
+		});
+	}
+
+	const Hash kernelRoot = m_pKernelMMR->Root(blockHeader.GetKernelMMRSize());
+	const Hash outputRoot = outputRootFuture.get();
+	const Hash rangeProofRoot = rangeProofRootFuture.get();
+
+	if (kernelRoot != blockHeader.GetKernelRoot())
 	{
 		LOG_ERROR_F("Kernel root not matching for header ({})", blockHeader);
 		return false;
 	}
 
-	Hash outputRoot = m_pOutputPMMR->Root(blockHeader.GetOutputMMRSize());
 	if (blockHeader.GetVersion() < 3)
 	{
 		if (outputRoot != blockHeader.GetOutputRoot())
@@ -180,8 +202,8 @@ bool TxHashSet::ValidateRoots(const BlockHeader& blockHeader) const
 	}
 	else
 	{
-		Hash UBMT = m_pOutputPMMR->UBMTRoot(MMRUtil::GetNumLeaves(blockHeader.GetOutputMMRSize() - 1));
-		Hash merged = MMRHashUtil::HashParentWithIndex(outputRoot, UBMT, blockHeader.GetOutputMMRSize());
+		const Hash UBMT = ubmtFuture.get();
+		Hash merged = MMRHashUtil::HashParentWithIndex(outputRoot, UBMT, outputMMRSize);
 		if (merged != blockHeader.GetOutputRoot())
 		{
 			LOG_ERROR_F("Output root not matching for header ({}). Output: {}, UBMT: {}", blockHeader, outputRoot, UBMT);
@@ -189,7 +211,7 @@ bool TxHashSet::ValidateRoots(const BlockHeader& blockHeader) const
 		}
 	}
 
-	if (m_pRangeProofPMMR->Root(blockHeader.GetOutputMMRSize()) != blockHeader.GetRangeProofRoot())
+	if (rangeProofRoot != blockHeader.GetRangeProofRoot())
 	{
 		LOG_ERROR_F("RangeProof root not matching for header ({})", blockHeader);
 		return false;
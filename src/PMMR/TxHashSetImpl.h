@@ -46,6 +46,10 @@ public:
 	std::shared_ptr<OutputPMMR> GetOutputPMMR() { return m_pOutputPMMR; }
 	std::shared_ptr<RangeProofPMMR> GetRangeProofPMMR() { return m_pRangeProofPMMR; }
 
+	// Called when the kernel MMR was already validated while the TxHashSet was being received,
+	// so ValidateTxHashSet doesn't need to validate it again.
+	void MarkKernelsValidated() noexcept { m_kernelsValidated = true; }
+
 private:
 	const Config& m_config;
 	std::shared_ptr<KernelMMR> m_pKernelMMR;
@@ -54,4 +58,5 @@ private:
 
 	BlockHeaderPtr m_pBlockHeader;
 	BlockHeaderPtr m_pBlockHeaderBackup;
+	bool m_kernelsValidated;
 };
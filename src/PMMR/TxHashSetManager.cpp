@@ -1,6 +1,7 @@
 #include <PMMR/TxHashSetManager.h>
 
 #include "TxHashSetImpl.h"
+#include "TxHashSetReceiver.h"
 #include "Zip/TxHashSetZip.h"
 #include "Zip/Zipper.h"
 
@@ -30,12 +31,54 @@ std::shared_ptr<ITxHashSet> TxHashSetManager::Open(BlockHeaderPtr pConfirmedTip,
 	return m_pTxHashSet;
 }
 
+// Rewinds the extracted MMRs to the header, and converts the leafsets from the roaring format used in archives.
+static std::shared_ptr<TxHashSet> LoadExtracted(const Config& config, BlockHeaderPtr pHeader)
+{
+	const fs::path& txHashSetPath = config.GetNodeConfig().GetTxHashSetPath();
+	const FullBlock& genesisBlock = config.GetEnvironment().GetGenesisBlock();
+
+	// Rewind Kernel MMR
+	std::shared_ptr<KernelMMR> pKernelMMR = KernelMMR::Load(txHashSetPath, genesisBlock);
+	pKernelMMR->Rewind(pHeader->GetKernelMMRSize());
+	pKernelMMR->Commit();
+
+	// Create output BitmapFile from Roaring file
+	const fs::path leafPath = txHashSetPath / "output" / "pmmr_leaf.bin";
+	Roaring outputBitmap;
+	std::vector<unsigned char> outputBytes;
+	if (FileUtil::ReadFile(leafPath, outputBytes))
+	{
+		outputBitmap = Roaring::readSafe((const char*)outputBytes.data(), outputBytes.size());
+	}
+	BitmapFile::Create(txHashSetPath / "output" / "pmmr_leafset.bin", outputBitmap);
+
+	// Rewind Output MMR
+	std::shared_ptr<OutputPMMR> pOutputPMMR = OutputPMMR::Load(txHashSetPath, genesisBlock);
+	pOutputPMMR->Rewind(pHeader->GetOutputMMRSize(), {});
+	pOutputPMMR->Commit();
+
+	// Create rangeproof BitmapFile from Roaring file
+	const fs::path rangeproofPath = txHashSetPath / "rangeproof" / "pmmr_leaf.bin";
+	Roaring rangeproofBitmap;
+	std::vector<unsigned char> rangeproofBytes;
+	if (FileUtil::ReadFile(rangeproofPath, rangeproofBytes))
+	{
+		rangeproofBitmap = Roaring::readSafe((const char*)rangeproofBytes.data(), rangeproofBytes.size());
+	}
+	BitmapFile::Create(txHashSetPath / "rangeproof" / "pmmr_leafset.bin", rangeproofBitmap);
+
+	// Rewind RangeProof MMR
+	std::shared_ptr<RangeProofPMMR> pRangeProofPMMR = RangeProofPMMR::Load(txHashSetPath, genesisBlock);
+	pRangeProofPMMR->Rewind(pHeader->GetOutputMMRSize(), {});
+	pRangeProofPMMR->Commit();
+
+	return std::shared_ptr<TxHashSet>(new TxHashSet(config, pKernelMMR, pOutputPMMR, pRangeProofPMMR, pHeader));
+}
+
 std::shared_ptr<ITxHashSet> TxHashSetManager::LoadFromZip(const Config& config, const fs::path& zipFilePath, BlockHeaderPtr pHeader)
 {
 	FileRemover fileRemover(zipFilePath);
 
-	const fs::path& txHashSetPath = config.GetNodeConfig().GetTxHashSetPath();
-	const FullBlock& genesisBlock = config.GetEnvironment().GetGenesisBlock();
 	const TxHashSetZip zip(config);
 
 	try
@@ -45,42 +88,7 @@ std::shared_ptr<ITxHashSet> TxHashSetManager::LoadFromZip(const Config& config,
 			LOG_INFO_F("{} extracted successfully", zipFilePath);
 			FileUtil::RemoveFile(zipFilePath);
 
-			// Rewind Kernel MMR
-			std::shared_ptr<KernelMMR> pKernelMMR = KernelMMR::Load(txHashSetPath, genesisBlock);
-			pKernelMMR->Rewind(pHeader->GetKernelMMRSize());
-			pKernelMMR->Commit();
-
-			// Create output BitmapFile from Roaring file
-			const fs::path leafPath = txHashSetPath / "output" / "pmmr_leaf.bin";
-			Roaring outputBitmap;
-			std::vector<unsigned char> outputBytes;
-			if (FileUtil::ReadFile(leafPath, outputBytes))
-			{
-				outputBitmap = Roaring::readSafe((const char*)outputBytes.data(), outputBytes.size());
-			}
-			BitmapFile::Create(txHashSetPath / "output" / "pmmr_leafset.bin", outputBitmap);
-
-			// Rewind Output MMR
-			std::shared_ptr<OutputPMMR> pOutputPMMR = OutputPMMR::Load(txHashSetPath, genesisBlock);
-			pOutputPMMR->Rewind(pHeader->GetOutputMMRSize(), {});
-			pOutputPMMR->Commit();
-
-			// Create rangeproof BitmapFile from Roaring file
-			const fs::path rangeproofPath = txHashSetPath / "rangeproof" / "pmmr_leaf.bin";
-			Roaring rangeproofBitmap;
-			std::vector<unsigned char> rangeproofBytes;
-			if (FileUtil::ReadFile(rangeproofPath, rangeproofBytes))
-			{
-				rangeproofBitmap = Roaring::readSafe((const char*)rangeproofBytes.data(), rangeproofBytes.size());
-			}
-			BitmapFile::Create(txHashSetPath / "rangeproof" / "pmmr_leafset.bin", rangeproofBitmap);
-
-			// Rewind RangeProof MMR
-			std::shared_ptr<RangeProofPMMR> pRangeProofPMMR = RangeProofPMMR::Load(txHashSetPath, genesisBlock);
-			pRangeProofPMMR->Rewind(pHeader->GetOutputMMRSize(), {});
-			pRangeProofPMMR->Commit();
-
-			return std::shared_ptr<TxHashSet>(new TxHashSet(config, pKernelMMR, pOutputPMMR, pRangeProofPMMR, pHeader));
+			return LoadExtracted(config, pHeader);
 		}
 	}
 	catch (std::exception& e)
@@ -91,6 +99,41 @@ std::shared_ptr<ITxHashSet> TxHashSetManager::LoadFromZip(const Config& config,
 	return nullptr;
 }
 
+ITxHashSetReceiverPtr TxHashSetManager::CreateReceiver(const Config& config, BlockHeaderPtr pHeader, const IBlockChainServer& blockChainServer, SyncStatus& syncStatus)
+{
+	return std::make_shared<TxHashSetReceiver>(config, pHeader, blockChainServer, syncStatus);
+}
+
+std::shared_ptr<ITxHashSet> TxHashSetManager::LoadFromReceiver(const Config& config, ITxHashSetReceiver& receiver, BlockHeaderPtr pHeader)
+{
+	try
+	{
+		if (!receiver.IsComplete())
+		{
+			LOG_ERROR("TxHashSet archive is incomplete");
+			return nullptr;
+		}
+
+		if (!receiver.WaitForKernelValidation())
+		{
+			LOG_ERROR("Invalid kernel MMR");
+			return nullptr;
+		}
+
+		receiver.MoveTo(config.GetNodeConfig().GetTxHashSetPath());
+
+		std::shared_ptr<TxHashSet> pTxHashSet = LoadExtracted(config, pHeader);
+		pTxHashSet->MarkKernelsValidated();
+		return pTxHashSet;
+	}
+	catch (std::exception& e)
+	{
+		LOG_ERROR_F("Failed to load: {}", e.what());
+	}
+
+	return nullptr;
+}
+
 fs::path TxHashSetManager::SaveSnapshot(std::shared_ptr<IBlockDB> pBlockDB, BlockHeaderPtr pHeader) const
 {
 	if (m_pTxHashSet == nullptr)
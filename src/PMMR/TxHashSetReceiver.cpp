@@ -0,0 +1,188 @@
+#include "TxHashSetReceiver.h"
+#include "TxHashSetValidator.h"
+#include "KernelMMR.h"
+
+#include <Common/Util/FileUtil.h>
+#include <Common/Util/StringUtil.h>
+#include <Common/Util/ThreadUtil.h>
+#include <Core/Exceptions/FileException.h>
+#include <Infrastructure/ThreadManager.h>
+#include <Infrastructure/Logger.h>
+#include <P2P/SyncStatus.h>
+#include <algorithm>
+
+static const std::vector<std::string> FOLDERS = { "kernel", "output", "rangeproof" };
+
+// Archives created on Windows may use backslashes as separators.
+static std::string NormalizeEntryName(const std::string& entryName)
+{
+	std::string normalized = entryName;
+	std::replace(normalized.begin(), normalized.end(), '\\', '/');
+	return normalized;
+}
+
+TxHashSetReceiver::TxHashSetReceiver(
+	const Config& config,
+	BlockHeaderPtr pHeader,
+	const IBlockChainServer& blockChainServer,
+	SyncStatus& syncStatus)
+	: m_config(config),
+	m_pHeader(pHeader),
+	m_blockChainServer(blockChainServer),
+	m_syncStatus(syncStatus),
+	m_stagingPath(config.GetNodeConfig().GetTxHashSetPath().parent_path() / "TXHASHSET_DOWNLOAD"),
+	m_zipStream(
+		[this](const std::string& entryName) { return GetDestination(entryName); },
+		[this](const std::string& entryName) { OnExtracted(entryName); }
+	),
+	m_kernelsValid(false)
+{
+	std::error_code ec;
+	fs::remove_all(m_stagingPath, ec);
+	if (ec)
+	{
+		LOG_ERROR_F("fs::remove_all failed with error: {}", ec.message());
+		throw FILE_EXCEPTION_F("fs::remove_all failed with error: {}", ec.message());
+	}
+
+	for (const std::string& folder : FOLDERS)
+	{
+		fs::create_directories(m_stagingPath / folder, ec);
+		if (ec)
+		{
+			LOG_ERROR_F("Failed to create {}. Error: {}", m_stagingPath / folder, ec.message());
+			throw FILE_EXCEPTION_F("Failed to create {}. Error: {}", m_stagingPath / folder, ec.message());
+		}
+	}
+
+	m_expectedFiles["kernel/pmmr_data.bin"] = m_stagingPath / "kernel" / "pmmr_data.bin";
+	m_expectedFiles["kernel/pmmr_hash.bin"] = m_stagingPath / "kernel" / "pmmr_hash.bin";
+
+	for (const std::string folder : { "output", "rangeproof" })
+	{
+		for (const std::string file : { "pmmr_data.bin", "pmmr_hash.bin", "pmmr_prun.bin" })
+		{
+			m_expectedFiles[folder + "/" + file] = m_stagingPath / folder / file;
+		}
+
+		const std::string leafFile = StringUtil::Format("{}/pmmr_leaf.bin.{}", folder, pHeader->ShortHash());
+		m_expectedFiles[leafFile] = m_stagingPath / folder / "pmmr_leaf.bin";
+	}
+}
+
+TxHashSetReceiver::~TxHashSetReceiver()
+{
+	ThreadUtil::Join(m_kernelThread);
+	FileUtil::RemoveFile(m_stagingPath);
+}
+
+void TxHashSetReceiver::Receive(const uint8_t* pData, const size_t numBytes)
+{
+	m_zipStream.Write(pData, numBytes);
+}
+
+bool TxHashSetReceiver::IsComplete() const
+{
+	return m_zipStream.IsComplete() && m_extractedFiles.size() == m_expectedFiles.size();
+}
+
+bool TxHashSetReceiver::WaitForKernelValidation()
+{
+	ThreadUtil::Join(m_kernelThread);
+	return m_kernelsValid;
+}
+
+void TxHashSetReceiver::MoveTo(const fs::path& txHashSetPath)
+{
+	// The kernel validation thread must release the staged kernel files first.
+	ThreadUtil::Join(m_kernelThread);
+
+	std::error_code ec;
+	fs::create_directories(txHashSetPath, ec);
+	if (ec)
+	{
+		LOG_ERROR_F("Failed to create {}. Error: {}", txHashSetPath, ec.message());
+		throw FILE_EXCEPTION_F("Failed to create {}. Error: {}", txHashSetPath, ec.message());
+	}
+
+	for (const std::string& folder : FOLDERS)
+	{
+		const fs::path destination = txHashSetPath / folder;
+		fs::remove_all(destination, ec);
+		if (ec)
+		{
+			LOG_ERROR_F("fs::remove_all failed with error: {}", ec.message());
+			throw FILE_EXCEPTION_F("fs::remove_all failed with error: {}", ec.message());
+		}
+
+		fs::rename(m_stagingPath / folder, destination, ec);
+		if (ec)
+		{
+			LOG_ERROR_F("Failed to move {} to {}. Error: {}", m_stagingPath / folder, destination, ec.message());
+			throw FILE_EXCEPTION_F("Failed to move {} to {}. Error: {}", m_stagingPath / folder, destination, ec.message());
+		}
+	}
+}
+
+std::optional<fs::path> TxHashSetReceiver::GetDestination(const std::string& entryName)
+{
+	const std::string normalized = NormalizeEntryName(entryName);
+	auto iter = m_expectedFiles.find(normalized);
+	if (iter == m_expectedFiles.end())
+	{
+		LOG_DEBUG_F("Skipping {}", entryName);
+		return std::nullopt;
+	}
+
+	// A repeated entry would overwrite a file that may already be validated (ie. the kernel MMR).
+	if (!m_openedFiles.insert(normalized).second)
+	{
+		LOG_ERROR_F("{} appears more than once in the archive", entryName);
+		throw FILE_EXCEPTION_F("{} appears more than once in the archive", entryName);
+	}
+
+	return iter->second;
+}
+
+void TxHashSetReceiver::OnExtracted(const std::string& entryName)
+{
+	if (!m_extractedFiles.insert(NormalizeEntryName(entryName)).second)
+	{
+		LOG_ERROR_F("{} was already extracted", entryName);
+		throw FILE_EXCEPTION_F("{} was already extracted", entryName);
+	}
+
+	const bool kernelsExtracted = m_extractedFiles.count("kernel/pmmr_data.bin") > 0
+		&& m_extractedFiles.count("kernel/pmmr_hash.bin") > 0;
+	if (kernelsExtracted && !m_kernelThread.joinable())
+	{
+		m_kernelThread = std::thread(Thread_ValidateKernels, std::ref(*this));
+	}
+}
+
+void TxHashSetReceiver::Thread_ValidateKernels(TxHashSetReceiver& receiver)
+{
+	try
+	{
+		ThreadManagerAPI::SetCurrentThreadName("TXHASHSET_KERNELS");
+		LOG_INFO("Kernel MMR extracted. Validating it while the remaining files are received.");
+
+		const FullBlock& genesisBlock = receiver.m_config.GetEnvironment().GetGenesisBlock();
+		std::shared_ptr<KernelMMR> pKernelMMR = KernelMMR::Load(receiver.m_stagingPath, genesisBlock);
+		pKernelMMR->Rewind(receiver.m_pHeader->GetKernelMMRSize());
+		pKernelMMR->Commit();
+
+		receiver.m_kernelsValid = TxHashSetValidator(receiver.m_blockChainServer).ValidateKernelMMR(
+			pKernelMMR,
+			*receiver.m_pHeader,
+			receiver.m_syncStatus
+		);
+
+		LOG_INFO_F("Kernel MMR validation {}", receiver.m_kernelsValid ? "succeeded" : "failed");
+	}
+	catch (std::exception& e)
+	{
+		LOG_ERROR_F("Exception thrown while validating kernel MMR: {}", e.what());
+		receiver.m_kernelsValid = false;
+	}
+}
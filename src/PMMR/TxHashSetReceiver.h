@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Zip/ZipStream.h"
+
+#include <PMMR/TxHashSetReceiver.h>
+#include <Core/Models/BlockHeader.h>
+#include <Config/Config.h>
+#include <atomic>
+#include <map>
+#include <set>
+#include <thread>
+
+// Forward Declarations
+class IBlockChainServer;
+class SyncStatus;
+
+class TxHashSetReceiver : public ITxHashSetReceiver
+{
+public:
+	TxHashSetReceiver(
+		const Config& config,
+		BlockHeaderPtr pHeader,
+		const IBlockChainServer& blockChainServer,
+		SyncStatus& syncStatus
+	);
+	~TxHashSetReceiver();
+
+	void Receive(const uint8_t* pData, const size_t numBytes) final;
+	bool IsComplete() const final;
+	bool WaitForKernelValidation() final;
+	void MoveTo(const fs::path& txHashSetPath) final;
+
+private:
+	std::optional<fs::path> GetDestination(const std::string& entryName);
+	void OnExtracted(const std::string& entryName);
+
+	static void Thread_ValidateKernels(TxHashSetReceiver& receiver);
+
+	const Config& m_config;
+	BlockHeaderPtr m_pHeader;
+	const IBlockChainServer& m_blockChainServer;
+	SyncStatus& m_syncStatus;
+
+	fs::path m_stagingPath;
+	std::map<std::string, fs::path> m_expectedFiles;
+	std::set<std::string> m_openedFiles;
+	std::set<std::string> m_extractedFiles;
+	ZipStream m_zipStream;
+
+	std::thread m_kernelThread;
+	std::atomic_bool m_kernelsValid;
+};
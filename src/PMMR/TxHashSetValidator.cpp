@@ -19,7 +19,7 @@ TxHashSetValidator::TxHashSetValidator(const IBlockChainServer& blockChainServer
 
 }
 
-std::unique_ptr<BlockSums> TxHashSetValidator::Validate(TxHashSet& txHashSet, const BlockHeader& blockHeader, SyncStatus& syncStatus) const
+std::unique_ptr<BlockSums> TxHashSetValidator::Validate(TxHashSet& txHashSet, const BlockHeader& blockHeader, SyncStatus& syncStatus, const bool validateKernels) const
 {
 	std::shared_ptr<const KernelMMR> pKernelMMR = txHashSet.GetKernelMMR();
 	std::shared_ptr<const OutputPMMR> pOutputPMMR = txHashSet.GetOutputPMMR();
@@ -37,7 +37,11 @@ std::unique_ptr<BlockSums> TxHashSetValidator::Validate(TxHashSet& txHashSet, co
 	// Validate MMR hashes in parallel
 	std::vector<std::thread> threads;
 	std::atomic_bool mmrHashesValidated = true;
-	threads.emplace_back(std::thread([this, pKernelMMR, &mmrHashesValidated] { if (!this->ValidateMMRHashes(pKernelMMR)) { mmrHashesValidated = false; }}));
+	if (validateKernels)
+	{
+		threads.emplace_back(std::thread([this, pKernelMMR, &mmrHashesValidated] { if (!this->ValidateMMRHashes(pKernelMMR)) { mmrHashesValidated = false; }}));
+	}
+
 	threads.emplace_back(std::thread([this, pOutputPMMR, &mmrHashesValidated] { if (!this->ValidateMMRHashes(pOutputPMMR)) { mmrHashesValidated = false; }}));
 	threads.emplace_back(std::thread([this, pRangeProofPMMR, &mmrHashesValidated] { if (!this->ValidateMMRHashes(pRangeProofPMMR)) { mmrHashesValidated = false; }}));
 
@@ -68,7 +72,7 @@ std::unique_ptr<BlockSums> TxHashSetValidator::Validate(TxHashSet& txHashSet, co
 
 	// Validate the full kernel history (kernel MMR root for every block header).
 	LOG_DEBUG("Validating kernel history");
-	if (!ValidateKernelHistory(*txHashSet.GetKernelMMR(), blockHeader, syncStatus))
+	if (validateKernels && !ValidateKernelHistory(*txHashSet.GetKernelMMR(), blockHeader, syncStatus))
 	{
 		LOG_ERROR("Invalid kernel history");
 		return std::unique_ptr<BlockSums>(nullptr);
@@ -107,7 +111,7 @@ std::unique_ptr<BlockSums> TxHashSetValidator::Validate(TxHashSet& txHashSet, co
 	// Validate kernel signatures
 	LOG_DEBUG("Validating kernel signatures");
 	LoggerAPI::Flush();
-	if (!ValidateKernelSignatures(*txHashSet.GetKernelMMR(), syncStatus))
+	if (validateKernels && !ValidateKernelSignatures(*txHashSet.GetKernelMMR(), syncStatus))
 	{
 		LOG_ERROR("Failed to verify kernel signatures");
 		return std::unique_ptr<BlockSums>(nullptr);
@@ -121,6 +125,43 @@ std::unique_ptr<BlockSums> TxHashSetValidator::Validate(TxHashSet& txHashSet, co
 	return pBlockSums;
 }
 
+bool TxHashSetValidator::ValidateKernelMMR(std::shared_ptr<const KernelMMR> pKernelMMR, const BlockHeader& blockHeader, SyncStatus& syncStatus) const
+{
+	if (pKernelMMR->GetSize() != blockHeader.GetKernelMMRSize())
+	{
+		LOG_ERROR_F("Kernel size not matching for header ({})", blockHeader);
+		return false;
+	}
+
+	if (!ValidateMMRHashes(pKernelMMR))
+	{
+		LOG_ERROR("Invalid kernel MMR hashes");
+		return false;
+	}
+
+	if (pKernelMMR->Root(blockHeader.GetKernelMMRSize()) != blockHeader.GetKernelRoot())
+	{
+		LOG_ERROR_F("Kernel root not matching for header ({})", blockHeader);
+		return false;
+	}
+
+	LOG_DEBUG("Validating kernel history");
+	if (!ValidateKernelHistory(*pKernelMMR, blockHeader, syncStatus))
+	{
+		LOG_ERROR("Invalid kernel history");
+		return false;
+	}
+
+	LOG_DEBUG("Validating kernel signatures");
+	if (!ValidateKernelSignatures(*pKernelMMR, syncStatus))
+	{
+		LOG_ERROR("Failed to verify kernel signatures");
+		return false;
+	}
+
+	return true;
+}
+
 bool TxHashSetValidator::ValidateSizes(TxHashSet& txHashSet, const BlockHeader& blockHeader) const
 {
 	if (txHashSet.GetKernelMMR()->GetSize() != blockHeader.GetKernelMMRSize())
@@ -219,30 +260,30 @@ BlockSums TxHashSetValidator::ValidateKernelSums(TxHashSet& txHashSet, const Blo
 
 	// Determine output commitments
 	std::shared_ptr<const OutputPMMR> pOutputPMMR = txHashSet.GetOutputPMMR();
-	std::vector<Commitment> outputCommitments;
+	std::vector<ParsedCommitment> outputCommitments;
 	for (uint64_t i = 0; i < blockHeader.GetOutputMMRSize(); i++)
 	{
 		std::unique_ptr<OutputIdentifier> pOutput = pOutputPMMR->GetAt(i);
 		if (pOutput != nullptr)
 		{
-			outputCommitments.push_back(pOutput->GetCommitment());
+			outputCommitments.push_back(Crypto::ParseCommitment(pOutput->GetCommitment()));
 		}
 	}
 
 	// Determine kernel excess commitments
 	std::shared_ptr<const KernelMMR> pKernelMMR = txHashSet.GetKernelMMR();
-	std::vector<Commitment> excessCommitments;
+	std::vector<ParsedCommitment> excessCommitments;
 	for (uint64_t i = 0; i < blockHeader.GetKernelMMRSize(); i++)
 	{
 		std::unique_ptr<TransactionKernel> pKernel = pKernelMMR->GetKernelAt(i);
 		if (pKernel != nullptr)
 		{
-			excessCommitments.push_back(pKernel->GetExcessCommitment());
+			excessCommitments.push_back(pKernel->GetParsedExcessCommitment());
 		}
 	}
 
 	return KernelSumValidator::ValidateKernelSums(
-		std::vector<Commitment>(),
+		std::vector<ParsedCommitment>(),
 		outputCommitments,
 		excessCommitments,
 		overage,
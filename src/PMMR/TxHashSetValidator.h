@@ -17,7 +17,17 @@ class TxHashSetValidator
 public:
 	TxHashSetValidator(const IBlockChainServer& blockChainServer);
 
-	std::unique_ptr<BlockSums> Validate(TxHashSet& txHashSet, const BlockHeader& blockHeader, SyncStatus& syncStatus) const;
+	//
+	// Validates the entire TxHashSet. When validateKernels is false, the checks performed by ValidateKernelMMR are skipped,
+	// since they were already performed while the rest of the TxHashSet was still being received.
+	//
+	std::unique_ptr<BlockSums> Validate(TxHashSet& txHashSet, const BlockHeader& blockHeader, SyncStatus& syncStatus, const bool validateKernels = true) const;
+
+	//
+	// Validates the size, hashes, root, history and signatures of the kernel MMR.
+	// These checks don't depend on the output or rangeproof MMRs.
+	//
+	bool ValidateKernelMMR(std::shared_ptr<const KernelMMR> pKernelMMR, const BlockHeader& blockHeader, SyncStatus& syncStatus) const;
 
 private:
 	bool ValidateSizes(TxHashSet& txHashSet, const BlockHeader& blockHeader) const;
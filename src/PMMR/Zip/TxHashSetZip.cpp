@@ -18,14 +18,13 @@ bool TxHashSetZip::Extract(const fs::path& path, const BlockHeader& header) cons
 	{
 		std::shared_ptr<ZipFile> pZipFile = ZipFile::Load(path);
 
-		// Extract kernel folder.
-		ExtractKernelFolder(*pZipFile);
+		FileList files;
+		PrepareKernelFolder(files);
+		PrepareFolder("output", header, files);
+		PrepareFolder("rangeproof", header, files);
 
-		// Extract output folder.
-		ExtractFolder(*pZipFile, "output", header);
-
-		// Extract rangeProof folder.
-		ExtractFolder(*pZipFile, "rangeproof", header);
+		// The entries are independent, so they're inflated concurrently.
+		pZipFile->ExtractFiles(files);
 
 		LOG_INFO("Successfully extracted zip file.");
 		return true;
@@ -38,7 +37,7 @@ bool TxHashSetZip::Extract(const fs::path& path, const BlockHeader& header) cons
 	return false;
 }
 
-void TxHashSetZip::ExtractKernelFolder(const ZipFile& zipFile) const
+void TxHashSetZip::PrepareKernelFolder(FileList& files) const
 {
 	std::error_code ec;
 
@@ -73,11 +72,11 @@ void TxHashSetZip::ExtractKernelFolder(const ZipFile& zipFile) const
 	const std::vector<std::string> kernelFiles = { "pmmr_data.bin", "pmmr_hash.bin" };
 	for (const std::string& file : kernelFiles)
 	{
-		zipFile.ExtractFile("kernel/" + file, kernelPath / file);
+		files.push_back({ "kernel/" + file, kernelPath / file });
 	}
 }
 
-void TxHashSetZip::ExtractFolder(const ZipFile& zipFile, const std::string& folderName, const BlockHeader& header) const
+void TxHashSetZip::PrepareFolder(const std::string& folderName, const BlockHeader& header, FileList& files) const
 {
 	std::error_code ec;
 
@@ -109,11 +108,10 @@ void TxHashSetZip::ExtractFolder(const ZipFile& zipFile, const std::string& fold
 		throw FILE_EXCEPTION_F("Failed to create {}. Error: {}", dir, ec.message());
 	}
 
-	const std::vector<std::string> files = { "pmmr_data.bin", "pmmr_hash.bin", "pmmr_prun.bin", "pmmr_leaf.bin." + header.ShortHash() };
-	for (const std::string& file : files)
+	for (const std::string file : { "pmmr_data.bin", "pmmr_hash.bin", "pmmr_prun.bin" })
 	{
-		zipFile.ExtractFile(StringUtil::Format("{}/{}", folderName, file), dir / file);
+		files.push_back({ StringUtil::Format("{}/{}", folderName, file), dir / file });
 	}
 
-	FileUtil::RenameFile(dir / StringUtil::Format("pmmr_leaf.bin.{}", header.ShortHash()), dir / "pmmr_leaf.bin");
+	files.push_back({ StringUtil::Format("{}/pmmr_leaf.bin.{}", folderName, header.ShortHash()), dir / "pmmr_leaf.bin" });
 }
\ No newline at end of file
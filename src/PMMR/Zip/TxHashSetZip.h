@@ -3,6 +3,8 @@
 #include <Core/Models/BlockHeader.h>
 #include <Config/Config.h>
 #include <filesystem.h>
+#include <utility>
+#include <vector>
 
 // Forward Declarations
 class ZipFile;
@@ -15,8 +17,11 @@ public:
 	bool Extract(const fs::path& path, const BlockHeader& header) const;
 
 private:
-	void ExtractKernelFolder(const ZipFile& zipFile) const;
-	void ExtractFolder(const ZipFile& zipFile, const std::string& folderName, const BlockHeader& header) const;
+	typedef std::vector<std::pair<std::string, fs::path>> FileList;
+
+	// Recreates the folder, and appends its files to the list of files to extract.
+	void PrepareKernelFolder(FileList& files) const;
+	void PrepareFolder(const std::string& folderName, const BlockHeader& header, FileList& files) const;
 	void ExtractOutputFolder(const ZipFile& zipFile, const BlockHeader& header) const;
 	void ExtractRangeProofFolder(const ZipFile& zipFile, const BlockHeader& header) const;
 
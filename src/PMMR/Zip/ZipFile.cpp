@@ -2,7 +2,56 @@
 
 #include <Core/Exceptions/FileException.h>
 #include <Infrastructure/Logger.h>
+#include <scheduler/ctpl_stl.h>
+#include <algorithm>
 #include <fstream>
+#include <future>
+#include <thread>
+
+#ifdef __linux__
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+static const size_t EXTRACT_BUFFER_SIZE = 256 * 1024;
+
+// Reserves the uncompressed size up front, so the large PMMR files aren't fragmented
+// while several of them are being written at once.
+static void Preallocate(const fs::path& destination, const uint64_t size)
+{
+#ifdef __linux__
+	const int fd = open(destination.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+	{
+		LOG_WARNING_F("Failed to create destination ({}).", destination);
+		throw FILE_EXCEPTION_F("Failed to create destination ({})", destination);
+	}
+
+	if (size > 0 && fallocate(fd, 0, 0, (off_t)size) != 0)
+	{
+		// Not supported by every filesystem. The file will just grow as it's written.
+		LOG_DEBUG_F("fallocate failed for ({}). Error: {}", destination, errno);
+	}
+
+	close(fd);
+#else
+	std::ofstream file(destination, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		LOG_WARNING_F("Failed to create destination ({}).", destination);
+		throw FILE_EXCEPTION_F("Failed to create destination ({})", destination);
+	}
+
+	file.close();
+
+	std::error_code ec;
+	fs::resize_file(destination, size, ec);
+	if (ec)
+	{
+		LOG_DEBUG_F("Failed to preallocate ({}). Error: {}", destination, ec.message());
+	}
+#endif
+}
 
 ZipFile::ZipFile(const fs::path& zipFilePath, const unzFile& file)
 	: m_zipFilePath(zipFilePath), m_unzFile(file)
@@ -35,6 +84,15 @@ void ZipFile::ExtractFile(const std::string& path, const fs::path& destination)
 		throw FILE_EXCEPTION("File not found");
 	}
 
+	unz_file_info64 fileInfo;
+	if (unzGetCurrentFileInfo64(m_unzFile, &fileInfo, NULL, 0, NULL, 0, NULL, 0) != UNZ_OK)
+	{
+		LOG_INFO_F("Failed to read info for path ({}) in zip file ({}).", path, m_zipFilePath);
+		throw FILE_EXCEPTION("Failed to read file info");
+	}
+
+	Preallocate(destination, fileInfo.uncompressed_size);
+
 	int openResult = unzOpenCurrentFile(m_unzFile);
 	if (openResult != UNZ_OK)
 	{
@@ -42,23 +100,72 @@ void ZipFile::ExtractFile(const std::string& path, const fs::path& destination)
 		throw FILE_EXCEPTION("Failed to open file");
 	}
 
-	std::ofstream destinationFile(destination, std::ios::out | std::ios::binary | std::ios::ate);
+	// Opened without truncating, so the preallocated blocks are kept.
+	std::fstream destinationFile(destination, std::ios::in | std::ios::out | std::ios::binary);
 	if (!destinationFile.is_open())
 	{
+		unzCloseCurrentFile(m_unzFile);
 		LOG_WARNING_F("Failed to write to destination ({}).", destination);
 		throw FILE_EXCEPTION("Failed to write to destination");
 	}
 
-	unsigned char buffer[256];
+	std::vector<unsigned char> buffer(EXTRACT_BUFFER_SIZE);
 	int readSize;
-	while ((readSize = unzReadCurrentFile(m_unzFile, &buffer, 256)) > 0)
+	while ((readSize = unzReadCurrentFile(m_unzFile, buffer.data(), (unsigned int)buffer.size())) > 0)
 	{
-		destinationFile.write((const char*)&buffer[0], readSize);
+		destinationFile.write((const char*)buffer.data(), readSize);
 	}
 
 	destinationFile.close();
 
-	unzCloseCurrentFile(m_unzFile);
+	// unzCloseCurrentFile verifies the CRC once the whole file has been read.
+	const int closeResult = unzCloseCurrentFile(m_unzFile);
+	if (readSize < 0 || closeResult != UNZ_OK || destinationFile.fail())
+	{
+		LOG_ERROR_F("Failed to extract path ({}) from zip file ({}). Read: {}, Close: {}", path, m_zipFilePath, readSize, closeResult);
+		throw FILE_EXCEPTION_F("Failed to extract {}", path);
+	}
+}
+
+void ZipFile::ExtractFiles(const std::vector<std::pair<std::string, fs::path>>& files) const
+{
+	if (files.empty())
+	{
+		return;
+	}
+
+	const size_t numWorkers = (std::min)(files.size(), (size_t)(std::max)(1u, std::thread::hardware_concurrency()));
+	ctpl::thread_pool workers((int)numWorkers);
+
+	std::vector<std::future<void>> tasks;
+	for (const auto& file : files)
+	{
+		tasks.push_back(workers.push([this, &file](int) {
+			ZipFile::Load(m_zipFilePath)->ExtractFile(file.first, file.second);
+		}));
+	}
+
+	// Wait for every task before rethrowing, so nothing is still writing when the caller cleans up.
+	std::exception_ptr pException = nullptr;
+	for (auto& task : tasks)
+	{
+		try
+		{
+			task.get();
+		}
+		catch (...)
+		{
+			if (pException == nullptr)
+			{
+				pException = std::current_exception();
+			}
+		}
+	}
+
+	if (pException != nullptr)
+	{
+		std::rethrow_exception(pException);
+	}
 }
 
 std::vector<std::string> ZipFile::ListFiles() const
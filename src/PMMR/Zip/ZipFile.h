@@ -9,6 +9,7 @@
 
 #include <filesystem.h>
 #include <string>
+#include <utility>
 #include <vector>
 #include <memory>
 
@@ -22,6 +23,13 @@ public:
 	~ZipFile();
 
 	void ExtractFile(const std::string& path, const fs::path& destination) const;
+
+	//
+	// Extracts each (path, destination) pair concurrently.
+	// Every worker opens its own handle to the zip file, since minizip handles can't be shared between threads.
+	// Throws a FileException if any of the files fail to extract.
+	//
+	void ExtractFiles(const std::vector<std::pair<std::string, fs::path>>& files) const;
 	std::vector<std::string> ListFiles() const;
 
 private:
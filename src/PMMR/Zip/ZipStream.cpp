@@ -0,0 +1,379 @@
+#include "ZipStream.h"
+
+#include <Core/Exceptions/FileException.h>
+#include <Infrastructure/Logger.h>
+#include <algorithm>
+#include <limits>
+
+static const uint32_t LOCAL_HEADER_SIGNATURE = 0x04034b50;
+static const uint32_t DESCRIPTOR_SIGNATURE = 0x08074b50;
+static const uint32_t CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+static const uint32_t END_OF_CENTRAL_DIR_SIGNATURE = 0x06054b50;
+
+static const size_t LOCAL_HEADER_SIZE = 30;
+static const uint16_t ENCRYPTED_FLAG = 0x0001;
+static const uint16_t DATA_DESCRIPTOR_FLAG = 0x0008;
+static const uint16_t METHOD_STORED = 0;
+static const uint16_t METHOD_DEFLATED = 8;
+static const uint16_t ZIP64_EXTRA_ID = 0x0001;
+static const uint32_t ZIP64_SIZE_MARKER = 0xFFFFFFFF;
+
+static const size_t INFLATE_BUFFER_SIZE = 256 * 1024;
+
+ZipStream::ZipStream(const PathResolver& resolver, const ExtractedCallback& onExtracted)
+	: m_resolver(resolver),
+	m_onExtracted(onExtracted),
+	m_state(EState::SIGNATURE),
+	m_headerSize(4),
+	m_entry{},
+	m_compressedRead(0),
+	m_uncompressedWritten(0),
+	m_crc(0),
+	m_inflater{},
+	m_inflating(false),
+	m_inflateBuffer(INFLATE_BUFFER_SIZE)
+{
+
+}
+
+ZipStream::~ZipStream()
+{
+	if (m_inflating)
+	{
+		inflateEnd(&m_inflater);
+	}
+}
+
+void ZipStream::Write(const uint8_t* pData, const size_t numBytes)
+{
+	size_t remaining = numBytes;
+	while (remaining > 0 && m_state != EState::COMPLETE)
+	{
+		const size_t consumed = (m_state == EState::DATA) ? ReadData(pData, remaining) : ReadHeader(pData, remaining);
+		pData += consumed;
+		remaining -= consumed;
+	}
+}
+
+size_t ZipStream::ReadHeader(const uint8_t* pData, const size_t numBytes)
+{
+	const size_t numToCopy = (std::min)(m_headerSize - m_header.size(), numBytes);
+	m_header.insert(m_header.end(), pData, pData + numToCopy);
+
+	while (m_state != EState::DATA && m_state != EState::COMPLETE && m_header.size() == m_headerSize)
+	{
+		ProcessHeader();
+	}
+
+	return numToCopy;
+}
+
+void ZipStream::ProcessHeader()
+{
+	switch (m_state)
+	{
+		case EState::SIGNATURE:
+		{
+			const uint32_t signature = ReadU32(0);
+			if (signature == LOCAL_HEADER_SIGNATURE)
+			{
+				ExpectHeader(EState::LOCAL_HEADER, LOCAL_HEADER_SIZE);
+			}
+			else if (signature == CENTRAL_HEADER_SIGNATURE || signature == END_OF_CENTRAL_DIR_SIGNATURE)
+			{
+				m_state = EState::COMPLETE;
+			}
+			else
+			{
+				throw FILE_EXCEPTION_F("Unexpected zip signature {}", signature);
+			}
+
+			break;
+		}
+		case EState::LOCAL_HEADER:
+		{
+			m_entry = Entry{};
+			m_entry.flags = ReadU16(6);
+			m_entry.method = ReadU16(8);
+			m_entry.crc = ReadU32(14);
+			m_entry.compressedSize = ReadU32(18);
+			m_entry.uncompressedSize = ReadU32(22);
+
+			const size_t nameLength = ReadU16(26);
+			const size_t extraLength = ReadU16(28);
+			ExpectHeader(EState::NAME_AND_EXTRA, LOCAL_HEADER_SIZE + nameLength + extraLength);
+			break;
+		}
+		case EState::NAME_AND_EXTRA:
+		{
+			const size_t nameLength = ReadU16(26);
+			m_entry.name = std::string((const char*)&m_header[LOCAL_HEADER_SIZE], nameLength);
+
+			// Sizes that don't fit in 32 bits are stored in the zip64 extra field instead.
+			size_t offset = LOCAL_HEADER_SIZE + nameLength;
+			while (offset + 4 <= m_header.size())
+			{
+				const uint16_t id = ReadU16(offset);
+				const size_t size = ReadU16(offset + 2);
+				const size_t end = (std::min)(offset + 4 + size, m_header.size());
+				if (id == ZIP64_EXTRA_ID)
+				{
+					m_entry.zip64 = true;
+
+					size_t position = offset + 4;
+					if (m_entry.uncompressedSize == ZIP64_SIZE_MARKER && position + 8 <= end)
+					{
+						m_entry.uncompressedSize = ReadU64(position);
+						position += 8;
+					}
+
+					if (m_entry.compressedSize == ZIP64_SIZE_MARKER && position + 8 <= end)
+					{
+						m_entry.compressedSize = ReadU64(position);
+					}
+				}
+
+				offset += 4 + size;
+			}
+
+			OpenEntry();
+			break;
+		}
+		case EState::DESCRIPTOR_SIGNATURE:
+		{
+			// The data descriptor's signature is optional.
+			const size_t sizesLength = m_entry.zip64 ? 16 : 8;
+			if (ReadU32(0) == DESCRIPTOR_SIGNATURE)
+			{
+				ExpectHeader(EState::DESCRIPTOR, 8 + sizesLength);
+			}
+			else
+			{
+				ExpectHeader(EState::DESCRIPTOR, 4 + sizesLength);
+			}
+
+			break;
+		}
+		case EState::DESCRIPTOR:
+		{
+			const size_t sizesLength = m_entry.zip64 ? 16 : 8;
+			const size_t offset = m_header.size() - (4 + sizesLength);
+
+			m_entry.crc = ReadU32(offset);
+			m_entry.compressedSize = m_entry.zip64 ? ReadU64(offset + 4) : ReadU32(offset + 4);
+			m_entry.uncompressedSize = m_entry.zip64 ? ReadU64(offset + 12) : ReadU32(offset + 8);
+			if (m_entry.compressedSize != m_compressedRead)
+			{
+				throw FILE_EXCEPTION_F("Compressed size of {} doesn't match its data descriptor", m_entry.name);
+			}
+
+			CloseEntry();
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+void ZipStream::OpenEntry()
+{
+	if ((m_entry.flags & ENCRYPTED_FLAG) != 0)
+	{
+		throw FILE_EXCEPTION_F("{} is encrypted", m_entry.name);
+	}
+
+	if (m_entry.method != METHOD_STORED && m_entry.method != METHOD_DEFLATED)
+	{
+		throw FILE_EXCEPTION_F("{} uses unsupported compression method {}", m_entry.name, m_entry.method);
+	}
+
+	if (m_entry.method == METHOD_STORED && (m_entry.flags & DATA_DESCRIPTOR_FLAG) != 0)
+	{
+		throw FILE_EXCEPTION_F("{} is stored without its size", m_entry.name);
+	}
+
+	m_entry.destination = m_resolver(m_entry.name);
+	if (m_entry.destination.has_value())
+	{
+		m_file.open(m_entry.destination.value(), std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!m_file.is_open())
+		{
+			LOG_ERROR_F("Failed to open {}", m_entry.destination.value());
+			throw FILE_EXCEPTION_F("Failed to open {}", m_entry.destination.value());
+		}
+	}
+
+	m_compressedRead = 0;
+	m_uncompressedWritten = 0;
+	m_crc = crc32(0, Z_NULL, 0);
+	m_state = EState::DATA;
+
+	if (m_entry.method == METHOD_DEFLATED)
+	{
+		m_inflater = z_stream{};
+		if (inflateInit2(&m_inflater, -MAX_WBITS) != Z_OK)
+		{
+			throw FILE_EXCEPTION_F("Failed to initialize inflater for {}", m_entry.name);
+		}
+
+		m_inflating = true;
+	}
+	else if (m_entry.compressedSize == 0)
+	{
+		EndData();
+	}
+}
+
+size_t ZipStream::ReadData(const uint8_t* pData, const size_t numBytes)
+{
+	if (m_entry.method == METHOD_DEFLATED)
+	{
+		return InflateData(pData, numBytes);
+	}
+
+	const size_t numToWrite = (size_t)(std::min)((uint64_t)numBytes, m_entry.compressedSize - m_compressedRead);
+	WriteOutput(pData, numToWrite);
+	m_compressedRead += numToWrite;
+
+	if (m_compressedRead == m_entry.compressedSize)
+	{
+		EndData();
+	}
+
+	return numToWrite;
+}
+
+size_t ZipStream::InflateData(const uint8_t* pData, const size_t numBytes)
+{
+	// Without a data descriptor, the compressed size is known up front.
+	// Otherwise, the end of the deflate stream marks the end of the entry.
+	const bool sizeKnown = (m_entry.flags & DATA_DESCRIPTOR_FLAG) == 0;
+
+	uint64_t available = (std::min)((uint64_t)numBytes, (uint64_t)(std::numeric_limits<uInt>::max)());
+	if (sizeKnown)
+	{
+		available = (std::min)(available, m_entry.compressedSize - m_compressedRead);
+	}
+
+	m_inflater.next_in = const_cast<Bytef*>(pData);
+	m_inflater.avail_in = (uInt)available;
+
+	int status = Z_OK;
+	do
+	{
+		m_inflater.next_out = m_inflateBuffer.data();
+		m_inflater.avail_out = (uInt)m_inflateBuffer.size();
+
+		status = inflate(&m_inflater, Z_NO_FLUSH);
+		if (status != Z_OK && status != Z_STREAM_END && status != Z_BUF_ERROR)
+		{
+			throw FILE_EXCEPTION_F("Failed to inflate {}. Error: {}", m_entry.name, status);
+		}
+
+		WriteOutput(m_inflateBuffer.data(), m_inflateBuffer.size() - m_inflater.avail_out);
+	} while (status == Z_OK && (m_inflater.avail_in > 0 || m_inflater.avail_out == 0));
+
+	const size_t consumed = (size_t)(available - m_inflater.avail_in);
+	m_compressedRead += consumed;
+
+	if (status == Z_STREAM_END)
+	{
+		if (sizeKnown && m_compressedRead != m_entry.compressedSize)
+		{
+			throw FILE_EXCEPTION_F("Deflate stream for {} ended early", m_entry.name);
+		}
+
+		EndData();
+	}
+	else if (consumed == 0 || (sizeKnown && m_compressedRead == m_entry.compressedSize))
+	{
+		throw FILE_EXCEPTION_F("Deflate stream for {} is truncated", m_entry.name);
+	}
+
+	return consumed;
+}
+
+void ZipStream::EndData()
+{
+	if (m_inflating)
+	{
+		inflateEnd(&m_inflater);
+		m_inflating = false;
+	}
+
+	if ((m_entry.flags & DATA_DESCRIPTOR_FLAG) != 0)
+	{
+		m_header.clear();
+		ExpectHeader(EState::DESCRIPTOR_SIGNATURE, 4);
+	}
+	else
+	{
+		CloseEntry();
+	}
+}
+
+void ZipStream::CloseEntry()
+{
+	if (m_file.is_open())
+	{
+		m_file.close();
+		if (m_file.fail())
+		{
+			throw FILE_EXCEPTION_F("Failed to write {}", m_entry.name);
+		}
+	}
+
+	if (m_crc != m_entry.crc || m_uncompressedWritten != m_entry.uncompressedSize)
+	{
+		throw FILE_EXCEPTION_F("CRC or size mismatch for {}", m_entry.name);
+	}
+
+	if (m_entry.destination.has_value())
+	{
+		m_onExtracted(m_entry.name);
+	}
+
+	m_header.clear();
+	ExpectHeader(EState::SIGNATURE, 4);
+}
+
+void ZipStream::WriteOutput(const uint8_t* pData, const size_t numBytes)
+{
+	if (numBytes == 0)
+	{
+		return;
+	}
+
+	m_crc = crc32_z(m_crc, pData, numBytes);
+	m_uncompressedWritten += numBytes;
+
+	if (m_file.is_open())
+	{
+		m_file.write((const char*)pData, numBytes);
+		if (m_file.fail())
+		{
+			throw FILE_EXCEPTION_F("Failed to write {}", m_entry.name);
+		}
+	}
+}
+
+void ZipStream::ExpectHeader(const EState state, const size_t headerSize)
+{
+	m_state = state;
+	m_headerSize = headerSize;
+}
+
+uint16_t ZipStream::ReadU16(const size_t offset) const
+{
+	return (uint16_t)(m_header[offset] | (m_header[offset + 1] << 8));
+}
+
+uint32_t ZipStream::ReadU32(const size_t offset) const
+{
+	return (uint32_t)ReadU16(offset) | ((uint32_t)ReadU16(offset + 2) << 16);
+}
+
+uint64_t ZipStream::ReadU64(const size_t offset) const
+{
+	return (uint64_t)ReadU32(offset) | ((uint64_t)ReadU32(offset + 4) << 32);
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <zlib.h>
+
+#include <filesystem.h>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+/*
+ * Extracts a zip archive as its bytes arrive, without needing the whole archive on disk first.
+ * Entries are read from their local file headers in the order they appear, and are inflated straight into their destination files.
+ * Supports stored and deflated entries, data descriptors and zip64 sizes.
+ * Everything after the first central directory header is ignored.
+ */
+class ZipStream
+{
+public:
+	// Returns the path an entry should be extracted to, or std::nullopt to skip it.
+	using PathResolver = std::function<std::optional<fs::path>(const std::string& entryName)>;
+
+	// Called once an entry has been completely extracted and its CRC has been verified.
+	using ExtractedCallback = std::function<void(const std::string& entryName)>;
+
+	ZipStream(const PathResolver& resolver, const ExtractedCallback& onExtracted);
+	~ZipStream();
+
+	//
+	// Extracts the next chunk of the archive.
+	// Throws a FileException if the archive is malformed, or a file can't be written.
+	//
+	void Write(const uint8_t* pData, const size_t numBytes);
+
+	//
+	// Returns true once every entry has been extracted.
+	//
+	bool IsComplete() const noexcept { return m_state == EState::COMPLETE; }
+
+private:
+	enum class EState
+	{
+		SIGNATURE,
+		LOCAL_HEADER,
+		NAME_AND_EXTRA,
+		DATA,
+		DESCRIPTOR_SIGNATURE,
+		DESCRIPTOR,
+		COMPLETE
+	};
+
+	struct Entry
+	{
+		std::string name;
+		uint16_t flags;
+		uint16_t method;
+		uint32_t crc;
+		uint64_t compressedSize;
+		uint64_t uncompressedSize;
+		bool zip64;
+		std::optional<fs::path> destination;
+	};
+
+	size_t ReadHeader(const uint8_t* pData, const size_t numBytes);
+	void ProcessHeader();
+	void OpenEntry();
+	size_t ReadData(const uint8_t* pData, const size_t numBytes);
+	size_t InflateData(const uint8_t* pData, const size_t numBytes);
+	void EndData();
+	void CloseEntry();
+	void WriteOutput(const uint8_t* pData, const size_t numBytes);
+
+	void ExpectHeader(const EState state, const size_t headerSize);
+	uint16_t ReadU16(const size_t offset) const;
+	uint32_t ReadU32(const size_t offset) const;
+	uint64_t ReadU64(const size_t offset) const;
+
+	PathResolver m_resolver;
+	ExtractedCallback m_onExtracted;
+
+	EState m_state;
+	std::vector<uint8_t> m_header;
+	size_t m_headerSize;
+
+	Entry m_entry;
+	uint64_t m_compressedRead;
+	uint64_t m_uncompressedWritten;
+	uint32_t m_crc;
+	std::ofstream m_file;
+
+	z_stream m_inflater;
+	bool m_inflating;
+	std::vector<uint8_t> m_inflateBuffer;
+};
@@ -1,14 +1,37 @@
 #include "Zipper.h"
 
 #include <Common/Util/FileUtil.h>
-#include <Core/File/File.h>
 #include <Core/Exceptions/FileException.h>
 #include <Infrastructure/Logger.h>
+#include <scheduler/ctpl_stl.h>
+#include <algorithm>
+#include <deque>
 #include <fstream>
+#include <future>
+#include <thread>
 #include <filesystem.h>
 
+static const size_t CHUNK_SIZE = 1024 * 1024;
+
+// Hashes and rangeproofs are effectively random, so deflate can't shrink them.
+// If the first chunk doesn't compress to below this fraction, the entry is stored instead.
+static const double MIN_COMPRESSION_RATIO = 0.9;
+
 void Zipper::CreateZipFile(const fs::path& destination, const std::vector<fs::path>& paths)
 {
+	std::vector<Entry> entries;
+	for (size_t i = 0; i < paths.size(); i++)
+	{
+		if (fs::is_directory(paths[i]))
+		{
+			AddDirectory(entries, paths[i], paths[i].filename());
+		}
+		else
+		{
+			AddFile(entries, paths[i], destination);
+		}
+	}
+
 	zipFile zf = zipOpen(destination.u8string().c_str(), APPEND_STATUS_CREATE);
 	if (zf == nullptr)
 	{
@@ -18,16 +41,34 @@ void Zipper::CreateZipFile(const fs::path& destination, const std::vector<fs::pa
 
 	try
 	{
-		for (size_t i = 0; i < paths.size(); i++)
+		// Entries are compressed ahead of the writer, but no more than one per worker,
+		// so only a bounded number of compressed entries are held in memory at once.
+		const size_t numWorkers = (std::max)((size_t)1, (std::min)(entries.size(), (size_t)std::thread::hardware_concurrency()));
+		ctpl::thread_pool workers((int)numWorkers);
+
+		std::deque<std::future<CompressedEntry>> pending;
+		size_t nextEntry = 0;
+		auto compressNext = [&entries, &workers, &pending, &nextEntry]() {
+			const Entry& entry = entries[nextEntry++];
+			pending.push_back(workers.push([&entry](int) { return Compress(entry); }));
+		};
+
+		while (nextEntry < entries.size() && pending.size() < numWorkers)
 		{
-			if (fs::is_directory(paths[i]))
-			{
-				AddDirectory(zf, paths[i], paths[i].filename());
-			}
-			else
+			compressNext();
+		}
+
+		for (const Entry& entry : entries)
+		{
+			const CompressedEntry compressed = pending.front().get();
+			pending.pop_front();
+
+			if (nextEntry < entries.size())
 			{
-				AddFile(zf, paths[i], destination);
+				compressNext();
 			}
+
+			WriteEntry(zf, entry, compressed);
 		}
 	}
 	catch (std::exception& e)
@@ -44,51 +85,149 @@ void Zipper::CreateZipFile(const fs::path& destination, const std::vector<fs::pa
 	}
 }
 
-void Zipper::AddDirectory(zipFile zf, const fs::path& sourceDir, const fs::path& destDir)
+void Zipper::AddDirectory(std::vector<Entry>& entries, const fs::path& sourceDir, const fs::path& destDir)
 {
 	for (const auto& entry : fs::directory_iterator(sourceDir))
 	{
 		if (fs::is_directory(entry))
 		{
-			AddDirectory(zf, entry, destDir / entry.path().filename());
+			AddDirectory(entries, entry, destDir / entry.path().filename());
 		}
 		else
 		{
-			AddFile(zf, entry.path().string(), destDir);
+			AddFile(entries, entry.path().string(), destDir);
 		}
 	}
 }
 
-void Zipper::AddFile(zipFile zf, const fs::path& sourceFile, const fs::path& destDir)
+void Zipper::AddFile(std::vector<Entry>& entries, const fs::path& sourceFile, const fs::path& destDir)
+{
+	entries.push_back(Entry{ sourceFile, (destDir / sourceFile.filename()).string() });
+}
+
+Zipper::CompressedEntry Zipper::Compress(const Entry& entry)
 {
-	File pFile = File::Load(sourceFile, std::ios::binary | std::ios::in);
-	if (pFile->is_open())
+	std::ifstream file(entry.sourceFile, std::ios::in | std::ios::binary);
+	if (!file.is_open())
+	{
+		throw FILE_EXCEPTION_F("Failed to add file {}", entry.sourceFile);
+	}
+
+	CompressedEntry compressed{ Z_DEFLATED, 0, crc32(0L, Z_NULL, 0), {} };
+
+	z_stream stream{};
+	if (deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
 	{
-		size_t size = FileUtil::GetFileSize(sourceFile);
-		pFile->seekg(0, std::ios::beg);
+		throw FILE_EXCEPTION_F("Failed to initialize deflate for {}", entry.sourceFile);
+	}
 
-		std::vector<char> buffer(size);
-		if (size == 0 || pFile->read(&buffer[0], size))
+	std::vector<uint8_t> input(CHUNK_SIZE);
+	std::vector<uint8_t> output(CHUNK_SIZE);
+	int result = Z_OK;
+	bool firstChunk = true;
+	while (result != Z_STREAM_END)
+	{
+		file.read((char*)input.data(), input.size());
+		const size_t bytesRead = (size_t)file.gcount();
+		if (file.bad())
 		{
-			zip_fileinfo zfi;
-			fs::path fileName = destDir / sourceFile.filename();
+			deflateEnd(&stream);
+			throw FILE_EXCEPTION_F("Failed to read file {}", entry.sourceFile);
+		}
 
-			if (ZIP_OK == zipOpenNewFileInZip(zf, fileName.string().c_str(), &zfi, nullptr, 0, nullptr, 0, nullptr, 0, Z_NO_COMPRESSION))
-			{
-				if (zipWriteInFileInZip(zf, size == 0 ? "" : buffer.data(), (unsigned int)size))
-				{
-					throw FILE_EXCEPTION_F("Failed to write to file {}", fileName);
-				}
+		compressed.size += bytesRead;
+		compressed.crc = crc32_z(compressed.crc, input.data(), bytesRead);
 
-				if (zipCloseFileInZip(zf))
-				{
-					throw FILE_EXCEPTION_F("Failed to close file {}", fileName);
-				}
+		if (compressed.method == Z_NO_COMPRESSION)
+		{
+			// Still read to the end, since the stored entry needs the CRC.
+			result = file.eof() ? Z_STREAM_END : Z_OK;
+			continue;
+		}
 
-				return;
+		// The first chunk is flushed so its compressed size can be measured.
+		const int flush = file.eof() ? Z_FINISH : (firstChunk ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+		stream.next_in = input.data();
+		stream.avail_in = (uInt)bytesRead;
+		do
+		{
+			stream.next_out = output.data();
+			stream.avail_out = (uInt)output.size();
+			result = deflate(&stream, flush);
+			if (result == Z_STREAM_ERROR)
+			{
+				deflateEnd(&stream);
+				throw FILE_EXCEPTION_F("Failed to compress {}", entry.sourceFile);
 			}
+
+			compressed.data.insert(compressed.data.end(), output.data(), output.data() + (output.size() - stream.avail_out));
+		} while (stream.avail_out == 0);
+
+		if (firstChunk && stream.total_out > stream.total_in * MIN_COMPRESSION_RATIO)
+		{
+			LOG_TRACE_F("{} is incompressible. Storing it instead.", entry.name);
+			compressed.method = Z_NO_COMPRESSION;
+			compressed.data.clear();
+			compressed.data.shrink_to_fit();
 		}
+
+		firstChunk = false;
 	}
 
-	throw FILE_EXCEPTION_F("Failed to add file {}", destDir);
-}
\ No newline at end of file
+	deflateEnd(&stream);
+	return compressed;
+}
+
+void Zipper::WriteEntry(zipFile zf, const Entry& entry, const CompressedEntry& compressed)
+{
+	zip_fileinfo zfi{};
+	const int zip64 = compressed.size >= 0xffffffff ? 1 : 0;
+	const int level = compressed.method == Z_DEFLATED ? Z_BEST_SPEED : Z_NO_COMPRESSION;
+
+	// Opened raw, since the data was already compressed (or is stored as is).
+	if (ZIP_OK != zipOpenNewFileInZip2_64(zf, entry.name.c_str(), &zfi, nullptr, 0, nullptr, 0, nullptr, compressed.method, level, 1, zip64))
+	{
+		throw FILE_EXCEPTION_F("Failed to add file {}", entry.name);
+	}
+
+	auto write = [zf, &entry](const uint8_t* pData, const size_t numBytes) {
+		if (zipWriteInFileInZip(zf, numBytes == 0 ? (const void*)"" : pData, (unsigned int)numBytes))
+		{
+			throw FILE_EXCEPTION_F("Failed to write to file {}", entry.name);
+		}
+	};
+
+	if (compressed.method == Z_DEFLATED)
+	{
+		for (size_t offset = 0; offset < compressed.data.size(); offset += CHUNK_SIZE)
+		{
+			write(compressed.data.data() + offset, (std::min)(CHUNK_SIZE, compressed.data.size() - offset));
+		}
+	}
+	else
+	{
+		std::ifstream file(entry.sourceFile, std::ios::in | std::ios::binary);
+		if (!file.is_open())
+		{
+			throw FILE_EXCEPTION_F("Failed to add file {}", entry.sourceFile);
+		}
+
+		std::vector<uint8_t> buffer(CHUNK_SIZE);
+		uint64_t bytesWritten = 0;
+		while (file.read((char*)buffer.data(), buffer.size()) || file.gcount() > 0)
+		{
+			write(buffer.data(), (size_t)file.gcount());
+			bytesWritten += (uint64_t)file.gcount();
+		}
+
+		if (bytesWritten != compressed.size)
+		{
+			throw FILE_EXCEPTION_F("File {} changed while being zipped", entry.sourceFile);
+		}
+	}
+
+	if (zipCloseFileInZipRaw64(zf, compressed.size, compressed.crc))
+	{
+		throw FILE_EXCEPTION_F("Failed to close file {}", entry.name);
+	}
+}
@@ -6,12 +6,36 @@
 #include <vector>
 #include <string>
 
+//
+// Creates zip files from files and directories.
+// Entries are compressed concurrently, and written to the zip file in the order they were found,
+// so the kernel files still come first when the kernel folder is passed first.
+//
 class Zipper
 {
 public:
 	static void CreateZipFile(const fs::path& destination, const std::vector<fs::path>& paths);
 
 private:
-	static void AddDirectory(zipFile zf, const fs::path& sourceDir, const fs::path& destDir);
-	static void AddFile(zipFile zf, const fs::path& sourceFile, const fs::path& destDir);
-};
\ No newline at end of file
+	struct Entry
+	{
+		fs::path sourceFile;
+		std::string name;
+	};
+
+	struct CompressedEntry
+	{
+		int method;
+		uint64_t size;
+		uLong crc;
+
+		// Only populated for deflated entries. Stored entries are copied from the source file when written.
+		std::vector<uint8_t> data;
+	};
+
+	static void AddDirectory(std::vector<Entry>& entries, const fs::path& sourceDir, const fs::path& destDir);
+	static void AddFile(std::vector<Entry>& entries, const fs::path& sourceFile, const fs::path& destDir);
+
+	static CompressedEntry Compress(const Entry& entry);
+	static void WriteEntry(zipFile zf, const Entry& entry, const CompressedEntry& compressed);
+};
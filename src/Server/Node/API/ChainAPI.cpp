@@ -75,46 +75,50 @@ int ChainAPI::GetChainOutputsByHeight_Handler(struct mg_connection* conn, void*
 			endHeight = startHeight;
 		}
 
-		Json::Value json;
-
-		std::vector<BlockWithOutputs> blocksWithOutputs = pServer->m_pBlockChainServer->GetOutputsByHeight(startHeight, endHeight);
-		for (const BlockWithOutputs& block : blocksWithOutputs)
-		{
-			/*
-
-			"header": {
-			  "hash": "40adad0aec27797b48840aa9e00472015c21baea118ce7a2ff1a82c0f8f5bf82",
-			  "height": 0,
-			  "previous": "0000000000000000000000000000000000000000000000000000000000000000"
-			},
-			"outputs": [
-			  {
-				"output_type": "Coinbase",
-				"commit": "08b7e57c448db5ef25aa119dde2312c64d7ff1b890c416c6dda5ec73cbfed2edea",
-				"spent": false,
-				"proof": null,
-				"proof_hash": "6c301688d9186c3a99444f827bdfe3b858fe87fc314737a4dc1155d9884491d2",
-				"block_height": 0,
-				"merkle_proof": "00000000000000010000000000000000",
-				"mmr_index": 1
-			  }
-			]
-			*/
-			Json::Value blockJSON;
-			blockJSON["header"] = block.GetBlockIdentifier().ToJSON();
-
-			Json::Value outputsJSON;
-			for (const OutputDTO& output : block.GetOutputs())
+		// The chain lock is released once the cursor is created, so a wide range doesn't stall block processing.
+		// Each page is written to the connection before the next one is read.
+		OutputsByHeightCursor::UPtr pCursor = pServer->m_pBlockChainServer->GetOutputsByHeightCursor(startHeight, endHeight);
+		return HTTPUtil::BuildSuccessResponseStream(conn, [&pCursor](JsonStreamWriter& writer) {
+			writer.BeginArray();
+			while (pCursor->HasNext())
 			{
-				outputsJSON.append(output.ToJSON());
-			}
-
-			blockJSON["outputs"] = outputsJSON;
-
-			json.append(blockJSON);
-		}
+				for (const BlockWithOutputs& block : pCursor->NextPage(OutputsByHeightCursor::DEFAULT_PAGE_SIZE))
+				{
+					/*
+
+					"header": {
+					  "hash": "40adad0aec27797b48840aa9e00472015c21baea118ce7a2ff1a82c0f8f5bf82",
+					  "height": 0,
+					  "previous": "0000000000000000000000000000000000000000000000000000000000000000"
+					},
+					"outputs": [
+					  {
+						"output_type": "Coinbase",
+						"commit": "08b7e57c448db5ef25aa119dde2312c64d7ff1b890c416c6dda5ec73cbfed2edea",
+						"spent": false,
+						"proof": null,
+						"proof_hash": "6c301688d9186c3a99444f827bdfe3b858fe87fc314737a4dc1155d9884491d2",
+						"block_height": 0,
+						"merkle_proof": "00000000000000010000000000000000",
+						"mmr_index": 1
+					  }
+					]
+					*/
+					writer.BeginObject();
+					writer.Key("header").Value(block.GetBlockIdentifier().ToJSON());
+
+					writer.Key("outputs").BeginArray();
+					for (const OutputDTO& output : block.GetOutputs())
+					{
+						writer.Value(output.ToJSON());
+					}
+					writer.EndArray();
 
-		return HTTPUtil::BuildSuccessResponse(conn, json.toStyledString());
+					writer.EndObject();
+				}
+			}
+			writer.EndArray();
+		});
 	}
 	catch (std::exception& e)
 	{
@@ -123,13 +127,47 @@ int ChainAPI::GetChainOutputsByHeight_Handler(struct mg_connection* conn, void*
 	}
 }
 
+// Every id in a request is resolved while holding the chain state's read lock, so the batch size is bounded.
+static const size_t MAX_OUTPUT_IDS = 1'000;
+
+//
+// GET /v1/chain/outputs/byids?id=xxx,yyy,zzz
+// POST /v1/chain/outputs/byids with body { "ids": ["xxx", "yyy", "zzz"] }
+//
+// Both look up every id against the same chain state, and reject requests with more than MAX_OUTPUT_IDS ids.
+// POST also returns the confirmed height of that state, and takes its ids in the body, so large batches don't hit URL limits.
+//
 int ChainAPI::GetChainOutputsByIds_Handler(struct mg_connection* conn, void* pNodeContext)
 {
 	NodeContext* pServer = (NodeContext*)pNodeContext;
 
 	try
 	{
-		std::vector<std::string> ids;
+		if (HTTPUtil::GetHTTPMethod(conn) == HTTP::EHTTPMethod::POST)
+		{
+			std::optional<Json::Value> bodyOpt = HTTPUtil::GetRequestBody(conn);
+			if (!bodyOpt.has_value())
+			{
+				return HTTPUtil::BuildBadRequestResponse(conn, "Expected { \"ids\": [...] }");
+			}
+
+			const Json::Value& ids = JsonUtil::GetRequiredField(bodyOpt.value(), "ids");
+			if (!ids.isArray() || ids.size() > MAX_OUTPUT_IDS)
+			{
+				return HTTPUtil::BuildBadRequestResponse(conn, StringUtil::Format("Expected an array of at most {} ids", MAX_OUTPUT_IDS));
+			}
+
+			std::vector<Commitment> commitments;
+			for (const Json::Value& id : ids)
+			{
+				commitments.push_back(JsonUtil::ConvertToCommitment(id));
+			}
+
+			const OutputLocations locations = pServer->m_pBlockChainServer->GetOutputLocations(commitments);
+			return HTTPUtil::BuildSuccessResponseJSON(conn, locations.ToJSON());
+		}
+
+		std::vector<Commitment> commitments;
 		const std::string queryString = HTTPUtil::GetQueryString(conn);
 		if (!queryString.empty())
 		{
@@ -141,31 +179,33 @@ int ChainAPI::GetChainOutputsByIds_Handler(struct mg_connection* conn, void* pNo
 					std::vector<std::string> startIndexTokens = StringUtil::Split(token, "=");
 					if (startIndexTokens.size() != 2)
 					{
-						return HTTPUtil::BuildBadRequestResponse(conn, "Expected /v1/txhashset/outputs?start_index=1&max=100");
+						return HTTPUtil::BuildBadRequestResponse(conn, "Expected /v1/chain/outputs/byids?id=xxx,yyy,zzz");
 					}
 
-					std::vector<std::string> tempIds = StringUtil::Split(startIndexTokens[1], ",");
-					ids.insert(ids.end(), tempIds.begin(), tempIds.end());
+					for (const std::string& id : StringUtil::Split(startIndexTokens[1], ","))
+					{
+						commitments.push_back(Commitment::FromHex(id));
+					}
 				}
 			}
 		}
 
-		std::shared_ptr<Locked<IBlockDB>> pBlockDB = pServer->m_pDatabase->GetBlockDB();
+		if (commitments.size() > MAX_OUTPUT_IDS)
+		{
+			return HTTPUtil::BuildBadRequestResponse(conn, StringUtil::Format("Expected at most {} ids", MAX_OUTPUT_IDS));
+		}
+
+		const OutputLocations locations = pServer->m_pBlockChainServer->GetOutputLocations(commitments);
 
 		Json::Value rootNode;
-		for (const std::string& id : ids)
+		for (const auto& entry : locations.GetLocations())
 		{
-			Commitment commitment = Commitment::FromHex(id);
-			std::unique_ptr<OutputLocation> pOutputPosition = pBlockDB->Read()->GetOutputPosition(commitment);
-			if (pOutputPosition != nullptr)
-			{
-				Json::Value outputNode;
-				outputNode["commit"] = commitment.Format();
-				outputNode["height"] = pOutputPosition->GetBlockHeight();
-				outputNode["mmr_index"] = pOutputPosition->GetMMRIndex() + 1;
+			Json::Value outputNode;
+			outputNode["commit"] = entry.first.ToHex();
+			outputNode["height"] = entry.second.GetBlockHeight();
+			outputNode["mmr_index"] = entry.second.GetMMRIndex() + 1;
 
-				rootNode.append(outputNode);
-			}
+			rootNode.append(outputNode);
 		}
 
 		return HTTPUtil::BuildSuccessResponse(conn, rootNode.toStyledString());
@@ -173,6 +213,6 @@ int ChainAPI::GetChainOutputsByIds_Handler(struct mg_connection* conn, void* pNo
 	catch (std::exception& e)
 	{
 		LOG_ERROR_F("Exception thrown: {}", e.what());
-		return HTTPUtil::BuildBadRequestResponse(conn, "Expected /v1/txhashset/outputs?start_index=1&max=100");
+		return HTTPUtil::BuildBadRequestResponse(conn, "Expected /v1/chain/outputs/byids?id=xxx,yyy,zzz");
 	}
 }
\ No newline at end of file
@@ -32,6 +32,7 @@ int ServerAPI::V1_Handler(struct mg_connection* conn, void*)
 		json.append("GET /v1/blocks/<output commit>?compact");
 		json.append("GET /v1/chain/");
 		json.append("GET /v1/chain/outputs/byids?id=xxx,yyy&id=zzz");
+		json.append("POST /v1/chain/outputs/byids {\"ids\": [\"xxx\", \"yyy\", \"zzz\"]}");
 		json.append("GET /v1/chain/outputs/byheight?start_height=100&end_height=200");
 		json.append("GET /v1/peers/all");
 		json.append("GET /v1/peers/connected");
@@ -65,15 +65,15 @@ int TxHashSetAPI::GetLastKernels_Handler(struct mg_connection* conn, void* pNode
 		auto pTxHashSet = pServer->m_pTxHashSetManager->GetTxHashSet();
 		if (pTxHashSet != nullptr)
 		{
-			Json::Value json;
-
-			std::vector<Hash> hashes = pTxHashSet->GetLastKernelHashes(numHashes);
-			for (const Hash& hash : hashes)
-			{
-				json.append(hash.ToHex());
-			}
-
-			return HTTPUtil::BuildSuccessResponse(conn, json.toStyledString());
+			const std::vector<Hash> hashes = pTxHashSet->GetLastKernelHashes(numHashes);
+			return HTTPUtil::BuildSuccessResponseStream(conn, [&hashes](JsonStreamWriter& writer) {
+				writer.BeginArray();
+				for (const Hash& hash : hashes)
+				{
+					writer.Value(hash.ToHex());
+				}
+				writer.EndArray();
+			});
 		}
 	}
 	catch (std::exception& e)
@@ -107,17 +107,15 @@ int TxHashSetAPI::GetLastOutputs_Handler(struct mg_connection* conn, void* pNode
 		auto pTxHashSet = pServer->m_pTxHashSetManager->GetTxHashSet();
 		if (pTxHashSet != nullptr)
 		{
-			Json::Value rootNode;
-
-			std::vector<Hash> hashes = pTxHashSet->GetLastOutputHashes(numHashes);
-			for (const Hash& hash : hashes)
-			{
-				Json::Value outputNode;
-				outputNode["hash"] = hash.ToHex();
-				rootNode.append(outputNode);
-			}
-
-			return HTTPUtil::BuildSuccessResponse(conn, rootNode.toStyledString());
+			const std::vector<Hash> hashes = pTxHashSet->GetLastOutputHashes(numHashes);
+			return HTTPUtil::BuildSuccessResponseStream(conn, [&hashes](JsonStreamWriter& writer) {
+				writer.BeginArray();
+				for (const Hash& hash : hashes)
+				{
+					writer.BeginObject().Key("hash").Value(hash.ToHex()).EndObject();
+				}
+				writer.EndArray();
+			});
 		}
 	}
 	catch (std::exception& e)
@@ -151,17 +149,15 @@ int TxHashSetAPI::GetLastRangeproofs_Handler(struct mg_connection* conn, void* p
 		auto pTxHashSet = pServer->m_pTxHashSetManager->GetTxHashSet();
 		if (pTxHashSet != nullptr)
 		{
-			Json::Value rootNode;
-
-			std::vector<Hash> hashes = pTxHashSet->GetLastRangeProofHashes(numHashes);
-			for (const Hash& hash : hashes)
-			{
-				Json::Value rangeProofNode;
-				rangeProofNode["hash"] = hash.ToHex();
-				rootNode.append(rangeProofNode);
-			}
-
-			return HTTPUtil::BuildSuccessResponse(conn, rootNode.toStyledString());
+			const std::vector<Hash> hashes = pTxHashSet->GetLastRangeProofHashes(numHashes);
+			return HTTPUtil::BuildSuccessResponseStream(conn, [&hashes](JsonStreamWriter& writer) {
+				writer.BeginArray();
+				for (const Hash& hash : hashes)
+				{
+					writer.BeginObject().Key("hash").Value(hash.ToHex()).EndObject();
+				}
+				writer.EndArray();
+			});
 		}
 	}
 	catch (std::exception& e)
@@ -236,36 +232,39 @@ int TxHashSetAPI::GetOutputs_Handler(struct mg_connection* conn, void* pNodeCont
 		auto pTxHashSet = pServer->m_pTxHashSetManager->GetTxHashSet();
 		if (pTxHashSet != nullptr)
 		{
-			Json::Value rootNode;
-
-			auto pBlockDB = pServer->m_pDatabase->GetBlockDB()->Read();
-			OutputRange range = pTxHashSet->GetOutputsByLeafIndex(pBlockDB.GetShared(), startIndex, max);
-			rootNode["highest_index"] = range.GetHighestIndex();
-			rootNode["last_retrieved_index"] = range.GetLastRetrievedIndex();
-
-			Json::Value outputsNode;
-			for (const OutputDTO& info : range.GetOutputs())
-			{
-				Json::Value outputNode;
-				const EOutputFeatures features = info.GetIdentifier().GetFeatures();
-				outputNode["output_type"] = OutputFeatures::ToString(info.GetIdentifier().GetFeatures());
-				outputNode["commit"] = info.GetIdentifier().GetCommitment().ToHex();
-				outputNode["spent"] = info.IsSpent();
-				outputNode["proof"] = info.GetRangeProof().Format();
-
-				Serializer proofSerializer;
-				info.GetRangeProof().Serialize(proofSerializer);
-				outputNode["proof_hash"] = Crypto::Blake2b(proofSerializer.GetBytes()).ToHex();
-
-				outputNode["block_height"] = info.GetLocation().GetBlockHeight();
-				outputNode["merkle_proof"] = Json::nullValue;
-				outputNode["mmr_index"] = info.GetLocation().GetMMRIndex() + 1;
-				outputsNode.append(outputNode);
-			}
-
-			rootNode["outputs"] = outputsNode;
+			// The block DB is only locked while the range is read, not while it's being sent.
+			const OutputRange range = pTxHashSet->GetOutputsByLeafIndex(
+				pServer->m_pDatabase->GetBlockDB()->Read().GetShared(),
+				startIndex,
+				max
+			);
+
+			return HTTPUtil::BuildSuccessResponseStream(conn, [&range](JsonStreamWriter& writer) {
+				writer.BeginObject();
+				writer.Key("highest_index").Value(range.GetHighestIndex());
+				writer.Key("last_retrieved_index").Value(range.GetLastRetrievedIndex());
+
+				writer.Key("outputs").BeginArray();
+				for (const OutputDTO& info : range.GetOutputs())
+				{
+					Serializer proofSerializer;
+					info.GetRangeProof().Serialize(proofSerializer);
+
+					writer.BeginObject();
+					writer.Key("output_type").Value(OutputFeatures::ToString(info.GetIdentifier().GetFeatures()));
+					writer.Key("commit").Value(info.GetIdentifier().GetCommitment().ToHex());
+					writer.Key("spent").Value(info.IsSpent());
+					writer.Key("proof").Value(info.GetRangeProof().Format());
+					writer.Key("proof_hash").Value(Crypto::Blake2b(proofSerializer.GetBytes()).ToHex());
+					writer.Key("block_height").Value(info.GetLocation().GetBlockHeight());
+					writer.Key("merkle_proof").Null();
+					writer.Key("mmr_index").Value(info.GetLocation().GetMMRIndex() + 1);
+					writer.EndObject();
+				}
+				writer.EndArray();
 
-			return HTTPUtil::BuildSuccessResponse(conn, rootNode.toStyledString());
+				writer.EndObject();
+			});
 		}
 	}
 	catch (std::exception& e)
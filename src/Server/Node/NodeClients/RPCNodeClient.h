@@ -74,7 +74,7 @@ public:
 		params.append(false);
 		params.append(false);
 
-		auto response = Invoke("get_outputs");
+		auto response = Invoke("get_outputs", params);
 
 		std::map<Commitment, OutputLocation> outputsByCommitment;
 		for (const auto& output : response)
@@ -89,6 +89,16 @@ public:
 		return outputsByCommitment;
 	}
 
+	//
+	// The node's API has no batch call that includes the height, so this takes two calls.
+	// The height is read after the outputs, so it's never lower than the height they were found at.
+	//
+	OutputLocations GetOutputLocations(const std::vector<Commitment>& commitments) const final
+	{
+		std::map<Commitment, OutputLocation> locations = GetOutputsByCommitment(commitments);
+		return OutputLocations(GetChainHeight(), std::move(locations));
+	}
+
 	//
 	// Returns a vector containing block ids and their outputs for the given range.
 	//
@@ -100,6 +110,56 @@ public:
 		throw UNIMPLEMENTED_EXCEPTION;
 	}
 
+	//
+	// Returns the outputs created and inputs spent by each confirmed block in the given range, in height order.
+	// Stops early at the first block that isn't available (ie. pruned), so callers must check what was returned.
+	//
+	std::vector<BlockDelta> GetBlockDeltas(const uint64_t startHeight, const uint64_t maxHeight) const final
+	{
+		std::vector<BlockDelta> deltas;
+		for (uint64_t height = startHeight; height <= maxHeight; height++)
+		{
+			Json::Value params(Json::arrayValue);
+			params.append(Json::UInt64(height));
+			params.append(Json::nullValue);
+			params.append(Json::nullValue);
+
+			// A block that can't be fetched or parsed ends the deltas there. The refresher then falls back to looking up every output.
+			try
+			{
+				const Json::Value block = Invoke("get_block", params);
+
+				const Json::Value header = JsonUtil::GetRequiredField(block, "header");
+				BlockIdentifier blockIdentifier(
+					JsonUtil::GetHash(header, "hash"),
+					JsonUtil::GetHash(header, "previous"),
+					JsonUtil::GetRequiredUInt64(header, "height")
+				);
+
+				std::vector<Commitment> created;
+				for (const Json::Value& output : block["outputs"])
+				{
+					created.push_back(JsonUtil::GetCommitment(output, "commit"));
+				}
+
+				// Rust nodes list inputs as bare commitments, while Grin++ includes their features.
+				std::vector<Commitment> spent;
+				for (const Json::Value& input : block["inputs"])
+				{
+					spent.push_back(input.isString() ? JsonUtil::ConvertToCommitment(input) : JsonUtil::GetCommitment(input, "commit"));
+				}
+
+				deltas.emplace_back(BlockDelta(std::move(blockIdentifier), std::move(created), std::move(spent)));
+			}
+			catch (std::exception&)
+			{
+				break;
+			}
+		}
+
+		return deltas;
+	}
+
 	//
 	// Returns a list of outputs starting at the given insertion index.
 	//
@@ -86,57 +86,45 @@ int OwnerGetAPI::RetrieveSummaryInfo(mg_connection* pConnection, IWalletManager&
 // GET /v1/wallet/owner/retrieve_txs?refresh&id=x
 int OwnerGetAPI::RetrieveTransactions(mg_connection* pConnection, IWalletManager& walletManager, const SessionToken& token)
 {
-	Json::Value rootJSON;
-
 	const std::optional<std::string> txIdOpt = HTTPUtil::GetQueryParam(pConnection, "id");
-
-	Json::Value transactionsJSON = Json::arrayValue;
+	const std::optional<uint64_t> txIdFilter = txIdOpt.has_value() ? std::make_optional(std::stoull(txIdOpt.value())) : std::nullopt;
 
 	ListTxsCriteria criteria(token, std::nullopt, std::nullopt, {});
 
-	if (txIdOpt.has_value())
-	{
-		const uint64_t txId = std::stoull(txIdOpt.value());
+	// TODO: Filter in walletManager for better performance
+	const std::vector<WalletTxDTO> transactions = walletManager.GetTransactions(criteria);
 
-		// TODO: Filter in walletManager for better performance
-		const std::vector<WalletTxDTO> transactions = walletManager.GetTransactions(criteria);
+	return HTTPUtil::BuildSuccessResponseStream(pConnection, [&transactions, &txIdFilter](JsonStreamWriter& writer) {
+		writer.BeginObject();
+		writer.Key("transactions").BeginArray();
 		for (const WalletTxDTO& transaction : transactions)
 		{
-			if (transaction.GetId() == txId)
+			if (!txIdFilter.has_value() || transaction.GetId() == txIdFilter.value())
 			{
-				transactionsJSON.append(transaction.ToJSON());
+				writer.Value(transaction.ToJSON());
 			}
 		}
-	}
-	else
-	{
-		const std::vector<WalletTxDTO> transactions = walletManager.GetTransactions(criteria);
-		for (const WalletTxDTO& transaction : transactions)
-		{
-			transactionsJSON.append(transaction.ToJSON());
-		}
-	}
-
-	rootJSON["transactions"] = transactionsJSON;
-	return HTTPUtil::BuildSuccessResponse(pConnection, rootJSON.toStyledString());
+		writer.EndArray();
+		writer.EndObject();
+	});
 }
 
 // GET /v1/wallet/owner/retrieve_outputs?show_spent&show_canceled
 int OwnerGetAPI::RetrieveOutputs(mg_connection* pConnection, IWalletManager& walletManager, const SessionToken& token)
 {
-	Json::Value rootJSON;
-
-	Json::Value outputsJSON = Json::arrayValue;
-
 	const bool includeSpent = HTTPUtil::HasQueryParam(pConnection, "show_spent");
 	const bool includeCanceled = HTTPUtil::HasQueryParam(pConnection, "show_canceled");
 
 	const std::vector<WalletOutputDTO> outputs = walletManager.GetOutputs(token, includeSpent, includeCanceled);
-	for (const WalletOutputDTO& output : outputs)
-	{
-		outputsJSON.append(output.ToJSON());
-	}
 
-	rootJSON["outputs"] = outputsJSON;
-	return HTTPUtil::BuildSuccessResponse(pConnection, rootJSON.toStyledString());
+	return HTTPUtil::BuildSuccessResponseStream(pConnection, [&outputs](JsonStreamWriter& writer) {
+		writer.BeginObject();
+		writer.Key("outputs").BeginArray();
+		for (const WalletOutputDTO& output : outputs)
+		{
+			writer.Value(output.ToJSON());
+		}
+		writer.EndArray();
+		writer.EndObject();
+	});
 }
\ No newline at end of file
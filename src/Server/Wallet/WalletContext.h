@@ -3,6 +3,7 @@
 #include <Config/Config.h>
 #include <Wallet/WalletManager.h>
 #include <Wallet/NodeClient.h>
+#include <Net/Servers/RequestLane.h>
 
 struct WalletContext
 {
@@ -10,11 +11,16 @@ struct WalletContext
 		const Config& config,
 		IWalletManagerPtr pWalletManager,
 		INodeClientPtr pNodeClient,
-		const TorProcess::Ptr& pTorProcess)
+		const TorProcess::Ptr& pTorProcess,
+		const size_t maxExpensiveRequests,
+		const size_t maxQueuedExpensiveRequests,
+		const uint32_t retryAfterSeconds)
 		: m_config(config),
 		m_pWalletManager(pWalletManager),
 		m_pNodeClient(pNodeClient),
-		m_pTorProcess(pTorProcess)
+		m_pTorProcess(pTorProcess),
+		m_expensiveLane(maxExpensiveRequests, maxQueuedExpensiveRequests),
+		m_retryAfterSeconds(retryAfterSeconds)
 	{
 
 	}
@@ -28,4 +34,6 @@ struct WalletContext
 	IWalletManagerPtr m_pWalletManager;
 	INodeClientPtr m_pNodeClient;
 	TorProcess::Ptr m_pTorProcess;
+	RequestLane m_expensiveLane;
+	uint32_t m_retryAfterSeconds;
 };
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "API/OwnerGetAPI.h"
 
 #include <civetweb.h>
+#include <Net/Servers/Server.h>
 #include <Net/Util/HTTPUtil.h>
 #include <Wallet/WalletDB/WalletStoreException.h>
 #include <Wallet/Exceptions/SessionTokenException.h>
@@ -35,14 +36,19 @@ std::unique_ptr<WalletRestServer> WalletRestServer::Create(
 {
 	const uint32_t ownerPort = config.GetWalletConfig().GetOwnerPort();
 	const std::string listeningPorts = StringUtil::Format("127.0.0.1:{}", ownerPort);
+
+	// Listing outputs or transactions can take a while for large wallets, so only 2 may run (and 1 wait) at a time,
+	// leaving 2 threads for everything else.
+	const ServerLimits limits{ 2, 1, 2, 1 };
+	const std::string numThreads = std::to_string(limits.GetNumThreads());
 	const char* pOwnerOptions[] = {
-		"num_threads", "5",
+		"num_threads", numThreads.c_str(),
 		"listening_ports", listeningPorts.c_str(),
 		NULL
 	};
 
 	std::unique_ptr<WalletContext> pWalletContext = std::make_unique<WalletContext>(
-		config, pWalletManager, pNodeClient, pTorProcess
+		config, pWalletManager, pNodeClient, pTorProcess, limits.expensiveConcurrency, limits.expensiveQueueDepth, limits.retryAfterSeconds
 	);
 
 	mg_context* pOwnerCivetContext = mg_start(NULL, 0, pOwnerOptions);
@@ -66,6 +72,16 @@ int WalletRestServer::OwnerAPIHandler(mg_connection* pConnection, void* pWalletC
 		const HTTP::EHTTPMethod method = HTTPUtil::GetHTTPMethod(pConnection);
 		if (method == HTTP::EHTTPMethod::GET)
 		{
+			std::unique_ptr<RequestLane::Ticket> pTicket;
+			if (action == "retrieve_outputs" || action == "retrieve_txs")
+			{
+				pTicket = pContext->m_expensiveLane.TryEnter();
+				if (pTicket == nullptr)
+				{
+					return HTTPUtil::BuildServiceUnavailableResponse(pConnection, pContext->m_retryAfterSeconds, "Wallet busy. Try again later.");
+				}
+			}
+
 			return OwnerGetAPI::HandleGET(pConnection, action, *pContext->m_pWalletManager, *pContext->m_pNodeClient);
 		}
 	}
@@ -5,6 +5,7 @@
 #include <Common/Util/VectorUtil.h>
 #include <Infrastructure/Logger.h>
 #include <algorithm>
+#include <iterator>
 #include <unordered_map>
 
 std::vector<TransactionPtr> Pool::GetTransactionsByShortId(const Hash& hash, const uint64_t nonce, const std::set<ShortId>& missingShortIds) const
@@ -30,24 +31,26 @@ std::vector<TransactionPtr> Pool::GetTransactionsByShortId(const Hash& hash, con
 	return transactionsFound;
 }
 
-void Pool::AddTransaction(TransactionPtr pTransaction, const EDandelionStatus status)
+bool Pool::AddTransaction(TransactionPtr pTransaction, const EDandelionStatus status)
 {
-	LOG_DEBUG_F("Transaction added: {}", pTransaction->GetHash());
+	const Hash& txHash = pTransaction->GetHash();
+	if (m_transactionsByHash.find(txHash) != m_transactionsByHash.cend())
+	{
+		LOG_TRACE_F("Transaction already in pool: {}", txHash);
+		return false;
+	}
 
-	m_transactions.emplace_back(TxPoolEntry(pTransaction, status, std::time_t()));
+	LOG_DEBUG_F("Transaction added: {}", txHash);
+
+	m_transactions.emplace_back(TxPoolEntry(pTransaction, status, std::time(nullptr)));
+	m_transactionsByHash.insert({ txHash, std::prev(m_transactions.end()) });
+	m_pendingAggregation.push_back(pTransaction);
+	return true;
 }
 
 bool Pool::ContainsTransaction(const Transaction& transaction) const
 {
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
-	{
-		if (*txPoolEntry.GetTransaction() == transaction)
-		{
-			return true;
-		}
-	}
-
-	return false;
+	return m_transactionsByHash.find(transaction.GetHash()) != m_transactionsByHash.cend();
 }
 
 std::vector<TransactionPtr> Pool::FindTransactionsByKernel(const std::set<TransactionKernel>& kernels) const
@@ -100,34 +103,56 @@ std::vector<TransactionPtr> Pool::FindTransactionsByStatus(const EDandelionStatu
 	return transactions;
 }
 
-std::vector<TransactionPtr> Pool::GetExpiredTransactions(const uint16_t embargoSeconds) const
+std::vector<TransactionPtr> Pool::FindTransactionsByHash(const std::vector<Hash>& hashes, const std::optional<EDandelionStatus>& statusOpt) const
 {
-	const std::time_t cutoff = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now() - std::chrono::seconds(embargoSeconds));
-
 	std::vector<TransactionPtr> transactions;
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
+	for (const Hash& hash : hashes)
 	{
-		if (txPoolEntry.GetTimestamp() < cutoff)
+		auto iter = m_transactionsByHash.find(hash);
+		if (iter == m_transactionsByHash.cend())
 		{
-			transactions.push_back(txPoolEntry.GetTransaction());
+			continue;
+		}
+
+		if (!statusOpt.has_value() || iter->second->GetStatus() == statusOpt.value())
+		{
+			transactions.push_back(iter->second->GetTransaction());
 		}
 	}
 
 	return transactions;
 }
 
+std::optional<EDandelionStatus> Pool::GetStatus(const Hash& txHash) const
+{
+	auto iter = m_transactionsByHash.find(txHash);
+	if (iter != m_transactionsByHash.cend())
+	{
+		return std::make_optional(iter->second->GetStatus());
+	}
+
+	return std::nullopt;
+}
+
 void Pool::RemoveTransaction(const Transaction& transaction)
 {
-	auto iter = m_transactions.begin();
-	while (iter != m_transactions.end())
+	if (EraseTransaction(transaction.GetHash()))
 	{
-		if (transaction == *iter->GetTransaction())
-		{
-			m_transactions.erase(iter);
-			break;
-		}
+		ResetAggregate();
+	}
+}
 
-		++iter;
+void Pool::RemoveTransactions(const std::vector<TransactionPtr>& transactions)
+{
+	bool removed = false;
+	for (const TransactionPtr& pTransaction : transactions)
+	{
+		removed = EraseTransaction(pTransaction->GetHash()) || removed;
+	}
+
+	if (removed)
+	{
+		ResetAggregate();
 	}
 }
 
@@ -151,27 +176,26 @@ void Pool::ReconcileBlock(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetCo
 		}
 	}
 
-	m_transactions.clear();
+	Clear();
 
 	std::vector<TransactionPtr> validTransactions = ValidTransactionFinder::FindValidTransactions(pBlockDB, pTxHashSet, filteredTransactions, pMemPoolAggTx);
 	for (auto& pTransaction : validTransactions)
 	{
 		const TxPoolEntry& txPoolEntry = filteredEntriesByHash.at(pTransaction->GetHash());
 		m_transactions.push_back(txPoolEntry);
+		m_transactionsByHash.insert({ pTransaction->GetHash(), std::prev(m_transactions.end()) });
+		m_pendingAggregation.push_back(pTransaction);
 	}
 }
 
 void Pool::ChangeStatus(const std::vector<TransactionPtr>& transactions, const EDandelionStatus status)
 {
-	for (auto& txPoolEntry : m_transactions)
+	for (auto& pTransaction : transactions)
 	{
-		for (auto& transaction : transactions)
+		auto iter = m_transactionsByHash.find(pTransaction->GetHash());
+		if (iter != m_transactionsByHash.end())
 		{
-			if (txPoolEntry.GetTransaction() == transaction)
-			{
-				txPoolEntry.SetStatus(status);
-				break;
-			}
+			iter->second->SetStatus(status);
 		}
 	}
 }
@@ -199,20 +223,58 @@ bool Pool::ShouldEvict(const Transaction& transaction, const FullBlock& block) c
 	return false;
 }
 
-TransactionPtr Pool::Aggregate() const
+bool Pool::EraseTransaction(const Hash& txHash)
+{
+	auto iter = m_transactionsByHash.find(txHash);
+	if (iter == m_transactionsByHash.end())
+	{
+		return false;
+	}
+
+	m_transactions.erase(iter->second);
+	m_transactionsByHash.erase(iter);
+	return true;
+}
+
+TransactionPtr Pool::Aggregate()
 {
-	if (m_transactions.empty())
+	if (m_pendingAggregation.empty())
 	{
-		return nullptr;
+		return m_pAggregateTx;
 	}
 
-	LOG_INFO_F("Aggregating {} transactions", m_transactions.size());
+	LOG_INFO_F("Aggregating {} new transactions into pool of {}", m_pendingAggregation.size(), m_transactions.size());
 
+	// Aggregation is associative (cut-through included), so merging the new txs into the
+	// previous aggregate gives the same result as aggregating the whole pool again.
 	std::vector<TransactionPtr> transactions;
-	for (const TxPoolEntry& entry : m_transactions)
+	transactions.reserve(m_pendingAggregation.size() + 1);
+	if (m_pAggregateTx != nullptr)
 	{
-		transactions.push_back(entry.GetTransaction());
+		transactions.push_back(m_pAggregateTx);
 	}
 
-	return TransactionUtil::Aggregate(transactions);
+	std::move(m_pendingAggregation.begin(), m_pendingAggregation.end(), std::back_inserter(transactions));
+	m_pendingAggregation.clear();
+
+	m_pAggregateTx = TransactionUtil::Aggregate(transactions);
+	return m_pAggregateTx;
+}
+
+void Pool::Clear()
+{
+	m_transactions.clear();
+	m_transactionsByHash.clear();
+	m_pAggregateTx = nullptr;
+	m_pendingAggregation.clear();
+}
+
+void Pool::ResetAggregate()
+{
+	m_pAggregateTx = nullptr;
+	m_pendingAggregation.clear();
+	for (const TxPoolEntry& txPoolEntry : m_transactions)
+	{
+		m_pendingAggregation.push_back(txPoolEntry.GetTransaction());
+	}
 }
\ No newline at end of file
@@ -10,7 +10,10 @@
 #include <Config/Config.h>
 #include <PMMR/TxHashSetManager.h>
 #include <Crypto/Hash.h>
+#include <list>
+#include <optional>
 #include <set>
+#include <unordered_map>
 
 class Pool
 {
@@ -18,9 +21,19 @@ public:
 	Pool() = default;
 	~Pool() = default;
 
-	void AddTransaction(TransactionPtr pTransaction, const EDandelionStatus status);
+	//
+	// Adds the transaction, unless it's already in the pool.
+	// Returns true if the transaction was added.
+	//
+	bool AddTransaction(TransactionPtr pTransaction, const EDandelionStatus status);
 	bool ContainsTransaction(const Transaction& transaction) const;
 	void RemoveTransaction(const Transaction& transaction);
+
+	//
+	// Removes each of the given transactions that are in the pool.
+	// The aggregate is only reset once, no matter how many transactions are removed.
+	//
+	void RemoveTransactions(const std::vector<TransactionPtr>& transactions);
 	void ReconcileBlock(
 		std::shared_ptr<const IBlockDB> pBlockDB,
 		ITxHashSetConstPtr pTxHashSet,
@@ -37,13 +50,30 @@ public:
 	std::vector<TransactionPtr> FindTransactionsByKernel(const std::set<TransactionKernel>& kernels) const;
 	TransactionPtr FindTransactionByKernelHash(const Hash& kernelHash) const;
 	std::vector<TransactionPtr> FindTransactionsByStatus(const EDandelionStatus status) const;
-	std::vector<TransactionPtr> GetExpiredTransactions(const uint16_t embargoSeconds) const;
 
-	TransactionPtr Aggregate() const;
-	void Clear() { m_transactions.clear(); }
+	//
+	// Looks up each of the given transaction hashes, returning only those transactions with the given status (if provided).
+	// Cost is proportional to the number of hashes, not the size of the pool.
+	//
+	std::vector<TransactionPtr> FindTransactionsByHash(const std::vector<Hash>& hashes, const std::optional<EDandelionStatus>& statusOpt) const;
+	std::optional<EDandelionStatus> GetStatus(const Hash& txHash) const;
+
+	//
+	// Returns the aggregate of all transactions in the pool.
+	// The aggregate is cached, and transactions added since the last call are merged into it,
+	// so it's only rebuilt from scratch after transactions are removed.
+	//
+	TransactionPtr Aggregate();
+	void Clear();
 
 private:
 	bool ShouldEvict(const Transaction& transaction, const FullBlock& block) const;
+	bool EraseTransaction(const Hash& txHash);
+	void ResetAggregate();
+
+	std::list<TxPoolEntry> m_transactions;
+	std::unordered_map<Hash, std::list<TxPoolEntry>::iterator> m_transactionsByHash;
 
-	std::vector<TxPoolEntry> m_transactions;
-};
\ No newline at end of file
+	TransactionPtr m_pAggregateTx;
+	std::vector<TransactionPtr> m_pendingAggregation;
+};
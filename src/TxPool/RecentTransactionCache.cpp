@@ -0,0 +1,83 @@
+#include "RecentTransactionCache.h"
+
+RecentTransactionCache::RecentTransactionCache(const size_t capacity)
+	: m_capacity(capacity)
+{
+
+}
+
+void RecentTransactionCache::AddTransaction(TransactionPtr pTransaction)
+{
+	if (m_capacity == 0 || !m_transactionHashes.insert(pTransaction->GetHash()).second)
+	{
+		return;
+	}
+
+	m_transactions.push_back(pTransaction);
+	for (const TransactionKernel& kernel : pTransaction->GetKernels())
+	{
+		auto iter = m_transactionsByKernel.find(kernel.GetHash());
+		if (iter == m_transactionsByKernel.end())
+		{
+			m_transactionsByKernel.insert({ kernel.GetHash(), pTransaction });
+		}
+		else if (pTransaction->GetKernels().size() < iter->second->GetKernels().size())
+		{
+			iter->second = pTransaction;
+		}
+	}
+
+	while (m_transactions.size() > m_capacity)
+	{
+		TransactionPtr pOldest = m_transactions.front();
+		m_transactions.pop_front();
+		m_transactionHashes.erase(pOldest->GetHash());
+
+		// A smaller transaction may have since claimed the same kernel.
+		for (const TransactionKernel& kernel : pOldest->GetKernels())
+		{
+			auto iter = m_transactionsByKernel.find(kernel.GetHash());
+			if (iter != m_transactionsByKernel.end() && iter->second == pOldest)
+			{
+				m_transactionsByKernel.erase(iter);
+			}
+		}
+	}
+}
+
+std::vector<TransactionPtr> RecentTransactionCache::GetTransactionsByShortId(
+	const Hash& hash,
+	const uint64_t nonce,
+	const std::set<ShortId>& shortIds) const
+{
+	std::vector<TransactionPtr> transactionsFound;
+	if (shortIds.empty())
+	{
+		return transactionsFound;
+	}
+
+	std::unordered_set<Hash> found;
+	for (const auto& entry : m_transactionsByKernel)
+	{
+		if (shortIds.count(ShortId::Create(entry.first, hash, nonce)) > 0)
+		{
+			if (found.insert(entry.second->GetHash()).second)
+			{
+				transactionsFound.push_back(entry.second);
+			}
+		}
+	}
+
+	return transactionsFound;
+}
+
+TransactionPtr RecentTransactionCache::FindTransactionByKernelHash(const Hash& kernelHash) const
+{
+	auto iter = m_transactionsByKernel.find(kernelHash);
+	if (iter != m_transactionsByKernel.end())
+	{
+		return iter->second;
+	}
+
+	return nullptr;
+}
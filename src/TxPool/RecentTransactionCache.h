@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Core/Models/Transaction.h>
+#include <Core/Models/ShortId.h>
+#include <Crypto/Hash.h>
+#include <deque>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+//
+// Bounded cache of recently seen transactions, keyed by kernel hash.
+// Transactions stay here after they leave the pool (eg. confirmed by a competing block, or expired from the stempool),
+// so compact blocks containing them can still be hydrated without downloading the full block.
+// Each kernel maps to the smallest transaction known to contain it, so an original transaction isn't shadowed
+// by a block or aggregate it was later included in. Once full, the oldest transactions are evicted first.
+//
+class RecentTransactionCache
+{
+public:
+	explicit RecentTransactionCache(const size_t capacity);
+
+	void AddTransaction(TransactionPtr pTransaction);
+
+	//
+	// Returns the cached transactions with a kernel matching one of the short ids.
+	//
+	std::vector<TransactionPtr> GetTransactionsByShortId(
+		const Hash& hash,
+		const uint64_t nonce,
+		const std::set<ShortId>& shortIds
+	) const;
+
+	//
+	// Returns the transaction with the fewest kernels that contains the given kernel, or nullptr if none is cached.
+	//
+	TransactionPtr FindTransactionByKernelHash(const Hash& kernelHash) const;
+
+	size_t GetSize() const noexcept { return m_transactions.size(); }
+
+private:
+	size_t m_capacity;
+
+	// Oldest first
+	std::deque<TransactionPtr> m_transactions;
+	std::unordered_set<Hash> m_transactionHashes;
+	std::unordered_map<Hash, TransactionPtr> m_transactionsByKernel;
+};
@@ -0,0 +1,162 @@
+#include "RewoundTransactionBuilder.h"
+
+#include <Core/Util/TransactionUtil.h>
+#include <Crypto/Crypto.h>
+#include <Infrastructure/Logger.h>
+#include <algorithm>
+
+TransactionPtr RewoundTransactionBuilder::BuildBlockTransaction(std::shared_ptr<const IBlockDB> pBlockDB, const FullBlock& block)
+{
+	std::vector<TransactionKernel> kernels;
+	std::copy_if(
+		block.GetKernels().cbegin(), block.GetKernels().cend(),
+		std::back_inserter(kernels),
+		[](const TransactionKernel& kernel) { return !kernel.IsCoinbase(); }
+	);
+	if (kernels.empty())
+	{
+		return nullptr;
+	}
+
+	auto pPreviousHeader = pBlockDB->GetBlockHeader(block.GetPreviousHash());
+	if (pPreviousHeader == nullptr)
+	{
+		LOG_WARNING_F("Previous header not found for block {}", block);
+		return nullptr;
+	}
+
+	std::vector<TransactionOutput> outputs;
+	std::copy_if(
+		block.GetOutputs().cbegin(), block.GetOutputs().cend(),
+		std::back_inserter(outputs),
+		[](const TransactionOutput& output) { return !output.IsCoinbase(); }
+	);
+
+	std::vector<TransactionInput> inputs = block.GetInputs();
+
+	BlindingFactor offset = Crypto::AddBlindingFactors(
+		{ block.GetTotalKernelOffset() },
+		{ pPreviousHeader->GetTotalKernelOffset() }
+	);
+
+	return std::make_shared<Transaction>(
+		std::move(offset),
+		TransactionBody(std::move(inputs), std::move(outputs), std::move(kernels))
+	);
+}
+
+TransactionPtr RewoundTransactionBuilder::BuildRemainder(
+	const std::vector<TransactionPtr>& rewoundTransactions,
+	const std::vector<TransactionPtr>& transactionsToRemove)
+{
+	if (rewoundTransactions.empty())
+	{
+		return nullptr;
+	}
+
+	std::vector<TransactionInput> inputs;
+	std::vector<TransactionOutput> outputs;
+	std::vector<TransactionKernel> kernels;
+	std::vector<BlindingFactor> offsets;
+
+	for (const TransactionPtr& pTransaction : rewoundTransactions)
+	{
+		inputs.insert(inputs.end(), pTransaction->GetInputs().cbegin(), pTransaction->GetInputs().cend());
+		outputs.insert(outputs.end(), pTransaction->GetOutputs().cbegin(), pTransaction->GetOutputs().cend());
+		kernels.insert(kernels.end(), pTransaction->GetKernels().cbegin(), pTransaction->GetKernels().cend());
+		offsets.push_back(pTransaction->GetOffset());
+	}
+
+	std::vector<TransactionPtr> overlapping;
+	for (const TransactionPtr& pTransaction : transactionsToRemove)
+	{
+		const auto& kernelsToRemove = pTransaction->GetKernels();
+		const size_t numShared = std::count_if(
+			kernelsToRemove.cbegin(), kernelsToRemove.cend(),
+			[&kernels](const TransactionKernel& kernel) { return std::find(kernels.cbegin(), kernels.cend(), kernel) != kernels.cend(); }
+		);
+		if (numShared == 0)
+		{
+			continue;
+		}
+		else if (numShared != kernelsToRemove.size())
+		{
+			LOG_DEBUG("Transaction partially overlaps the rewound transactions.");
+			return nullptr;
+		}
+
+		overlapping.push_back(pTransaction);
+	}
+
+	std::vector<BlindingFactor> negativeOffsets;
+	if (!overlapping.empty())
+	{
+		// Removed together, so an output created by one and spent by another is cut-through first.
+		TransactionPtr pToRemove = TransactionUtil::Aggregate(overlapping);
+
+		for (const TransactionKernel& kernel : pToRemove->GetKernels())
+		{
+			auto iter = std::find(kernels.begin(), kernels.end(), kernel);
+			if (iter == kernels.end())
+			{
+				LOG_DEBUG("Kernel removed more than once from the rewound transactions.");
+				return nullptr;
+			}
+
+			kernels.erase(iter);
+		}
+
+		// Subtracting an output that was cut-through in the rewound transactions means spending it instead.
+		for (const TransactionOutput& output : pToRemove->GetOutputs())
+		{
+			auto iter = std::find_if(
+				outputs.begin(), outputs.end(),
+				[&output](const TransactionOutput& rewound) { return rewound.GetCommitment() == output.GetCommitment(); }
+			);
+			if (iter != outputs.end())
+			{
+				outputs.erase(iter);
+			}
+			else
+			{
+				inputs.push_back(TransactionInput(output.GetFeatures(), output.GetCommitment()));
+			}
+		}
+
+		// An input can't be turned into an output, since its rangeproof isn't known.
+		for (const TransactionInput& input : pToRemove->GetInputs())
+		{
+			auto iter = std::find_if(
+				inputs.begin(), inputs.end(),
+				[&input](const TransactionInput& rewound) { return rewound.GetCommitment() == input.GetCommitment(); }
+			);
+			if (iter == inputs.end())
+			{
+				LOG_DEBUG_F("Input {} not found in the rewound transactions.", input.GetCommitment());
+				return nullptr;
+			}
+
+			inputs.erase(iter);
+		}
+
+		negativeOffsets.push_back(pToRemove->GetOffset());
+	}
+
+	if (kernels.empty())
+	{
+		return nullptr;
+	}
+
+	TransactionUtil::PerformCutThrough(inputs, outputs);
+
+	std::sort(kernels.begin(), kernels.end(), SortKernelsByHash);
+	std::sort(inputs.begin(), inputs.end(), SortInputsByHash);
+	std::sort(outputs.begin(), outputs.end(), SortOutputsByHash);
+
+	BlindingFactor offset = Crypto::AddBlindingFactors(offsets, negativeOffsets);
+
+	return std::make_shared<Transaction>(
+		std::move(offset),
+		TransactionBody(std::move(inputs), std::move(outputs), std::move(kernels))
+	);
+}
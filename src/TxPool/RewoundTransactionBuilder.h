@@ -0,0 +1,31 @@
+#pragma once
+
+#include <Core/Models/Transaction.h>
+#include <Core/Models/FullBlock.h>
+#include <Database/BlockDb.h>
+
+//
+// Rebuilds unconfirmed transactions from the blocks disconnected during a reorg.
+// A block's body, minus its coinbase outputs and kernels, balances on its own as a transaction
+// whose offset is the difference between the block's total kernel offset and its parent's.
+//
+class RewoundTransactionBuilder
+{
+public:
+	//
+	// Returns the non-coinbase part of the block's body as a single transaction,
+	// or nullptr if the block only contains its coinbase.
+	//
+	static TransactionPtr BuildBlockTransaction(std::shared_ptr<const IBlockDB> pBlockDB, const FullBlock& block);
+
+	//
+	// Subtracts the given transactions (eg. those confirmed on the new fork) from the aggregate of the rewound ones,
+	// leaving only what isn't covered by them. Transactions that share no kernels with the rewound ones are ignored.
+	// Returns nullptr if nothing is left, or if a transaction only partially overlaps the rewound ones,
+	// since the remainder can't be split along transaction boundaries.
+	//
+	static TransactionPtr BuildRemainder(
+		const std::vector<TransactionPtr>& rewoundTransactions,
+		const std::vector<TransactionPtr>& transactionsToRemove
+	);
+};
@@ -1,5 +1,6 @@
 #include "TransactionPoolImpl.h"
 #include "ValidTransactionFinder.h"
+#include "RewoundTransactionBuilder.h"
 
 #include <Core/Util/TransactionUtil.h>
 #include <Database/BlockDb.h>
@@ -8,11 +9,20 @@
 #include <Infrastructure/Logger.h>
 #include <Core/Util/FeeUtil.h>
 #include <Core/Validation/TransactionValidator.h>
+#include <algorithm>
+#include <unordered_set>
 
-TransactionPool::TransactionPool(const Config& config)
+// Roughly an hour's worth of txs at current volumes.
+static const size_t RECENT_TRANSACTIONS_CAPACITY = 5'000;
+
+TransactionPool::TransactionPool(const Config& config, const std::function<std::chrono::system_clock::time_point()>& clock)
 	: m_config(config), 
+	m_clock(clock),
 	m_memPool(),
-	m_stemPool()
+	m_stemPool(),
+	m_recentTransactions(RECENT_TRANSACTIONS_CAPACITY),
+	m_patienceTimers(clock()),
+	m_embargoTimers(clock())
 {
 
 }
@@ -21,7 +31,21 @@ std::vector<TransactionPtr> TransactionPool::GetTransactionsByShortId(const Hash
 {
 	std::shared_lock<std::shared_mutex> readLock(m_mutex);
 
-	return m_memPool.GetTransactionsByShortId(hash, nonce, missingShortIds);
+	std::vector<TransactionPtr> transactions = m_memPool.GetTransactionsByShortId(hash, nonce, missingShortIds);
+
+	std::set<ShortId> stillMissing = missingShortIds;
+	for (const TransactionPtr& pTransaction : transactions)
+	{
+		for (const TransactionKernel& kernel : pTransaction->GetKernels())
+		{
+			stillMissing.erase(ShortId::Create(kernel.GetHash(), hash, nonce));
+		}
+	}
+
+	const std::vector<TransactionPtr> recentTransactions = m_recentTransactions.GetTransactionsByShortId(hash, nonce, stillMissing);
+	transactions.insert(transactions.end(), recentTransactions.cbegin(), recentTransactions.cend());
+
+	return transactions;
 }
 
 EAddTransactionStatus TransactionPool::AddTransaction(
@@ -85,12 +109,18 @@ EAddTransactionStatus TransactionPool::AddTransaction(
 		if (random <= m_config.GetNodeConfig().GetDandelion().GetStemProbability())
 		{
 			LOG_INFO_F("Stemming transaction ({})", *pTransaction);
-			m_stemPool.AddTransaction(pTransaction, EDandelionStatus::TO_STEM);
+			if (m_stemPool.AddTransaction(pTransaction, EDandelionStatus::TO_STEM))
+			{
+				ScheduleDandelionTimers(pTransaction->GetHash());
+			}
 		}
 		else
 		{
 			LOG_INFO_F("Fluffing transaction ({})", *pTransaction);
-			m_stemPool.AddTransaction(pTransaction, EDandelionStatus::TO_FLUFF);
+			if (m_stemPool.AddTransaction(pTransaction, EDandelionStatus::TO_FLUFF))
+			{
+				ScheduleDandelionTimers(pTransaction->GetHash());
+			}
 		}
 	}
 	else if (poolType == EPoolType::JOINPOOL)
@@ -98,6 +128,8 @@ EAddTransactionStatus TransactionPool::AddTransaction(
 		m_joinPool.AddTransaction(pTransaction, EDandelionStatus::TO_FLUFF);
 	}
 
+	m_recentTransactions.AddTransaction(pTransaction);
+
 	return EAddTransactionStatus::ADDED;
 }
 
@@ -134,11 +166,192 @@ void TransactionPool::ReconcileBlock(std::shared_ptr<const IBlockDB> pBlockDB, I
 	m_joinPool.ReconcileBlock(pBlockDB, pTxHashSet, block, pMemPoolAggTx);
 }
 
+void TransactionPool::ReconcileReorg(
+	std::shared_ptr<const IBlockDB> pBlockDB,
+	ITxHashSetConstPtr pTxHashSet,
+	const std::vector<FullBlock::CPtr>& rewoundBlocks,
+	const std::vector<FullBlock::CPtr>& confirmedBlocks)
+{
+	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+
+	auto buildTransactions = [&pBlockDB](const std::vector<FullBlock::CPtr>& blocks) {
+		std::vector<TransactionPtr> transactions;
+		for (const FullBlock::CPtr& pBlock : blocks)
+		{
+			TransactionPtr pTransaction = RewoundTransactionBuilder::BuildBlockTransaction(pBlockDB, *pBlock);
+			if (pTransaction != nullptr)
+			{
+				transactions.push_back(pTransaction);
+			}
+		}
+
+		return transactions;
+	};
+
+	const std::vector<TransactionPtr> rewoundTransactions = buildTransactions(rewoundBlocks);
+	if (rewoundTransactions.empty())
+	{
+		return;
+	}
+
+	const std::vector<TransactionPtr> confirmedTransactions = buildTransactions(confirmedBlocks);
+
+	std::unordered_set<Hash> confirmedKernels;
+	for (const TransactionPtr& pTransaction : confirmedTransactions)
+	{
+		for (const TransactionKernel& kernel : pTransaction->GetKernels())
+		{
+			confirmedKernels.insert(kernel.GetHash());
+		}
+	}
+
+	std::unordered_set<Hash> unconfirmedKernels;
+	for (const TransactionPtr& pTransaction : rewoundTransactions)
+	{
+		for (const TransactionKernel& kernel : pTransaction->GetKernels())
+		{
+			if (confirmedKernels.count(kernel.GetHash()) == 0)
+			{
+				unconfirmedKernels.insert(kernel.GetHash());
+			}
+		}
+	}
+
+	// Where the original transactions are still known, each is re-added as its own entry,
+	// so confirming one of them later doesn't evict the others along with it.
+	std::vector<TransactionPtr> originalTransactions;
+	std::unordered_set<Hash> coveredKernels;
+	for (const TransactionPtr& pTransaction : rewoundTransactions)
+	{
+		for (const TransactionKernel& kernel : pTransaction->GetKernels())
+		{
+			if (unconfirmedKernels.count(kernel.GetHash()) == 0 || coveredKernels.count(kernel.GetHash()) > 0)
+			{
+				continue;
+			}
+
+			TransactionPtr pOriginal = m_recentTransactions.FindTransactionByKernelHash(kernel.GetHash());
+			if (pOriginal == nullptr)
+			{
+				continue;
+			}
+
+			const auto& originalKernels = pOriginal->GetKernels();
+			const bool unconfirmed = std::all_of(
+				originalKernels.cbegin(), originalKernels.cend(),
+				[&unconfirmedKernels, &coveredKernels](const TransactionKernel& originalKernel) {
+					return unconfirmedKernels.count(originalKernel.GetHash()) > 0 && coveredKernels.count(originalKernel.GetHash()) == 0;
+				}
+			);
+			if (unconfirmed)
+			{
+				originalTransactions.push_back(pOriginal);
+				for (const TransactionKernel& originalKernel : originalKernels)
+				{
+					coveredKernels.insert(originalKernel.GetHash());
+				}
+			}
+		}
+	}
+
+	for (const TransactionPtr& pTransaction : rewoundTransactions)
+	{
+		m_recentTransactions.AddTransaction(pTransaction);
+	}
+
+	// The rewound blocks that share no kernels with the new fork, or with the original transactions.
+	auto findUncoveredBlocks = [&rewoundTransactions, &unconfirmedKernels, &coveredKernels]() {
+		std::vector<TransactionPtr> uncoveredTransactions;
+		std::copy_if(
+			rewoundTransactions.cbegin(), rewoundTransactions.cend(),
+			std::back_inserter(uncoveredTransactions),
+			[&unconfirmedKernels, &coveredKernels](const TransactionPtr& pTransaction) {
+				const auto& kernels = pTransaction->GetKernels();
+				return std::all_of(
+					kernels.cbegin(), kernels.cend(),
+					[&unconfirmedKernels, &coveredKernels](const TransactionKernel& kernel) {
+						return unconfirmedKernels.count(kernel.GetHash()) > 0 && coveredKernels.count(kernel.GetHash()) == 0;
+					}
+				);
+			}
+		);
+
+		return uncoveredTransactions;
+	};
+
+	// Any kernels no original transaction covers are usually left over as whole blocks' worth,
+	// so they're re-added together as a single aggregate transaction.
+	std::vector<TransactionPtr> transactionsToRemove = confirmedTransactions;
+	transactionsToRemove.insert(transactionsToRemove.end(), originalTransactions.cbegin(), originalTransactions.cend());
+	TransactionPtr pRemainder = RewoundTransactionBuilder::BuildRemainder(rewoundTransactions, transactionsToRemove);
+
+	std::vector<TransactionPtr> candidateTransactions = originalTransactions;
+	if (pRemainder != nullptr)
+	{
+		candidateTransactions.push_back(pRemainder);
+	}
+	else
+	{
+		const std::vector<TransactionPtr> uncoveredTransactions = findUncoveredBlocks();
+		candidateTransactions.insert(candidateTransactions.end(), uncoveredTransactions.cbegin(), uncoveredTransactions.cend());
+	}
+
+	// Validated together as a single batch, and only one at a time if that fails.
+	auto pMemPoolAggTx = m_memPool.Aggregate();
+	std::vector<TransactionPtr> validTransactions = ValidTransactionFinder::FindValidTransactions(
+		pBlockDB,
+		pTxHashSet,
+		candidateTransactions,
+		pMemPoolAggTx
+	);
+
+	// If the remainder is invalid, fall back to the uncovered rewound blocks.
+	if (pRemainder != nullptr && std::find(validTransactions.cbegin(), validTransactions.cend(), pRemainder) == validTransactions.cend())
+	{
+		std::vector<TransactionPtr> acceptedTransactions = validTransactions;
+		if (pMemPoolAggTx != nullptr)
+		{
+			acceptedTransactions.push_back(pMemPoolAggTx);
+		}
+
+		const std::vector<TransactionPtr> validBlocks = ValidTransactionFinder::FindValidTransactions(
+			pBlockDB,
+			pTxHashSet,
+			findUncoveredBlocks(),
+			acceptedTransactions.empty() ? nullptr : TransactionUtil::Aggregate(acceptedTransactions)
+		);
+		validTransactions.insert(validTransactions.end(), validBlocks.cbegin(), validBlocks.cend());
+	}
+
+	for (const TransactionPtr& pTransaction : validTransactions)
+	{
+		LOG_INFO_F("Re-adding rewound transaction ({})", *pTransaction);
+		m_memPool.AddTransaction(pTransaction, EDandelionStatus::FLUFFED);
+	}
+}
+
+void TransactionPool::AddForkBlocks(std::shared_ptr<const IBlockDB> pBlockDB, const std::vector<FullBlock::CPtr>& blocks)
+{
+	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+
+	for (const FullBlock::CPtr& pBlock : blocks)
+	{
+		TransactionPtr pTransaction = RewoundTransactionBuilder::BuildBlockTransaction(pBlockDB, *pBlock);
+		if (pTransaction != nullptr)
+		{
+			m_recentTransactions.AddTransaction(pTransaction);
+		}
+	}
+}
+
 TransactionPtr TransactionPool::GetTransactionToStem(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet)
 {
 	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
 
-	const std::vector<TransactionPtr> transactionsToStem = m_stemPool.FindTransactionsByStatus(EDandelionStatus::TO_STEM);
+	AdvanceDandelionTimers();
+
+	const std::vector<TransactionPtr> transactionsToStem = m_stemPool.FindTransactionsByHash(m_dueToStem, EDandelionStatus::TO_STEM);
+	m_dueToStem.clear();
 	if (transactionsToStem.empty())
 	{
 		return nullptr;
@@ -152,6 +365,7 @@ TransactionPtr TransactionPool::GetTransactionToStem(std::shared_ptr<const IBloc
 		transactionsToStem,
 		pMemPoolAggTx
 	);
+	ReschedulePatienceTimers(transactionsToStem, validTransactionsToStem);
 	if (validTransactionsToStem.empty())
 	{
 		return nullptr;
@@ -168,7 +382,10 @@ TransactionPtr TransactionPool::GetTransactionToFluff(std::shared_ptr<const IBlo
 {
 	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
 
-	std::vector<TransactionPtr> transactionsToFluff = m_stemPool.FindTransactionsByStatus(EDandelionStatus::TO_FLUFF);
+	AdvanceDandelionTimers();
+
+	std::vector<TransactionPtr> transactionsToFluff = m_stemPool.FindTransactionsByHash(m_dueToFluff, EDandelionStatus::TO_FLUFF);
+	m_dueToFluff.clear();
 	if (transactionsToFluff.empty())
 	{
 		return nullptr;
@@ -182,6 +399,7 @@ TransactionPtr TransactionPool::GetTransactionToFluff(std::shared_ptr<const IBlo
 		transactionsToFluff,
 		pMemPoolAggTx
 	);
+	ReschedulePatienceTimers(transactionsToFluff, validTransactionsToFluff);
 	if (validTransactionsToFluff.empty())
 	{
 		return nullptr;
@@ -190,20 +408,39 @@ TransactionPtr TransactionPool::GetTransactionToFluff(std::shared_ptr<const IBlo
 	TransactionPtr pTransactionToFluff = TransactionUtil::Aggregate(validTransactionsToFluff);
 
 	m_memPool.AddTransaction(pTransactionToFluff, EDandelionStatus::FLUFFED);
-	for (auto& pTransaction : validTransactionsToFluff)
-	{
-		m_stemPool.RemoveTransaction(*pTransaction);
-	}
+	m_stemPool.RemoveTransactions(validTransactionsToFluff);
 
 	return pTransactionToFluff;
 }
 
-std::vector<TransactionPtr> TransactionPool::GetExpiredTransactions() const
+std::vector<TransactionPtr> TransactionPool::GetExpiredTransactions()
+{
+	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+
+	AdvanceDandelionTimers();
+
+	std::vector<TransactionPtr> expiredTransactions = m_stemPool.FindTransactionsByHash(m_dueExpired, std::nullopt);
+	m_dueExpired.clear();
+	return expiredTransactions;
+}
+
+std::optional<std::chrono::system_clock::time_point> TransactionPool::GetNextDandelionDeadline() const
 {
 	std::shared_lock<std::shared_mutex> readLock(m_mutex);
 
-	const uint16_t embargoSeconds = m_config.GetNodeConfig().GetDandelion().GetEmbargoSeconds() + (uint16_t)RandomNumberGenerator::GenerateRandom(0, 30);
-	return m_stemPool.GetExpiredTransactions(embargoSeconds);
+	if (!m_dueToStem.empty() || !m_dueToFluff.empty() || !m_dueExpired.empty())
+	{
+		return std::make_optional(m_clock());
+	}
+
+	const auto patienceDeadline = m_patienceTimers.GetNextDeadline();
+	const auto embargoDeadline = m_embargoTimers.GetNextDeadline();
+	if (patienceDeadline.has_value() && embargoDeadline.has_value())
+	{
+		return std::make_optional((std::min)(patienceDeadline.value(), embargoDeadline.value()));
+	}
+
+	return patienceDeadline.has_value() ? patienceDeadline : embargoDeadline;
 }
 
 void TransactionPool::FluffJoinPool()
@@ -214,16 +451,88 @@ void TransactionPool::FluffJoinPool()
 	if (pAggregatedTx != nullptr)
 	{
 		LOG_INFO_F("Fluffing transaction with {} kernels", pAggregatedTx->GetKernels().size());
-		m_stemPool.AddTransaction(pAggregatedTx, EDandelionStatus::TO_FLUFF);
+		if (m_stemPool.AddTransaction(pAggregatedTx, EDandelionStatus::TO_FLUFF))
+		{
+			ScheduleDandelionTimers(pAggregatedTx->GetHash());
+		}
 	}
 
 	m_joinPool.Clear();
 }
 
+// Stempool entries are stemmed/fluffed once their patience timer expires,
+// and fluffed by Dandelion as a fallback once their embargo timer expires.
+void TransactionPool::ScheduleDandelionTimers(const Hash& txHash)
+{
+	const DandelionConfig& dandelionConfig = m_config.GetNodeConfig().GetDandelion();
+	const auto now = m_clock();
+
+	m_patienceTimers.Schedule(now + std::chrono::seconds(dandelionConfig.GetPatienceSeconds()), txHash);
+
+	const uint16_t embargoSeconds = dandelionConfig.GetEmbargoSeconds() + (uint16_t)RandomNumberGenerator::GenerateRandom(0, 30);
+	m_embargoTimers.Schedule(now + std::chrono::seconds(embargoSeconds), txHash);
+}
+
+// Due entries that failed validation (eg. because they conflict with the mempool) stay in the stempool,
+// so they get another patience period rather than waiting for their embargo to expire.
+void TransactionPool::ReschedulePatienceTimers(const std::vector<TransactionPtr>& dueTransactions, const std::vector<TransactionPtr>& validTransactions)
+{
+	if (dueTransactions.size() == validTransactions.size())
+	{
+		return;
+	}
+
+	std::unordered_set<Hash> validHashes;
+	for (const TransactionPtr& pTransaction : validTransactions)
+	{
+		validHashes.insert(pTransaction->GetHash());
+	}
+
+	const auto deadline = m_clock() + std::chrono::seconds(m_config.GetNodeConfig().GetDandelion().GetPatienceSeconds());
+	for (const TransactionPtr& pTransaction : dueTransactions)
+	{
+		if (validHashes.count(pTransaction->GetHash()) == 0)
+		{
+			LOG_DEBUG_F("Transaction ({}) not valid yet. Retrying after patience timer.", *pTransaction);
+			m_patienceTimers.Schedule(deadline, pTransaction->GetHash());
+		}
+	}
+}
+
+// Fires the due timers, sorting the entries they belong to into the stem, fluff, and expired lists.
+// Timers for entries that have since left the stempool (or already moved on) are simply dropped.
+void TransactionPool::AdvanceDandelionTimers()
+{
+	const auto now = m_clock();
+
+	for (const Hash& txHash : m_patienceTimers.Advance(now))
+	{
+		const std::optional<EDandelionStatus> statusOpt = m_stemPool.GetStatus(txHash);
+		if (statusOpt == EDandelionStatus::TO_STEM)
+		{
+			m_dueToStem.push_back(txHash);
+		}
+		else if (statusOpt == EDandelionStatus::TO_FLUFF)
+		{
+			m_dueToFluff.push_back(txHash);
+		}
+	}
+
+	for (const Hash& txHash : m_embargoTimers.Advance(now))
+	{
+		if (m_stemPool.GetStatus(txHash).has_value())
+		{
+			m_dueExpired.push_back(txHash);
+		}
+	}
+}
+
 namespace TxPoolAPI
 {
-	TX_POOL_API std::shared_ptr<ITransactionPool> CreateTransactionPool(const Config& config)
+	TX_POOL_API std::shared_ptr<ITransactionPool> CreateTransactionPool(
+		const Config& config,
+		const std::function<std::chrono::system_clock::time_point()>& clock)
 	{
-		return std::shared_ptr<TransactionPool>(new TransactionPool(config));
+		return std::shared_ptr<TransactionPool>(new TransactionPool(config, clock));
 	}
 }
\ No newline at end of file
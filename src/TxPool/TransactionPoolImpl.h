@@ -1,18 +1,21 @@
 #pragma once
 
 #include "Pool.h"
+#include "RecentTransactionCache.h"
 
 #include <TxPool/TransactionPool.h>
 #include <Core/Models/Transaction.h>
 #include <Core/Models/ShortId.h>
 #include <Crypto/Hash.h>
+#include <Common/TimerWheel.h>
+#include <functional>
 #include <shared_mutex>
 #include <set>
 
 class TransactionPool : public ITransactionPool
 {
 public:
-	TransactionPool(const Config& config);
+	TransactionPool(const Config& config, const std::function<std::chrono::system_clock::time_point()>& clock);
     virtual ~TransactionPool() = default;
 
 	virtual std::vector<TransactionPtr> GetTransactionsByShortId(const Hash& hash, const uint64_t nonce, const std::set<ShortId>& missingShortIds) const override final;
@@ -20,20 +23,41 @@ public:
 	virtual std::vector<TransactionPtr> FindTransactionsByKernel(const std::set<TransactionKernel>& kernels) const override final;
 	virtual TransactionPtr FindTransactionByKernelHash(const Hash& kernelHash) const override final;
 	virtual void ReconcileBlock(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet, const FullBlock& block) override final;
+	virtual void ReconcileReorg(
+		std::shared_ptr<const IBlockDB> pBlockDB,
+		ITxHashSetConstPtr pTxHashSet,
+		const std::vector<FullBlock::CPtr>& rewoundBlocks,
+		const std::vector<FullBlock::CPtr>& confirmedBlocks
+	) override final;
+	virtual void AddForkBlocks(std::shared_ptr<const IBlockDB> pBlockDB, const std::vector<FullBlock::CPtr>& blocks) override final;
 
 	// Dandelion
 	virtual TransactionPtr GetTransactionToStem(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet) override final;
 	virtual TransactionPtr GetTransactionToFluff(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet) override final;
-	virtual std::vector<TransactionPtr> GetExpiredTransactions() const override final;
+	virtual std::vector<TransactionPtr> GetExpiredTransactions() override final;
+	virtual std::optional<std::chrono::system_clock::time_point> GetNextDandelionDeadline() const override final;
 
 	// GrinJoin
 	virtual void FluffJoinPool() override final;
 
 private:
+	void ScheduleDandelionTimers(const Hash& txHash);
+	void ReschedulePatienceTimers(const std::vector<TransactionPtr>& dueTransactions, const std::vector<TransactionPtr>& validTransactions);
+	void AdvanceDandelionTimers();
+
 	const Config& m_config;
+	std::function<std::chrono::system_clock::time_point()> m_clock;
 	mutable std::shared_mutex m_mutex;
 
 	Pool m_memPool;
 	Pool m_stemPool;
 	Pool m_joinPool;
+	RecentTransactionCache m_recentTransactions;
+
+	// Per-entry Dandelion timers for the stempool, so only the entries that are due get looked at.
+	TimerWheel<Hash> m_patienceTimers;
+	TimerWheel<Hash> m_embargoTimers;
+	std::vector<Hash> m_dueToStem;
+	std::vector<Hash> m_dueToFluff;
+	std::vector<Hash> m_dueExpired;
 };
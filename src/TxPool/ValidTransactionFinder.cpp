@@ -13,6 +13,26 @@ std::vector<TransactionPtr> ValidTransactionFinder::FindValidTransactions(
 	const std::vector<TransactionPtr>& transactions,
 	TransactionPtr pExtraTransaction)
 {
+	if (transactions.empty())
+	{
+		return {};
+	}
+
+	// Usually every tx is still valid, so check them all together in a single pass first.
+	// Only when that fails is each tx checked incrementally to find the invalid ones.
+	{
+		std::vector<TransactionPtr> candidateTransactions = transactions;
+		if (pExtraTransaction != nullptr)
+		{
+			candidateTransactions.push_back(pExtraTransaction);
+		}
+
+		if (IsValidTransaction(pBlockDB, pTxHashSet, TransactionUtil::Aggregate(candidateTransactions)))
+		{
+			return transactions;
+		}
+	}
+
 	std::vector<TransactionPtr> validTransactions;
 	for (TransactionPtr pTransaction : transactions)
 	{
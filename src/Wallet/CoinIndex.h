@@ -0,0 +1,35 @@
+#pragma once
+
+#include <Wallet/WalletDB/Models/OutputDataEntity.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+//
+// The wallet's spendable coins, sorted by ascending amount.
+// Built once per change to the wallet's outputs, and shared by every coin selection until then,
+// so selection never has to copy or sort the coins itself.
+//
+class CoinIndex
+{
+public:
+	using CPtr = std::shared_ptr<const CoinIndex>;
+
+	explicit CoinIndex(std::vector<OutputDataEntity>&& coins)
+		: m_coins(std::move(coins)), m_total(0)
+	{
+		std::stable_sort(m_coins.begin(), m_coins.end());
+
+		for (const OutputDataEntity& coin : m_coins)
+		{
+			m_total += coin.GetAmount();
+		}
+	}
+
+	const std::vector<OutputDataEntity>& GetCoins() const noexcept { return m_coins; }
+	uint64_t GetTotal() const noexcept { return m_total; }
+
+private:
+	std::vector<OutputDataEntity> m_coins;
+	uint64_t m_total;
+};
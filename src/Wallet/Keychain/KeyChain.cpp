@@ -7,17 +7,22 @@
 #include <Common/Exceptions/UnimplementedException.h>
 #include <Common/Util/VectorUtil.h>
 
-KeyChain::KeyChain(const Config& config, PrivateExtKey&& masterKey, SecretKey&& bulletProofNonce)
-	: m_config(config), m_masterKey(std::move(masterKey)), m_bulletProofNonce(std::move(bulletProofNonce))
+KeyChain::KeyChain(const Config& config, PrivateExtKey&& masterKey, SecretKey&& bulletProofNonce, const KeyChainCache::Ptr& pCache)
+	: m_config(config),
+	m_masterKey(std::move(masterKey)),
+	m_bulletProofNonce(std::move(bulletProofNonce)),
+	m_rewindNonceHash(Crypto::Blake2b(Crypto::CalculatePublicKey(m_masterKey.GetPrivateKey()).GetCompressedVec())),
+	m_privateNonceHash(Crypto::Blake2b(m_masterKey.GetPrivateKey().GetVec())),
+	m_pCache(pCache != nullptr ? pCache : std::make_shared<KeyChainCache>())
 {
 
 }
 
-KeyChain KeyChain::FromSeed(const Config& config, const SecureVector& masterSeed)
+KeyChain KeyChain::FromSeed(const Config& config, const SecureVector& masterSeed, const KeyChainCache::Ptr& pCache)
 {
 	PrivateExtKey masterKey = KeyGenerator(config).GenerateMasterKey(masterSeed);
 	SecretKey bulletProofNonce = Crypto::BlindSwitch(masterKey.GetPrivateKey(), 0);
-	return KeyChain(config, std::move(masterKey), std::move(bulletProofNonce));
+	return KeyChain(config, std::move(masterKey), std::move(bulletProofNonce), pCache);
 }
 
 KeyChain KeyChain::FromRandom(const Config& config)
@@ -27,16 +32,61 @@ KeyChain KeyChain::FromRandom(const Config& config)
 }
 
 SecretKey KeyChain::DerivePrivateKey(const KeyChainPath& keyPath) const
+{
+	const std::vector<uint32_t>& keyIndices = keyPath.GetKeyIndices();
+	if (keyIndices.empty())
+	{
+		return m_masterKey.GetPrivateKey();
+	}
+
+	// Only the parent is cached, since leaf keys are rarely derived more than once.
+	const std::vector<uint32_t> parentIndices(keyIndices.cbegin(), keyIndices.cend() - 1);
+	const PrivateExtKey parentKey = DeriveExtendedKey(parentIndices);
+
+	return KeyGenerator(m_config).GenerateChildPrivateKey(parentKey, keyIndices.back()).GetPrivateKey();
+}
+
+std::vector<SecretKey> KeyChain::DerivePrivateKeys(const KeyChainPath& parentPath, const uint32_t firstChildIndex, const uint32_t numChildren) const
 {
 	KeyGenerator keygen(m_config);
+	const PrivateExtKey parentKey = DeriveExtendedKey(parentPath.GetKeyIndices());
 
-	PrivateExtKey privateKey(m_masterKey);
-	for (const uint32_t childIndex : keyPath.GetKeyIndices())
+	std::vector<SecretKey> privateKeys;
+	privateKeys.reserve(numChildren);
+	for (uint32_t i = 0; i < numChildren; i++)
 	{
-		privateKey = keygen.GenerateChildPrivateKey(privateKey, childIndex);
+		privateKeys.push_back(keygen.GenerateChildPrivateKey(parentKey, firstChildIndex + i).GetPrivateKey());
 	}
 
-	return privateKey.GetPrivateKey();
+	return privateKeys;
+}
+
+PrivateExtKey KeyChain::DeriveExtendedKey(const std::vector<uint32_t>& keyIndices) const
+{
+	// Start from the longest cached prefix of the path, falling back to the master key.
+	size_t depth = keyIndices.size();
+	std::unique_ptr<PrivateExtKey> pCachedKey = nullptr;
+	while (depth > 0)
+	{
+		pCachedKey = m_pCache->Get(std::vector<uint32_t>(keyIndices.cbegin(), keyIndices.cbegin() + depth));
+		if (pCachedKey != nullptr)
+		{
+			break;
+		}
+
+		--depth;
+	}
+
+	PrivateExtKey extendedKey = pCachedKey != nullptr ? *pCachedKey : m_masterKey;
+
+	KeyGenerator keygen(m_config);
+	while (depth < keyIndices.size())
+	{
+		extendedKey = keygen.GenerateChildPrivateKey(extendedKey, keyIndices[depth++]);
+		m_pCache->Put(std::vector<uint32_t>(keyIndices.cbegin(), keyIndices.cbegin() + depth), extendedKey);
+	}
+
+	return extendedKey;
 }
 
 SecretKey KeyChain::DerivePrivateKey(const KeyChainPath& keyPath, const uint64_t amount) const
@@ -61,11 +111,7 @@ std::unique_ptr<RewoundProof> KeyChain::RewindRangeProof(const Commitment& commi
 	}
 	else if (bulletproofType == EBulletproofType::ENHANCED)
 	{
-		PublicKey masterPublicKey = Crypto::CalculatePublicKey(m_masterKey.GetPrivateKey());
-
-		const SecretKey rewindNonceHash = Crypto::Blake2b(masterPublicKey.GetCompressedVec());
-
-		return Crypto::RewindRangeProof(commitment, rangeProof, CreateNonce(commitment, rewindNonceHash));
+		return Crypto::RewindRangeProof(commitment, rangeProof, CreateNonce(commitment, m_rewindNonceHash));
 	}
 
 	throw UNIMPLEMENTED_EXCEPTION;
@@ -88,12 +134,7 @@ RangeProof KeyChain::GenerateRangeProof(
 	}
 	else if (bulletproofType == EBulletproofType::ENHANCED)
 	{
-		const SecretKey privateNonceHash = Crypto::Blake2b(m_masterKey.GetPrivateKey().GetVec());
-
-		PublicKey masterPublicKey = Crypto::CalculatePublicKey(m_masterKey.GetPrivateKey());
-		const SecretKey rewindNonceHash = Crypto::Blake2b(masterPublicKey.GetCompressedVec());
-
-		return Crypto::GenerateRangeProof(amount, blindingFactor, CreateNonce(commitment, privateNonceHash), CreateNonce(commitment, rewindNonceHash), proofMessage);
+		return Crypto::GenerateRangeProof(amount, blindingFactor, CreateNonce(commitment, m_privateNonceHash), CreateNonce(commitment, m_rewindNonceHash), proofMessage);
 	}
 	
 	throw UNIMPLEMENTED_EXCEPTION;
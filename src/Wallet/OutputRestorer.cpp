@@ -5,8 +5,13 @@
 #include <Consensus/BlockTime.h>
 #include <Consensus/HardForks.h>
 #include <Infrastructure/Logger.h>
+#include <scheduler/ctpl_stl.h>
+#include <future>
+#include <thread>
 
 static const uint64_t NUM_OUTPUTS_PER_BATCH = 1000;
+static const uint64_t NUM_BATCHES_PER_CHECKPOINT = 10;
+static const size_t NUM_OUTPUTS_PER_TASK = 50;
 
 OutputRestorer::OutputRestorer(const Config& config, INodeClientConstPtr pNodeClient, const KeyChain& keyChain)
 	: m_config(config), m_pNodeClient(pNodeClient), m_keyChain(keyChain)
@@ -14,40 +19,100 @@ OutputRestorer::OutputRestorer(const Config& config, INodeClientConstPtr pNodeCl
 
 }
 
-std::vector<OutputDataEntity> OutputRestorer::FindAndRewindOutputs(Writer<IWalletDB> pBatch, const bool fromGenesis) const
+void OutputRestorer::FindAndRewindOutputs(
+	Writer<IWalletDB> pBatch,
+	const bool fromGenesis,
+	const std::function<void(std::vector<OutputDataEntity>&&)>& onCheckpoint) const
 {
 	const uint64_t chainHeight = m_pNodeClient->GetChainHeight();
 
 	uint64_t nextLeafIndex = fromGenesis ? 0 : pBatch->GetRestoreLeafIndex() + 1;
 
+	std::unique_ptr<OutputRange> pOutputRange = m_pNodeClient->GetOutputsByLeafIndex(nextLeafIndex, NUM_OUTPUTS_PER_BATCH);
+	if (pOutputRange == nullptr || pOutputRange->GetLastRetrievedIndex() == 0)
+	{
+		// No new outputs since last restore
+		return;
+	}
+
+	const int numWorkers = (std::max)(1, (int)std::thread::hardware_concurrency());
+	ctpl::thread_pool workers(numWorkers);
+
 	std::vector<OutputDataEntity> walletOutputs;
+	uint64_t numBatches = 0;
 	while (true)
 	{
-		std::unique_ptr<OutputRange> pOutputRange = m_pNodeClient->GetOutputsByLeafIndex(nextLeafIndex, NUM_OUTPUTS_PER_BATCH);
-		if (pOutputRange == nullptr || pOutputRange->GetLastRetrievedIndex() == 0)
+		nextLeafIndex = pOutputRange->GetLastRetrievedIndex() + 1;
+		const uint64_t highestIndex = pOutputRange->GetHighestIndex();
+		const bool lastBatch = nextLeafIndex > highestIndex;
+
+		// Prefetch the next page while the current one is being rewound.
+		std::future<std::unique_ptr<OutputRange>> nextOutputRange;
+		if (!lastBatch)
 		{
-			// No new outputs since last restore
-			return std::vector<OutputDataEntity>();
+			nextOutputRange = std::async(std::launch::async, [this, nextLeafIndex]() {
+				return m_pNodeClient->GetOutputsByLeafIndex(nextLeafIndex, NUM_OUTPUTS_PER_BATCH);
+			});
 		}
 
-		const std::vector<OutputDTO>& outputs = pOutputRange->GetOutputs();
-		for (const OutputDTO& output : outputs)
+		std::vector<OutputDataEntity> found = ScanOutputs(workers, pOutputRange->GetOutputs(), chainHeight);
+		std::move(found.begin(), found.end(), std::back_inserter(walletOutputs));
+
+		if (lastBatch || ++numBatches % NUM_BATCHES_PER_CHECKPOINT == 0)
 		{
-			std::unique_ptr<OutputDataEntity> pOutputDataEntity = GetWalletOutput(output, chainHeight);
-			if (pOutputDataEntity != nullptr)
-			{
-				walletOutputs.emplace_back(*pOutputDataEntity);
-			}
+			WALLET_INFO_F("Scanned outputs up to leaf index {} of {}", nextLeafIndex - 1, highestIndex);
+
+			pBatch->UpdateRestoreLeafIndex(nextLeafIndex - 1);
+			onCheckpoint(std::move(walletOutputs));
+			walletOutputs.clear();
 		}
 
-		nextLeafIndex = pOutputRange->GetLastRetrievedIndex() + 1;
-		if (nextLeafIndex > pOutputRange->GetHighestIndex())
+		if (lastBatch)
+		{
+			break;
+		}
+
+		pOutputRange = nextOutputRange.get();
+		if (pOutputRange == nullptr || pOutputRange->GetLastRetrievedIndex() == 0)
 		{
+			// Node is no longer responding. The scan will resume from the last checkpoint next time.
+			WALLET_WARNING_F("Failed to retrieve outputs starting at leaf index {}", nextLeafIndex);
 			break;
 		}
 	}
+}
+
+std::vector<OutputDataEntity> OutputRestorer::ScanOutputs(
+	ctpl::thread_pool& workers,
+	const std::vector<OutputDTO>& outputs,
+	const uint64_t currentBlockHeight) const
+{
+	std::vector<std::future<std::vector<OutputDataEntity>>> tasks;
+	for (size_t begin = 0; begin < outputs.size(); begin += NUM_OUTPUTS_PER_TASK)
+	{
+		const size_t end = (std::min)(begin + NUM_OUTPUTS_PER_TASK, outputs.size());
+		tasks.push_back(workers.push([this, &outputs, begin, end, currentBlockHeight](int) {
+			std::vector<OutputDataEntity> found;
+			for (size_t i = begin; i < end; i++)
+			{
+				std::unique_ptr<OutputDataEntity> pOutputDataEntity = GetWalletOutput(outputs[i], currentBlockHeight);
+				if (pOutputDataEntity != nullptr)
+				{
+					found.emplace_back(std::move(*pOutputDataEntity));
+				}
+			}
+
+			return found;
+		}));
+	}
 
-	pBatch->UpdateRestoreLeafIndex(nextLeafIndex - 1);
+	// Collect the results in leaf index order.
+	std::vector<OutputDataEntity> walletOutputs;
+	for (auto& task : tasks)
+	{
+		std::vector<OutputDataEntity> found = task.get();
+		std::move(found.begin(), found.end(), std::back_inserter(walletOutputs));
+	}
 
 	return walletOutputs;
 }
@@ -5,18 +5,36 @@
 #include <Wallet/NodeClient.h>
 #include <Config/Config.h>
 #include <Core/Models/DTOs/OutputDTO.h>
+#include <functional>
+
+// Forward Declarations
+namespace ctpl { class thread_pool; }
 
 class OutputRestorer
 {
 public:
 	OutputRestorer(const Config& config, INodeClientConstPtr pNodeClient, const KeyChain& keyChain);
 
-	std::vector<OutputDataEntity> FindAndRewindOutputs(
+	//
+	// Scans all outputs added since the last restore, and rewinds their rangeproofs to find the wallet's own outputs.
+	// Pages are scanned across a pool of workers while the next page is fetched from the node.
+	//
+	// Every few pages (and once at the end) the restore leaf index is updated and onCheckpoint is called with the
+	// outputs found since the previous checkpoint. Committing the batch from within onCheckpoint makes the scan resumable.
+	//
+	void FindAndRewindOutputs(
 		Writer<IWalletDB> pBatch,
-		const bool fromGenesis
+		const bool fromGenesis,
+		const std::function<void(std::vector<OutputDataEntity>&&)>& onCheckpoint
 	) const;
 
 private:
+	std::vector<OutputDataEntity> ScanOutputs(
+		ctpl::thread_pool& workers,
+		const std::vector<OutputDTO>& outputs,
+		const uint64_t currentBlockHeight
+	) const;
+
 	std::unique_ptr<OutputDataEntity> GetWalletOutput(
 		const OutputDTO& output,
 		const uint64_t currentBlockHeight
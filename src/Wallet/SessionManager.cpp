@@ -178,6 +178,7 @@ void SessionManager::Logout(const SessionToken& token)
 	if (iter != m_sessionsById.end())
 	{
 		m_pForeignController->StopListener(iter->second->m_wallet.Read()->GetUsername());
+		iter->second->m_wallet.Write()->ClearKeyCache();
 		m_sessionsById.erase(iter);
 	}
 }
@@ -3,15 +3,21 @@
 #include <Wallet/WalletUtil.h>
 #include <Wallet/Exceptions/InsufficientFundsException.h>
 #include <Infrastructure/Logger.h>
+#include <numeric>
+
+// Bitcoin Core's limit. Enough to find a match in wallets with thousands of coins, without noticeably delaying a send.
+static const size_t MAX_BNB_TRIES = 100'000;
 
 // If strategy is "ALL", spend all available coins to reduce the fee.
+// If strategy is "BRANCH_AND_BOUND", look for coins that don't need change, falling back to "SMALLEST".
 std::vector<OutputDataEntity> CoinSelection::SelectCoinsToSpend(
-	const std::vector<OutputDataEntity>& availableCoins, 
+	const CoinIndex& availableCoins,
 	const uint64_t amount,
 	const uint64_t feeBase,
 	const ESelectionStrategy& strategy,
 	const std::set<Commitment>& inputs,
 	const int64_t numOutputs,
+	const int64_t numChangeOutputs,
 	const int64_t numKernels)
 {
 	if (strategy == ESelectionStrategy::CUSTOM)
@@ -26,24 +32,70 @@ std::vector<OutputDataEntity> CoinSelection::SelectCoinsToSpend(
 	{
 		return SelectUsingAllInputs(availableCoins, amount, feeBase, numOutputs, numKernels);
 	}
+	else if (strategy == ESelectionStrategy::BRANCH_AND_BOUND)
+	{
+		auto selectedCoinsOpt = SelectUsingBranchAndBound(availableCoins, amount, feeBase, numOutputs, numChangeOutputs, numKernels);
+		if (selectedCoinsOpt.has_value())
+		{
+			return selectedCoinsOpt.value();
+		}
+
+		WALLET_DEBUG("No changeless selection found. Selecting smallest inputs instead.");
+		return SelectUsingSmallestInputs(availableCoins, amount, feeBase, numOutputs, numKernels);
+	}
 
 	WALLET_ERROR("Unsupported selection strategy used.");
 	throw InsufficientFundsException();
 }
 
-std::vector<OutputDataEntity> CoinSelection::SelectUsingSmallestInputs(
-	const std::vector<OutputDataEntity>& availableCoins,
+bool CoinSelection::CanAvoidChange(
+	const std::vector<OutputDataEntity>& inputs,
 	const uint64_t amount,
 	const uint64_t feeBase,
 	const int64_t numOutputs,
+	const int64_t numChangeOutputs,
 	const int64_t numKernels)
 {
-	std::vector<OutputDataEntity> sortedCoins = availableCoins;
-	std::sort(sortedCoins.begin(), sortedCoins.end());
+	if (numChangeOutputs <= 0)
+	{
+		return false;
+	}
 
+	const uint64_t inputTotal = std::accumulate(
+		inputs.cbegin(), inputs.cend(), (uint64_t)0,
+		[](const uint64_t sum, const OutputDataEntity& input) { return sum + input.GetAmount(); }
+	);
+
+	const uint64_t changeFee = WalletUtil::CalculateFee(feeBase, 0, numOutputs, numKernels)
+		- WalletUtil::CalculateFee(feeBase, 0, numOutputs - numChangeOutputs, numKernels);
+	const uint64_t target = amount + WalletUtil::CalculateFee(feeBase, inputs.size(), numOutputs - numChangeOutputs, numKernels);
+
+	return inputTotal >= target && (inputTotal - target) <= changeFee;
+}
+
+bool CoinSelection::ShouldAvoidChange(
+	const ESelectionStrategy& strategy,
+	const std::vector<OutputDataEntity>& inputs,
+	const uint64_t amount,
+	const uint64_t feeBase,
+	const int64_t numOutputs,
+	const int64_t numChangeOutputs,
+	const int64_t numKernels)
+{
+	return strategy == ESelectionStrategy::BRANCH_AND_BOUND
+		&& CanAvoidChange(inputs, amount, feeBase, numOutputs, numChangeOutputs, numKernels);
+}
+
+std::vector<OutputDataEntity> CoinSelection::SelectUsingSmallestInputs(
+	const CoinIndex& availableCoins,
+	const uint64_t amount,
+	const uint64_t feeBase,
+	const int64_t numOutputs,
+	const int64_t numKernels)
+{
 	uint64_t amountFound = 0;
 	std::vector<OutputDataEntity> selectedCoins;
-	for (const OutputDataEntity& coin : sortedCoins)
+	for (const OutputDataEntity& coin : availableCoins.GetCoins())
 	{
 		amountFound += coin.GetAmount();
 		selectedCoins.push_back(coin);
@@ -61,21 +113,15 @@ std::vector<OutputDataEntity> CoinSelection::SelectUsingSmallestInputs(
 }
 
 std::vector<OutputDataEntity> CoinSelection::SelectUsingAllInputs(
-	const std::vector<OutputDataEntity>& availableCoins,
+	const CoinIndex& availableCoins,
 	const uint64_t amount,
 	const uint64_t feeBase,
 	const int64_t numOutputs,
 	const int64_t numKernels)
 {
-	uint64_t amountFound = 0;
-	for (const OutputDataEntity& coin : availableCoins)
-	{
-		amountFound += coin.GetAmount();
-	}
-
-	const uint64_t fee = WalletUtil::CalculateFee(feeBase, (int64_t)availableCoins.size(), numOutputs, numKernels);
-	if (amount < amount + fee) {
-		return availableCoins;
+	const uint64_t fee = WalletUtil::CalculateFee(feeBase, (int64_t)availableCoins.GetCoins().size(), numOutputs, numKernels);
+	if (availableCoins.GetTotal() >= (amount + fee)) {
+		return availableCoins.GetCoins();
 	}
 
 	// Not enough coins found.
@@ -84,7 +130,7 @@ std::vector<OutputDataEntity> CoinSelection::SelectUsingAllInputs(
 }
 
 std::vector<OutputDataEntity> CoinSelection::SelectUsingCustomInputs(
-	const std::vector<OutputDataEntity>& availableCoins,
+	const CoinIndex& availableCoins,
 	const uint64_t amount,
 	const uint64_t feeBase,
 	const std::set<Commitment>& inputs,
@@ -93,7 +139,7 @@ std::vector<OutputDataEntity> CoinSelection::SelectUsingCustomInputs(
 {
 	uint64_t amountFound = 0;
 	std::vector<OutputDataEntity> selectedCoins;
-	for (const OutputDataEntity& coin : availableCoins)
+	for (const OutputDataEntity& coin : availableCoins.GetCoins())
 	{
 		if (inputs.find(coin.GetOutput().GetCommitment()) != inputs.end())
 		{
@@ -111,4 +157,121 @@ std::vector<OutputDataEntity> CoinSelection::SelectUsingCustomInputs(
 	// Not enough coins selected.
 	WALLET_ERROR("Not enough funds.");
 	throw InsufficientFundsException();
+}
+
+//
+// Depth-first search for the coins that cover the amount and the fee of a transaction without change,
+// leaving as little as possible over, and never more than the change outputs would have cost.
+// Coins are tried largest first, including each coin before trying without it.
+// Branches are cut once they overshoot, or once even the remaining coins can't reach the target.
+// Adding a coin never raises the fee, so neither cut can skip a better selection.
+// Based on Bitcoin Core's SelectCoinsBnB.
+//
+std::optional<std::vector<OutputDataEntity>> CoinSelection::SelectUsingBranchAndBound(
+	const CoinIndex& availableCoins,
+	const uint64_t amount,
+	const uint64_t feeBase,
+	const int64_t numOutputs,
+	const int64_t numChangeOutputs,
+	const int64_t numKernels)
+{
+	const std::vector<OutputDataEntity>& sortedCoins = availableCoins.GetCoins();
+	const size_t numCoins = sortedCoins.size();
+	const auto getAmount = [&sortedCoins, numCoins](const size_t index) { return sortedCoins[numCoins - 1 - index].GetAmount(); };
+
+	const int64_t numOutputsWithoutChange = numOutputs - numChangeOutputs;
+	const auto getTarget = [amount, feeBase, numOutputsWithoutChange, numKernels](const size_t numInputs) {
+		return amount + WalletUtil::CalculateFee(feeBase, numInputs, numOutputsWithoutChange, numKernels);
+	};
+
+	const uint64_t changeFee = numChangeOutputs > 0 ? WalletUtil::CalculateFee(feeBase, 0, numOutputs, numKernels)
+		- WalletUtil::CalculateFee(feeBase, 0, numOutputsWithoutChange, numKernels) : 0;
+
+	std::vector<size_t> selected; // Indices (largest first) of the coins on the current branch.
+	std::optional<std::vector<size_t>> bestOpt = std::nullopt;
+	uint64_t bestExcess = 0;
+
+	uint64_t selectedTotal = 0;
+	uint64_t remainingTotal = availableCoins.GetTotal(); // Total of the coins not yet decided on.
+	size_t index = 0;
+	for (size_t tries = 0; tries < MAX_BNB_TRIES; tries++)
+	{
+		const uint64_t target = getTarget(selected.size());
+
+		bool backtrack = false;
+		if (selectedTotal + remainingTotal < getTarget(selected.size() + (numCoins - index)))
+		{
+			backtrack = true;
+		}
+		else if (selectedTotal > target + changeFee)
+		{
+			backtrack = true;
+		}
+		else if (selectedTotal >= target)
+		{
+			const uint64_t excess = selectedTotal - target;
+			if (!bestOpt.has_value() || excess < bestExcess)
+			{
+				bestOpt = std::make_optional<std::vector<size_t>>(selected);
+				bestExcess = excess;
+				if (excess == 0)
+				{
+					break;
+				}
+			}
+
+			backtrack = true;
+		}
+		else if (index == numCoins)
+		{
+			backtrack = true;
+		}
+
+		if (backtrack)
+		{
+			if (selected.empty())
+			{
+				break;
+			}
+
+			// Undo the coins left out since the last one included, and leave that one out instead.
+			for (--index; index > selected.back(); --index)
+			{
+				remainingTotal += getAmount(index);
+			}
+
+			selectedTotal -= getAmount(index);
+			selected.pop_back();
+			++index;
+		}
+		else
+		{
+			const uint64_t coinAmount = getAmount(index);
+			remainingTotal -= coinAmount;
+
+			// Including a coin worth the same as the one just left out would only repeat that branch.
+			const bool previousLeftOut = index > 0 && (selected.empty() || selected.back() != index - 1);
+			if (!previousLeftOut || coinAmount != getAmount(index - 1))
+			{
+				selected.push_back(index);
+				selectedTotal += coinAmount;
+			}
+
+			++index;
+		}
+	}
+
+	if (!bestOpt.has_value())
+	{
+		return std::nullopt;
+	}
+
+	std::vector<OutputDataEntity> selectedCoins;
+	selectedCoins.reserve(bestOpt.value().size());
+	for (const size_t selectedIndex : bestOpt.value())
+	{
+		selectedCoins.push_back(sortedCoins[numCoins - 1 - selectedIndex]);
+	}
+
+	return std::make_optional<std::vector<OutputDataEntity>>(std::move(selectedCoins));
 }
\ No newline at end of file
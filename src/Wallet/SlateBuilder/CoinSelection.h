@@ -2,24 +2,59 @@
 
 #include <Wallet/WalletDB/Models/OutputDataEntity.h>
 #include <Wallet/Enums/SelectionStrategy.h>
+#include "../CoinIndex.h"
+#include <optional>
 #include <set>
 
 class CoinSelection
 {
 public:
+	//
+	// numOutputs includes the numChangeOutputs the transaction will have if the selection doesn't avoid change.
+	//
 	static std::vector<OutputDataEntity> SelectCoinsToSpend(
-		const std::vector<OutputDataEntity>& availableCoins,
+		const CoinIndex& availableCoins,
 		const uint64_t amount,
 		const uint64_t feeBase,
 		const ESelectionStrategy& strategy,
 		const std::set<Commitment>& inputs,
 		const int64_t numOutputs,
+		const int64_t numChangeOutputs,
+		const int64_t numKernels
+	);
+
+	//
+	// True if the inputs cover the amount plus the fee of a transaction without its change outputs,
+	// with no more left over than those change outputs would have added to the fee.
+	// The leftover can then be paid as fee, instead of being sent back as change.
+	//
+	static bool CanAvoidChange(
+		const std::vector<OutputDataEntity>& inputs,
+		const uint64_t amount,
+		const uint64_t feeBase,
+		const int64_t numOutputs,
+		const int64_t numChangeOutputs,
+		const int64_t numKernels
+	);
+
+	//
+	// True if the send should leave out its change outputs, paying the leftover as fee.
+	// Only BRANCH_AND_BOUND opts into this, since it's the only strategy that searches for a selection close to the target.
+	// The other strategies would otherwise give up to the change outputs' share of the fee to whatever they happen to select.
+	//
+	static bool ShouldAvoidChange(
+		const ESelectionStrategy& strategy,
+		const std::vector<OutputDataEntity>& inputs,
+		const uint64_t amount,
+		const uint64_t feeBase,
+		const int64_t numOutputs,
+		const int64_t numChangeOutputs,
 		const int64_t numKernels
 	);
 
 private:
 	static std::vector<OutputDataEntity> SelectUsingSmallestInputs(
-		const std::vector<OutputDataEntity>& availableCoins,
+		const CoinIndex& availableCoins,
 		const uint64_t amount,
 		const uint64_t feeBase,
 		const int64_t numOutputs,
@@ -27,7 +62,7 @@ private:
 	);
 
 	static std::vector<OutputDataEntity> SelectUsingAllInputs(
-		const std::vector<OutputDataEntity>& availableCoins,
+		const CoinIndex& availableCoins,
 		const uint64_t amount,
 		const uint64_t feeBase,
 		const int64_t numOutputs,
@@ -35,11 +70,20 @@ private:
 	);
 
 	static std::vector<OutputDataEntity> SelectUsingCustomInputs(
-		const std::vector<OutputDataEntity>& availableCoins,
+		const CoinIndex& availableCoins,
 		const uint64_t amount,
 		const uint64_t feeBase,
 		const std::set<Commitment>& inputs,
 		const int64_t numOutputs,
 		const int64_t numKernels
 	);
+
+	static std::optional<std::vector<OutputDataEntity>> SelectUsingBranchAndBound(
+		const CoinIndex& availableCoins,
+		const uint64_t amount,
+		const uint64_t feeBase,
+		const int64_t numOutputs,
+		const int64_t numChangeOutputs,
+		const int64_t numKernels
+	);
 };
\ No newline at end of file
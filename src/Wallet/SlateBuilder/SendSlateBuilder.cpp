@@ -29,28 +29,37 @@ Slate SendSlateBuilder::BuildSendSlate(
 	const SelectionStrategyDTO& strategy,
 	const uint16_t slateVersion) const
 {
-	const uint8_t numChangeOutputs = sendEntireBalance ? 0 : maxChangeOutputs;
-	const uint8_t totalNumOutputs = 1 + numChangeOutputs;
+	const uint8_t maxNumChangeOutputs = sendEntireBalance ? 0 : maxChangeOutputs;
 	const uint64_t numKernels = 1;
 
 	// Select inputs using desired selection strategy.
 	auto pWallet = wallet.Write();
-	const std::vector<OutputDataEntity> availableCoins = pWallet->GetAllAvailableCoins(masterSeed);
+	const CoinIndex::CPtr pAvailableCoins = pWallet->GetAvailableCoins(masterSeed);
 
 	// Filter all coins to find inputs to spend
-	std::vector<OutputDataEntity> inputs = availableCoins;
-	if (!sendEntireBalance)
-	{
-		inputs = CoinSelection::SelectCoinsToSpend(
-			availableCoins,
-			amount,
-			feeBase,
-			strategy.GetStrategy(),
-			strategy.GetInputs(),
-			totalNumOutputs,
-			numKernels
-		);
-	}
+	std::vector<OutputDataEntity> inputs = sendEntireBalance ? pAvailableCoins->GetCoins() : CoinSelection::SelectCoinsToSpend(
+		*pAvailableCoins,
+		amount,
+		feeBase,
+		strategy.GetStrategy(),
+		strategy.GetInputs(),
+		1 + maxNumChangeOutputs,
+		maxNumChangeOutputs,
+		numKernels
+	);
+
+	// Inputs that BRANCH_AND_BOUND found close enough to the amount and fee don't need change. What's left over goes to the fee instead.
+	const bool avoidChange = CoinSelection::ShouldAvoidChange(
+		strategy.GetStrategy(),
+		inputs,
+		amount,
+		feeBase,
+		1 + maxNumChangeOutputs,
+		maxNumChangeOutputs,
+		numKernels
+	);
+	const uint8_t numChangeOutputs = avoidChange ? 0 : maxNumChangeOutputs;
+	const uint8_t totalNumOutputs = 1 + numChangeOutputs;
 
 	const uint64_t inputTotal = std::accumulate(
 		inputs.cbegin(), inputs.cend(), (uint64_t)0,
@@ -76,7 +85,7 @@ Slate SendSlateBuilder::BuildSendSlate(
 		masterSeed,
 		amountToSend,
 		fee,
-		sendEntireBalance ? 0 : numChangeOutputs,
+		numChangeOutputs,
 		inputs,
 		addressOpt,
 		slateVersion
@@ -8,7 +8,7 @@
 #include <unordered_set>
 
 Wallet::Wallet(const Config& config, INodeClientConstPtr pNodeClient, Locked<IWalletDB> walletDB, const std::string& username, KeyChainPath&& userPath, const SlatepackAddress& address)
-	: m_config(config), m_pNodeClient(pNodeClient), m_walletDB(walletDB), m_username(username), m_userPath(std::move(userPath)), m_address(address)
+	: m_config(config), m_pNodeClient(pNodeClient), m_walletDB(walletDB), m_username(username), m_userPath(std::move(userPath)), m_address(address), m_pKeyCache(std::make_shared<KeyChainCache>()), m_coinIndexVersion(0)
 {
 
 }
@@ -113,26 +113,55 @@ WalletBalanceDTO Wallet::GetBalance(const SecureVector& masterSeed)
 
 std::vector<OutputDataEntity> Wallet::RefreshOutputs(const SecureVector& masterSeed, const bool fromGenesis)
 {
-	return WalletRefresher(m_config, m_pNodeClient).Refresh(masterSeed, m_walletDB, fromGenesis);
+	return WalletRefresher(m_config, m_pNodeClient, m_pKeyCache).Refresh(masterSeed, m_walletDB, fromGenesis);
 }
 
-std::vector<OutputDataEntity> Wallet::GetAllAvailableCoins(const SecureVector& masterSeed)
+CoinIndex::CPtr Wallet::GetAvailableCoins(const SecureVector& masterSeed)
 {
-	const KeyChain keyChain = KeyChain::FromSeed(m_config, masterSeed);
+	// Spendable coins only change when outputs are written: by the refresher as blocks confirm, spend, or mature them,
+	// or by sends, receives, and cancels locking and adding them. Each write bumps the outputs version.
+	if (m_pCoinIndex != nullptr && IsRefreshedToTip() && m_walletDB.Read()->GetOutputsVersion() == m_coinIndexVersion)
+	{
+		return m_pCoinIndex;
+	}
 
-	std::vector<OutputDataEntity> coins;
+	RefreshOutputs(masterSeed, false);
 
-	std::vector<Commitment> commitments;
-	const std::vector<OutputDataEntity> outputs = RefreshOutputs(masterSeed, false);
-	for (const OutputDataEntity& output : outputs)
+	auto pWalletDB = m_walletDB.Read();
+	const uint64_t outputsVersion = pWalletDB->GetOutputsVersion();
+	if (m_pCoinIndex == nullptr || outputsVersion != m_coinIndexVersion)
 	{
-		if (output.GetStatus() == EOutputStatus::SPENDABLE)
+		std::vector<OutputDataEntity> coins;
+
+		std::vector<OutputDataEntity> outputs = pWalletDB->GetOutputs(masterSeed);
+		for (OutputDataEntity& output : outputs)
 		{
-			coins.emplace_back(output);
+			if (output.GetStatus() == EOutputStatus::SPENDABLE)
+			{
+				coins.emplace_back(std::move(output));
+			}
 		}
+
+		m_pCoinIndex = std::make_shared<const CoinIndex>(std::move(coins));
+		m_coinIndexVersion = outputsVersion;
+	}
+
+	return m_pCoinIndex;
+}
+
+bool Wallet::IsRefreshedToTip() const
+{
+	const uint64_t chainHeight = m_pNodeClient->GetChainHeight();
+
+	auto pWalletDB = m_walletDB.Read();
+	const std::optional<Hash> refreshBlockHashOpt = pWalletDB->GetRefreshBlockHash();
+	if (pWalletDB->GetRefreshBlockHeight() != chainHeight || !refreshBlockHashOpt.has_value())
+	{
+		return false;
 	}
 
-	return coins;
+	auto pTipHeader = m_pNodeClient->GetBlockHeader(chainHeight);
+	return pTipHeader != nullptr && pTipHeader->GetHash() == refreshBlockHashOpt.value();
 }
 
 OutputDataEntity Wallet::CreateBlindedOutput(
@@ -142,7 +171,7 @@ OutputDataEntity Wallet::CreateBlindedOutput(
 	const uint32_t walletTxId,
 	const EBulletproofType& bulletproofType)
 {
-	const KeyChain keyChain = KeyChain::FromSeed(m_config, masterSeed);
+	const KeyChain keyChain = KeyChain::FromSeed(m_config, masterSeed, m_pKeyCache);
 
 	SecretKey blindingFactor = keyChain.DerivePrivateKey(keyChainPath, amount);
 	Commitment commitment = Crypto::CommitBlinded(amount, BlindingFactor(blindingFactor.GetBytes()));
@@ -171,7 +200,7 @@ BuildCoinbaseResponse Wallet::CreateCoinbase(
 	const uint64_t fees,
 	const std::optional<KeyChainPath>& keyChainPathOpt)
 {
-	const KeyChain keyChain = KeyChain::FromSeed(m_config, masterSeed);
+	const KeyChain keyChain = KeyChain::FromSeed(m_config, masterSeed, m_pKeyCache);
 
 	auto pDatabase = m_walletDB.BatchWrite();
 
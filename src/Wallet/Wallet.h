@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Wallet/Keychain/KeyChain.h>
+#include "CoinIndex.h"
 
 #include <uuid.h>
 #include <optional>
@@ -45,6 +46,11 @@ public:
 	void SetListenerPort(const uint16_t port) { m_listenerPort = port; }
 	uint16_t GetListenerPort() const { return m_listenerPort; }
 
+	//
+	// Erases the intermediate keys cached for this session. Called on logout.
+	//
+	void ClearKeyCache() { m_pKeyCache->Clear(); }
+
 	WalletSummaryDTO GetWalletSummary(const SecureVector& masterSeed);
 	WalletBalanceDTO GetBalance(const SecureVector& masterSeed);
 
@@ -53,7 +59,12 @@ public:
 
 	std::vector<OutputDataEntity> RefreshOutputs(const SecureVector& masterSeed, const bool fromGenesis);
 
-	std::vector<OutputDataEntity> GetAllAvailableCoins(const SecureVector& masterSeed);
+	//
+	// Returns the spendable coins, sorted by amount.
+	// The index is reused until the wallet's outputs change. Outputs are only refreshed if the chain has moved since the last refresh.
+	//
+	CoinIndex::CPtr GetAvailableCoins(const SecureVector& masterSeed);
+
 	OutputDataEntity CreateBlindedOutput(
 		const SecureVector& masterSeed,
 		const uint64_t amount,
@@ -69,6 +80,9 @@ public:
 	);
 
 private:
+	// True if the outputs were last refreshed at the current chain tip, so refreshing again would find nothing new.
+	bool IsRefreshedToTip() const;
+
 	Wallet(
 		const Config& config,
 		INodeClientConstPtr pNodeClient,
@@ -86,4 +100,7 @@ private:
 	SlatepackAddress m_address;
 	std::optional<TorAddress> m_torAddressOpt;
 	uint16_t m_listenerPort;
+	KeyChainCache::Ptr m_pKeyCache;
+	CoinIndex::CPtr m_pCoinIndex;
+	uint64_t m_coinIndexVersion; // IWalletDB::GetOutputsVersion() the index was built from
 };
\ No newline at end of file
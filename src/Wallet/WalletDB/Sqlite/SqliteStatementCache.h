@@ -0,0 +1,156 @@
+#pragma once
+
+#include <libsqlite3/sqlite3.h>
+#include <Wallet/WalletDB/WalletStoreException.h>
+#include <Infrastructure/Logger.h>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+//
+// Keeps compiled statements for the lifetime of a connection, keyed by their SQL,
+// so frequently used statements (ie. saving outputs) are only compiled once instead of on every call.
+//
+// A cached statement is only handed to one caller at a time. If the same SQL is requested
+// while its cached statement is still in use (ie. by a concurrent Reader), a one-off statement is compiled instead.
+//
+// Clear() must be called before closing the connection, since sqlite3_close fails while statements are unfinalized.
+//
+class SqliteStatementCache
+{
+	struct Entry
+	{
+		sqlite3_stmt* pStatement;
+		bool inUse;
+	};
+
+public:
+	//
+	// A compiled statement, ready to be bound and stepped.
+	// When destroyed, it's reset and returned to the cache, or finalized if it wasn't cached.
+	//
+	class Statement
+	{
+	public:
+		Statement(SqliteStatementCache& cache, sqlite3_stmt* pStatement, Entry* pEntry)
+			: m_cache(cache), m_pStatement(pStatement), m_pEntry(pEntry) { }
+
+		Statement(Statement&& other) noexcept
+			: m_cache(other.m_cache), m_pStatement(other.m_pStatement), m_pEntry(other.m_pEntry)
+		{
+			other.m_pStatement = nullptr;
+			other.m_pEntry = nullptr;
+		}
+
+		Statement(const Statement&) = delete;
+		Statement& operator=(const Statement&) = delete;
+		Statement& operator=(Statement&&) = delete;
+
+		~Statement()
+		{
+			if (m_pStatement != nullptr)
+			{
+				m_cache.Release(m_pStatement, m_pEntry);
+			}
+		}
+
+		sqlite3_stmt* Get() const noexcept { return m_pStatement; }
+
+		//
+		// Rewinds the statement and clears its bindings, so it can be executed again with new values.
+		//
+		void Reset()
+		{
+			sqlite3_reset(m_pStatement);
+			sqlite3_clear_bindings(m_pStatement);
+		}
+
+	private:
+		SqliteStatementCache& m_cache;
+		sqlite3_stmt* m_pStatement;
+		Entry* m_pEntry;
+	};
+
+	SqliteStatementCache(sqlite3& database) : m_database(database) { }
+	~SqliteStatementCache() { Clear(); }
+
+	SqliteStatementCache(const SqliteStatementCache&) = delete;
+	SqliteStatementCache& operator=(const SqliteStatementCache&) = delete;
+
+	sqlite3& GetDatabase() const noexcept { return m_database; }
+
+	Statement Prepare(const std::string& sql)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+
+			auto iter = m_entries.find(sql);
+			if (iter == m_entries.end())
+			{
+				sqlite3_stmt* pStatement = Compile(sql);
+				iter = m_entries.emplace(sql, Entry{ pStatement, false }).first;
+			}
+
+			if (!iter->second.inUse)
+			{
+				iter->second.inUse = true;
+				return Statement(*this, iter->second.pStatement, &iter->second);
+			}
+		}
+
+		return Statement(*this, Compile(sql), nullptr);
+	}
+
+	//
+	// Finalizes all cached statements.
+	//
+	void Clear()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		for (auto& entry : m_entries)
+		{
+			if (entry.second.inUse)
+			{
+				WALLET_ERROR_F("Finalizing statement that is still in use: {}", entry.first);
+			}
+
+			sqlite3_finalize(entry.second.pStatement);
+		}
+
+		m_entries.clear();
+	}
+
+private:
+	sqlite3_stmt* Compile(const std::string& sql)
+	{
+		sqlite3_stmt* pStatement = nullptr;
+		if (sqlite3_prepare_v2(&m_database, sql.c_str(), (int)sql.size() + 1, &pStatement, NULL) != SQLITE_OK)
+		{
+			WALLET_ERROR_F("Error while compiling sql: {}", sqlite3_errmsg(&m_database));
+			sqlite3_finalize(pStatement);
+			throw WALLET_STORE_EXCEPTION("Error compiling statement.");
+		}
+
+		return pStatement;
+	}
+
+	void Release(sqlite3_stmt* pStatement, Entry* pEntry)
+	{
+		if (pEntry == nullptr)
+		{
+			sqlite3_finalize(pStatement);
+			return;
+		}
+
+		sqlite3_reset(pStatement);
+		sqlite3_clear_bindings(pStatement);
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		pEntry->inUse = false;
+	}
+
+	sqlite3& m_database;
+
+	mutable std::mutex m_mutex;
+	std::unordered_map<std::string, Entry> m_entries;
+};
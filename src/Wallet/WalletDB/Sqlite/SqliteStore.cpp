@@ -12,12 +12,23 @@
 #include <Common/Util/FileUtil.h>
 #include <Common/Util/StringUtil.h>
 #include <Infrastructure/Logger.h>
+#include <unordered_set>
 
 static const uint8_t ENCRYPTION_FORMAT = 0;
+static const std::unordered_set<std::string> SYNCHRONOUS_LEVELS = { "OFF", "NORMAL", "FULL", "EXTRA" };
 
 std::shared_ptr<SqliteStore> SqliteStore::Open(const Config& config)
 {
-	return std::make_shared<SqliteStore>(SqliteStore(config.GetWalletConfig().GetWalletDirectory()));
+	const WalletConfig& walletConfig = config.GetWalletConfig();
+
+	std::string synchronous = StringUtil::ToUpper(walletConfig.GetDatabaseSynchronous());
+	if (SYNCHRONOUS_LEVELS.count(synchronous) == 0)
+	{
+		WALLET_WARNING_F("Invalid synchronous level ({}). Using NORMAL instead.", synchronous);
+		synchronous = "NORMAL";
+	}
+
+	return std::make_shared<SqliteStore>(SqliteStore(walletConfig.GetWalletDirectory(), synchronous));
 }
 
 fs::path SqliteStore::GetDBFile(const std::string& username) const
@@ -55,6 +66,8 @@ Locked<IWalletDB> SqliteStore::OpenWallet(const std::string& username, const Sec
 			throw WALLET_STORE_EXCEPTION("Failed to create wallet.db");
 		}
 
+		ConfigureConnection(*pDatabase);
+
 		const int version = VersionTable::GetCurrentVersion(*pDatabase);
 		if (version < LATEST_SCHEMA_VERSION)
 		{
@@ -155,6 +168,8 @@ sqlite3* SqliteStore::CreateWalletDB(const std::string& username)
 
 	try
 	{
+		ConfigureConnection(*pDatabase);
+
 		SqliteTransaction transaction(*pDatabase);
 		transaction.Begin();
 
@@ -190,6 +205,21 @@ sqlite3* SqliteStore::CreateWalletDB(const std::string& username)
 	return pDatabase;
 }
 
+// Uses write-ahead logging, so each commit appends to the log instead of rewriting pages and a rollback journal.
+// In WAL mode, synchronous=NORMAL only syncs at checkpoints, rather than on every commit.
+void SqliteStore::ConfigureConnection(sqlite3& database) const
+{
+	const std::string pragmas = "PRAGMA journal_mode=WAL; PRAGMA synchronous=" + m_synchronous + ";";
+
+	char* error = nullptr;
+	if (sqlite3_exec(&database, pragmas.c_str(), NULL, NULL, &error) != SQLITE_OK)
+	{
+		WALLET_ERROR_F("Failed to configure wallet.db. Error: {}", error);
+		sqlite3_free(error);
+		throw WALLET_STORE_EXCEPTION("Failed to configure wallet.db");
+	}
+}
+
 EncryptedSeed SqliteStore::LoadWalletSeed(const std::string& username) const
 {
 	const auto wideUsername = StringUtil::ToWide(username);
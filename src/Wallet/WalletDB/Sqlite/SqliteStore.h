@@ -20,11 +20,14 @@ public:
 	EncryptedSeed LoadWalletSeed(const std::string& username) const final;
 
 private:
-	SqliteStore(const fs::path& walletDirectory) : m_walletDirectory(walletDirectory) { }
+	SqliteStore(const fs::path& walletDirectory, const std::string& synchronous)
+		: m_walletDirectory(walletDirectory), m_synchronous(synchronous) { }
 
 	sqlite3* CreateWalletDB(const std::string& username);
 	fs::path GetDBFile(const std::string& username) const;
+	void ConfigureConnection(sqlite3& database) const;
 
 	const fs::path& m_walletDirectory;
+	std::string m_synchronous;
 	std::unordered_map<std::string, Locked<IWalletDB>> m_userDBs;
 };
\ No newline at end of file
@@ -9,10 +9,11 @@
 // next_tx_id: INTEGER NOT NULL
 // refresh_block_height: BLOB NOT NULL
 // restore_leaf_index: INTEGER NOT NULL
+// refresh_block_hash: TEXT
 void MetadataTable::CreateTable(sqlite3& database)
 {
-	std::string tableCreation = "create table metadata(id INTEGER PRIMARY KEY, next_tx_id INTEGER NOT NULL, refresh_block_height INTEGER NOT NULL, restore_leaf_index INTEGER NOT NULL);";
-	tableCreation += "insert into metadata values(1, 0, 0, 0);";
+	std::string tableCreation = "create table metadata(id INTEGER PRIMARY KEY, next_tx_id INTEGER NOT NULL, refresh_block_height INTEGER NOT NULL, restore_leaf_index INTEGER NOT NULL, refresh_block_hash TEXT);";
+	tableCreation += "insert into metadata values(1, 0, 0, 0, NULL);";
 
 	char* error = nullptr;
 	if (sqlite3_exec(&database, tableCreation.c_str(), NULL, NULL, &error) != SQLITE_OK)
@@ -25,32 +26,42 @@ void MetadataTable::CreateTable(sqlite3& database)
 
 void MetadataTable::UpdateSchema(sqlite3& database, const int previousVersion)
 {
+	if (previousVersion < 3)
+	{
+		const std::string addColumn = "ALTER TABLE metadata ADD COLUMN refresh_block_hash TEXT";
+
+		char* error = nullptr;
+		if (sqlite3_exec(&database, addColumn.c_str(), NULL, NULL, &error) != SQLITE_OK)
+		{
+			WALLET_ERROR_F("Adding refresh_block_hash column failed with error: {}", error);
+			sqlite3_free(error);
+			throw WALLET_STORE_EXCEPTION("Error updating metadata table.");
+		}
+	}
+
 	if (previousVersion == 0)
 	{
-		UserMetadata metadata = MetadataTable::GetMetadata(database);
+		SqliteStatementCache statements(database);
+		UserMetadata metadata = MetadataTable::GetMetadata(statements);
 		UserMetadata newMetadata(
 			metadata.GetNextTxId(),
 			metadata.GetRefreshBlockHeight(),
+			metadata.GetRefreshBlockHash(),
 			0
 		);
-		SaveMetadata(database, newMetadata);
+		SaveMetadata(statements, newMetadata);
 	}
 
 	return;
 }
 
-UserMetadata MetadataTable::GetMetadata(sqlite3& database)
+UserMetadata MetadataTable::GetMetadata(SqliteStatementCache& statements)
 {
-	UserMetadata metadata(0, 0, 0);
+	UserMetadata metadata(0, 0, std::nullopt, 0);
 
-	sqlite3_stmt* stmt;
-
-	if (sqlite3_prepare_v2(&database, "SELECT next_tx_id, refresh_block_height, restore_leaf_index FROM metadata WHERE ID=1", -1, &stmt, NULL) != SQLITE_OK)
-	{
-		WALLET_ERROR_F("Error while compiling sql: {}", sqlite3_errmsg(&database));
-		sqlite3_finalize(stmt);
-		throw WALLET_STORE_EXCEPTION("Error compiling statement.");
-	}
+	sqlite3& database = statements.GetDatabase();
+	SqliteStatementCache::Statement statement = statements.Prepare("SELECT next_tx_id, refresh_block_height, restore_leaf_index, refresh_block_hash FROM metadata WHERE ID=1");
+	sqlite3_stmt* stmt = statement.Get();
 
 	if (sqlite3_step(stmt) == SQLITE_ROW)
 	{
@@ -58,7 +69,13 @@ UserMetadata MetadataTable::GetMetadata(sqlite3& database)
 		const uint64_t refreshBlockHeight = (uint64_t)sqlite3_column_int64(stmt, 1);
 		const uint64_t restoreLeafIndex = (uint64_t)sqlite3_column_int64(stmt, 2);
 
-		metadata = UserMetadata(nextTxId, refreshBlockHeight, restoreLeafIndex);
+		std::optional<Hash> refreshBlockHashOpt = std::nullopt;
+		if (sqlite3_column_type(stmt, 3) != SQLITE_NULL)
+		{
+			refreshBlockHashOpt = std::make_optional<Hash>(Hash::FromHex(std::string((const char*)sqlite3_column_text(stmt, 3))));
+		}
+
+		metadata = UserMetadata(nextTxId, refreshBlockHeight, refreshBlockHashOpt, restoreLeafIndex);
 	}
 	else
 	{
@@ -66,30 +83,33 @@ UserMetadata MetadataTable::GetMetadata(sqlite3& database)
 		throw WALLET_STORE_EXCEPTION("No metadata found.");
 	}
 
-
-	if (sqlite3_finalize(stmt) != SQLITE_OK)
-	{
-		WALLET_ERROR_F("Error finalizing statement: {}", sqlite3_errmsg(&database));
-		throw WALLET_STORE_EXCEPTION("Error finalizing statement.");
-	}
-
 	return metadata;
 }
 
-void MetadataTable::SaveMetadata(sqlite3& database, const UserMetadata& userMetadata)
+void MetadataTable::SaveMetadata(SqliteStatementCache& statements, const UserMetadata& userMetadata)
 {
-	std::string update = StringUtil::Format(
-		"update metadata set next_tx_id={}, refresh_block_height={}, restore_leaf_index={} where id=1;",
-		userMetadata.GetNextTxId(),
-		userMetadata.GetRefreshBlockHeight(),
-		userMetadata.GetRestoreLeafIndex()
-	);
+	sqlite3& database = statements.GetDatabase();
+	SqliteStatementCache::Statement statement = statements.Prepare("update metadata set next_tx_id=?, refresh_block_height=?, restore_leaf_index=?, refresh_block_hash=? where id=1");
+	sqlite3_stmt* stmt = statement.Get();
 
-	char* error = nullptr;
-	if (sqlite3_exec(&database, update.c_str(), NULL, NULL, &error) != SQLITE_OK)
+	sqlite3_bind_int64(stmt, 1, (sqlite3_int64)userMetadata.GetNextTxId());
+	sqlite3_bind_int64(stmt, 2, (sqlite3_int64)userMetadata.GetRefreshBlockHeight());
+	sqlite3_bind_int64(stmt, 3, (sqlite3_int64)userMetadata.GetRestoreLeafIndex());
+
+	const std::optional<Hash>& refreshBlockHashOpt = userMetadata.GetRefreshBlockHash();
+	const std::string refreshBlockHash = refreshBlockHashOpt.has_value() ? refreshBlockHashOpt.value().ToHex() : "";
+	if (refreshBlockHashOpt.has_value())
 	{
-		WALLET_ERROR_F("Failed to save metadata for user. Error: {}", error);
-		sqlite3_free(error);
+		sqlite3_bind_text(stmt, 4, refreshBlockHash.c_str(), (int)refreshBlockHash.size(), NULL);
+	}
+	else
+	{
+		sqlite3_bind_null(stmt, 4);
+	}
+
+	if (sqlite3_step(stmt) != SQLITE_DONE)
+	{
+		WALLET_ERROR_F("Failed to save metadata for user. Error: {}", sqlite3_errmsg(&database));
 		throw WALLET_STORE_EXCEPTION("Failed to save metadata.");
 	}
 }
\ No newline at end of file
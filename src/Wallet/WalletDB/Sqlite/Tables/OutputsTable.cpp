@@ -1,4 +1,5 @@
 #include "OutputsTable.h"
+#include "../SqliteTransaction.h"
 #include "../../WalletEncryptionUtil.h"
 
 #include <Infrastructure/Logger.h>
@@ -41,10 +42,19 @@ void OutputsTable::UpdateSchema(sqlite3& database, const SecureVector& masterSee
 	}
 
 	// Load all outputs from existing table
-	std::vector<OutputDataEntity> outputs = GetOutputs(database, masterSeed, previousVersion);
+	const SecretKey encryptionKey = WalletEncryptionUtil::CreateSecureKey(masterSeed, "OUTPUT");
+	std::vector<OutputDataEntity> outputs;
+	{
+		SqliteStatementCache statements(database);
+		outputs = GetOutputs(statements, encryptionKey, previousVersion);
+	}
 
 	// Add outputs to "new_outputs" table
-	AddOutputs(database, masterSeed, outputs, "new_outputs");
+	{
+		// Statements must be finalized before the old table can be dropped.
+		SqliteStatementCache statements(database);
+		AddOutputs(statements, encryptionKey, outputs, "new_outputs");
+	}
 
 	// Delete existing table
 	const std::string dropTable = "DROP TABLE outputs";
@@ -65,26 +75,67 @@ void OutputsTable::UpdateSchema(sqlite3& database, const SecureVector& masterSee
 	}
 }
 
-void OutputsTable::AddOutputs(sqlite3& database, const SecureVector& masterSeed, const std::vector<OutputDataEntity>& outputs)
+void OutputsTable::AddOutputs(SqliteStatementCache& statements, const SecretKey& encryptionKey, const std::vector<OutputDataEntity>& outputs)
 {
-	AddOutputs(database, masterSeed, outputs, "outputs");
+	AddOutputs(statements, encryptionKey, outputs, "outputs");
 }
 
-void OutputsTable::AddOutputs(sqlite3& database, const SecureVector& masterSeed, const std::vector<OutputDataEntity>& outputs, const std::string& tableName)
+void OutputsTable::AddOutputs(SqliteStatementCache& statements, const SecretKey& encryptionKey, const std::vector<OutputDataEntity>& outputs, const std::string& tableName)
 {
+	std::vector<SecureVector> serializedOutputs;
+	serializedOutputs.reserve(outputs.size());
+
 	for (const OutputDataEntity& output : outputs)
 	{
-		WALLET_DEBUG_F("Saving output: {}", output.GetOutput());
+		Serializer serializer;
+		output.Serialize(serializer);
+		serializedOutputs.push_back(serializer.GetSecureBytes());
+	}
 
-		sqlite3_stmt* stmt = nullptr;
-		std::string insert = "insert into " + tableName + "(commitment, status, transaction_id, encrypted) values(?, ?, ?, ?)";
-		insert += " ON CONFLICT(commitment) DO UPDATE SET status=excluded.status, transaction_id=excluded.transaction_id, encrypted=excluded.encrypted";
-		if (sqlite3_prepare_v2(&database, insert.c_str(), -1, &stmt, NULL) != SQLITE_OK)
-		{
-			WALLET_ERROR_F("Error while compiling sql: {}", sqlite3_errmsg(&database));
-			sqlite3_finalize(stmt);
-			throw WALLET_STORE_EXCEPTION("Error compiling statement.");
-		}
+	AddEncryptedOutputs(statements, outputs, WalletEncryptionUtil::EncryptAll(encryptionKey, serializedOutputs), tableName);
+}
+
+void OutputsTable::AddEncryptedOutputs(
+	SqliteStatementCache& statements,
+	const std::vector<OutputDataEntity>& outputs,
+	const std::vector<std::vector<unsigned char>>& encryptedOutputs)
+{
+	AddEncryptedOutputs(statements, outputs, encryptedOutputs, "outputs");
+}
+
+void OutputsTable::AddEncryptedOutputs(
+	SqliteStatementCache& statements,
+	const std::vector<OutputDataEntity>& outputs,
+	const std::vector<std::vector<unsigned char>>& encryptedOutputs,
+	const std::string& tableName)
+{
+	if (outputs.empty())
+	{
+		return;
+	}
+
+	WALLET_DEBUG_F("Saving {} outputs", outputs.size());
+
+	// Writes normally happen inside the batch's transaction (see WalletSqlite::OnInitWrite).
+	// If not, use one here, so the rows are committed (and synced) together rather than one at a time.
+	sqlite3& database = statements.GetDatabase();
+	std::unique_ptr<SqliteTransaction> pTransaction = nullptr;
+	if (sqlite3_get_autocommit(&database) != 0)
+	{
+		pTransaction = std::make_unique<SqliteTransaction>(database);
+		pTransaction->Begin();
+	}
+
+	// A single-row statement is compiled once and re-stepped for each output.
+	// This measured faster than multi-row "values (...), (...)" upserts, which sqlite runs through a co-routine.
+	std::string insert = "insert into " + tableName + "(commitment, status, transaction_id, encrypted) values(?, ?, ?, ?)";
+	insert += " ON CONFLICT(commitment) DO UPDATE SET status=excluded.status, transaction_id=excluded.transaction_id, encrypted=excluded.encrypted";
+	SqliteStatementCache::Statement statement = statements.Prepare(insert);
+	sqlite3_stmt* stmt = statement.Get();
+
+	for (size_t i = 0; i < outputs.size(); i++)
+	{
+		const OutputDataEntity& output = outputs[i];
 
 		const std::string commitmentHex = output.GetOutput().GetCommitment().ToHex();
 		sqlite3_bind_text(stmt, 1, commitmentHex.c_str(), (int)commitmentHex.size(), NULL);
@@ -100,51 +151,43 @@ void OutputsTable::AddOutputs(sqlite3& database, const SecureVector& masterSeed,
 			sqlite3_bind_null(stmt, 3);
 		}
 
-		Serializer serializer;
-		output.Serialize(serializer);
-		const std::vector<unsigned char> encrypted = WalletEncryptionUtil::Encrypt(masterSeed, "OUTPUT", serializer.GetSecureBytes());
+		const std::vector<unsigned char>& encrypted = encryptedOutputs[i];
 		sqlite3_bind_blob(stmt, 4, (const void*)encrypted.data(), (int)encrypted.size(), NULL);
 
-		sqlite3_step(stmt);
-
-		if (sqlite3_finalize(stmt) != SQLITE_OK)
+		if (sqlite3_step(stmt) != SQLITE_DONE)
 		{
-			WALLET_ERROR_F("Error finalizing statement: {}", sqlite3_errmsg(&database));
-			throw WALLET_STORE_EXCEPTION("Error finalizing statement.");
+			WALLET_ERROR_F("Error while performing sql: {}", sqlite3_errmsg(&database));
+			throw WALLET_STORE_EXCEPTION("Error saving outputs.");
 		}
+
+		statement.Reset();
+	}
+
+	if (pTransaction != nullptr)
+	{
+		pTransaction->Commit();
 	}
 }
 
-std::vector<OutputDataEntity> OutputsTable::GetOutputs(sqlite3& database, const SecureVector& masterSeed)
+std::vector<OutputDataEntity> OutputsTable::GetOutputs(SqliteStatementCache& statements, const SecretKey& encryptionKey)
 {
-	return GetOutputs(database, masterSeed, 1);
+	return GetOutputs(statements, encryptionKey, 1);
 }
 
-std::vector<OutputDataEntity> OutputsTable::GetOutputs(sqlite3& database, const SecureVector& masterSeed, const int /*version*/)
+std::vector<OutputDataEntity> OutputsTable::GetOutputs(SqliteStatementCache& statements, const SecretKey& encryptionKey, const int /*version*/)
 {
-	// Prepare statement
-	sqlite3_stmt* stmt = nullptr;
-	const std::string query = "select encrypted from outputs";
-	if (sqlite3_prepare_v2(&database, query.c_str(), -1, &stmt, NULL) != SQLITE_OK)
-	{
-		WALLET_ERROR_F("Error while compiling sql: {}", sqlite3_errmsg(&database));
-		sqlite3_finalize(stmt);
-		throw WALLET_STORE_EXCEPTION("Error compiling statement.");
-	}
+	sqlite3& database = statements.GetDatabase();
+	SqliteStatementCache::Statement statement = statements.Prepare("select encrypted from outputs");
+	sqlite3_stmt* stmt = statement.Get();
 
-	std::vector<OutputDataEntity> outputs;
+	std::vector<std::vector<unsigned char>> encryptedOutputs;
 
 	int ret_code = 0;
 	while ((ret_code = sqlite3_step(stmt)) == SQLITE_ROW)
 	{
 		const int encryptedSize = sqlite3_column_bytes(stmt, 0);
 		const unsigned char* pEncrypted = (const unsigned char*)sqlite3_column_blob(stmt, 0);
-		std::vector<unsigned char> encrypted(pEncrypted, pEncrypted + encryptedSize);
-		const SecureVector decrypted = WalletEncryptionUtil::Decrypt(masterSeed, "OUTPUT", encrypted);
-		const std::vector<unsigned char> decryptedUnsafe(decrypted.begin(), decrypted.end());
-
-		ByteBuffer byteBuffer(std::move(decryptedUnsafe));
-		outputs.emplace_back(OutputDataEntity::Deserialize(byteBuffer));
+		encryptedOutputs.emplace_back(pEncrypted, pEncrypted + encryptedSize);
 	}
 
 	if (ret_code != SQLITE_DONE)
@@ -152,10 +195,15 @@ std::vector<OutputDataEntity> OutputsTable::GetOutputs(sqlite3& database, const
 		WALLET_ERROR_F("Error while performing sql: {}", sqlite3_errmsg(&database));
 	}
 
-	if (sqlite3_finalize(stmt) != SQLITE_OK)
+	std::vector<OutputDataEntity> outputs;
+	outputs.reserve(encryptedOutputs.size());
+
+	for (const SecureVector& decrypted : WalletEncryptionUtil::DecryptAll(encryptionKey, encryptedOutputs))
 	{
-		WALLET_ERROR_F("Error finalizing statement: {}", sqlite3_errmsg(&database));
-		throw WALLET_STORE_EXCEPTION("Error finalizing statement.");
+		const std::vector<unsigned char> decryptedUnsafe(decrypted.begin(), decrypted.end());
+
+		ByteBuffer byteBuffer(std::move(decryptedUnsafe));
+		outputs.emplace_back(OutputDataEntity::Deserialize(byteBuffer));
 	}
 
 	return outputs;
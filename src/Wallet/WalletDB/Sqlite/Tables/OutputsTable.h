@@ -1,7 +1,10 @@
 #pragma once
 
+#include "../SqliteStatementCache.h"
+
 #include <libsqlite3/sqlite3.h>
 #include <Common/Secure.h>
+#include <Crypto/SecretKey.h>
 #include <Wallet/WalletDB/Models/OutputDataEntity.h>
 
 class OutputsTable
@@ -10,10 +13,29 @@ public:
 	static void CreateTable(sqlite3& database);
 	static void UpdateSchema(sqlite3& database, const SecureVector& masterSeed, const int previousVersion);
 
-	static void AddOutputs(sqlite3& database, const SecureVector& masterSeed, const std::vector<OutputDataEntity>& outputs);
-	static std::vector<OutputDataEntity> GetOutputs(sqlite3& database, const SecureVector& masterSeed);
+	//
+	// encryptionKey must be the key created by WalletEncryptionUtil::CreateSecureKey(masterSeed, "OUTPUT").
+	// Outputs are encrypted in parallel, then upserted with a single cached statement, all in one transaction.
+	//
+	static void AddOutputs(SqliteStatementCache& statements, const SecretKey& encryptionKey, const std::vector<OutputDataEntity>& outputs);
+	static std::vector<OutputDataEntity> GetOutputs(SqliteStatementCache& statements, const SecretKey& encryptionKey);
+
+	//
+	// Upserts outputs that were already encrypted, where encryptedOutputs[i] is outputs[i] encrypted with the "OUTPUT" key.
+	//
+	static void AddEncryptedOutputs(
+		SqliteStatementCache& statements,
+		const std::vector<OutputDataEntity>& outputs,
+		const std::vector<std::vector<unsigned char>>& encryptedOutputs
+	);
 
 private:
-	static void AddOutputs(sqlite3& database, const SecureVector& masterSeed, const std::vector<OutputDataEntity>& outputs, const std::string& tableName);
-	static std::vector<OutputDataEntity> GetOutputs(sqlite3& database, const SecureVector& masterSeed, const int version);
+	static void AddOutputs(SqliteStatementCache& statements, const SecretKey& encryptionKey, const std::vector<OutputDataEntity>& outputs, const std::string& tableName);
+	static void AddEncryptedOutputs(
+		SqliteStatementCache& statements,
+		const std::vector<OutputDataEntity>& outputs,
+		const std::vector<std::vector<unsigned char>>& encryptedOutputs,
+		const std::string& tableName
+	);
+	static std::vector<OutputDataEntity> GetOutputs(SqliteStatementCache& statements, const SecretKey& encryptionKey, const int version);
 };
\ No newline at end of file
@@ -36,19 +36,13 @@ void SlateContextTable::UpdateSchema(sqlite3& database, const int previousVersio
 }
 
 void SlateContextTable::SaveSlateContext(
-	sqlite3& database,
+	SqliteStatementCache& statements,
 	const SecureVector& masterSeed,
 	const uuids::uuid& slateId,
 	const SlateContextEntity& slateContext)
 {
-	sqlite3_stmt* stmt = nullptr;
-	std::string insert = "insert into slate_contexts values(?, ?, ?)";
-	if (sqlite3_prepare_v2(&database, insert.c_str(), -1, &stmt, NULL) != SQLITE_OK)
-	{
-		WALLET_ERROR_F("Error while compiling sql: {}", sqlite3_errmsg(&database));
-		sqlite3_finalize(stmt);
-		throw WALLET_STORE_EXCEPTION("Error compiling statement.");
-	}
+	SqliteStatementCache::Statement statement = statements.Prepare("insert into slate_contexts values(?, ?, ?)");
+	sqlite3_stmt* stmt = statement.Get();
 
 	const std::string slateIdStr = uuids::to_string(slateId);
 	sqlite3_bind_text(stmt, 1, slateIdStr.c_str(), (int)slateIdStr.size(), NULL);
@@ -60,29 +54,21 @@ void SlateContextTable::SaveSlateContext(
 	sqlite3_bind_blob(stmt, 3, (const void*)encrypted.data(), (int)encrypted.size(), NULL);
 
 	sqlite3_step(stmt);
-
-	if (sqlite3_finalize(stmt) != SQLITE_OK)
-	{
-		WALLET_ERROR_F("Error finalizing statement: {}", sqlite3_errmsg(&database));
-		throw WALLET_STORE_EXCEPTION("Error finalizing statement.");
-	}
 }
 
 std::unique_ptr<SlateContextEntity> SlateContextTable::LoadSlateContext(
-	sqlite3& database,
+	SqliteStatementCache& statements,
 	const SecureVector& masterSeed,
 	const uuids::uuid& slateId)
 {
 	std::unique_ptr<SlateContextEntity> pSlateContext = nullptr;
 
-	sqlite3_stmt* stmt = nullptr;
-	const std::string query = "SELECT iv, enc_context FROM slate_contexts WHERE slate_id='" + uuids::to_string(slateId) + "'";
-	if (sqlite3_prepare_v2(&database, query.c_str(), -1, &stmt, NULL) != SQLITE_OK)
-	{
-		WALLET_ERROR_F("Error while compiling sql: {}", sqlite3_errmsg(&database));
-		sqlite3_finalize(stmt);
-		throw WALLET_STORE_EXCEPTION("Error compiling statement.");
-	}
+	sqlite3& database = statements.GetDatabase();
+	SqliteStatementCache::Statement statement = statements.Prepare("SELECT iv, enc_context FROM slate_contexts WHERE slate_id=?");
+	sqlite3_stmt* stmt = statement.Get();
+
+	const std::string slateIdStr = uuids::to_string(slateId);
+	sqlite3_bind_text(stmt, 1, slateIdStr.c_str(), (int)slateIdStr.size(), NULL);
 
 	if (sqlite3_step(stmt) == SQLITE_ROW)
 	{
@@ -92,7 +78,6 @@ std::unique_ptr<SlateContextEntity> SlateContextTable::LoadSlateContext(
 		if (ivBytes != 16)
 		{
 			WALLET_ERROR_F("Slate context corrupted: {}", sqlite3_errmsg(&database));
-			sqlite3_finalize(stmt);
 			throw WALLET_STORE_EXCEPTION("Slate context corrupted.");
 		}
 
@@ -109,12 +94,6 @@ std::unique_ptr<SlateContextEntity> SlateContextTable::LoadSlateContext(
 		WALLET_INFO_F("Slate context not found for id {}", uuids::to_string(slateId));
 	}
 
-	if (sqlite3_finalize(stmt) != SQLITE_OK)
-	{
-		WALLET_ERROR_F("Error finalizing statement: {}", sqlite3_errmsg(&database));
-		throw WALLET_STORE_EXCEPTION("Error finalizing statement.");
-	}
-
 	return pSlateContext;
 }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../SqliteStatementCache.h"
+
 #include <libsqlite3/sqlite3.h>
 #include <Common/Secure.h>
 #include <uuid.h>
@@ -13,14 +15,14 @@ public:
 	static void UpdateSchema(sqlite3& database, const int previousVersion);
 
 	static void SaveSlateContext(
-		sqlite3& database,
+		SqliteStatementCache& statements,
 		const SecureVector& masterSeed,
 		const uuids::uuid& slateId,
 		const SlateContextEntity& slateContext
 	);
 	
 	static std::unique_ptr<SlateContextEntity> LoadSlateContext(
-		sqlite3& database,
+		SqliteStatementCache& statements,
 		const SecureVector& masterSeed,
 		const uuids::uuid& slateId
 	);
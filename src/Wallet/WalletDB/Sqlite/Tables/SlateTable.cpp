@@ -28,19 +28,13 @@ void SlateTable::UpdateSchema(sqlite3& database, const int previousVersion)
 }
 
 void SlateTable::SaveSlate(
-	sqlite3& database,
+	SqliteStatementCache& statements,
 	const SecureVector& masterSeed,
 	const Slate& slate)
 {
 	// TODO: Update if it already exists?
-	sqlite3_stmt* stmt = nullptr;
-	std::string insert = "insert into slate values(?, ?, ?, ?)";
-	if (sqlite3_prepare_v2(&database, insert.c_str(), -1, &stmt, NULL) != SQLITE_OK)
-	{
-		WALLET_ERROR_F("Error while compiling sql: {}", sqlite3_errmsg(&database));
-		sqlite3_finalize(stmt);
-		throw WALLET_STORE_EXCEPTION("Error compiling statement.");
-	}
+	SqliteStatementCache::Statement statement = statements.Prepare("insert into slate values(?, ?, ?, ?)");
+	sqlite3_stmt* stmt = statement.Get();
 
 	const std::string slateIdStr = uuids::to_string(slate.slateId);
 	sqlite3_bind_text(stmt, 1, slateIdStr.c_str(), (int)slateIdStr.size(), NULL);
@@ -55,30 +49,25 @@ void SlateTable::SaveSlate(
 	sqlite3_bind_blob(stmt, 4, (const void*)encrypted.data(), (int)encrypted.size(), NULL);
 
 	sqlite3_step(stmt);
-
-	if (sqlite3_finalize(stmt) != SQLITE_OK)
-	{
-		WALLET_ERROR_F("Error finalizing statement: {}", sqlite3_errmsg(&database));
-		throw WALLET_STORE_EXCEPTION("Error finalizing statement.");
-	}
 }
 
 std::unique_ptr<Slate> SlateTable::LoadSlate(
-	sqlite3& database,
+	SqliteStatementCache& statements,
 	const SecureVector& masterSeed,
 	const uuids::uuid& slateId,
 	const SlateStage& stage)
 {
 	std::unique_ptr<Slate> pSlate = nullptr;
 
-	sqlite3_stmt* stmt = nullptr;
-	const std::string query = "SELECT iv, slate FROM slate WHERE slate_id='" + uuids::to_string(slateId) + "' and stage='" + stage.ToString() + "'";
-	if (sqlite3_prepare_v2(&database, query.c_str(), -1, &stmt, NULL) != SQLITE_OK)
-	{
-		WALLET_ERROR_F("Error while compiling sql: {}", sqlite3_errmsg(&database));
-		sqlite3_finalize(stmt);
-		throw WALLET_STORE_EXCEPTION("Error compiling statement.");
-	}
+	sqlite3& database = statements.GetDatabase();
+	SqliteStatementCache::Statement statement = statements.Prepare("SELECT iv, slate FROM slate WHERE slate_id=? and stage=?");
+	sqlite3_stmt* stmt = statement.Get();
+
+	const std::string slateIdStr = uuids::to_string(slateId);
+	sqlite3_bind_text(stmt, 1, slateIdStr.c_str(), (int)slateIdStr.size(), NULL);
+
+	const std::string stageStr = stage.ToString();
+	sqlite3_bind_text(stmt, 2, stageStr.c_str(), (int)stageStr.size(), NULL);
 
 	if (sqlite3_step(stmt) == SQLITE_ROW)
 	{
@@ -88,7 +77,6 @@ std::unique_ptr<Slate> SlateTable::LoadSlate(
 		if (ivBytes != 16)
 		{
 			WALLET_ERROR_F("Slate corrupted: {}", sqlite3_errmsg(&database));
-			sqlite3_finalize(stmt);
 			throw WALLET_STORE_EXCEPTION("Slate corrupted.");
 		}
 
@@ -106,7 +94,6 @@ std::unique_ptr<Slate> SlateTable::LoadSlate(
 		catch (std::exception& e)
 		{
 			WALLET_ERROR_F("Failed to load slate ({}): {}", uuids::to_string(slateId), e);
-			sqlite3_finalize(stmt);
 			throw WALLET_STORE_EXCEPTION("Failed to load slate");
 		}
 	}
@@ -115,12 +102,6 @@ std::unique_ptr<Slate> SlateTable::LoadSlate(
 		WALLET_INFO_F("Slate not found for id {}", uuids::to_string(slateId));
 	}
 
-	if (sqlite3_finalize(stmt) != SQLITE_OK)
-	{
-		WALLET_ERROR_F("Error finalizing statement: {}", sqlite3_errmsg(&database));
-		throw WALLET_STORE_EXCEPTION("Error finalizing statement.");
-	}
-
 	return pSlate;
 }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../SqliteStatementCache.h"
+
 #include <libsqlite3/sqlite3.h>
 #include <Common/Secure.h>
 #include <uuid.h>
@@ -12,14 +14,14 @@ public:
 	static void UpdateSchema(sqlite3& database, const int previousVersion);
 
 	static std::unique_ptr<Slate> LoadSlate(
-		sqlite3& database,
+		SqliteStatementCache& statements,
 		const SecureVector& masterSeed,
 		const uuids::uuid& slateId,
 		const SlateStage& stage
 	);
 
 	static void SaveSlate(
-		sqlite3& database,
+		SqliteStatementCache& statements,
 		const SecureVector& masterSeed,
 		const Slate& slate
 	);
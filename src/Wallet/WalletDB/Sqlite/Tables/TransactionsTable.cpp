@@ -26,20 +26,17 @@ void TransactionsTable::UpdateSchema(sqlite3& /*database*/, const SecureVector&
 	return;
 }
 
-void TransactionsTable::AddTransactions(sqlite3& database, const SecureVector& masterSeed, const std::vector<WalletTx>& transactions)
+void TransactionsTable::AddTransactions(SqliteStatementCache& statements, const SecretKey& encryptionKey, const std::vector<WalletTx>& transactions)
 {
+	sqlite3& database = statements.GetDatabase();
+
+	std::string insert = "insert into transactions(id, slate_id, encrypted) values(?, ?, ?)";
+	insert += " ON CONFLICT(id) DO UPDATE SET slate_id=excluded.slate_id, encrypted=excluded.encrypted";
+	SqliteStatementCache::Statement statement = statements.Prepare(insert);
+	sqlite3_stmt* stmt = statement.Get();
+
 	for (const WalletTx& walletTx : transactions)
 	{
-		sqlite3_stmt* stmt = nullptr;
-		std::string insert = "insert into transactions(id, slate_id, encrypted) values(?, ?, ?)";
-		insert += " ON CONFLICT(id) DO UPDATE SET slate_id=excluded.slate_id, encrypted=excluded.encrypted";
-		if (sqlite3_prepare_v2(&database, insert.c_str(), -1, &stmt, NULL) != SQLITE_OK)
-		{
-			WALLET_ERROR_F("Error while compiling sql: {}", sqlite3_errmsg(&database));
-			sqlite3_finalize(stmt);
-			throw WALLET_STORE_EXCEPTION("Error compiling statement.");
-		}
-
 		sqlite3_bind_int(stmt, 1, (int)walletTx.GetId());
 
 		if (walletTx.GetSlateId().has_value())
@@ -54,43 +51,33 @@ void TransactionsTable::AddTransactions(sqlite3& database, const SecureVector& m
 
 		Serializer serializer;
 		walletTx.Serialize(serializer);
-		const std::vector<unsigned char> encrypted = WalletEncryptionUtil::Encrypt(masterSeed, "WALLET_TX", serializer.GetSecureBytes());
+		const std::vector<unsigned char> encrypted = WalletEncryptionUtil::Encrypt(encryptionKey, serializer.GetSecureBytes());
 		sqlite3_bind_blob(stmt, 3, (const void*)encrypted.data(), (int)encrypted.size(), NULL);
 
-		sqlite3_step(stmt);
-
-		if (sqlite3_finalize(stmt) != SQLITE_OK)
+		if (sqlite3_step(stmt) != SQLITE_DONE)
 		{
-			WALLET_ERROR_F("Error finalizing statement: {}", sqlite3_errmsg(&database));
-			throw WALLET_STORE_EXCEPTION("Error finalizing statement.");
+			WALLET_ERROR_F("Error while performing sql: {}", sqlite3_errmsg(&database));
+			throw WALLET_STORE_EXCEPTION("Error saving transaction.");
 		}
+
+		statement.Reset();
 	}
 }
 
-std::vector<WalletTx> TransactionsTable::GetTransactions(sqlite3& database, const SecureVector& masterSeed)
+std::vector<WalletTx> TransactionsTable::GetTransactions(SqliteStatementCache& statements, const SecretKey& encryptionKey)
 {
-	sqlite3_stmt* stmt = nullptr;
-	const std::string query = "select encrypted from transactions";
-	if (sqlite3_prepare_v2(&database, query.c_str(), -1, &stmt, NULL) != SQLITE_OK)
-	{
-		WALLET_ERROR_F("Error while compiling sql: {}", sqlite3_errmsg(&database));
-		sqlite3_finalize(stmt);
-		throw WALLET_STORE_EXCEPTION("Error compiling statement.");
-	}
+	sqlite3& database = statements.GetDatabase();
+	SqliteStatementCache::Statement statement = statements.Prepare("select encrypted from transactions");
+	sqlite3_stmt* stmt = statement.Get();
 
-	std::vector<WalletTx> transactions;
+	std::vector<std::vector<unsigned char>> encryptedTransactions;
 
 	int ret_code = 0;
 	while ((ret_code = sqlite3_step(stmt)) == SQLITE_ROW)
 	{
 		const int encryptedSize = sqlite3_column_bytes(stmt, 0);
 		const unsigned char* pEncrypted = (const unsigned char*)sqlite3_column_blob(stmt, 0);
-		std::vector<unsigned char> encrypted(pEncrypted, pEncrypted + encryptedSize);
-		const SecureVector decrypted = WalletEncryptionUtil::Decrypt(masterSeed, "WALLET_TX", encrypted);
-		const std::vector<unsigned char> decryptedUnsafe(decrypted.begin(), decrypted.end());
-
-		ByteBuffer byteBuffer(std::move(decryptedUnsafe));
-		transactions.emplace_back(WalletTx::Deserialize(byteBuffer));
+		encryptedTransactions.emplace_back(pEncrypted, pEncrypted + encryptedSize);
 	}
 
 	if (ret_code != SQLITE_DONE)
@@ -98,25 +85,25 @@ std::vector<WalletTx> TransactionsTable::GetTransactions(sqlite3& database, cons
 		WALLET_ERROR_F("Error while performing sql: {}", sqlite3_errmsg(&database));
 	}
 
-	if (sqlite3_finalize(stmt) != SQLITE_OK)
+	std::vector<WalletTx> transactions;
+	transactions.reserve(encryptedTransactions.size());
+
+	for (const SecureVector& decrypted : WalletEncryptionUtil::DecryptAll(encryptionKey, encryptedTransactions))
 	{
-		WALLET_ERROR_F("Error finalizing statement: {}", sqlite3_errmsg(&database));
-		throw WALLET_STORE_EXCEPTION("Error finalizing statement.");
+		const std::vector<unsigned char> decryptedUnsafe(decrypted.begin(), decrypted.end());
+
+		ByteBuffer byteBuffer(std::move(decryptedUnsafe));
+		transactions.emplace_back(WalletTx::Deserialize(byteBuffer));
 	}
 
 	return transactions;
 }
 
-std::unique_ptr<WalletTx> TransactionsTable::GetTransactionById(sqlite3& database, const SecureVector& masterSeed, const uint32_t walletTxId)
+std::unique_ptr<WalletTx> TransactionsTable::GetTransactionById(SqliteStatementCache& statements, const SecretKey& encryptionKey, const uint32_t walletTxId)
 {
-	sqlite3_stmt* stmt = nullptr;
-	const std::string query = "select encrypted from transactions where id=?";
-	if (sqlite3_prepare_v2(&database, query.c_str(), -1, &stmt, NULL) != SQLITE_OK)
-	{
-		WALLET_ERROR_F("Error while compiling sql: {}", sqlite3_errmsg(&database));
-		sqlite3_finalize(stmt);
-		throw WALLET_STORE_EXCEPTION("Error compiling statement.");
-	}
+	sqlite3& database = statements.GetDatabase();
+	SqliteStatementCache::Statement statement = statements.Prepare("select encrypted from transactions where id=?");
+	sqlite3_stmt* stmt = statement.Get();
 
 	sqlite3_bind_int(stmt, 1, walletTxId);
 
@@ -128,7 +115,7 @@ std::unique_ptr<WalletTx> TransactionsTable::GetTransactionById(sqlite3& databas
 		const int encryptedSize = sqlite3_column_bytes(stmt, 0);
 		const unsigned char* pEncrypted = (const unsigned char*)sqlite3_column_blob(stmt, 0);
 		std::vector<unsigned char> encrypted(pEncrypted, pEncrypted + encryptedSize);
-		const SecureVector decrypted = WalletEncryptionUtil::Decrypt(masterSeed, "WALLET_TX", encrypted);
+		const SecureVector decrypted = WalletEncryptionUtil::Decrypt(encryptionKey, encrypted);
 		const std::vector<unsigned char> decryptedUnsafe(decrypted.begin(), decrypted.end());
 
 		ByteBuffer byteBuffer(std::move(decryptedUnsafe));
@@ -142,11 +129,5 @@ std::unique_ptr<WalletTx> TransactionsTable::GetTransactionById(sqlite3& databas
 		WALLET_ERROR_F("Error while performing sql: {}", sqlite3_errmsg(&database));
 	}
 
-	if (sqlite3_finalize(stmt) != SQLITE_OK)
-	{
-		WALLET_ERROR_F("Error finalizing statement: {}", sqlite3_errmsg(&database));
-		throw WALLET_STORE_EXCEPTION("Error finalizing statement.");
-	}
-
 	return pWalletTx;
 }
\ No newline at end of file
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "../SqliteStatementCache.h"
+
 #include <libsqlite3/sqlite3.h>
 #include <Common/Secure.h>
+#include <Crypto/SecretKey.h>
 #include <Wallet/WalletTx.h>
 
 class TransactionsTable
@@ -10,7 +13,10 @@ public:
 	static void CreateTable(sqlite3& database);
 	static void UpdateSchema(sqlite3& database, const SecureVector& masterSeed, const int previousVersion);
 
-	static void AddTransactions(sqlite3& database, const SecureVector& masterSeed, const std::vector<WalletTx>& transactions);
-	static std::vector<WalletTx> GetTransactions(sqlite3& database, const SecureVector& masterSeed);
-	static std::unique_ptr<WalletTx> GetTransactionById(sqlite3& database, const SecureVector& masterSeed, const uint32_t walletTxId);
+	//
+	// encryptionKey must be the key created by WalletEncryptionUtil::CreateSecureKey(masterSeed, "WALLET_TX").
+	//
+	static void AddTransactions(SqliteStatementCache& statements, const SecretKey& encryptionKey, const std::vector<WalletTx>& transactions);
+	static std::vector<WalletTx> GetTransactions(SqliteStatementCache& statements, const SecretKey& encryptionKey);
+	static std::unique_ptr<WalletTx> GetTransactionById(SqliteStatementCache& statements, const SecretKey& encryptionKey, const uint32_t walletTxId);
 };
\ No newline at end of file
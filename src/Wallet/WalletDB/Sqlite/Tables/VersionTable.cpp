@@ -8,7 +8,7 @@
 void VersionTable::CreateTable(sqlite3& database)
 {
 	std::string tableCreation = "create table version(schema_version INTEGER PRIMARY KEY);";
-	tableCreation += "insert into version(schema_version) values (2)";
+	tableCreation += StringUtil::Format("insert into version(schema_version) values ({})", LATEST_SCHEMA_VERSION);
 
 	char* error = nullptr;
 	if (sqlite3_exec(&database, tableCreation.c_str(), NULL, NULL, &error) != SQLITE_OK)
@@ -13,6 +13,7 @@
 #include <Common/Util/FileUtil.h>
 #include <Common/Util/StringUtil.h>
 #include <Infrastructure/Logger.h>
+#include <algorithm>
 
 static const uint8_t ENCRYPTION_FORMAT = 0;
 static const int LATEST_SCHEMA_VERSION = 1;
@@ -27,6 +28,11 @@ void WalletSqlite::Rollback() noexcept
 {
 	m_pTransaction->Rollback();
 	SetDirty(false);
+
+	std::unique_lock<std::mutex> lock(m_cacheMutex);
+	m_outputsOpt.reset();
+	m_transactionsOpt.reset();
+	m_outputsVersion++;
 }
 
 void WalletSqlite::OnInitWrite()
@@ -43,37 +49,28 @@ void WalletSqlite::OnEndWrite()
 
 KeyChainPath WalletSqlite::GetNextChildPath(const KeyChainPath& parentPath)
 {
-	sqlite3_stmt* stmt = nullptr;
-	const std::string query = "SELECT next_child_index FROM accounts WHERE parent_path='" + parentPath.Format() + "'";
-	if (sqlite3_prepare_v2(m_pDatabase, query.c_str(), -1, &stmt, NULL) != SQLITE_OK)
-	{
-		WALLET_ERROR_F("Error while compiling sql: {}", sqlite3_errmsg(m_pDatabase));
-		sqlite3_finalize(stmt);
-		throw WALLET_STORE_EXCEPTION("Error compiling statement.");
-	}
+	const std::string parentPathStr = parentPath.Format();
 
-	if (sqlite3_step(stmt) != SQLITE_ROW)
+	SqliteStatementCache::Statement query = m_statements.Prepare("SELECT next_child_index FROM accounts WHERE parent_path=?");
+	sqlite3_bind_text(query.Get(), 1, parentPathStr.c_str(), (int)parentPathStr.size(), NULL);
+
+	if (sqlite3_step(query.Get()) != SQLITE_ROW)
 	{
 		WALLET_ERROR_F("Account not found for user: {}", m_username);
-		sqlite3_finalize(stmt);
 		throw WALLET_STORE_EXCEPTION("Account not found.");
 	}
 
-	const uint32_t nextChildIndex = (uint32_t)sqlite3_column_int(stmt, 0);
+	const uint32_t nextChildIndex = (uint32_t)sqlite3_column_int(query.Get(), 0);
 	KeyChainPath nextChildPath = parentPath.GetChild(nextChildIndex);
+	query.Reset();
 
-	if (sqlite3_finalize(stmt) != SQLITE_OK)
-	{
-		WALLET_ERROR_F("Error finalizing statement: {}", sqlite3_errmsg(m_pDatabase));
-		throw WALLET_STORE_EXCEPTION("Error finalizing statement.");
-	}
+	SqliteStatementCache::Statement update = m_statements.Prepare("UPDATE accounts SET next_child_index=? WHERE parent_path=?");
+	sqlite3_bind_int64(update.Get(), 1, (sqlite3_int64)nextChildPath.GetKeyIndices().back() + 1);
+	sqlite3_bind_text(update.Get(), 2, parentPathStr.c_str(), (int)parentPathStr.size(), NULL);
 
-	char* error = nullptr;
-	const std::string update = "UPDATE accounts SET next_child_index=" + std::to_string(nextChildPath.GetKeyIndices().back() + 1) + " WHERE parent_path='" + parentPath.Format() + "';";
-	if (sqlite3_exec(m_pDatabase, update.c_str(), NULL, NULL, &error) != SQLITE_OK)
+	if (sqlite3_step(update.Get()) != SQLITE_DONE)
 	{
-		WALLET_ERROR_F("Failed to update account for user: {}. Error: {}", m_username, error);
-		sqlite3_free(error);
+		WALLET_ERROR_F("Failed to update account for user: {}. Error: {}", m_username, sqlite3_errmsg(m_pDatabase));
 		throw WALLET_STORE_EXCEPTION("Failed to update account");
 	}
 
@@ -82,47 +79,143 @@ KeyChainPath WalletSqlite::GetNextChildPath(const KeyChainPath& parentPath)
 
 std::unique_ptr<Slate> WalletSqlite::LoadSlate(const SecureVector& masterSeed, const uuids::uuid& slateId, const SlateStage& stage) const
 {
-	return SlateTable::LoadSlate(*m_pDatabase, masterSeed, slateId, stage);
+	return SlateTable::LoadSlate(m_statements, masterSeed, slateId, stage);
 }
 
 void WalletSqlite::SaveSlate(const SecureVector& masterSeed, const Slate& slate)
 {
-	SlateTable::SaveSlate(*m_pDatabase, masterSeed, slate);
+	SlateTable::SaveSlate(m_statements, masterSeed, slate);
 }
 
 std::unique_ptr<SlateContextEntity> WalletSqlite::LoadSlateContext(const SecureVector& masterSeed, const uuids::uuid& slateId) const
 {
-	return SlateContextTable::LoadSlateContext(*m_pDatabase, masterSeed, slateId);
+	return SlateContextTable::LoadSlateContext(m_statements, masterSeed, slateId);
 }
 
 void WalletSqlite::SaveSlateContext(const SecureVector& masterSeed, const uuids::uuid& slateId, const SlateContextEntity& slateContext)
 {
-	SlateContextTable::SaveSlateContext(*m_pDatabase, masterSeed, slateId, slateContext);
+	SlateContextTable::SaveSlateContext(m_statements, masterSeed, slateId, slateContext);
 }
 
 void WalletSqlite::AddOutputs(const SecureVector& masterSeed, const std::vector<OutputDataEntity>& outputs)
 {
-	OutputsTable::AddOutputs(*m_pDatabase, masterSeed, outputs);
+	if (outputs.empty())
+	{
+		return;
+	}
+
+	OutputsTable::AddOutputs(m_statements, GetEncryptionKey(masterSeed, "OUTPUT"), outputs);
+
+	std::unique_lock<std::mutex> lock(m_cacheMutex);
+	m_outputsVersion++;
+	if (m_outputsOpt.has_value())
+	{
+		// Mirror the upsert: existing outputs are replaced in place, and new ones are appended.
+		std::vector<OutputDataEntity>& cachedOutputs = m_outputsOpt.value();
+		std::unordered_map<Commitment, size_t> indexByCommitment;
+		for (size_t i = 0; i < cachedOutputs.size(); i++)
+		{
+			indexByCommitment[cachedOutputs[i].GetOutput().GetCommitment()] = i;
+		}
+
+		for (const OutputDataEntity& output : outputs)
+		{
+			auto iter = indexByCommitment.find(output.GetOutput().GetCommitment());
+			if (iter != indexByCommitment.end())
+			{
+				cachedOutputs[iter->second] = output;
+			}
+			else
+			{
+				indexByCommitment[output.GetOutput().GetCommitment()] = cachedOutputs.size();
+				cachedOutputs.push_back(output);
+			}
+		}
+	}
 }
 
 std::vector<OutputDataEntity> WalletSqlite::GetOutputs(const SecureVector& masterSeed) const
 {
-	return OutputsTable::GetOutputs(*m_pDatabase, masterSeed);
+	std::unique_lock<std::mutex> lock(m_cacheMutex);
+	if (!m_outputsOpt.has_value())
+	{
+		lock.unlock();
+		std::vector<OutputDataEntity> outputs = OutputsTable::GetOutputs(m_statements, GetEncryptionKey(masterSeed, "OUTPUT"));
+
+		lock.lock();
+		m_outputsOpt = std::make_optional(std::move(outputs));
+	}
+
+	return m_outputsOpt.value();
+}
+
+uint64_t WalletSqlite::GetOutputsVersion() const
+{
+	std::unique_lock<std::mutex> lock(m_cacheMutex);
+	return m_outputsVersion;
 }
 
 void WalletSqlite::AddTransaction(const SecureVector& masterSeed, const WalletTx& walletTx)
 {
-	TransactionsTable::AddTransactions(*m_pDatabase, masterSeed, std::vector<WalletTx>({ walletTx }));
+	TransactionsTable::AddTransactions(m_statements, GetEncryptionKey(masterSeed, "WALLET_TX"), std::vector<WalletTx>({ walletTx }));
+
+	std::unique_lock<std::mutex> lock(m_cacheMutex);
+	if (m_transactionsOpt.has_value())
+	{
+		// Transactions are read back in id order, so keep the cache sorted the same way.
+		std::vector<WalletTx>& cachedTransactions = m_transactionsOpt.value();
+		auto iter = std::lower_bound(
+			cachedTransactions.begin(),
+			cachedTransactions.end(),
+			walletTx.GetId(),
+			[](const WalletTx& tx, const uint32_t id) { return tx.GetId() < id; }
+		);
+
+		if (iter != cachedTransactions.end() && iter->GetId() == walletTx.GetId())
+		{
+			*iter = walletTx;
+		}
+		else
+		{
+			cachedTransactions.insert(iter, walletTx);
+		}
+	}
 }
 
 std::vector<WalletTx> WalletSqlite::GetTransactions(const SecureVector& masterSeed) const
 {
-	return TransactionsTable::GetTransactions(*m_pDatabase, masterSeed);
+	std::unique_lock<std::mutex> lock(m_cacheMutex);
+	if (!m_transactionsOpt.has_value())
+	{
+		lock.unlock();
+		std::vector<WalletTx> transactions = TransactionsTable::GetTransactions(m_statements, GetEncryptionKey(masterSeed, "WALLET_TX"));
+
+		lock.lock();
+		m_transactionsOpt = std::make_optional(std::move(transactions));
+	}
+
+	return m_transactionsOpt.value();
 }
 
 std::unique_ptr<WalletTx> WalletSqlite::GetTransactionById(const SecureVector& masterSeed, const uint32_t walletTxId) const
 {
-	return TransactionsTable::GetTransactionById(*m_pDatabase, masterSeed, walletTxId);
+	{
+		std::unique_lock<std::mutex> lock(m_cacheMutex);
+		if (m_transactionsOpt.has_value())
+		{
+			for (const WalletTx& walletTx : m_transactionsOpt.value())
+			{
+				if (walletTx.GetId() == walletTxId)
+				{
+					return std::make_unique<WalletTx>(walletTx);
+				}
+			}
+
+			return nullptr;
+		}
+	}
+
+	return TransactionsTable::GetTransactionById(m_statements, GetEncryptionKey(masterSeed, "WALLET_TX"), walletTxId);
 }
 
 uint32_t WalletSqlite::GetNextTransactionId()
@@ -130,7 +223,7 @@ uint32_t WalletSqlite::GetNextTransactionId()
 	UserMetadata metadata = GetMetadata();
 
 	const uint32_t nextTxId = metadata.GetNextTxId();
-	const UserMetadata updatedMetadata(nextTxId + 1, metadata.GetRefreshBlockHeight(), metadata.GetRestoreLeafIndex());
+	const UserMetadata updatedMetadata(nextTxId + 1, metadata.GetRefreshBlockHeight(), metadata.GetRefreshBlockHash(), metadata.GetRestoreLeafIndex());
 	SaveMetadata(updatedMetadata);
 
 	return nextTxId;
@@ -143,11 +236,18 @@ uint64_t WalletSqlite::GetRefreshBlockHeight() const
 	return metadata.GetRefreshBlockHeight();
 }
 
-void WalletSqlite::UpdateRefreshBlockHeight(const uint64_t refreshBlockHeight)
+std::optional<Hash> WalletSqlite::GetRefreshBlockHash() const
+{
+	UserMetadata metadata = GetMetadata();
+
+	return metadata.GetRefreshBlockHash();
+}
+
+void WalletSqlite::UpdateRefreshBlock(const uint64_t refreshBlockHeight, const std::optional<Hash>& refreshBlockHashOpt)
 {
 	UserMetadata metadata = GetMetadata();
 
-	SaveMetadata(UserMetadata(metadata.GetNextTxId(), refreshBlockHeight, metadata.GetRestoreLeafIndex()));
+	SaveMetadata(UserMetadata(metadata.GetNextTxId(), refreshBlockHeight, refreshBlockHashOpt, metadata.GetRestoreLeafIndex()));
 }
 
 uint64_t WalletSqlite::GetRestoreLeafIndex() const
@@ -161,15 +261,28 @@ void WalletSqlite::UpdateRestoreLeafIndex(const uint64_t lastLeafIndex)
 {
 	UserMetadata metadata = GetMetadata();
 
-	SaveMetadata(UserMetadata(metadata.GetNextTxId(), metadata.GetRefreshBlockHeight(), lastLeafIndex));
+	SaveMetadata(UserMetadata(metadata.GetNextTxId(), metadata.GetRefreshBlockHeight(), metadata.GetRefreshBlockHash(), lastLeafIndex));
 }
 
 UserMetadata WalletSqlite::GetMetadata() const
 {
-	return MetadataTable::GetMetadata(*m_pDatabase);
+	return MetadataTable::GetMetadata(m_statements);
 }
 
 void WalletSqlite::SaveMetadata(const UserMetadata& userMetadata)
 {
-	MetadataTable::SaveMetadata(*m_pDatabase, userMetadata);
+	MetadataTable::SaveMetadata(m_statements, userMetadata);
+}
+
+SecretKey WalletSqlite::GetEncryptionKey(const SecureVector& masterSeed, const std::string& dataType) const
+{
+	std::unique_lock<std::mutex> lock(m_cacheMutex);
+
+	auto iter = m_encryptionKeys.find(dataType);
+	if (iter == m_encryptionKeys.end())
+	{
+		iter = m_encryptionKeys.emplace(dataType, WalletEncryptionUtil::CreateSecureKey(masterSeed, dataType)).first;
+	}
+
+	return iter->second;
 }
\ No newline at end of file
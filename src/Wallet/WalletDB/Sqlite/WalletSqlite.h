@@ -2,22 +2,30 @@
 
 #include "../UserMetadata.h"
 #include "SqliteTransaction.h"
+#include "SqliteStatementCache.h"
 
 #include <Wallet/WalletDB/WalletDB.h>
 #include <Wallet/WalletDB/Models/SlateContextEntity.h>
 #include <libsqlite3/sqlite3.h>
+#include <Crypto/SecretKey.h>
+#include <mutex>
+#include <optional>
 #include <unordered_map>
 
 class WalletSqlite : public IWalletDB
 {
 public:
 	explicit WalletSqlite(const fs::path& walletDirectory, const std::string& username, sqlite3* pDatabase)
-		: m_walletDirectory(walletDirectory), m_username(username), m_pDatabase(pDatabase), m_pTransaction(nullptr)
+		: m_walletDirectory(walletDirectory), m_username(username), m_pDatabase(pDatabase), m_statements(*pDatabase), m_pTransaction(nullptr), m_outputsVersion(0)
 	{
 	
 	}
 
-	virtual ~WalletSqlite() { sqlite3_close(m_pDatabase); }
+	virtual ~WalletSqlite()
+	{
+		m_statements.Clear();
+		sqlite3_close(m_pDatabase);
+	}
 
 	void Commit() final;
 	void Rollback() noexcept final;
@@ -49,6 +57,7 @@ public:
 
 	void AddOutputs(const SecureVector& masterSeed, const std::vector<OutputDataEntity>& outputs) final;
 	std::vector<OutputDataEntity> GetOutputs(const SecureVector& masterSeed) const final;
+	uint64_t GetOutputsVersion() const final;
 
 	void AddTransaction(const SecureVector& masterSeed, const WalletTx& walletTx) final;
 	std::vector<WalletTx> GetTransactions(const SecureVector& masterSeed) const final;
@@ -56,7 +65,8 @@ public:
 
 	uint32_t GetNextTransactionId() final;
 	uint64_t GetRefreshBlockHeight() const final;
-	void UpdateRefreshBlockHeight(const uint64_t refreshBlockHeight) final;
+	std::optional<Hash> GetRefreshBlockHash() const final;
+	void UpdateRefreshBlock(const uint64_t refreshBlockHeight, const std::optional<Hash>& refreshBlockHashOpt) final;
 	uint64_t GetRestoreLeafIndex() const final;
 	void UpdateRestoreLeafIndex(const uint64_t lastLeafIndex) final;
 
@@ -64,8 +74,21 @@ private:
 	UserMetadata GetMetadata() const;
 	void SaveMetadata(const UserMetadata& userMetadata);
 
+	SecretKey GetEncryptionKey(const SecureVector& masterSeed, const std::string& dataType) const;
+
 	fs::path m_walletDirectory;
 	std::string m_username;
 	sqlite3* m_pDatabase;
+	mutable SqliteStatementCache m_statements;
 	std::unique_ptr<SqliteTransaction> m_pTransaction;
+
+	// A WalletSqlite only lives as long as the user's session, so derived encryption keys
+	// and decrypted outputs/transactions are cached here to avoid repeating the crypto for every read.
+	// The entity caches are kept in sync on writes, and dropped on Rollback.
+	// Guarded by m_cacheMutex, since const methods can be called concurrently by Readers.
+	mutable std::mutex m_cacheMutex;
+	mutable std::unordered_map<std::string, SecretKey> m_encryptionKeys;
+	mutable std::optional<std::vector<OutputDataEntity>> m_outputsOpt;
+	mutable std::optional<std::vector<WalletTx>> m_transactionsOpt;
+	uint64_t m_outputsVersion;
 };
@@ -2,21 +2,31 @@
 
 #include <Core/Serialization/Serializer.h>
 #include <Core/Serialization/ByteBuffer.h>
+#include <Crypto/Hash.h>
+#include <optional>
 #include <stdint.h>
 
-static const uint8_t USER_METADATA_FORMAT = 0;
+static const uint8_t USER_METADATA_FORMAT = 1;
 
 class UserMetadata
 {
 public:
-	UserMetadata(const uint32_t nextTxId, const uint64_t refreshBlockHeight, const uint64_t restoreLeafIndex)
-		: m_nextTxId(nextTxId), m_refreshBlockHeight(refreshBlockHeight), m_restoreLeafIndex(restoreLeafIndex)
+	UserMetadata(
+		const uint32_t nextTxId,
+		const uint64_t refreshBlockHeight,
+		const std::optional<Hash>& refreshBlockHashOpt,
+		const uint64_t restoreLeafIndex)
+		: m_nextTxId(nextTxId),
+		m_refreshBlockHeight(refreshBlockHeight),
+		m_refreshBlockHashOpt(refreshBlockHashOpt),
+		m_restoreLeafIndex(restoreLeafIndex)
 	{
 
 	}
 
 	inline uint32_t GetNextTxId() const { return m_nextTxId; }
 	inline uint64_t GetRefreshBlockHeight() const { return m_refreshBlockHeight; }
+	inline const std::optional<Hash>& GetRefreshBlockHash() const { return m_refreshBlockHashOpt; }
 	inline uint64_t GetRestoreLeafIndex() const { return m_restoreLeafIndex; }
 
 	void Serialize(Serializer& serializer) const
@@ -25,24 +35,39 @@ public:
 		serializer.Append<uint32_t>(m_nextTxId);
 		serializer.Append<uint64_t>(m_refreshBlockHeight);
 		serializer.Append<uint64_t>(m_restoreLeafIndex);
+
+		serializer.Append<uint8_t>(m_refreshBlockHashOpt.has_value() ? 1 : 0);
+		if (m_refreshBlockHashOpt.has_value())
+		{
+			serializer.AppendBigInteger(m_refreshBlockHashOpt.value());
+		}
 	}
 
 	static UserMetadata Deserialize(ByteBuffer& byteBuffer)
 	{
 		const uint8_t format = byteBuffer.ReadU8();
-		if (format != USER_METADATA_FORMAT)
+		if (format > USER_METADATA_FORMAT)
 		{
-			throw DESERIALIZATION_EXCEPTION_F("Expected format {}, but was {}", USER_METADATA_FORMAT, format);
+			throw DESERIALIZATION_EXCEPTION_F("Expected format <= {}, but was {}", USER_METADATA_FORMAT, format);
 		}
 
 		const uint32_t nextTxId = byteBuffer.ReadU32();
 		const uint64_t refreshBlockHeight = byteBuffer.ReadU64();
 		const uint64_t restoreLeafIndex = byteBuffer.ReadU64();
-		return UserMetadata(nextTxId, refreshBlockHeight, restoreLeafIndex);
+
+		// Format 0 didn't include the refresh block hash.
+		std::optional<Hash> refreshBlockHashOpt = std::nullopt;
+		if (format >= 1 && byteBuffer.ReadU8() == 1)
+		{
+			refreshBlockHashOpt = std::make_optional<Hash>(byteBuffer.ReadBigInteger<32>());
+		}
+
+		return UserMetadata(nextTxId, refreshBlockHeight, refreshBlockHashOpt, restoreLeafIndex);
 	}
 
 private:
 	uint32_t m_nextTxId;
 	uint64_t m_refreshBlockHeight;
+	std::optional<Hash> m_refreshBlockHashOpt;
 	uint64_t m_restoreLeafIndex;
-};
\ No newline at end of file
+};
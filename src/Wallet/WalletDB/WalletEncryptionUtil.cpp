@@ -2,17 +2,59 @@
 
 #include <Crypto/Crypto.h>
 #include <Crypto/RandomNumberGenerator.h>
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <thread>
 
 static const uint8_t ENCRYPTION_FORMAT = 0;
+static const size_t MIN_RECORDS_PER_THREAD = 64;
+
+// Calls func(i) for every i in [0, numRecords), split into contiguous ranges across threads
+// when there are enough records to be worth it.
+static void ForEachInParallel(const size_t numRecords, const std::function<void(const size_t)>& func)
+{
+	const size_t numThreads = std::min<size_t>(
+		std::max<size_t>(std::thread::hardware_concurrency(), 1),
+		std::max<size_t>(numRecords / MIN_RECORDS_PER_THREAD, 1)
+	);
+	const size_t recordsPerThread = (numRecords + numThreads - 1) / numThreads;
+
+	auto processRange = [&func](const size_t begin, const size_t end) {
+		for (size_t i = begin; i < end; i++)
+		{
+			func(i);
+		}
+	};
+
+	// The calling thread takes the first range, so small tables never spawn threads.
+	std::vector<std::future<void>> futures;
+	for (size_t begin = recordsPerThread; begin < numRecords; begin += recordsPerThread)
+	{
+		const size_t end = std::min(begin + recordsPerThread, numRecords);
+		futures.push_back(std::async(std::launch::async, processRange, begin, end));
+	}
+
+	processRange(0, std::min(recordsPerThread, numRecords));
+
+	for (auto& future : futures)
+	{
+		future.get();
+	}
+}
 
 std::vector<unsigned char> WalletEncryptionUtil::Encrypt(
 	const SecureVector& masterSeed,
 	const std::string& dataType,
 	const SecureVector& bytes)
+{
+	return Encrypt(WalletEncryptionUtil::CreateSecureKey(masterSeed, dataType), bytes);
+}
+
+std::vector<unsigned char> WalletEncryptionUtil::Encrypt(const SecretKey& key, const SecureVector& bytes)
 {
 	const CBigInteger<32> randomNumber = RandomNumberGenerator::GenerateRandom32();
 	const CBigInteger<16> iv = CBigInteger<16>(&randomNumber[0]);
-	const SecretKey key = WalletEncryptionUtil::CreateSecureKey(masterSeed, dataType);
 
 	const std::vector<unsigned char> encryptedBytes =
 		Crypto::AES256_Encrypt(bytes, key, iv);
@@ -28,6 +70,11 @@ SecureVector WalletEncryptionUtil::Decrypt(
 	const SecureVector& masterSeed,
 	const std::string& dataType,
 	const std::vector<unsigned char>& encrypted)
+{
+	return Decrypt(WalletEncryptionUtil::CreateSecureKey(masterSeed, dataType), encrypted);
+}
+
+SecureVector WalletEncryptionUtil::Decrypt(const SecretKey& key, const std::vector<unsigned char>& encrypted)
 {
 	ByteBuffer byteBuffer(encrypted);
 
@@ -44,11 +91,36 @@ SecureVector WalletEncryptionUtil::Decrypt(
 	const CBigInteger<16> iv = byteBuffer.ReadBigInteger<16>();
 	const std::vector<unsigned char> encryptedBytes =
 		byteBuffer.ReadVector(byteBuffer.GetRemainingSize());
-	const SecretKey key = WalletEncryptionUtil::CreateSecureKey(masterSeed, dataType);
 
 	return Crypto::AES256_Decrypt(encryptedBytes, key, iv);
 }
 
+std::vector<std::vector<unsigned char>> WalletEncryptionUtil::EncryptAll(
+	const SecretKey& key,
+	const std::vector<SecureVector>& records)
+{
+	std::vector<std::vector<unsigned char>> encrypted(records.size());
+
+	ForEachInParallel(records.size(), [&key, &records, &encrypted](const size_t i) {
+		encrypted[i] = Encrypt(key, records[i]);
+	});
+
+	return encrypted;
+}
+
+std::vector<SecureVector> WalletEncryptionUtil::DecryptAll(
+	const SecretKey& key,
+	const std::vector<std::vector<unsigned char>>& encrypted)
+{
+	std::vector<SecureVector> decrypted(encrypted.size());
+
+	ForEachInParallel(encrypted.size(), [&key, &encrypted, &decrypted](const size_t i) {
+		decrypted[i] = Decrypt(key, encrypted[i]);
+	});
+
+	return decrypted;
+}
+
 SecretKey WalletEncryptionUtil::CreateSecureKey(
 	const SecureVector& masterSeed,
 	const std::string& dataType)
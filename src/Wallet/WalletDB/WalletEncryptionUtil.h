@@ -11,6 +11,19 @@ public:
 	static std::vector<unsigned char> Encrypt(const SecureVector& masterSeed, const std::string& dataType, const SecureVector& bytes);
 	static SecureVector Decrypt(const SecureVector& masterSeed, const std::string& dataType, const std::vector<unsigned char>& encrypted);
 
-private:
+	//
+	// Same as above, but using a key previously created by CreateSecureKey.
+	// Callers encrypting/decrypting many records should create the key once and reuse it.
+	//
+	static std::vector<unsigned char> Encrypt(const SecretKey& key, const SecureVector& bytes);
+	static SecureVector Decrypt(const SecretKey& key, const std::vector<unsigned char>& encrypted);
+
+	//
+	// Encrypts/decrypts all of the given records, in parallel when there are enough of them to be worth it.
+	// The results are returned in the same order.
+	//
+	static std::vector<std::vector<unsigned char>> EncryptAll(const SecretKey& key, const std::vector<SecureVector>& records);
+	static std::vector<SecureVector> DecryptAll(const SecretKey& key, const std::vector<std::vector<unsigned char>>& encrypted);
+
 	static SecretKey CreateSecureKey(const SecureVector& masterSeed, const std::string& dataType);
-};
\ No newline at end of file
+};
@@ -19,6 +19,7 @@
 #include <Net/Tor/TorAddressParser.h>
 #include <Net/Tor/TorProcess.h>
 #include <cassert>
+#include <numeric>
 #include <thread>
 
 WalletManager::WalletManager(const Config& config, INodeClientPtr pNodeClient, std::shared_ptr<IWalletStore> pWalletStore)
@@ -320,26 +321,35 @@ FeeEstimateDTO WalletManager::EstimateFee(const EstimateFeeCriteria& criteria)
 	Locked<Wallet> wallet = m_sessionManager.Read()->GetWallet(criteria.GetToken());
 
 	// Select inputs using desired selection strategy.
-	const uint8_t totalNumOutputs = criteria.GetNumChangeOutputs() + 1;
+	const uint8_t numChangeOutputs = criteria.GetNumChangeOutputs();
 	const uint64_t numKernels = 1;
-	const std::vector<OutputDataEntity> availableCoins = wallet.Write()->GetAllAvailableCoins(masterSeed);
-	std::vector<OutputDataEntity> inputs = CoinSelection().SelectCoinsToSpend(
-		availableCoins,
+	const CoinIndex::CPtr pAvailableCoins = wallet.Write()->GetAvailableCoins(masterSeed);
+	std::vector<OutputDataEntity> inputs = CoinSelection::SelectCoinsToSpend(
+		*pAvailableCoins,
 		criteria.GetAmount(),
 		criteria.GetFeeBase(),
 		criteria.GetSelectionStrategy().GetStrategy(),
 		criteria.GetSelectionStrategy().GetInputs(),
-		totalNumOutputs,
+		numChangeOutputs + 1,
+		numChangeOutputs,
 		numKernels
 	);
 
-	// Calculate the fee
-	const uint64_t fee = WalletUtil::CalculateFee(
+	// Calculate the fee, the same way SendSlateBuilder will.
+	uint64_t fee = WalletUtil::CalculateFee(
 		criteria.GetFeeBase(),
 		(int64_t)inputs.size(),
-		totalNumOutputs,
+		numChangeOutputs + 1,
 		numKernels
 	);
+	if (CoinSelection::ShouldAvoidChange(criteria.GetSelectionStrategy().GetStrategy(), inputs, criteria.GetAmount(), criteria.GetFeeBase(), numChangeOutputs + 1, numChangeOutputs, numKernels))
+	{
+		const uint64_t inputTotal = std::accumulate(
+			inputs.cbegin(), inputs.cend(), (uint64_t)0,
+			[](const uint64_t sum, const OutputDataEntity& input) { return sum + input.GetAmount(); }
+		);
+		fee = inputTotal - criteria.GetAmount();
+	}
 
 	std::vector<WalletOutputDTO> inputDTOs;
 	for (const OutputDataEntity& input : inputs)
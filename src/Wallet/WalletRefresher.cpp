@@ -7,38 +7,88 @@
 #include <Wallet/WalletDB/WalletDB.h>
 #include <unordered_map>
 
-WalletRefresher::WalletRefresher(const Config& config, INodeClientConstPtr pNodeClient)
-	: m_config(config), m_pNodeClient(pNodeClient)
+WalletRefresher::WalletRefresher(const Config& config, INodeClientConstPtr pNodeClient, const KeyChainCache::Ptr& pKeyCache)
+	: m_config(config), m_pNodeClient(pNodeClient), m_pKeyCache(pKeyCache)
 {
 
 }
 
-// TODO: Rewrite this && use cache - Shouldn't refresh when block height = same
+// Past this many blocks, looking up every output at once is cheaper than fetching each block.
+static const uint64_t MAX_DELTA_BLOCKS = 720;
+
 // 0. Initial login after upgrade - for every output, find matching WalletTx and update OutputDataEntity TxId. If none found, create new WalletTx.
 //
 // 1. Check for own outputs in new blocks.
 // 2. For each output, look for OutputDataEntity with matching commitment. If no output found, create new WalletTx and OutputDataEntity.
-// 3. Refresh status for all OutputDataEntity by calling m_pNodeClient->GetOutputsByCommitment
+// 3. Refresh status of the OutputDataEntities affected by the blocks since the last refresh,
+//    or of all of them by calling m_pNodeClient->GetOutputsByCommitment if that's not possible.
 // 4. For all OutputDataEntity, update matching WalletTx status.
 
 std::vector<OutputDataEntity> WalletRefresher::Refresh(const SecureVector& masterSeed, Locked<IWalletDB> walletDB, const bool fromGenesis)
 {
 	auto pBatch = walletDB.BatchWrite();
 
-	if (m_pNodeClient->GetChainHeight() < pBatch->GetRefreshBlockHeight())
+	const uint64_t lastConfirmedHeight = m_pNodeClient->GetChainHeight();
+	if (lastConfirmedHeight < pBatch->GetRefreshBlockHeight())
 	{
 		WALLET_TRACE("Skipping refresh since node is resyncing.");
 		return std::vector<OutputDataEntity>();
 	}
 
 	std::vector<OutputDataEntity> walletOutputs = pBatch->GetOutputs(masterSeed);
-	std::vector<WalletTx> walletTransactions = pBatch->GetTransactions(masterSeed);
+	OutputIndex outputIndex = IndexByCommitment(walletOutputs);
 
 	// 1. Check for own outputs in new blocks.
-	KeyChain keyChain = KeyChain::FromSeed(m_config, masterSeed);
-	std::vector<OutputDataEntity> restoredOutputs = OutputRestorer(m_config, m_pNodeClient, keyChain).FindAndRewindOutputs(pBatch, fromGenesis);
+	KeyChain keyChain = KeyChain::FromSeed(m_config, masterSeed, m_pKeyCache);
+	OutputRestorer(m_config, m_pNodeClient, keyChain).FindAndRewindOutputs(
+		pBatch,
+		fromGenesis,
+		[this, &masterSeed, &pBatch, &walletOutputs, &outputIndex](std::vector<OutputDataEntity>&& restoredOutputs) {
+			// 2. For each restored output, look for OutputDataEntity with matching commitment.
+			AddRestoredOutputs(masterSeed, pBatch, restoredOutputs, walletOutputs, outputIndex);
+
+			// Commit what has been found so far, so an interrupted restore resumes from this checkpoint.
+			pBatch->Commit();
+			pBatch->OnInitWrite();
+		}
+	);
+
+	// 3. Refresh status of the OutputDataEntities that changed on chain.
+	std::optional<Hash> refreshBlockHashOpt = std::nullopt;
+	std::optional<std::vector<OutputDataEntity>> outputsToUpdateOpt = std::nullopt;
+	if (!fromGenesis)
+	{
+		outputsToUpdateOpt = RefreshOutputsFromDeltas(pBatch, walletOutputs, outputIndex, lastConfirmedHeight, refreshBlockHashOpt);
+	}
+
+	uint64_t refreshHeight = lastConfirmedHeight;
+	const bool fullRefresh = !outputsToUpdateOpt.has_value();
+	if (fullRefresh)
+	{
+		outputsToUpdateOpt = RefreshOutputs(walletOutputs, refreshHeight, refreshBlockHashOpt);
+	}
+
+	pBatch->AddOutputs(masterSeed, outputsToUpdateOpt.value());
+	pBatch->UpdateRefreshBlock(refreshHeight, refreshBlockHashOpt);
+
+	// 4. For all OutputDataEntity, update matching WalletTx status.
+	// Transactions only change along with their outputs, so there's nothing to do if no outputs changed since the last refresh.
+	if (fullRefresh || !outputsToUpdateOpt.value().empty())
+	{
+		RefreshTransactions(masterSeed, pBatch, walletOutputs, outputIndex);
+	}
 
-	// 2. For each restored output, look for OutputDataEntity with matching commitment.
+	pBatch->Commit();
+	return walletOutputs;
+}
+
+void WalletRefresher::AddRestoredOutputs(
+	const SecureVector& masterSeed,
+	Writer<IWalletDB> pBatch,
+	std::vector<OutputDataEntity>& restoredOutputs,
+	std::vector<OutputDataEntity>& walletOutputs,
+	OutputIndex& outputIndex)
+{
 	for (OutputDataEntity& restoredOutput : restoredOutputs)
 	{
 		WALLET_INFO_F("Output found at index {}", restoredOutput.GetMMRIndex().value_or(0));
@@ -46,8 +96,7 @@ std::vector<OutputDataEntity> WalletRefresher::Refresh(const SecureVector& maste
 		if (restoredOutput.GetStatus() != EOutputStatus::SPENT)
 		{
 			const Commitment& commitment = restoredOutput.GetOutput().GetCommitment();
-			std::unique_ptr<OutputDataEntity> pExistingOutput = FindOutput(walletOutputs, commitment);
-			if (pExistingOutput == nullptr)
+			if (outputIndex.find(commitment) == outputIndex.cend())
 			{
 				WALLET_INFO_F("Restoring unknown output with commitment: {}", commitment);
 
@@ -75,24 +124,22 @@ std::vector<OutputDataEntity> WalletRefresher::Refresh(const SecureVector& maste
 				pBatch->AddOutputs(masterSeed, std::vector<OutputDataEntity>({ restoredOutput }));
 				pBatch->AddTransaction(masterSeed, walletTx);
 
+				outputIndex[commitment] = walletOutputs.size();
 				walletOutputs.push_back(restoredOutput);
-				walletTransactions.emplace_back(std::move(walletTx));
 			}
 		}
 	}
-
-	// 3. Refresh status for all OutputDataEntity by calling m_pNodeClient->GetOutputsByCommitment
-	RefreshOutputs(masterSeed, pBatch, walletOutputs);
-
-	// 4. For all OutputDataEntity, update matching WalletTx status.
-	RefreshTransactions(masterSeed, pBatch, walletOutputs, walletTransactions);
-
-	pBatch->Commit();
-	return walletOutputs;
 }
 
-void WalletRefresher::RefreshOutputs(const SecureVector& masterSeed, Writer<IWalletDB> pBatch, std::vector<OutputDataEntity>& walletOutputs)
+std::vector<OutputDataEntity> WalletRefresher::RefreshOutputs(
+	std::vector<OutputDataEntity>& walletOutputs,
+	uint64_t& refreshHeight,
+	std::optional<Hash>& refreshBlockHashOpt)
 {
+	// Looked up before the outputs, so a reorg that happens in between is caught by the next refresh.
+	const uint64_t expectedHeight = refreshHeight;
+	auto pHeader = m_pNodeClient->GetBlockHeader(expectedHeight);
+
 	std::vector<Commitment> commitments;
 
 	for (const OutputDataEntity& outputData : walletOutputs)
@@ -110,72 +157,208 @@ void WalletRefresher::RefreshOutputs(const SecureVector& masterSeed, Writer<IWal
 		commitments.push_back(commitment);		
 	}
 
-	const uint64_t lastConfirmedHeight = m_pNodeClient->GetChainHeight();
+	// The outputs and the height they're checked for maturity against come from the same chain state.
+	const OutputLocations outputLocations = m_pNodeClient->GetOutputLocations(commitments);
+	refreshHeight = outputLocations.GetHeight();
+
+	// If the chain moved on in between, the header's hash doesn't match the outputs, so the next refresh is a full one.
+	refreshBlockHashOpt = (pHeader != nullptr && refreshHeight == expectedHeight)
+		? std::make_optional<Hash>(pHeader->GetHash())
+		: std::optional<Hash>();
 
 	std::vector<OutputDataEntity> outputsToUpdate;
-	const std::map<Commitment, OutputLocation> outputLocations = m_pNodeClient->GetOutputsByCommitment(commitments);
+	const std::map<Commitment, OutputLocation>& locations = outputLocations.GetLocations();
 	for (OutputDataEntity& outputData : walletOutputs)
 	{
-		auto iter = outputLocations.find(outputData.GetOutput().GetCommitment());
-		if (iter != outputLocations.cend())
+		auto iter = locations.find(outputData.GetOutput().GetCommitment());
+		const std::optional<uint64_t> blockHeightOpt = iter != locations.cend()
+			? std::make_optional<uint64_t>(iter->second.GetBlockHeight())
+			: std::optional<uint64_t>();
+
+		if (UpdateStatus(outputData, blockHeightOpt, refreshHeight))
+		{
+			outputsToUpdate.push_back(outputData);
+		}
+	}
+
+	return outputsToUpdate;
+}
+
+std::optional<std::vector<OutputDataEntity>> WalletRefresher::RefreshOutputsFromDeltas(
+	Writer<IWalletDB> pBatch,
+	std::vector<OutputDataEntity>& walletOutputs,
+	const OutputIndex& outputIndex,
+	const uint64_t lastConfirmedHeight,
+	std::optional<Hash>& refreshBlockHashOpt)
+{
+	const uint64_t refreshHeight = pBatch->GetRefreshBlockHeight();
+	const std::optional<Hash> previousHashOpt = pBatch->GetRefreshBlockHash();
+	if (!previousHashOpt.has_value() || lastConfirmedHeight - refreshHeight > MAX_DELTA_BLOCKS)
+	{
+		return std::nullopt;
+	}
+
+	auto pRefreshHeader = m_pNodeClient->GetBlockHeader(refreshHeight);
+	if (pRefreshHeader == nullptr || pRefreshHeader->GetHash() != previousHashOpt.value())
+	{
+		WALLET_INFO_F("Block at refresh height {} was reorged. Refreshing all outputs.", refreshHeight);
+		return std::nullopt;
+	}
+
+	const std::vector<BlockDelta> deltas = m_pNodeClient->GetBlockDeltas(refreshHeight + 1, lastConfirmedHeight);
+	if (deltas.size() != lastConfirmedHeight - refreshHeight)
+	{
+		WALLET_INFO_F("Blocks {} to {} not available. Refreshing all outputs.", refreshHeight + 1, lastConfirmedHeight);
+		return std::nullopt;
+	}
+
+	// Where each affected output ended up:
+	// the height of the block that created it if it's still unspent, or nullopt if it's been spent.
+	std::unordered_map<Commitment, std::optional<uint64_t>> changes;
+
+	Hash previousHash = previousHashOpt.value();
+	for (const BlockDelta& delta : deltas)
+	{
+		const BlockIdentifier& block = delta.GetBlockIdentifier();
+		if (block.GetPreviousHash() != previousHash)
+		{
+			WALLET_INFO_F("Reorg at height {} during refresh. Refreshing all outputs.", block.GetHeight());
+			return std::nullopt;
+		}
+
+		previousHash = block.GetHash();
+
+		for (const Commitment& created : delta.GetCreated())
 		{
-			if (outputData.GetStatus() != EOutputStatus::LOCKED)
+			if (outputIndex.find(created) != outputIndex.cend())
 			{
-				const EOutputFeatures features = outputData.GetOutput().GetFeatures();
-				const uint64_t outputBlockHeight = iter->second.GetBlockHeight();
-				const uint32_t minimumConfirmations = m_config.GetWalletConfig().GetMinimumConfirmations();
-				const bool immature = WalletUtil::IsOutputImmature(
-					m_config.GetEnvironment().GetType(),
-					features,
-					outputBlockHeight,
-					lastConfirmedHeight,
-					minimumConfirmations
-				);
+				changes[created] = std::make_optional<uint64_t>(block.GetHeight());
+			}
+		}
 
-				if (immature)
-				{
-					if (outputData.GetStatus() != EOutputStatus::IMMATURE)
-					{
-						WALLET_DEBUG_F("Marking output as immature: {}", outputData);
+		for (const Commitment& spent : delta.GetSpent())
+		{
+			if (outputIndex.find(spent) != outputIndex.cend())
+			{
+				changes[spent] = std::nullopt;
+			}
+		}
+	}
 
-						outputData.SetBlockHeight(outputBlockHeight);
-						outputData.SetStatus(EOutputStatus::IMMATURE);
-						outputsToUpdate.push_back(outputData);
-					}
-				}
-				else if (outputData.GetStatus() != EOutputStatus::SPENDABLE)
+	// Immature outputs change as the chain grows, and outputs added or canceled since the last refresh
+	// may have been confirmed earlier than the new blocks, so those still have to be looked up.
+	std::vector<Commitment> pending;
+	for (const OutputDataEntity& outputData : walletOutputs)
+	{
+		const EOutputStatus status = outputData.GetStatus();
+		const Commitment& commitment = outputData.GetOutput().GetCommitment();
+		if ((status == EOutputStatus::IMMATURE || status == EOutputStatus::NO_CONFIRMATIONS || status == EOutputStatus::CANCELED)
+			&& changes.find(commitment) == changes.cend())
+		{
+			pending.push_back(commitment);
+		}
+	}
+
+	if (!pending.empty())
+	{
+		// Their maturity is checked against lastConfirmedHeight, so they must have been looked up at that height too.
+		const OutputLocations outputLocations = m_pNodeClient->GetOutputLocations(pending);
+		if (outputLocations.GetHeight() != lastConfirmedHeight)
+		{
+			WALLET_INFO_F("Chain moved past height {} during refresh. Refreshing all outputs.", lastConfirmedHeight);
+			return std::nullopt;
+		}
+
+		const std::map<Commitment, OutputLocation>& locations = outputLocations.GetLocations();
+		for (const Commitment& commitment : pending)
+		{
+			auto iter = locations.find(commitment);
+			changes[commitment] = iter != locations.cend()
+				? std::make_optional<uint64_t>(iter->second.GetBlockHeight())
+				: std::optional<uint64_t>();
+		}
+	}
+
+	WALLET_DEBUG_F("Refreshing {} outputs affected by blocks {} to {}", changes.size(), refreshHeight + 1, lastConfirmedHeight);
+
+	std::vector<OutputDataEntity> outputsToUpdate;
+	for (const auto& change : changes)
+	{
+		OutputDataEntity& outputData = walletOutputs[outputIndex.at(change.first)];
+		if (UpdateStatus(outputData, change.second, lastConfirmedHeight))
+		{
+			outputsToUpdate.push_back(outputData);
+		}
+	}
+
+	refreshBlockHashOpt = std::make_optional(previousHash);
+	return std::make_optional(std::move(outputsToUpdate));
+}
+
+bool WalletRefresher::UpdateStatus(
+	OutputDataEntity& outputData,
+	const std::optional<uint64_t>& blockHeightOpt,
+	const uint64_t lastConfirmedHeight) const
+{
+	if (blockHeightOpt.has_value())
+	{
+		if (outputData.GetStatus() != EOutputStatus::LOCKED)
+		{
+			const EOutputFeatures features = outputData.GetOutput().GetFeatures();
+			const uint64_t outputBlockHeight = blockHeightOpt.value();
+			const uint32_t minimumConfirmations = m_config.GetWalletConfig().GetMinimumConfirmations();
+			const bool immature = WalletUtil::IsOutputImmature(
+				m_config.GetEnvironment().GetType(),
+				features,
+				outputBlockHeight,
+				lastConfirmedHeight,
+				minimumConfirmations
+			);
+
+			if (immature)
+			{
+				if (outputData.GetStatus() != EOutputStatus::IMMATURE)
 				{
-					WALLET_DEBUG_F("Marking output as spendable: {}", outputData);
+					WALLET_DEBUG_F("Marking output as immature: {}", outputData);
 
 					outputData.SetBlockHeight(outputBlockHeight);
-					outputData.SetStatus(EOutputStatus::SPENDABLE);
-					outputsToUpdate.push_back(outputData);
+					outputData.SetStatus(EOutputStatus::IMMATURE);
+					return true;
 				}
 			}
-		}
-		else if (
-			outputData.GetStatus() != EOutputStatus::NO_CONFIRMATIONS && 
-			outputData.GetStatus() != EOutputStatus::SPENT && 
-			outputData.GetStatus() != EOutputStatus::CANCELED)
-		{
-			// TODO: Check if (lastConfirmedHeight > outputData.GetConfirmedHeight)
-			WALLET_DEBUG_F("Marking output as spent: {}", outputData);
+			else if (outputData.GetStatus() != EOutputStatus::SPENDABLE)
+			{
+				WALLET_DEBUG_F("Marking output as spendable: {}", outputData);
 
-			outputData.SetStatus(EOutputStatus::SPENT);
-			outputsToUpdate.push_back(outputData);
+				outputData.SetBlockHeight(outputBlockHeight);
+				outputData.SetStatus(EOutputStatus::SPENDABLE);
+				return true;
+			}
 		}
 	}
+	else if (
+		outputData.GetStatus() != EOutputStatus::NO_CONFIRMATIONS && 
+		outputData.GetStatus() != EOutputStatus::SPENT && 
+		outputData.GetStatus() != EOutputStatus::CANCELED)
+	{
+		// TODO: Check if (lastConfirmedHeight > outputData.GetConfirmedHeight)
+		WALLET_DEBUG_F("Marking output as spent: {}", outputData);
 
-	pBatch->AddOutputs(masterSeed, outputsToUpdate);
-	pBatch->UpdateRefreshBlockHeight(lastConfirmedHeight);
+		outputData.SetStatus(EOutputStatus::SPENT);
+		return true;
+	}
+
+	return false;
 }
 
 void WalletRefresher::RefreshTransactions(
 	const SecureVector& masterSeed,
 	Writer<IWalletDB> pBatch,
 	const std::vector<OutputDataEntity>& refreshedOutputs,
-	std::vector<WalletTx>& walletTransactions)
+	const OutputIndex& outputIndex)
 {
+	std::vector<WalletTx> walletTransactions = pBatch->GetTransactions(masterSeed);
+
 	std::unordered_map<uint32_t, WalletTx> walletTransactionsById;
 	for (WalletTx& walletTx : walletTransactions)
 	{
@@ -221,10 +404,10 @@ void WalletRefresher::RefreshTransactions(
 			const std::vector<TransactionOutput>& outputs = walletTx.GetTransaction().value().GetOutputs();
 			for (const TransactionOutput& output : outputs)
 			{
-				std::unique_ptr<OutputDataEntity> pOutputData = FindOutput(refreshedOutputs, output.GetCommitment());
-				if (pOutputData != nullptr)
+				auto iter = outputIndex.find(output.GetCommitment());
+				if (iter != outputIndex.cend())
 				{
-					if (pOutputData->GetStatus() == EOutputStatus::SPENT)
+					if (refreshedOutputs[iter->second].GetStatus() == EOutputStatus::SPENT)
 					{
 						WALLET_DEBUG_F("Output is spent. Marking transaction as sent: {}", walletTx.GetId());
 
@@ -253,17 +436,14 @@ std::optional<std::chrono::system_clock::time_point> WalletRefresher::GetBlockTi
 	return std::nullopt;
 }
 
-std::unique_ptr<OutputDataEntity> WalletRefresher::FindOutput(
-	const std::vector<OutputDataEntity>& walletOutputs,
-	const Commitment& commitment) const
+WalletRefresher::OutputIndex WalletRefresher::IndexByCommitment(const std::vector<OutputDataEntity>& walletOutputs)
 {
-	for (const OutputDataEntity& outputData : walletOutputs)
+	OutputIndex outputIndex;
+	outputIndex.reserve(walletOutputs.size());
+	for (size_t i = 0; i < walletOutputs.size(); i++)
 	{
-		if (commitment == outputData.GetOutput().GetCommitment())
-		{
-			return std::make_unique<OutputDataEntity>(outputData);
-		}
+		outputIndex[walletOutputs[i].GetOutput().GetCommitment()] = i;
 	}
 
-	return std::unique_ptr<OutputDataEntity>(nullptr);
+	return outputIndex;
 }
\ No newline at end of file
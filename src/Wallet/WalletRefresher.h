@@ -2,6 +2,7 @@
 
 #include <Config/Config.h>
 #include <Wallet/WalletTx.h>
+#include <Wallet/Keychain/KeyChainCache.h>
 #include <Wallet/NodeClient.h>
 #include <Wallet/WalletDB/WalletDB.h>
 #include <Wallet/WalletDB/Models/OutputDataEntity.h>
@@ -9,6 +10,7 @@
 #include <Crypto/SecretKey.h>
 #include <stdint.h>
 #include <string>
+#include <unordered_map>
 
 // Forward Declarations
 class INodeClient;
@@ -17,17 +19,57 @@ class Wallet;
 class WalletRefresher
 {
 public:
-	WalletRefresher(const Config& config, INodeClientConstPtr pNodeClient);
+	WalletRefresher(const Config& config, INodeClientConstPtr pNodeClient, const KeyChainCache::Ptr& pKeyCache = nullptr);
 
 	std::vector<OutputDataEntity> Refresh(const SecureVector& masterSeed, Locked<IWalletDB> walletDB, const bool fromGenesis);
 
 private:
-	void RefreshOutputs(const SecureVector& masterSeed, Writer<IWalletDB> pBatch, std::vector<OutputDataEntity>& walletOutputs);
-	void RefreshTransactions(const SecureVector& masterSeed, Writer<IWalletDB> pBatch, const std::vector<OutputDataEntity>& walletOutputs, std::vector<WalletTx>& walletTransactions);
+	// Position of each wallet output, by commitment.
+	using OutputIndex = std::unordered_map<Commitment, size_t>;
+
+	void AddRestoredOutputs(
+		const SecureVector& masterSeed,
+		Writer<IWalletDB> pBatch,
+		std::vector<OutputDataEntity>& restoredOutputs,
+		std::vector<OutputDataEntity>& walletOutputs,
+		OutputIndex& outputIndex
+	);
+
+	//
+	// Looks up every output on the node. Returns the outputs whose status changed.
+	// refreshHeight is updated to the height the outputs were actually looked up at.
+	//
+	std::vector<OutputDataEntity> RefreshOutputs(
+		std::vector<OutputDataEntity>& walletOutputs,
+		uint64_t& refreshHeight,
+		std::optional<Hash>& refreshBlockHashOpt
+	);
+
+	//
+	// Only updates the outputs created or spent by the blocks since the last refresh, plus the few whose status depends on the tip.
+	// Returns nullopt, without changing anything, if a reorg replaced the block at the refresh height,
+	// or the blocks since then aren't available, in which case RefreshOutputs must be used instead.
+	//
+	std::optional<std::vector<OutputDataEntity>> RefreshOutputsFromDeltas(
+		Writer<IWalletDB> pBatch,
+		std::vector<OutputDataEntity>& walletOutputs,
+		const OutputIndex& outputIndex,
+		const uint64_t lastConfirmedHeight,
+		std::optional<Hash>& refreshBlockHashOpt
+	);
+
+	//
+	// Updates the output's status given the height of the block it's in, or nullopt if it's not in the UTXO set.
+	// Returns true if the status changed.
+	//
+	bool UpdateStatus(OutputDataEntity& outputData, const std::optional<uint64_t>& blockHeightOpt, const uint64_t lastConfirmedHeight) const;
+
+	void RefreshTransactions(const SecureVector& masterSeed, Writer<IWalletDB> pBatch, const std::vector<OutputDataEntity>& walletOutputs, const OutputIndex& outputIndex);
 	std::optional<std::chrono::system_clock::time_point> GetBlockTime(const OutputDataEntity& output) const;
 
-	std::unique_ptr<OutputDataEntity> FindOutput(const std::vector<OutputDataEntity>& walletOutputs, const Commitment& commitment) const;
+	static OutputIndex IndexByCommitment(const std::vector<OutputDataEntity>& walletOutputs);
 
 	const Config& m_config;
 	INodeClientConstPtr m_pNodeClient;
+	KeyChainCache::Ptr m_pKeyCache;
 };
\ No newline at end of file
@@ -49,11 +49,33 @@ public:
 		return outputs;
 	}
 
+	OutputLocations GetOutputLocations(const std::vector<Commitment>& commitments) const final
+	{
+		return m_pBlockChainServer->GetOutputLocations(commitments);
+	}
+
 	std::vector<BlockWithOutputs> GetBlockOutputs(const uint64_t startHeight, const uint64_t maxHeight) const final
 	{
 		return m_pBlockChainServer->GetOutputsByHeight(startHeight, maxHeight);
 	}
 
+	std::vector<BlockDelta> GetBlockDeltas(const uint64_t startHeight, const uint64_t maxHeight) const final
+	{
+		std::vector<BlockDelta> deltas;
+		for (uint64_t height = startHeight; height <= maxHeight; height++)
+		{
+			std::unique_ptr<FullBlock> pBlock = m_pBlockChainServer->GetBlockByHeight(height);
+			if (pBlock == nullptr)
+			{
+				break;
+			}
+
+			deltas.emplace_back(BlockDelta::FromBlock(*pBlock));
+		}
+
+		return deltas;
+	}
+
 	std::unique_ptr<OutputRange> GetOutputsByLeafIndex(const uint64_t startIndex, const uint64_t maxNumOutputs) const final
 	{
 		auto pTxHashSet = m_pTxHashSetManager.Read()->GetTxHashSet();
@@ -0,0 +1,173 @@
+#include <catch.hpp>
+
+#include <TestServer.h>
+#include <TestMiner.h>
+#include <TxBuilder.h>
+
+#include <BlockChain/BlockChainServer.h>
+#include <BlockChain/CompactBlockFactory.h>
+#include <TxPool/TransactionPool.h>
+#include <Core/Util/TransactionUtil.h>
+#include <Consensus/Common.h>
+
+namespace
+{
+	struct HydrationStats
+	{
+		size_t numCompactBlocks = 0;
+		size_t mempoolOnlyHits = 0;
+		size_t hits = 0;
+		size_t mempoolOnlyBytes = 0;
+		size_t bytes = 0;
+	};
+
+	size_t SerializedSize(const CompactBlock& compactBlock)
+	{
+		Serializer serializer;
+		compactBlock.Serialize(serializer);
+		return serializer.GetBytes().size();
+	}
+
+	size_t SerializedSize(const FullBlock& block)
+	{
+		Serializer serializer;
+		block.Serialize(serializer);
+		return serializer.GetBytes().size();
+	}
+
+	// Relays the block to the receiving node as a compact block, like a peer would.
+	// Falls back to the full block when hydration fails, and tallies the bytes transferred each way.
+	// "Mempool only" is what hydration would have looked like without the recent transaction cache.
+	void RelayCompactBlock(const TestServer::Ptr& pReceiver, const FullBlock& block, HydrationStats& stats)
+	{
+		Serializer serializer;
+		CompactBlockFactory::CreateCompactBlock(block).Serialize(serializer);
+		ByteBuffer byteBuffer(serializer.GetBytes());
+		const CompactBlock compactBlock = CompactBlock::Deserialize(byteBuffer);
+
+		const size_t compactSize = SerializedSize(compactBlock);
+		const size_t fullSize = SerializedSize(block);
+		stats.numCompactBlocks++;
+
+		std::set<TransactionKernel> kernels;
+		for (const TransactionKernel& kernel : block.GetKernels())
+		{
+			if (!kernel.IsCoinbase())
+			{
+				kernels.insert(kernel);
+			}
+		}
+
+		std::set<TransactionKernel> kernelsInMempool;
+		for (const TransactionPtr& pTransaction : pReceiver->GetTxPool()->FindTransactionsByKernel(kernels))
+		{
+			kernelsInMempool.insert(pTransaction->GetKernels().cbegin(), pTransaction->GetKernels().cend());
+		}
+
+		const bool mempoolOnlyHit = std::all_of(
+			kernels.cbegin(), kernels.cend(),
+			[&kernelsInMempool](const TransactionKernel& kernel) { return kernelsInMempool.count(kernel) > 0; }
+		);
+		stats.mempoolOnlyHits += mempoolOnlyHit ? 1 : 0;
+		stats.mempoolOnlyBytes += compactSize + (mempoolOnlyHit ? 0 : fullSize);
+
+		const EBlockChainStatus status = pReceiver->GetBlockChainServer()->AddCompactBlock(compactBlock);
+		if (status == EBlockChainStatus::SUCCESS)
+		{
+			stats.hits++;
+			stats.bytes += compactSize;
+		}
+		else
+		{
+			REQUIRE(status == EBlockChainStatus::TRANSACTIONS_MISSING);
+			REQUIRE(pReceiver->GetBlockChainServer()->AddBlock(block) == EBlockChainStatus::SUCCESS);
+			stats.bytes += compactSize + fullSize;
+		}
+	}
+}
+
+//
+// 29 - 30a
+//   \
+//    - 30b - 31b
+//
+// The receiving node has tx0-tx4 in its mempool.
+// 30a (tx0-tx2) arrives first as a full block, evicting tx0-tx2 from the mempool.
+// 30b (tx0-tx3) and 31b (tx4) are then relayed as compact blocks.
+// Without the recent transaction cache, 30b can't be hydrated and the full block has to be downloaded.
+//
+TEST_CASE("Compact block hydration - Recent transaction cache")
+{
+	TestServer::Ptr pReceiver = TestServer::Create();
+	TestMiner miner(pReceiver);
+	KeyChain keyChain = KeyChain::FromRandom(*pReceiver->GetConfig());
+	TxBuilder txBuilder(keyChain);
+	auto pBlockChainServer = pReceiver->GetBlockChainServer();
+
+	std::vector<MinedBlock> minedChain = miner.MineChain(keyChain, 30);
+	REQUIRE(minedChain.size() == 30);
+
+	const uint64_t fee = 10'000'000;
+	std::vector<TransactionPtr> txs;
+	for (size_t i = 1; i <= 5; i++)
+	{
+		TransactionOutput outputToSpend = minedChain[i].block.GetOutputs().front();
+		Test::Input input({
+			{ outputToSpend.GetFeatures(), outputToSpend.GetCommitment() },
+			minedChain[i].coinbasePath.value(),
+			minedChain[i].coinbaseAmount
+		});
+		Test::Output output({
+			KeyChainPath({ 2, (uint32_t)i }),
+			minedChain[i].coinbaseAmount - fee
+		});
+
+		txs.push_back(std::make_shared<Transaction>(txBuilder.BuildTx(fee, { input }, { output })));
+		REQUIRE(pBlockChainServer->AddTransaction(txs.back(), EPoolType::MEMPOOL) == EBlockChainStatus::SUCCESS);
+	}
+
+	auto mineBlock = [&miner, &txBuilder, &minedChain, fee](
+		const uint32_t coinbaseIndex,
+		std::vector<TransactionPtr> blockTxs,
+		const std::vector<FullBlock>& blocksToApply)
+	{
+		const uint64_t coinbaseAmount = Consensus::REWARD + (fee * blockTxs.size());
+		blockTxs.push_back(txBuilder.BuildCoinbaseTx(KeyChainPath({ 1, coinbaseIndex }), coinbaseAmount).pTransaction);
+
+		return miner.MineNextBlock(
+			minedChain.back().block.GetBlockHeader(),
+			*TransactionUtil::Aggregate(blockTxs),
+			blocksToApply
+		);
+	};
+
+	FullBlock block30a = mineBlock(0, { txs[0], txs[1], txs[2] }, {});
+	FullBlock block30b = mineBlock(1, { txs[0], txs[1], txs[2], txs[3] }, {});
+	FullBlock block31b = mineBlock(2, { txs[4] }, { block30b });
+
+	REQUIRE(pBlockChainServer->AddBlock(block30a) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pReceiver->GetTxPool()->FindTransactionsByKernel({ txs[0]->GetKernels().front() }).empty());
+
+	HydrationStats stats;
+	RelayCompactBlock(pReceiver, block30b, stats);
+	RelayCompactBlock(pReceiver, block31b, stats);
+
+	REQUIRE(pBlockChainServer->GetTipBlockHeader(EChainType::CONFIRMED)->GetHash() == block31b.GetHash());
+
+	INFO("Hydration success rate: " << stats.mempoolOnlyHits << "/" << stats.numCompactBlocks << " (mempool only), "
+		<< stats.hits << "/" << stats.numCompactBlocks << " (with recent transactions)");
+	INFO("Bytes per block: " << stats.mempoolOnlyBytes / stats.numCompactBlocks << " (mempool only), "
+		<< stats.bytes / stats.numCompactBlocks << " (with recent transactions)");
+
+	REQUIRE(stats.mempoolOnlyHits == 1);
+	REQUIRE(stats.hits == 2);
+	REQUIRE(stats.bytes < stats.mempoolOnlyBytes);
+
+	// Everything was confirmed by the new fork, so nothing is re-added from 30a.
+	std::set<TransactionKernel> allKernels;
+	for (const TransactionPtr& pTransaction : txs)
+	{
+		allKernels.insert(pTransaction->GetKernels().front());
+	}
+	REQUIRE(pReceiver->GetTxPool()->FindTransactionsByKernel(allKernels).empty());
+}
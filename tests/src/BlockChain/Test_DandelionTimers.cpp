@@ -0,0 +1,154 @@
+#include <catch.hpp>
+
+#include <TestServer.h>
+#include <TestMiner.h>
+#include <TxBuilder.h>
+
+#include <BlockChain/BlockChainServer.h>
+#include <Database/Database.h>
+#include <PMMR/TxHashSetManager.h>
+#include <TxPool/TransactionPool.h>
+#include <Config/ConfigProps.h>
+
+using namespace std::chrono;
+
+//
+// Drives a TxPool's Dandelion timers with a simulated clock, validating against the TestServer's chain.
+// Patience is 10 seconds, and the embargo is 180 seconds plus up to 30 seconds of jitter.
+//
+TEST_CASE("TxPool - Dandelion timers with simulated clock")
+{
+	TestServer::Ptr pTestServer = TestServer::Create();
+	TestMiner miner(pTestServer);
+	KeyChain keyChain = KeyChain::FromRandom(*pTestServer->GetConfig());
+	TxBuilder txBuilder(keyChain);
+	auto pBlockChainServer = pTestServer->GetBlockChainServer();
+
+	std::vector<MinedBlock> minedChain = miner.MineChain(keyChain, 30);
+	REQUIRE(minedChain.size() == 30);
+
+	// Always stem, so the stem and fluff paths are deterministic.
+	Json::Value json;
+	json[ConfigProps::DATA_PATH] = pTestServer->GetConfig()->GetDataDirectory().u8string();
+	json[ConfigProps::Dandelion::DANDELION][ConfigProps::Dandelion::STEM_PROBABILITY] = 100;
+	ConfigPtr pConfig = Config::Load(json, EEnvironmentType::AUTOMATED_TESTING);
+	REQUIRE(pConfig->GetNodeConfig().GetDandelion().GetPatienceSeconds() == 10);
+	REQUIRE(pConfig->GetNodeConfig().GetDandelion().GetEmbargoSeconds() == 180);
+
+	const system_clock::time_point start(seconds(1'600'000'000));
+	system_clock::time_point now = start;
+	ITransactionPoolPtr pTxPool = TxPoolAPI::CreateTransactionPool(*pConfig, [&now]() { return now; });
+
+	auto addTransaction = [&pTestServer, &pBlockChainServer, &pTxPool](TransactionPtr pTransaction, const EPoolType poolType) {
+		auto pBlockDB = pTestServer->GetDatabase()->GetBlockDB()->Read();
+		auto pTxHashSetManager = pTestServer->GetTxHashSetManager()->Read();
+		return pTxPool->AddTransaction(
+			pBlockDB.GetShared(),
+			pTxHashSetManager->GetTxHashSet(),
+			pTransaction,
+			poolType,
+			*pBlockChainServer->GetTipBlockHeader(EChainType::CONFIRMED)
+		);
+	};
+
+	auto getTransactionToStem = [&pTestServer, &pTxPool]() {
+		auto pBlockDB = pTestServer->GetDatabase()->GetBlockDB()->Read();
+		auto pTxHashSetManager = pTestServer->GetTxHashSetManager()->Read();
+		return pTxPool->GetTransactionToStem(pBlockDB.GetShared(), pTxHashSetManager->GetTxHashSet());
+	};
+
+	auto getTransactionToFluff = [&pTestServer, &pTxPool]() {
+		auto pBlockDB = pTestServer->GetDatabase()->GetBlockDB()->Read();
+		auto pTxHashSetManager = pTestServer->GetTxHashSetManager()->Read();
+		return pTxPool->GetTransactionToFluff(pBlockDB.GetShared(), pTxHashSetManager->GetTxHashSet());
+	};
+
+	// Spends the coinbase from the given block
+	auto spendCoinbase = [&txBuilder, &minedChain](const size_t blockIndex, const uint32_t account) {
+		const uint64_t fee = 10'000'000;
+		TransactionOutput outputToSpend = minedChain[blockIndex].block.GetOutputs().front();
+		Test::Input input({
+			{ outputToSpend.GetFeatures(), outputToSpend.GetCommitment() },
+			minedChain[blockIndex].coinbasePath.value(),
+			minedChain[blockIndex].coinbaseAmount
+		});
+		Test::Output output({
+			KeyChainPath({ account, (uint32_t)blockIndex }),
+			minedChain[blockIndex].coinbaseAmount - fee
+		});
+
+		return std::make_shared<Transaction>(txBuilder.BuildTx(fee, { input }, { output }));
+	};
+
+	SECTION("Stem, then expire")
+	{
+		TransactionPtr pTransaction = spendCoinbase(1, 2);
+		REQUIRE(addTransaction(pTransaction, EPoolType::STEMPOOL) == EAddTransactionStatus::ADDED);
+		REQUIRE(pTxPool->GetNextDandelionDeadline() == start + seconds(10));
+
+		now = start + seconds(9);
+		REQUIRE(getTransactionToStem() == nullptr);
+
+		now = start + seconds(10);
+		TransactionPtr pStemmed = getTransactionToStem();
+		REQUIRE(pStemmed != nullptr);
+		REQUIRE(pStemmed->GetKernels() == pTransaction->GetKernels());
+		REQUIRE(getTransactionToFluff() == nullptr);
+		REQUIRE(pTxPool->GetExpiredTransactions().empty());
+
+		// Once stemmed, only the embargo is left to wait for.
+		const auto embargoDeadline = pTxPool->GetNextDandelionDeadline();
+		REQUIRE(embargoDeadline.has_value());
+		REQUIRE(embargoDeadline.value() >= start + seconds(180));
+		REQUIRE(embargoDeadline.value() <= start + seconds(210));
+
+		now = embargoDeadline.value();
+		const std::vector<TransactionPtr> expired = pTxPool->GetExpiredTransactions();
+		REQUIRE(expired.size() == 1);
+		REQUIRE(*expired.front() == *pTransaction);
+		REQUIRE_FALSE(pTxPool->GetNextDandelionDeadline().has_value());
+	}
+
+	SECTION("Fluff")
+	{
+		TransactionPtr pTransaction = spendCoinbase(2, 2);
+		REQUIRE(addTransaction(pTransaction, EPoolType::JOINPOOL) == EAddTransactionStatus::ADDED);
+		pTxPool->FluffJoinPool();
+
+		now = start + seconds(10);
+		REQUIRE(getTransactionToStem() == nullptr);
+
+		TransactionPtr pFluffed = getTransactionToFluff();
+		REQUIRE(pFluffed != nullptr);
+		REQUIRE(pFluffed->GetKernels() == pTransaction->GetKernels());
+		REQUIRE(pTxPool->FindTransactionByKernelHash(pTransaction->GetKernels().front().GetHash()) == pFluffed);
+
+		// The fluffed tx left the stempool, so its embargo timer fires without anything to expire.
+		now = start + seconds(210);
+		REQUIRE(pTxPool->GetExpiredTransactions().empty());
+	}
+
+	SECTION("Failed validation is retried after another patience period")
+	{
+		TransactionPtr pTransaction = spendCoinbase(3, 2);
+		REQUIRE(addTransaction(pTransaction, EPoolType::STEMPOOL) == EAddTransactionStatus::ADDED);
+
+		// A conflicting tx reaches the mempool first, so the stem tx no longer validates against it.
+		TransactionPtr pConflicting = spendCoinbase(3, 3);
+		REQUIRE(addTransaction(pConflicting, EPoolType::MEMPOOL) == EAddTransactionStatus::ADDED);
+
+		now = start + seconds(10);
+		REQUIRE(getTransactionToStem() == nullptr);
+		REQUIRE(pTxPool->GetNextDandelionDeadline() == start + seconds(20));
+
+		now = start + seconds(20);
+		REQUIRE(getTransactionToStem() == nullptr);
+		REQUIRE(pTxPool->GetNextDandelionDeadline() == start + seconds(30));
+
+		// It's still fluffed by the embargo as a last resort.
+		now = start + seconds(210);
+		const std::vector<TransactionPtr> expired = pTxPool->GetExpiredTransactions();
+		REQUIRE(expired.size() == 1);
+		REQUIRE(*expired.front() == *pTransaction);
+	}
+}
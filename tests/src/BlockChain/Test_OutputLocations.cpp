@@ -0,0 +1,77 @@
+#include <catch.hpp>
+
+#include <TestServer.h>
+#include <TestChain.h>
+#include <TxBuilder.h>
+
+#include <BlockChain/BlockChainServer.h>
+#include <Core/Models/DTOs/OutputLocations.h>
+#include <Crypto/RandomNumberGenerator.h>
+#include <map>
+#include <tuple>
+
+TEST_CASE("OutputLocations - Batch matches looking up each commitment")
+{
+	TestServer::Ptr pTestServer = TestServer::Create();
+	KeyChain keyChain = KeyChain::FromRandom(*pTestServer->GetConfig());
+	TxBuilder txBuilder(keyChain);
+	auto pBlockChainServer = pTestServer->GetBlockChainServer();
+	auto pNodeClient = pTestServer->GetNodeClient();
+
+	TestChain chain(pTestServer);
+
+	std::vector<Commitment> commitments;
+	for (uint32_t i = 1; i <= 4; i++)
+	{
+		Test::Tx coinbase = txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, i }));
+		MinedBlock minedBlock = chain.AddNextBlock({ coinbase });
+		REQUIRE(pBlockChainServer->AddBlock(minedBlock.block) == EBlockChainStatus::SUCCESS);
+
+		commitments.push_back(minedBlock.block.GetOutputs().front().GetCommitment());
+	}
+
+	// Commitments the chain doesn't know about, and a repeated one, are mixed in.
+	commitments.push_back(Commitment(CBigInteger<33>(RandomNumberGenerator::GenerateRandomBytes(33).data())));
+	commitments.push_back(commitments[1]);
+	commitments.push_back(Commitment(CBigInteger<33>(RandomNumberGenerator::GenerateRandomBytes(33).data())));
+
+	// Resolved one at a time, each under its own lock.
+	std::map<Commitment, OutputLocation> expected;
+	for (const Commitment& commitment : commitments)
+	{
+		std::unique_ptr<OutputLocation> pLocation = pTestServer->GetDatabase()->GetBlockDB()->Read()->GetOutputPosition(commitment);
+		if (pLocation != nullptr)
+		{
+			expected.insert({ commitment, *pLocation });
+		}
+	}
+	REQUIRE(expected.size() == 4);
+
+	const auto toPairs = [](const std::map<Commitment, OutputLocation>& locations) {
+		std::vector<std::tuple<Commitment, uint64_t, uint64_t>> pairs;
+		for (const auto& entry : locations)
+		{
+			pairs.emplace_back(entry.first, entry.second.GetMMRIndex(), entry.second.GetBlockHeight());
+		}
+
+		return pairs;
+	};
+
+	const OutputLocations batch = pBlockChainServer->GetOutputLocations(commitments);
+	REQUIRE(batch.GetHeight() == 4);
+	REQUIRE(toPairs(batch.GetLocations()) == toPairs(expected));
+	for (uint64_t height = 1; height <= 4; height++)
+	{
+		REQUIRE(batch.GetLocations().at(commitments[height - 1]).GetBlockHeight() == height);
+	}
+
+	// Node clients return the same, and the height survives the round trip through the REST API's JSON.
+	REQUIRE(toPairs(pNodeClient->GetOutputsByCommitment(commitments)) == toPairs(expected));
+	REQUIRE(pNodeClient->GetOutputLocations(commitments).GetHeight() == 4);
+
+	const OutputLocations fromJSON = OutputLocations::FromJSON(batch.ToJSON());
+	REQUIRE(fromJSON.GetHeight() == batch.GetHeight());
+	REQUIRE(toPairs(fromJSON.GetLocations()) == toPairs(expected));
+
+	REQUIRE(pBlockChainServer->GetOutputLocations({}).GetLocations().empty());
+}
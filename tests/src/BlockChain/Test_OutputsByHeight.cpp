@@ -0,0 +1,80 @@
+#include <catch.hpp>
+
+#include <TestServer.h>
+#include <TestChain.h>
+#include <TxBuilder.h>
+
+#include <BlockChain/BlockChainServer.h>
+#include <BlockChain/OutputsByHeightCursor.h>
+#include <chrono>
+#include <future>
+
+TEST_CASE("OutputsByHeightCursor - Block accepted mid-scan")
+{
+	TestServer::Ptr pTestServer = TestServer::Create();
+	KeyChain keyChain = KeyChain::FromRandom(*pTestServer->GetConfig());
+	TxBuilder txBuilder(keyChain);
+	auto pBlockChainServer = pTestServer->GetBlockChainServer();
+
+	TestChain chain(pTestServer);
+
+	std::vector<MinedBlock> blocks;
+	for (uint32_t i = 1; i <= 4; i++)
+	{
+		Test::Tx coinbase = txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, i }));
+		blocks.push_back(chain.AddNextBlock({ coinbase }));
+	}
+
+	// Only the first 3 blocks are added before the scan starts.
+	for (size_t i = 0; i < 3; i++)
+	{
+		REQUIRE(pBlockChainServer->AddBlock(blocks[i].block) == EBlockChainStatus::SUCCESS);
+	}
+
+	OutputsByHeightCursor::UPtr pCursor = pBlockChainServer->GetOutputsByHeightCursor(1, 100);
+	REQUIRE(pCursor->GetNumBlocks() == 3);
+
+	std::vector<BlockWithOutputs> page1 = pCursor->NextPage(2);
+	REQUIRE(page1.size() == 2);
+	REQUIRE(pCursor->HasNext());
+
+	// The cursor doesn't hold the chain lock between pages, so the next block is accepted without waiting for the scan to finish.
+	std::future<EBlockChainStatus> added = std::async(std::launch::async, [pBlockChainServer, &blocks]() {
+		return pBlockChainServer->AddBlock(blocks[3].block);
+	});
+	REQUIRE(added.wait_for(std::chrono::seconds(30)) == std::future_status::ready);
+	REQUIRE(added.get() == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChainServer->GetHeight(EChainType::CONFIRMED) == 4);
+
+	// The rest of the scan still only covers the snapshotted blocks.
+	std::vector<BlockWithOutputs> page2 = pCursor->NextPage(2);
+	REQUIRE(page2.size() == 1);
+	REQUIRE_FALSE(pCursor->HasNext());
+	REQUIRE(pCursor->NextPage(2).empty());
+
+	std::vector<BlockWithOutputs> scanned = page1;
+	scanned.insert(scanned.end(), page2.begin(), page2.end());
+	for (size_t i = 0; i < scanned.size(); i++)
+	{
+		const FullBlock& block = blocks[i].block;
+		const BlockIdentifier& identifier = scanned[i].GetBlockIdentifier();
+		REQUIRE(identifier.GetHash() == block.GetHash());
+		REQUIRE(identifier.GetPreviousHash() == block.GetHeader()->GetPreviousHash());
+		REQUIRE(identifier.GetHeight() == block.GetHeight());
+
+		REQUIRE(scanned[i].GetOutputs().size() == 1);
+		REQUIRE(scanned[i].GetOutputs()[0].GetIdentifier().GetCommitment() == block.GetOutputs()[0].GetCommitment());
+		REQUIRE(scanned[i].GetOutputs()[0].GetLocation().GetBlockHeight() == block.GetHeight());
+	}
+
+	// A new scan sees the block that was accepted mid-scan.
+	std::vector<BlockWithOutputs> all = pBlockChainServer->GetOutputsByHeight(0, 100);
+	REQUIRE(all.size() == 5);
+	REQUIRE(all[0].GetBlockIdentifier().GetHash() == pTestServer->GetGenesisBlock().GetHash());
+	REQUIRE(all[0].GetBlockIdentifier().GetPreviousHash() == pTestServer->GetGenesisHeader()->GetPreviousHash());
+	REQUIRE(all[4].GetBlockIdentifier().GetHash() == blocks[3].block.GetHash());
+	REQUIRE(all[4].GetOutputs().size() == 1);
+
+	// Ranges beyond the tip are empty, rather than failing.
+	REQUIRE(pBlockChainServer->GetOutputsByHeight(10, 20).empty());
+}
@@ -0,0 +1,106 @@
+#include <catch.hpp>
+
+#include <TxPool/RecentTransactionCache.h>
+#include <algorithm>
+#include <random>
+
+namespace
+{
+	class KernelGenerator
+	{
+	public:
+		KernelGenerator() : m_rng(4321) { }
+
+		TransactionKernel RandomKernel()
+		{
+			std::vector<unsigned char> bytes(33);
+			bytes[0] = 0x08;
+			for (size_t i = 1; i < bytes.size(); i++)
+			{
+				bytes[i] = (unsigned char)m_rng();
+			}
+
+			return TransactionKernel(EKernelFeatures::DEFAULT_KERNEL, 1'000'000, 0, Commitment(CBigInteger<33>(std::move(bytes))), Signature());
+		}
+
+	private:
+		std::mt19937 m_rng;
+	};
+
+	// The cache only looks at kernels, so the transactions don't need inputs or outputs.
+	TransactionPtr CreateTransaction(std::vector<TransactionKernel> kernels)
+	{
+		std::sort(kernels.begin(), kernels.end(), SortKernelsByHash);
+		return std::make_shared<Transaction>(
+			BlindingFactor(),
+			TransactionBody(std::vector<TransactionInput>(), std::vector<TransactionOutput>(), std::move(kernels))
+		);
+	}
+}
+
+TEST_CASE("RecentTransactionCache - Kernels map to the smallest transaction")
+{
+	KernelGenerator generator;
+	const TransactionKernel kernel1 = generator.RandomKernel();
+	const TransactionKernel kernel2 = generator.RandomKernel();
+	const TransactionKernel kernel3 = generator.RandomKernel();
+
+	RecentTransactionCache cache(10);
+
+	// A block containing tx1 is seen first, then tx1 itself.
+	TransactionPtr pBlockTx = CreateTransaction({ kernel1, kernel2, kernel3 });
+	cache.AddTransaction(pBlockTx);
+	REQUIRE(cache.FindTransactionByKernelHash(kernel1.GetHash()) == pBlockTx);
+
+	TransactionPtr pTx1 = CreateTransaction({ kernel1 });
+	cache.AddTransaction(pTx1);
+	REQUIRE(cache.FindTransactionByKernelHash(kernel1.GetHash()) == pTx1);
+	REQUIRE(cache.FindTransactionByKernelHash(kernel2.GetHash()) == pBlockTx);
+
+	// A larger aggregate seen later doesn't shadow tx1.
+	TransactionPtr pAggregate = CreateTransaction({ kernel1, kernel2 });
+	cache.AddTransaction(pAggregate);
+	REQUIRE(cache.FindTransactionByKernelHash(kernel1.GetHash()) == pTx1);
+	REQUIRE(cache.FindTransactionByKernelHash(kernel2.GetHash()) == pAggregate);
+	REQUIRE(cache.FindTransactionByKernelHash(kernel3.GetHash()) == pBlockTx);
+
+	// Adding the same transaction again changes nothing.
+	cache.AddTransaction(pTx1);
+	REQUIRE(cache.GetSize() == 3);
+
+	REQUIRE(cache.FindTransactionByKernelHash(generator.RandomKernel().GetHash()) == nullptr);
+}
+
+TEST_CASE("RecentTransactionCache - Eviction only forgets kernels the evicted transaction claimed")
+{
+	KernelGenerator generator;
+	const TransactionKernel kernel1 = generator.RandomKernel();
+	const TransactionKernel kernel2 = generator.RandomKernel();
+	const TransactionKernel kernel3 = generator.RandomKernel();
+
+	RecentTransactionCache cache(2);
+
+	TransactionPtr pBlockTx = CreateTransaction({ kernel1, kernel2 });
+	TransactionPtr pTx1 = CreateTransaction({ kernel1 });
+	cache.AddTransaction(pBlockTx);
+	cache.AddTransaction(pTx1);
+
+	// pBlockTx is the oldest, so it's evicted. kernel1 was claimed by pTx1, so it stays.
+	TransactionPtr pTx3 = CreateTransaction({ kernel3 });
+	cache.AddTransaction(pTx3);
+	REQUIRE(cache.GetSize() == 2);
+	REQUIRE(cache.FindTransactionByKernelHash(kernel1.GetHash()) == pTx1);
+	REQUIRE(cache.FindTransactionByKernelHash(kernel2.GetHash()) == nullptr);
+	REQUIRE(cache.FindTransactionByKernelHash(kernel3.GetHash()) == pTx3);
+
+	// Once pTx1 is evicted too, nothing is left with kernel1.
+	cache.AddTransaction(CreateTransaction({ generator.RandomKernel() }));
+	REQUIRE(cache.FindTransactionByKernelHash(kernel1.GetHash()) == nullptr);
+	REQUIRE(cache.FindTransactionByKernelHash(kernel3.GetHash()) == pTx3);
+
+	// An evicted transaction can be cached again.
+	cache.AddTransaction(pBlockTx);
+	REQUIRE(cache.FindTransactionByKernelHash(kernel1.GetHash()) == pBlockTx);
+	REQUIRE(cache.FindTransactionByKernelHash(kernel2.GetHash()) == pBlockTx);
+	REQUIRE(cache.FindTransactionByKernelHash(kernel3.GetHash()) == nullptr);
+}
@@ -443,4 +443,264 @@ TEST_CASE("Reorg Chain")
 	REQUIRE(pBlockChainServer->GetBlockByHeight(31)->GetHash() == block31b.GetHash());
 
 	// TODO: Assert unspent positions in leafset and in database.
-}
\ No newline at end of file
+}
+
+//
+// 30 - 31a - 32a
+//   \
+//    - 31b - 32b - 33b - 34b
+//
+// 31a contains tx1 & tx2, and 32a contains tx3. Only tx1 is confirmed on the new fork,
+// so tx2 & tx3 should each end up back in the mempool as their own entry after the reorg.
+// 34b then confirms tx2, which must leave tx3 in the mempool.
+//
+TEST_CASE("Reorg - Rewound transactions are re-added to the TxPool")
+{
+	TestServer::Ptr pTestServer = TestServer::Create();
+	TestMiner miner(pTestServer);
+	KeyChain keyChain = KeyChain::FromRandom(*pTestServer->GetConfig());
+	TxBuilder txBuilder(keyChain);
+	auto pBlockChainServer = pTestServer->GetBlockChainServer();
+	auto pTxPool = pTestServer->GetTxPool();
+
+	std::vector<MinedBlock> minedChain = miner.MineChain(keyChain, 30);
+	REQUIRE(minedChain.size() == 30);
+
+	// Spends the coinbase from the given block
+	auto spendCoinbase = [&txBuilder, &minedChain](const size_t blockIndex) {
+		const uint64_t fee = 10'000'000;
+		TransactionOutput outputToSpend = minedChain[blockIndex].block.GetOutputs().front();
+		Test::Input input({
+			{ outputToSpend.GetFeatures(), outputToSpend.GetCommitment() },
+			minedChain[blockIndex].coinbasePath.value(),
+			minedChain[blockIndex].coinbaseAmount
+		});
+		Test::Output output({
+			KeyChainPath({ 2, (uint32_t)blockIndex }),
+			minedChain[blockIndex].coinbaseAmount - fee
+		});
+
+		return std::make_shared<Transaction>(txBuilder.BuildTx(fee, { input }, { output }));
+	};
+
+	TransactionPtr pTx1 = spendCoinbase(1);
+	TransactionPtr pTx2 = spendCoinbase(2);
+	TransactionPtr pTx3 = spendCoinbase(3);
+
+	// Each tx is first seen on its own, as it would be when relayed by a peer.
+	REQUIRE(pBlockChainServer->AddTransaction(pTx1, EPoolType::MEMPOOL) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChainServer->AddTransaction(pTx2, EPoolType::MEMPOOL) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChainServer->AddTransaction(pTx3, EPoolType::MEMPOOL) == EBlockChainStatus::SUCCESS);
+
+	////////////////////////////////////////
+	// Original chain
+	////////////////////////////////////////
+	Test::Tx coinbaseTx31a = txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, 31 }));
+	FullBlock block31a = miner.MineNextBlock(
+		minedChain.back().block.GetBlockHeader(),
+		*TransactionUtil::Aggregate({ coinbaseTx31a.pTransaction, pTx1, pTx2 })
+	);
+	REQUIRE(pBlockChainServer->AddBlock(block31a) == EBlockChainStatus::SUCCESS);
+
+	Test::Tx coinbaseTx32a = txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, 32 }));
+	FullBlock block32a = miner.MineNextBlock(
+		minedChain.back().block.GetBlockHeader(),
+		*TransactionUtil::Aggregate({ coinbaseTx32a.pTransaction, pTx3 }),
+		{ block31a }
+	);
+	REQUIRE(pBlockChainServer->AddBlock(block32a) == EBlockChainStatus::SUCCESS);
+
+	const TransactionKernel& kernel1 = pTx1->GetKernels().front();
+	const TransactionKernel& kernel2 = pTx2->GetKernels().front();
+	const TransactionKernel& kernel3 = pTx3->GetKernels().front();
+	REQUIRE(pTxPool->FindTransactionsByKernel({ kernel1, kernel2, kernel3 }).empty());
+
+	////////////////////////////////////////
+	// Fork that only confirms tx1
+	////////////////////////////////////////
+	Test::Tx coinbaseTx31b = txBuilder.BuildCoinbaseTx(KeyChainPath({ 1, 31 }));
+	FullBlock block31b = miner.MineNextBlock(
+		minedChain.back().block.GetBlockHeader(),
+		*TransactionUtil::Aggregate({ coinbaseTx31b.pTransaction, pTx1 })
+	);
+
+	Test::Tx coinbaseTx32b = txBuilder.BuildCoinbaseTx(KeyChainPath({ 1, 32 }));
+	FullBlock block32b = miner.MineNextBlock(
+		minedChain.back().block.GetBlockHeader(),
+		*coinbaseTx32b.pTransaction,
+		{ block31b }
+	);
+
+	Test::Tx coinbaseTx33b = txBuilder.BuildCoinbaseTx(KeyChainPath({ 1, 33 }));
+	FullBlock block33b = miner.MineNextBlock(
+		minedChain.back().block.GetBlockHeader(),
+		*coinbaseTx33b.pTransaction,
+		{ block31b, block32b }
+	);
+
+	REQUIRE(pBlockChainServer->AddBlock(block31b) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChainServer->AddBlock(block32b) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChainServer->GetTipBlockHeader(EChainType::CONFIRMED)->GetHash() == block32a.GetHash());
+
+	REQUIRE(pBlockChainServer->AddBlock(block33b) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChainServer->GetTipBlockHeader(EChainType::CONFIRMED)->GetHash() == block33b.GetHash());
+
+	////////////////////////////////////////
+	// Verify the mempool holds tx2 & tx3, each as its own entry
+	////////////////////////////////////////
+	REQUIRE(pTxPool->FindTransactionByKernelHash(kernel1.GetHash()) == nullptr);
+
+	TransactionPtr pReadded2 = pTxPool->FindTransactionByKernelHash(kernel2.GetHash());
+	REQUIRE(pReadded2 != nullptr);
+	REQUIRE(*pReadded2 == *pTx2);
+
+	TransactionPtr pReadded3 = pTxPool->FindTransactionByKernelHash(kernel3.GetHash());
+	REQUIRE(pReadded3 != nullptr);
+	REQUIRE(*pReadded3 == *pTx3);
+
+	REQUIRE(pTxPool->FindTransactionsByKernel({ kernel1, kernel2, kernel3 }).size() == 2);
+
+	////////////////////////////////////////
+	// Confirm tx2 on the new fork, and verify tx3 survives
+	////////////////////////////////////////
+	Test::Tx coinbaseTx34b = txBuilder.BuildCoinbaseTx(KeyChainPath({ 1, 34 }));
+	FullBlock block34b = miner.MineNextBlock(
+		minedChain.back().block.GetBlockHeader(),
+		*TransactionUtil::Aggregate({ coinbaseTx34b.pTransaction, pTx2 }),
+		{ block31b, block32b, block33b }
+	);
+	REQUIRE(pBlockChainServer->AddBlock(block34b) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChainServer->GetTipBlockHeader(EChainType::CONFIRMED)->GetHash() == block34b.GetHash());
+
+	REQUIRE(pTxPool->FindTransactionByKernelHash(kernel2.GetHash()) == nullptr);
+	REQUIRE(pTxPool->FindTransactionByKernelHash(kernel3.GetHash()) == pReadded3);
+
+	const std::vector<TransactionPtr> poolTxs = pTxPool->FindTransactionsByKernel({ kernel1, kernel2, kernel3 });
+	REQUIRE(poolTxs.size() == 1);
+	REQUIRE(*poolTxs.front() == *pTx3);
+}
+
+//
+// 30 - 31a - 32a
+//   \
+//    - 31b - 32b - 33b
+//
+// 31a contains txA & txB, and 32a contains txC. None of them were seen by the pool before being mined,
+// so there are no original transactions to re-add, only what's left of the rewound blocks.
+//
+TEST_CASE("Reorg - Rewound blocks are re-added as a remainder, or block by block if it's invalid")
+{
+	TestServer::Ptr pTestServer = TestServer::Create();
+	TestMiner miner(pTestServer);
+	KeyChain keyChain = KeyChain::FromRandom(*pTestServer->GetConfig());
+	TxBuilder txBuilder(keyChain);
+	auto pBlockChainServer = pTestServer->GetBlockChainServer();
+	auto pTxPool = pTestServer->GetTxPool();
+
+	std::vector<MinedBlock> minedChain = miner.MineChain(keyChain, 30);
+	REQUIRE(minedChain.size() == 30);
+
+	// Spends the coinbase from the given block
+	auto spendCoinbase = [&txBuilder, &minedChain](const size_t blockIndex, const uint32_t account) {
+		const uint64_t fee = 10'000'000;
+		TransactionOutput outputToSpend = minedChain[blockIndex].block.GetOutputs().front();
+		Test::Input input({
+			{ outputToSpend.GetFeatures(), outputToSpend.GetCommitment() },
+			minedChain[blockIndex].coinbasePath.value(),
+			minedChain[blockIndex].coinbaseAmount
+		});
+		Test::Output output({
+			KeyChainPath({ account, (uint32_t)blockIndex }),
+			minedChain[blockIndex].coinbaseAmount - fee
+		});
+
+		return std::make_shared<Transaction>(txBuilder.BuildTx(fee, { input }, { output }));
+	};
+
+	TransactionPtr pTxA = spendCoinbase(4, 2);
+	TransactionPtr pTxB = spendCoinbase(5, 2);
+	TransactionPtr pTxC = spendCoinbase(6, 2);
+
+	const TransactionKernel& kernelA = pTxA->GetKernels().front();
+	const TransactionKernel& kernelB = pTxB->GetKernels().front();
+	const TransactionKernel& kernelC = pTxC->GetKernels().front();
+
+	////////////////////////////////////////
+	// Original chain
+	////////////////////////////////////////
+	Test::Tx coinbaseTx31a = txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, 31 }));
+	FullBlock block31a = miner.MineNextBlock(
+		minedChain.back().block.GetBlockHeader(),
+		*TransactionUtil::Aggregate({ coinbaseTx31a.pTransaction, pTxA, pTxB })
+	);
+	REQUIRE(pBlockChainServer->AddBlock(block31a) == EBlockChainStatus::SUCCESS);
+
+	Test::Tx coinbaseTx32a = txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, 32 }));
+	FullBlock block32a = miner.MineNextBlock(
+		minedChain.back().block.GetBlockHeader(),
+		*TransactionUtil::Aggregate({ coinbaseTx32a.pTransaction, pTxC }),
+		{ block31a }
+	);
+	REQUIRE(pBlockChainServer->AddBlock(block32a) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pTxPool->FindTransactionsByKernel({ kernelA, kernelB, kernelC }).empty());
+
+	// Mines the fork, with 31b containing the given txs.
+	auto reorg = [&](const std::vector<TransactionPtr>& transactions31b) {
+		std::vector<TransactionPtr> transactions = transactions31b;
+		transactions.push_back(txBuilder.BuildCoinbaseTx(KeyChainPath({ 1, 31 })).pTransaction);
+		FullBlock block31b = miner.MineNextBlock(
+			minedChain.back().block.GetBlockHeader(),
+			*TransactionUtil::Aggregate(transactions)
+		);
+
+		Test::Tx coinbaseTx32b = txBuilder.BuildCoinbaseTx(KeyChainPath({ 1, 32 }));
+		FullBlock block32b = miner.MineNextBlock(
+			minedChain.back().block.GetBlockHeader(),
+			*coinbaseTx32b.pTransaction,
+			{ block31b }
+		);
+
+		Test::Tx coinbaseTx33b = txBuilder.BuildCoinbaseTx(KeyChainPath({ 1, 33 }));
+		FullBlock block33b = miner.MineNextBlock(
+			minedChain.back().block.GetBlockHeader(),
+			*coinbaseTx33b.pTransaction,
+			{ block31b, block32b }
+		);
+
+		REQUIRE(pBlockChainServer->AddBlock(block31b) == EBlockChainStatus::SUCCESS);
+		REQUIRE(pBlockChainServer->AddBlock(block32b) == EBlockChainStatus::SUCCESS);
+		REQUIRE(pBlockChainServer->AddBlock(block33b) == EBlockChainStatus::SUCCESS);
+		REQUIRE(pBlockChainServer->GetTipBlockHeader(EChainType::CONFIRMED)->GetHash() == block33b.GetHash());
+	};
+
+	SECTION("Remainder")
+	{
+		// The fork confirms none of the rewound txs, so all of them are re-added as a single aggregate.
+		reorg({});
+
+		TransactionPtr pRemainder = pTxPool->FindTransactionByKernelHash(kernelA.GetHash());
+		REQUIRE(pRemainder != nullptr);
+		REQUIRE(pRemainder->GetKernels().size() == 3);
+		REQUIRE(pTxPool->FindTransactionByKernelHash(kernelB.GetHash()) == pRemainder);
+		REQUIRE(pTxPool->FindTransactionByKernelHash(kernelC.GetHash()) == pRemainder);
+		REQUIRE(pTxPool->FindTransactionsByKernel({ kernelA, kernelB, kernelC }).size() == 1);
+	}
+
+	SECTION("Fallback to rewound blocks")
+	{
+		// The fork double-spends txA's input, so the remainder is invalid.
+		// Only 32a can still be re-added. txB is lost along with txA, since they came from the same block.
+		TransactionPtr pDoubleSpend = spendCoinbase(4, 3);
+		REQUIRE(pDoubleSpend->GetKernels().front() != kernelA);
+		reorg({ pDoubleSpend });
+
+		REQUIRE(pTxPool->FindTransactionByKernelHash(kernelA.GetHash()) == nullptr);
+		REQUIRE(pTxPool->FindTransactionByKernelHash(kernelB.GetHash()) == nullptr);
+
+		TransactionPtr pReadded = pTxPool->FindTransactionByKernelHash(kernelC.GetHash());
+		REQUIRE(pReadded != nullptr);
+		REQUIRE(pReadded->GetKernels() == pTxC->GetKernels());
+		REQUIRE(pReadded->GetInputs() == pTxC->GetInputs());
+		REQUIRE(pReadded->GetOutputs() == pTxC->GetOutputs());
+	}
+}
@@ -0,0 +1,122 @@
+#include <catch.hpp>
+
+#include <TestServer.h>
+#include <TestChain.h>
+#include <TxBuilder.h>
+
+#include <BlockChain/BlockChainServer.h>
+#include <P2P/SyncStatus.h>
+#include <map>
+
+namespace
+{
+	using TxHashSetFiles = std::map<std::string, std::vector<uint8_t>>;
+
+	TxHashSetFiles ReadTxHashSetFiles(const TestServer::Ptr& pServer)
+	{
+		const fs::path& txHashSetPath = pServer->GetConfig()->GetNodeConfig().GetTxHashSetPath();
+
+		TxHashSetFiles files;
+		for (const std::string folder : { "kernel", "output", "rangeproof" })
+		{
+			for (const std::string file : { "pmmr_data.bin", "pmmr_hash.bin", "pmmr_prun.bin", "pmmr_leafset.bin" })
+			{
+				std::vector<uint8_t> contents;
+				if (FileUtil::ReadFile(txHashSetPath / folder / file, contents))
+				{
+					files[folder + "/" + file] = contents;
+				}
+			}
+		}
+
+		return files;
+	}
+
+	TestServer::Ptr CreateServerWithHeaders(const std::vector<BlockHeaderPtr>& headers)
+	{
+		TestServer::Ptr pServer = TestServer::Create();
+		REQUIRE(pServer->GetBlockChainServer()->AddBlockHeaders(headers) == EBlockChainStatus::SUCCESS);
+		return pServer;
+	}
+
+	void ReceiveInChunks(ITxHashSetReceiver& receiver, const std::vector<uint8_t>& archive, const size_t numBytes)
+	{
+		const size_t chunkSize = 1000;
+		for (size_t offset = 0; offset < numBytes; offset += chunkSize)
+		{
+			receiver.Receive(archive.data() + offset, (std::min)(chunkSize, numBytes - offset));
+		}
+	}
+}
+
+TEST_CASE("TxHashSet - Streamed archive matches serial extraction")
+{
+	std::vector<BlockHeaderPtr> headers;
+	std::vector<uint8_t> archive;
+
+	// Generate an archive from a locally mined chain.
+	{
+		TestServer::Ptr pServer = TestServer::Create();
+		KeyChain keyChain = KeyChain::FromRandom(*pServer->GetConfig());
+		TxBuilder txBuilder(keyChain);
+		TestChain chain(pServer);
+
+		for (uint32_t i = 1; i <= 10; i++)
+		{
+			MinedBlock block = chain.AddNextBlock({ txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, i })) });
+			REQUIRE(pServer->GetBlockChainServer()->AddBlock(block.block) == EBlockChainStatus::SUCCESS);
+			headers.push_back(block.block.GetHeader());
+		}
+
+		const fs::path zipPath = pServer->GetBlockChainServer()->SnapshotTxHashSet(headers.back());
+		REQUIRE(FileUtil::ReadFile(zipPath, archive));
+		FileUtil::RemoveFile(zipPath);
+	}
+
+	const Hash tipHash = headers.back()->GetHash();
+
+	// Serial path: the whole archive is written to disk, then extracted and validated.
+	TxHashSetFiles serialFiles;
+	{
+		TestServer::Ptr pServer = CreateServerWithHeaders(headers);
+		const fs::path zipPath = pServer->GenerateTempDir() / "txhashset.zip";
+		FileUtil::SafeWriteToFile(zipPath, archive);
+
+		SyncStatus syncStatus;
+		REQUIRE(pServer->GetBlockChainServer()->ProcessTransactionHashSet(tipHash, zipPath, syncStatus) == EBlockChainStatus::SUCCESS);
+		REQUIRE(pServer->GetBlockChainServer()->GetTipBlockHeader(EChainType::CONFIRMED)->GetHash() == tipHash);
+
+		serialFiles = ReadTxHashSetFiles(pServer);
+	}
+
+	// Streaming path: the archive is extracted as it's received, like it would be from a peer.
+	{
+		TestServer::Ptr pServer = CreateServerWithHeaders(headers);
+		IBlockChainServer* pBlockChainServer = pServer->GetBlockChainServer();
+		SyncStatus syncStatus;
+
+		REQUIRE(pBlockChainServer->CreateTxHashSetReceiver(Hash(), syncStatus) == nullptr);
+
+		// A truncated archive is rejected.
+		{
+			ITxHashSetReceiverPtr pReceiver = pBlockChainServer->CreateTxHashSetReceiver(tipHash, syncStatus);
+			REQUIRE(pReceiver != nullptr);
+
+			ReceiveInChunks(*pReceiver, archive, archive.size() / 2);
+			REQUIRE_FALSE(pReceiver->IsComplete());
+			REQUIRE(pBlockChainServer->ProcessTransactionHashSet(tipHash, *pReceiver, syncStatus) == EBlockChainStatus::INVALID);
+		}
+
+		ITxHashSetReceiverPtr pReceiver = pBlockChainServer->CreateTxHashSetReceiver(tipHash, syncStatus);
+		REQUIRE(pReceiver != nullptr);
+
+		ReceiveInChunks(*pReceiver, archive, archive.size());
+		REQUIRE(pReceiver->IsComplete());
+		REQUIRE(pReceiver->WaitForKernelValidation());
+
+		REQUIRE(pBlockChainServer->ProcessTransactionHashSet(tipHash, *pReceiver, syncStatus) == EBlockChainStatus::SUCCESS);
+		REQUIRE(pBlockChainServer->GetTipBlockHeader(EChainType::CONFIRMED)->GetHash() == tipHash);
+
+		REQUIRE(ReadTxHashSetFiles(pServer) == serialFiles);
+	}
+}
@@ -0,0 +1,180 @@
+#include <catch.hpp>
+
+#include <Core/Util/JsonStreamWriter.h>
+#include <Core/Util/JsonUtil.h>
+#include <json/json.h>
+
+#include <limits>
+#include <string>
+
+namespace
+{
+	std::string WriteCompact(const Json::Value& json)
+	{
+		Json::StreamWriterBuilder builder;
+		builder["indentation"] = "";
+		return Json::writeString(builder, json);
+	}
+
+	Json::Value ParseJSON(const std::string& str)
+	{
+		return JsonUtil::Parse(std::vector<unsigned char>(str.cbegin(), str.cend()));
+	}
+
+	Json::Value BuildOutputJSON(const uint64_t index)
+	{
+		Json::Value json;
+		json["output_type"] = index % 2 == 0 ? "Coinbase" : "Transaction";
+		json["commit"] = std::string(66, 'a' + (char)(index % 6));
+		json["spent"] = false;
+		json["proof"] = Json::nullValue;
+		json["block_height"] = index / 3;
+		json["mmr_index"] = index + 1;
+		return json;
+	}
+}
+
+TEST_CASE("JsonStreamWriter - Matches jsoncpp")
+{
+	Json::Value json;
+	json["null"] = Json::nullValue;
+	json["true"] = true;
+	json["false"] = false;
+	json["int"] = (Json::Int64)-1234567890123;
+	json["uint"] = (Json::UInt64)std::numeric_limits<uint64_t>::max();
+	json["zero"] = 0;
+	json["real"] = 1.5;
+	json["string"] = "Quotes \" backslashes \\ slashes / tabs \t newlines \n returns \r and \x01 control";
+	json["empty_string"] = "";
+	json["empty_array"] = Json::arrayValue;
+	json["empty_object"] = Json::objectValue;
+	json["nested"]["array"].append(1);
+	json["nested"]["array"].append("two");
+	json["nested"]["array"].append(Json::Value(Json::objectValue));
+	json["nested"]["array"][2]["three"] = 3;
+	json["nested"]["object"]["key with spaces"] = "value";
+
+	SECTION("Json::Value")
+	{
+		std::string streamed;
+		JsonStreamWriter writer([&streamed](const char* pData, const size_t length) { streamed.append(pData, length); });
+		writer.Value(json);
+		writer.Flush();
+
+		REQUIRE(streamed == WriteCompact(json));
+		REQUIRE(ParseJSON(streamed) == json);
+		REQUIRE(writer.GetBytesWritten() == streamed.size());
+	}
+
+	SECTION("Builder calls")
+	{
+		std::string streamed;
+		JsonStreamWriter writer([&streamed](const char* pData, const size_t length) { streamed.append(pData, length); });
+
+		writer.BeginObject();
+		writer.Key("empty_array").BeginArray().EndArray();
+		writer.Key("empty_object").BeginObject().EndObject();
+		writer.Key("empty_string").Value("");
+		writer.Key("false").Value(false);
+		writer.Key("int").Value((int64_t)-1234567890123);
+		writer.Key("nested").BeginObject();
+		writer.Key("array").BeginArray().Value(1).Value(std::string("two")).BeginObject().Key("three").Value((uint32_t)3).EndObject().EndArray();
+		writer.Key("object").BeginObject().Key("key with spaces").Value("value").EndObject();
+		writer.EndObject();
+		writer.Key("null").Null();
+		writer.Key("real").Value(1.5);
+		writer.Key("string").Value(json["string"].asString());
+		writer.Key("true").Value(true);
+		writer.Key("uint").Value(std::numeric_limits<uint64_t>::max());
+		writer.Key("zero").Value(0);
+		writer.EndObject();
+		writer.Flush();
+
+		REQUIRE(streamed == WriteCompact(json));
+	}
+
+	SECTION("UTF-8")
+	{
+		Json::Value utf8;
+		utf8["name"] = u8"grïn グリン";
+
+		std::string streamed;
+		JsonStreamWriter writer([&streamed](const char* pData, const size_t length) { streamed.append(pData, length); });
+		writer.Value(utf8);
+		writer.Flush();
+
+		REQUIRE(ParseJSON(streamed) == utf8);
+	}
+}
+
+TEST_CASE("JsonStreamWriter - Memory stays bounded")
+{
+	const size_t bufferSize = 4096;
+	const uint64_t numOutputs = 50000;
+
+	std::string streamed;
+	size_t numChunks = 0;
+	size_t largestChunk = 0;
+	uint64_t outputsWrittenAtFirstChunk = 0;
+	uint64_t outputsWritten = 0;
+
+	JsonStreamWriter writer(
+		[&](const char* pData, const size_t length) {
+			if (numChunks++ == 0)
+			{
+				outputsWrittenAtFirstChunk = outputsWritten;
+			}
+
+			largestChunk = (std::max)(largestChunk, length);
+			streamed.append(pData, length);
+		},
+		bufferSize
+	);
+
+	Json::Value expected(Json::arrayValue);
+
+	writer.BeginArray();
+	for (uint64_t i = 0; i < numOutputs; i++)
+	{
+		Json::Value output = BuildOutputJSON(i);
+		writer.Value(output);
+		expected.append(std::move(output));
+		outputsWritten++;
+	}
+	writer.EndArray();
+	writer.Flush();
+
+	// Chunks are sent while the document is still being produced, and never exceed the buffer.
+	REQUIRE(outputsWrittenAtFirstChunk < 100);
+	REQUIRE(largestChunk <= bufferSize);
+	REQUIRE(numChunks >= streamed.size() / bufferSize);
+
+	REQUIRE(streamed == WriteCompact(expected));
+}
+
+TEST_CASE("JsonStreamWriter - Strings larger than the buffer")
+{
+	const std::string large(1000, 'x');
+
+	std::string streamed;
+	size_t largestChunk = 0;
+	JsonStreamWriter writer(
+		[&](const char* pData, const size_t length) {
+			largestChunk = (std::max)(largestChunk, length);
+			streamed.append(pData, length);
+		},
+		64
+	);
+
+	writer.BeginArray().Value(large).Value("small").Value(large).EndArray();
+	writer.Flush();
+
+	Json::Value expected(Json::arrayValue);
+	expected.append(large);
+	expected.append("small");
+	expected.append(large);
+	REQUIRE(streamed == WriteCompact(expected));
+
+	// Only the oversized string itself bypasses the buffer.
+	REQUIRE(largestChunk == large.size());
+}
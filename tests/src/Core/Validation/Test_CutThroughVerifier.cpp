@@ -0,0 +1,202 @@
+#include <catch.hpp>
+
+#include <Core/Validation/CutThroughVerifier.h>
+#include <Core/Validation/TransactionBodyValidator.h>
+#include <Core/Exceptions/BadDataException.h>
+#include <Consensus/BlockWeight.h>
+#include <Consensus/Sorting.h>
+#include <algorithm>
+#include <random>
+#include <set>
+
+namespace
+{
+	class BodyGenerator
+	{
+	public:
+		BodyGenerator() : m_rng(1234) { }
+
+		Commitment RandomCommitment()
+		{
+			std::vector<unsigned char> bytes(33);
+			bytes[0] = 0x08;
+			for (size_t i = 1; i < bytes.size(); i++)
+			{
+				bytes[i] = (unsigned char)m_rng();
+			}
+
+			return Commitment(CBigInteger<33>(std::move(bytes)));
+		}
+
+		std::vector<TransactionInput> Inputs(const size_t count)
+		{
+			std::vector<TransactionInput> inputs;
+			for (size_t i = 0; i < count; i++)
+			{
+				inputs.emplace_back(TransactionInput(EOutputFeatures::DEFAULT, RandomCommitment()));
+			}
+
+			std::sort(inputs.begin(), inputs.end(), SortInputsByHash);
+			return inputs;
+		}
+
+		std::vector<TransactionOutput> Outputs(const size_t count)
+		{
+			std::vector<TransactionOutput> outputs;
+			for (size_t i = 0; i < count; i++)
+			{
+				outputs.emplace_back(TransactionOutput(EOutputFeatures::DEFAULT, RandomCommitment(), RangeProof(std::vector<unsigned char>(683))));
+			}
+
+			std::sort(outputs.begin(), outputs.end(), SortOutputsByHash);
+			return outputs;
+		}
+
+		std::vector<TransactionKernel> Kernels(const size_t count)
+		{
+			std::vector<TransactionKernel> kernels;
+			for (size_t i = 0; i < count; i++)
+			{
+				kernels.emplace_back(TransactionKernel(EKernelFeatures::DEFAULT_KERNEL, 1'000'000, 0, RandomCommitment(), Signature()));
+			}
+
+			std::sort(kernels.begin(), kernels.end(), SortKernelsByHash);
+			return kernels;
+		}
+
+	private:
+		std::mt19937 m_rng;
+	};
+
+	// The set-based check this replaced, kept here only for comparison.
+	bool VerifyCutThroughWithSet(const TransactionBody& body)
+	{
+		std::set<Commitment> commitments;
+		for (auto output : body.GetOutputs())
+		{
+			commitments.insert(output.GetCommitment());
+		}
+
+		for (auto input : body.GetInputs())
+		{
+			if (commitments.count(input.GetCommitment()) > 0)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void RequireStatus(
+		std::vector<TransactionInput> inputs,
+		std::vector<TransactionOutput> outputs,
+		std::vector<TransactionKernel> kernels,
+		const CutThroughVerifier::EStatus expected)
+	{
+		const TransactionBody body(std::move(inputs), std::move(outputs), std::move(kernels));
+		REQUIRE(CutThroughVerifier::Verify(body) == expected);
+
+		if (expected != CutThroughVerifier::EStatus::VALID)
+		{
+			REQUIRE_THROWS_AS(TransactionBodyValidator().Validate(body, false), BadDataException);
+		}
+	}
+}
+
+TEST_CASE("CutThroughVerifier - Sorted, unique, and cut-through")
+{
+	BodyGenerator generator;
+	const std::vector<TransactionInput> inputs = generator.Inputs(10);
+	const std::vector<TransactionOutput> outputs = generator.Outputs(10);
+	const std::vector<TransactionKernel> kernels = generator.Kernels(3);
+
+	RequireStatus({}, {}, {}, CutThroughVerifier::EStatus::VALID);
+	RequireStatus(inputs, outputs, kernels, CutThroughVerifier::EStatus::VALID);
+
+	SECTION("Not sorted")
+	{
+		std::vector<TransactionInput> unsortedInputs = inputs;
+		std::swap(unsortedInputs[3], unsortedInputs[4]);
+		RequireStatus(unsortedInputs, outputs, kernels, CutThroughVerifier::EStatus::NOT_SORTED);
+
+		std::vector<TransactionOutput> unsortedOutputs = outputs;
+		std::swap(unsortedOutputs.front(), unsortedOutputs.back());
+		RequireStatus(inputs, unsortedOutputs, kernels, CutThroughVerifier::EStatus::NOT_SORTED);
+
+		std::vector<TransactionKernel> unsortedKernels = kernels;
+		std::reverse(unsortedKernels.begin(), unsortedKernels.end());
+		RequireStatus(inputs, outputs, unsortedKernels, CutThroughVerifier::EStatus::NOT_SORTED);
+	}
+
+	SECTION("Duplicates")
+	{
+		std::vector<TransactionInput> duplicateInputs = inputs;
+		duplicateInputs.insert(duplicateInputs.begin() + 5, inputs[5]);
+		RequireStatus(duplicateInputs, outputs, kernels, CutThroughVerifier::EStatus::DUPLICATE);
+
+		std::vector<TransactionOutput> duplicateOutputs = outputs;
+		duplicateOutputs.push_back(outputs.back());
+		RequireStatus(inputs, duplicateOutputs, kernels, CutThroughVerifier::EStatus::DUPLICATE);
+
+		std::vector<TransactionKernel> duplicateKernels = kernels;
+		duplicateKernels.insert(duplicateKernels.begin(), kernels.front());
+		RequireStatus(inputs, outputs, duplicateKernels, CutThroughVerifier::EStatus::DUPLICATE);
+	}
+
+	SECTION("Cut-through")
+	{
+		for (const size_t index : { (size_t)0, (size_t)4, outputs.size() - 1 })
+		{
+			std::vector<TransactionInput> spendingInputs = inputs;
+			spendingInputs.emplace_back(TransactionInput(outputs[index].GetFeatures(), outputs[index].GetCommitment()));
+			std::sort(spendingInputs.begin(), spendingInputs.end(), SortInputsByHash);
+
+			RequireStatus(spendingInputs, outputs, kernels, CutThroughVerifier::EStatus::CUT_THROUGH);
+		}
+	}
+
+	SECTION("Cut-through with mismatched features")
+	{
+		// The input's hash differs from the output's, but it still spends the same commitment.
+		std::vector<TransactionInput> spendingInputs = inputs;
+		spendingInputs.emplace_back(TransactionInput(EOutputFeatures::COINBASE_OUTPUT, outputs[2].GetCommitment()));
+		std::sort(spendingInputs.begin(), spendingInputs.end(), SortInputsByHash);
+
+		REQUIRE(outputs[2].GetFeatures() == EOutputFeatures::DEFAULT);
+		RequireStatus(spendingInputs, outputs, kernels, CutThroughVerifier::EStatus::CUT_THROUGH);
+	}
+}
+
+TEST_CASE("CutThroughVerifier - Max weight block")
+{
+	// 7,000 inputs, 1,400 outputs, and 1,200 kernels fill a block exactly.
+	const size_t numInputs = 7'000;
+	const size_t numOutputs = 1'400;
+	const size_t numKernels = 1'200;
+	const size_t weight = (numInputs * Consensus::BLOCK_INPUT_WEIGHT)
+		+ (numOutputs * Consensus::BLOCK_OUTPUT_WEIGHT)
+		+ (numKernels * Consensus::BLOCK_KERNEL_WEIGHT);
+	REQUIRE(weight == Consensus::MAX_BLOCK_WEIGHT);
+
+	BodyGenerator generator;
+	const TransactionBody body(generator.Inputs(numInputs), generator.Outputs(numOutputs), generator.Kernels(numKernels));
+
+	// Agrees with the sorted checks and set-based cut-through check it replaced.
+	REQUIRE(VerifyCutThroughWithSet(body));
+	REQUIRE(Consensus::IsSorted(body.GetInputs()));
+	REQUIRE(Consensus::IsSorted(body.GetOutputs()));
+	REQUIRE(Consensus::IsSorted(body.GetKernels()));
+	REQUIRE(CutThroughVerifier::Verify(body) == CutThroughVerifier::EStatus::VALID);
+
+	// Spending the last output, with mismatched features, is still caught.
+	std::vector<TransactionInput> inputs = body.GetInputs();
+	inputs.emplace_back(TransactionInput(EOutputFeatures::COINBASE_OUTPUT, body.GetOutputs().back().GetCommitment()));
+	std::sort(inputs.begin(), inputs.end(), SortInputsByHash);
+
+	std::vector<TransactionOutput> outputs = body.GetOutputs();
+	std::vector<TransactionKernel> kernels = body.GetKernels();
+	const TransactionBody spendingBody(std::move(inputs), std::move(outputs), std::move(kernels));
+	REQUIRE_FALSE(VerifyCutThroughWithSet(spendingBody));
+	REQUIRE(CutThroughVerifier::Verify(spendingBody) == CutThroughVerifier::EStatus::CUT_THROUGH);
+}
@@ -0,0 +1,87 @@
+#include <catch.hpp>
+
+#include <Core/Validation/KernelSumValidator.h>
+#include <Crypto/RandomNumberGenerator.h>
+
+namespace
+{
+	TransactionKernel CreateKernel(const Commitment& excess)
+	{
+		return TransactionKernel(EKernelFeatures::DEFAULT_KERNEL, 0, 0, Commitment(excess), Signature());
+	}
+
+	TransactionOutput CreateOutput(const Commitment& commitment)
+	{
+		return TransactionOutput(EOutputFeatures::DEFAULT, commitment, RangeProof(std::vector<unsigned char>(675)));
+	}
+}
+
+TEST_CASE("KernelSumValidator - No inputs")
+{
+	const uint64_t amount = 60'000'000'000;
+	const BlindingFactor blind = RandomNumberGenerator::GenerateRandom32();
+
+	// Like a coinbase, the output's value is balanced by the overage alone.
+	const TransactionBody body(
+		{},
+		{ CreateOutput(Crypto::CommitBlinded(amount, blind)) },
+		{ CreateKernel(Crypto::CommitBlinded(0, blind)) }
+	);
+
+	REQUIRE_NOTHROW(KernelSumValidator::VerifyKernelSums(body, 0 - (int64_t)amount, BlindingFactor()));
+
+	const BlockSums blockSums = KernelSumValidator::ValidateKernelSums(body, 0 - (int64_t)amount, BlindingFactor(), std::nullopt);
+	REQUIRE(blockSums.GetOutputSum() == Crypto::CommitBlinded(0, blind));
+	REQUIRE(blockSums.GetKernelSum() == Crypto::CommitBlinded(0, blind));
+
+	// Mismatched sum
+	REQUIRE_THROWS_AS(KernelSumValidator::VerifyKernelSums(body, 1 - (int64_t)amount, BlindingFactor()), BadDataException);
+	REQUIRE_THROWS_AS(KernelSumValidator::ValidateKernelSums(body, 1 - (int64_t)amount, BlindingFactor(), std::nullopt), BadDataException);
+}
+
+TEST_CASE("KernelSumValidator - No outputs")
+{
+	const uint64_t amount = 1'000'000;
+	const BlindingFactor blind = RandomNumberGenerator::GenerateRandom32();
+
+	// The input's value is balanced by the overage, and its blinding factor by the negated kernel excess.
+	const Commitment inputCommitment = Crypto::CommitBlinded(amount, blind);
+	const TransactionBody body(
+		{ TransactionInput(EOutputFeatures::DEFAULT, inputCommitment) },
+		{},
+		{ CreateKernel(Crypto::AddCommitments({}, { Crypto::CommitBlinded(0, blind) })) }
+	);
+
+	REQUIRE_NOTHROW(KernelSumValidator::VerifyKernelSums(body, (int64_t)amount, BlindingFactor()));
+	REQUIRE_NOTHROW(KernelSumValidator::ValidateKernelSums(body, (int64_t)amount, BlindingFactor(), std::nullopt));
+
+	// Mismatched sum
+	REQUIRE_THROWS_AS(KernelSumValidator::VerifyKernelSums(body, (int64_t)amount - 1, BlindingFactor()), BadDataException);
+	REQUIRE_THROWS_AS(KernelSumValidator::VerifyKernelSums(body, 0, BlindingFactor()), BadDataException);
+}
+
+TEST_CASE("KernelSumValidator - Offset and previous block sums")
+{
+	const uint64_t amount = 1'000'000;
+	const BlindingFactor inputBlind = RandomNumberGenerator::GenerateRandom32();
+	const BlindingFactor outputBlind = RandomNumberGenerator::GenerateRandom32();
+	const BlindingFactor offset = RandomNumberGenerator::GenerateRandom32();
+
+	// excess = outputBlind - inputBlind - offset
+	const BlindingFactor excessBlind = Crypto::AddBlindingFactors({ outputBlind }, { inputBlind, offset });
+	const Commitment inputCommitment = Crypto::CommitBlinded(amount, inputBlind);
+	const TransactionBody body(
+		{ TransactionInput(EOutputFeatures::DEFAULT, inputCommitment) },
+		{ CreateOutput(Crypto::CommitBlinded(amount, outputBlind)) },
+		{ CreateKernel(Crypto::CommitBlinded(0, excessBlind)) }
+	);
+
+	REQUIRE_NOTHROW(KernelSumValidator::VerifyKernelSums(body, 0, offset));
+	REQUIRE_THROWS_AS(KernelSumValidator::VerifyKernelSums(body, 0, BlindingFactor()), BadDataException);
+
+	// The previous block's sums are carried forward. They balance on their own, as they would on a valid chain.
+	const BlockSums previous(Crypto::CommitBlinded(0, inputBlind), Crypto::CommitBlinded(0, inputBlind));
+	const BlockSums blockSums = KernelSumValidator::ValidateKernelSums(body, 0, offset, std::make_optional(previous));
+	REQUIRE(blockSums.GetOutputSum() == Crypto::CommitBlinded(0, outputBlind));
+	REQUIRE(blockSums.GetKernelSum() == Crypto::AddCommitments({ Crypto::CommitBlinded(0, excessBlind), Crypto::CommitBlinded(0, inputBlind) }, {}));
+}
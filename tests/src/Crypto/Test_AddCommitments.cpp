@@ -65,4 +65,38 @@ TEST_CASE("Crypto - PublicKey to Commitment")
 {
 	auto commit = Crypto::ToCommitment(PublicKey(CBigInteger<33>::FromHex("02f434a6b929d0aa6ac757bbe387075066d51ee5308d5be91d2fb478a494d38bdf")));
 	REQUIRE(commit.ToHex() == "08f434a6b929d0aa6ac757bbe387075066d51ee5308d5be91d2fb478a494d38bdf");
-}
\ No newline at end of file
+}
+
+TEST_CASE("Crypto - VerifyCommitmentSum")
+{
+	BlindingFactor blind_a = RandomNumberGenerator::GenerateRandom32() / 2;
+	BlindingFactor blind_b = RandomNumberGenerator::GenerateRandom32() / 2;
+	BlindingFactor blind_c = Crypto::AddBlindingFactors({ blind_a, blind_b }, {});
+
+	Commitment commit_a = Crypto::CommitBlinded(3, blind_a);
+	const ParsedCommitment a = Crypto::ParseCommitment(commit_a);
+	const ParsedCommitment b = Crypto::ParseCommitment(Crypto::CommitBlinded(2, blind_b));
+	const ParsedCommitment c = Crypto::ParseCommitment(Crypto::CommitBlinded(5, blind_c));
+	const ParsedCommitment wrong = Crypto::ParseCommitment(Crypto::CommitBlinded(6, blind_c));
+
+	REQUIRE(Crypto::VerifyCommitmentSum({ &a, &b }, { &c }));
+	REQUIRE(Crypto::VerifyCommitmentSum({ &c }, { &a, &b }));
+
+	// Mismatched sum
+	REQUIRE_FALSE(Crypto::VerifyCommitmentSum({ &a, &b }, { &wrong }));
+	REQUIRE_FALSE(Crypto::VerifyCommitmentSum({ &a }, { &c }));
+
+	// Empty negative set
+	REQUIRE_FALSE(Crypto::VerifyCommitmentSum({ &c }, {}));
+
+	// Empty positive set
+	REQUIRE_FALSE(Crypto::VerifyCommitmentSum({}, { &c }));
+
+	// Nothing on either side sums to zero.
+	REQUIRE(Crypto::VerifyCommitmentSum({}, {}));
+
+	// Summing with an empty side matches summing the serialized commitments.
+	REQUIRE(Crypto::SerializeCommitment(Crypto::AddParsedCommitments({ &a, &b }, {})) == Crypto::SerializeCommitment(c));
+	REQUIRE(Crypto::SerializeCommitment(Crypto::AddParsedCommitments({}, { &a })) == Crypto::AddCommitments({}, { commit_a }));
+	REQUIRE(Crypto::SerializeCommitment(Crypto::AddParsedCommitments({ &c }, { &b })) == commit_a);
+}
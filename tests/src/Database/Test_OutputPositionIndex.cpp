@@ -0,0 +1,93 @@
+#include <catch.hpp>
+
+#include <Database/OutputPositionIndex.h>
+#include <Crypto/RandomNumberGenerator.h>
+#include <unordered_map>
+
+static Commitment RandomCommitment()
+{
+	SecureVector randomBytes = RandomNumberGenerator::GenerateRandomBytes(33);
+	return Commitment(CBigInteger<33>(std::vector<unsigned char>(randomBytes.begin(), randomBytes.end())));
+}
+
+TEST_CASE("OutputPositionIndex - Put/Get/Erase")
+{
+	OutputPositionIndex index;
+
+	Commitment commitment1 = RandomCommitment();
+	Commitment commitment2 = RandomCommitment();
+
+	REQUIRE(index.Get(commitment1) == nullptr);
+	REQUIRE(index.Erase(commitment1) == nullptr);
+
+	index.Put(commitment1, OutputLocation(5, 10));
+	index.Put(commitment2, OutputLocation(6, 11));
+	REQUIRE(index.Size() == 2);
+	REQUIRE(index.Get(commitment1)->GetMMRIndex() == 5);
+	REQUIRE(index.Get(commitment1)->GetBlockHeight() == 10);
+
+	// Replacing an existing commitment shouldn't change the size
+	index.Put(commitment1, OutputLocation(7, 12));
+	REQUIRE(index.Size() == 2);
+	REQUIRE(index.Get(commitment1)->GetMMRIndex() == 7);
+
+	std::unique_ptr<OutputLocation> pErased = index.Erase(commitment1);
+	REQUIRE(pErased != nullptr);
+	REQUIRE(pErased->GetMMRIndex() == 7);
+	REQUIRE(pErased->GetBlockHeight() == 12);
+	REQUIRE(index.Get(commitment1) == nullptr);
+	REQUIRE(index.Get(commitment2)->GetMMRIndex() == 6);
+	REQUIRE(index.Size() == 1);
+
+	index.Clear();
+	REQUIRE(index.Size() == 0);
+	REQUIRE(index.Get(commitment2) == nullptr);
+}
+
+TEST_CASE("OutputPositionIndex - Matches std::unordered_map")
+{
+	OutputPositionIndex index;
+	std::unordered_map<Commitment, uint64_t> expected;
+	std::vector<Commitment> commitments;
+
+	for (uint64_t i = 0; i < 20000; i++)
+	{
+		Commitment commitment = RandomCommitment();
+		index.Put(commitment, OutputLocation(i, i / 10));
+		expected[commitment] = i;
+		commitments.push_back(commitment);
+
+		// Erase roughly a third of the commitments along the way to exercise backward-shift deletion.
+		if (i % 3 == 0)
+		{
+			const Commitment& toErase = commitments[RandomNumberGenerator::GenerateRandom(0, commitments.size() - 1)];
+			const bool wasIndexed = expected.erase(toErase) > 0;
+			REQUIRE((index.Erase(toErase) != nullptr) == wasIndexed);
+		}
+	}
+
+	REQUIRE(index.Size() == expected.size());
+
+	for (const Commitment& commitment : commitments)
+	{
+		auto iter = expected.find(commitment);
+		std::unique_ptr<OutputLocation> pLocation = index.Get(commitment);
+		if (iter == expected.end())
+		{
+			REQUIRE(pLocation == nullptr);
+		}
+		else
+		{
+			REQUIRE(pLocation != nullptr);
+			REQUIRE(pLocation->GetMMRIndex() == iter->second);
+			REQUIRE(pLocation->GetBlockHeight() == iter->second / 10);
+		}
+	}
+
+	size_t numVisited = 0;
+	index.ForEach([&expected, &numVisited](const Commitment& commitment, const OutputLocation& location) {
+		REQUIRE(expected.at(commitment) == location.GetMMRIndex());
+		++numVisited;
+	});
+	REQUIRE(numVisited == expected.size());
+}
@@ -0,0 +1,189 @@
+#include <catch.hpp>
+
+#include <Net/Servers/Server.h>
+#include <Net/Servers/RequestLane.h>
+#include <Net/Util/HTTPUtil.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	struct Response
+	{
+		int statusCode;
+		std::string retryAfter;
+	};
+
+	Response Get(const uint16_t port, const std::string& uri)
+	{
+		char errorBuffer[256] = { 0 };
+		mg_connection* pConnection = mg_download(
+			"127.0.0.1",
+			port,
+			0,
+			errorBuffer,
+			sizeof(errorBuffer),
+			"GET %s HTTP/1.0\r\nHost: 127.0.0.1\r\n\r\n",
+			uri.c_str()
+		);
+		if (pConnection == nullptr)
+		{
+			// Called from multiple threads, so this can't use REQUIRE.
+			throw std::runtime_error(errorBuffer);
+		}
+
+		char body[256];
+		while (mg_read(pConnection, body, sizeof(body)) > 0) { }
+
+		const char* pRetryAfter = mg_get_header(pConnection, "Retry-After");
+		Response response{
+			mg_get_response_info(pConnection)->status_code,
+			pRetryAfter != nullptr ? std::string(pRetryAfter) : ""
+		};
+
+		mg_close_connection(pConnection);
+		return response;
+	}
+
+	int Status_Handler(mg_connection* pConnection, void*)
+	{
+		return HTTPUtil::BuildSuccessResponse(pConnection, "{\"ok\":true}");
+	}
+
+	// Simulates a range query that holds a lock until the test releases it.
+	struct SlowQueries
+	{
+		std::atomic<size_t> running{ 0 };
+		std::shared_future<void> released;
+	};
+
+	int Slow_Handler(mg_connection* pConnection, void* pSlowQueries)
+	{
+		SlowQueries& slowQueries = *(SlowQueries*)pSlowQueries;
+		++slowQueries.running;
+		slowQueries.released.wait();
+		--slowQueries.running;
+
+		return HTTPUtil::BuildSuccessResponse(pConnection, "[]");
+	}
+}
+
+TEST_CASE("RequestLane - Rejects once running and queued limits are reached")
+{
+	RequestLane lane(1, 1);
+
+	auto pFirst = lane.TryEnter();
+	REQUIRE(pFirst != nullptr);
+
+	// The second request waits for the first to finish.
+	std::promise<void> waiting;
+	std::future<bool> second = std::async(std::launch::async, [&lane, &waiting]() {
+		waiting.set_value();
+		return lane.TryEnter() != nullptr;
+	});
+	waiting.get_future().wait();
+	while (lane.GetNumQueued() == 0)
+	{
+		std::this_thread::yield();
+	}
+
+	// The queue is full, so a third is turned away immediately.
+	REQUIRE(lane.TryEnter() == nullptr);
+
+	pFirst.reset();
+	REQUIRE(second.get());
+
+	// Both tickets were released, so the lane is empty again.
+	REQUIRE(lane.TryEnter() != nullptr);
+}
+
+TEST_CASE("Server - Status requests are served while range queries saturate the expensive lane")
+{
+	ServerLimits limits;
+	limits.expensiveConcurrency = 2;
+	limits.expensiveQueueDepth = 2;
+	limits.reservedCheapThreads = 3;
+	limits.retryAfterSeconds = 2;
+
+	std::promise<void> release;
+	SlowQueries slowQueries;
+	slowQueries.released = release.get_future().share();
+
+	ServerPtr pServer = Server::Create(EServerType::LOCAL, std::nullopt, limits);
+	pServer->AddListener("/status", Status_Handler, nullptr);
+	pServer->AddListener("/range", Slow_Handler, &slowQueries, ERequestCost::EXPENSIVE);
+	const uint16_t port = pServer->GetPortNumber();
+
+	std::vector<std::future<Response>> rangeQueries;
+	for (size_t i = 0; i < 20; i++)
+	{
+		rangeQueries.push_back(std::async(std::launch::async, [port]() { return Get(port, "/range"); }));
+	}
+
+	// Wait for the expensive lane to fill up, and for the first overflow to be turned away.
+	auto isReady = [](const std::future<Response>& rangeQuery) {
+		return rangeQuery.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+	};
+	const auto deadline = Clock::now() + std::chrono::seconds(5);
+	while ((slowQueries.running < limits.expensiveConcurrency || std::none_of(rangeQueries.cbegin(), rangeQueries.cend(), isReady))
+		&& Clock::now() < deadline)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+	REQUIRE(slowQueries.running == limits.expensiveConcurrency);
+
+	// Nothing is released until after the status requests, so they can only succeed if they never wait on a range query.
+	for (size_t i = 0; i < 10; i++)
+	{
+		REQUIRE(Get(port, "/status").statusCode == 200);
+	}
+	REQUIRE(slowQueries.running == limits.expensiveConcurrency);
+
+	// Every range query that already finished was turned away.
+	for (auto& rangeQuery : rangeQueries)
+	{
+		if (isReady(rangeQuery))
+		{
+			Response response = rangeQuery.get();
+			REQUIRE(response.statusCode == 503);
+			REQUIRE(response.retryAfter == "2");
+		}
+	}
+
+	release.set_value();
+
+	size_t succeeded = 0;
+	size_t rejected = 0;
+	for (auto& rangeQuery : rangeQueries)
+	{
+		if (!rangeQuery.valid())
+		{
+			++rejected;
+			continue;
+		}
+
+		Response response = rangeQuery.get();
+		if (response.statusCode == 200)
+		{
+			++succeeded;
+		}
+		else
+		{
+			REQUIRE(response.statusCode == 503);
+			REQUIRE(response.retryAfter == "2");
+			++rejected;
+		}
+	}
+
+	REQUIRE(succeeded >= limits.expensiveConcurrency);
+	REQUIRE(rejected > 0);
+	REQUIRE(succeeded + rejected == 20);
+}
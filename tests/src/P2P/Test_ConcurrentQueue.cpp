@@ -0,0 +1,180 @@
+#include <catch.hpp>
+
+#include <Common/ConcurrentQueue.h>
+#include <Common/KeyedConcurrentQueue.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <thread>
+
+using namespace std::chrono;
+
+TEST_CASE("ConcurrentQueue - pop_wait")
+{
+	ConcurrentQueue<int> queue;
+	std::atomic_bool terminate = false;
+
+	// Times out when nothing is queued
+	const auto start = steady_clock::now();
+	REQUIRE(queue.pop_wait(milliseconds(20), terminate) == nullptr);
+	REQUIRE(steady_clock::now() - start >= milliseconds(20));
+
+	// Returns immediately when items are already queued, in FIFO order
+	queue.push_back(1);
+	queue.push_back(2);
+	REQUIRE(queue.wait(milliseconds(0), terminate));
+	REQUIRE(*queue.pop_wait(milliseconds(0), terminate) == 1);
+	REQUIRE(*queue.pop_wait(milliseconds(0), terminate) == 2);
+	REQUIRE_FALSE(queue.wait(milliseconds(0), terminate));
+
+	// Gives up once terminate is set
+	terminate = true;
+	queue.push_back(3);
+	REQUIRE(queue.pop_wait(seconds(10), terminate) != nullptr);
+	REQUIRE(queue.pop_wait(seconds(10), terminate) == nullptr);
+}
+
+TEST_CASE("ConcurrentQueue - Waiting consumers are woken by push_back")
+{
+	ConcurrentQueue<int> queue;
+	std::atomic_bool terminate = false;
+
+	// The timeouts are far longer than the test should ever take, so consumers only return when woken by a push.
+	const minutes timeout(10);
+
+	SECTION("One consumer receives every item in order")
+	{
+		const int numItems = 200;
+		std::atomic_int numReceived = 0;
+		std::vector<int> received;
+		size_t numTimeouts = 0;
+
+		std::thread consumer([&]() {
+			while (numReceived < numItems)
+			{
+				auto pItem = queue.pop_wait(timeout, terminate);
+				if (pItem == nullptr)
+				{
+					++numTimeouts;
+					continue;
+				}
+
+				received.push_back(*pItem);
+				++numReceived;
+			}
+		});
+
+		for (int i = 0; i < numItems; i++)
+		{
+			// Only push once the previous item was consumed, so each push has to wake the consumer.
+			while (numReceived < i)
+			{
+				std::this_thread::yield();
+			}
+
+			queue.push_back(i);
+		}
+
+		consumer.join();
+
+		std::vector<int> expected(numItems);
+		std::iota(expected.begin(), expected.end(), 0);
+		REQUIRE(received == expected);
+		REQUIRE(numTimeouts == 0);
+	}
+
+	SECTION("Each item goes to exactly one of several consumers")
+	{
+		const int numConsumers = 4;
+		const int numItems = 400;
+
+		std::vector<std::vector<int>> receivedByConsumer(numConsumers);
+		std::vector<std::thread> consumers;
+		for (int c = 0; c < numConsumers; c++)
+		{
+			consumers.emplace_back([&queue, &terminate, &timeout, &received = receivedByConsumer[c]]() {
+				while (true)
+				{
+					auto pItem = queue.pop_wait(timeout, terminate);
+					if (pItem != nullptr && *pItem < 0)
+					{
+						break;
+					}
+					else if (pItem != nullptr)
+					{
+						received.push_back(*pItem);
+					}
+				}
+			});
+		}
+
+		for (int i = 0; i < numItems; i++)
+		{
+			queue.push_back(i);
+		}
+
+		// One stop marker per consumer.
+		for (int c = 0; c < numConsumers; c++)
+		{
+			queue.push_back(-1);
+		}
+
+		for (std::thread& consumer : consumers)
+		{
+			consumer.join();
+		}
+
+		std::vector<int> allReceived;
+		for (const std::vector<int>& received : receivedByConsumer)
+		{
+			// Items are popped from the front, so each consumer sees them in the order they were pushed.
+			REQUIRE(std::is_sorted(received.cbegin(), received.cend()));
+			allReceived.insert(allReceived.end(), received.cbegin(), received.cend());
+		}
+
+		std::sort(allReceived.begin(), allReceived.end());
+		std::vector<int> expected(numItems);
+		std::iota(expected.begin(), expected.end(), 0);
+		REQUIRE(allReceived == expected);
+		REQUIRE(queue.copy_front() == nullptr);
+	}
+
+	SECTION("wait is woken without popping")
+	{
+		std::atomic_bool waitResult = false;
+		std::thread waiter([&]() { waitResult = queue.wait(timeout, terminate); });
+
+		queue.push_back(7);
+		waiter.join();
+
+		REQUIRE(waitResult);
+		REQUIRE(*queue.copy_front() == 7);
+	}
+}
+
+TEST_CASE("KeyedConcurrentQueue - push_back_unique")
+{
+	KeyedConcurrentQueue<int, std::pair<int, std::string>> queue([](const std::pair<int, std::string>& item) { return item.first; });
+
+	REQUIRE(queue.push_back_unique({ 1, "a" }));
+	REQUIRE(queue.push_back_unique({ 2, "b" }));
+	REQUIRE_FALSE(queue.push_back_unique({ 1, "c" }));
+	REQUIRE(queue.size() == 2);
+	REQUIRE(queue.contains(1));
+	REQUIRE_FALSE(queue.contains(3));
+
+	// Items that have been copied, but not yet popped, still block duplicates.
+	REQUIRE(queue.copy_front()->second == "a");
+	REQUIRE_FALSE(queue.push_back_unique({ 1, "d" }));
+
+	// Popping releases the key.
+	queue.pop_front(1);
+	REQUIRE_FALSE(queue.contains(1));
+	REQUIRE(queue.push_back_unique({ 1, "e" }));
+
+	std::atomic_bool terminate = false;
+	REQUIRE(queue.pop_wait(milliseconds(0), terminate)->second == "b");
+	REQUIRE_FALSE(queue.contains(2));
+	REQUIRE(queue.copy_front(5).size() == 1);
+}
@@ -0,0 +1,206 @@
+#include <catch.hpp>
+
+#include <P2P/ConnectionManager.h>
+#include <P2P/Connection.h>
+#include <P2P/MessageProcessor.h>
+#include <P2P/Messages/HeaderMessage.h>
+#include <P2P/Messages/TransactionKernelMessage.h>
+#include <P2P/Messages/MessageHeader.h>
+#include <Config/Genesis.h>
+#include <chrono>
+#include <map>
+#include <set>
+#include <thread>
+
+using namespace std::chrono;
+
+namespace
+{
+	//
+	// Connects numPeers loopback clients to the ConnectionManager as inbound Connections with ids 1 to numPeers,
+	// so broadcasts go through the same Connection send queues and threads as they would for real peers.
+	//
+	struct BroadcastFixture
+	{
+		BroadcastFixture(const size_t numPeers, const int broadcastFanout)
+			: pConfig(LoadConfig(broadcastFanout)),
+			pSyncStatus(std::make_shared<SyncStatus>()),
+			pContext(std::make_shared<asio::io_context>()),
+			acceptor(*pContext, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0)),
+			pConnectionManager(ConnectionManager::Create(*pConfig))
+		{
+			for (size_t i = 1; i <= numPeers; i++)
+			{
+				auto pClient = std::make_unique<asio::ip::tcp::socket>(*pContext);
+				pClient->connect(acceptor.local_endpoint());
+
+				auto pSocket = std::make_shared<asio::ip::tcp::socket>(*pContext);
+				acceptor.accept(*pSocket);
+
+				const IPAddress ipAddress = IPAddress::CreateV4({ 127, 0, 0, (uint8_t)i });
+				const uint16_t port = pSocket->remote_endpoint().port();
+				Connection::Create(
+					SocketPtr(new Socket(SocketAddress(ipAddress, port), pContext, pSocket)),
+					i,
+					*pConfig,
+					*pConnectionManager,
+					nullptr,
+					ConnectedPeer(std::make_shared<Peer>(ipAddress), EDirection::INBOUND, port),
+					std::weak_ptr<MessageProcessor>(),
+					pSyncStatus
+				);
+
+				clients.push_back(std::move(pClient));
+			}
+
+			// Each connection adds itself to the ConnectionManager from its own thread.
+			const auto deadline = steady_clock::now() + seconds(10);
+			while (pConnectionManager->GetNumberOfActiveConnections() < numPeers && steady_clock::now() < deadline)
+			{
+				std::this_thread::sleep_for(milliseconds(1));
+			}
+
+			REQUIRE(pConnectionManager->GetNumberOfActiveConnections() == numPeers);
+		}
+
+		~BroadcastFixture()
+		{
+			pConnectionManager->Shutdown();
+		}
+
+		static ConfigPtr LoadConfig(const int broadcastFanout)
+		{
+			Json::Value json;
+			json[ConfigProps::P2P::P2P][ConfigProps::P2P::BROADCAST_FANOUT] = broadcastFanout;
+			return Config::Load(json, EEnvironmentType::AUTOMATED_TESTING);
+		}
+
+		struct Received
+		{
+			std::vector<Hash> headers;
+			std::vector<Hash> kernels;
+		};
+
+		//
+		// Queues a header that goes to every peer, then reads what each peer received before it.
+		// Connections send in the order messages were broadcast, so nothing broadcast earlier can arrive later.
+		//
+		std::vector<Received> ReadUntilMarker()
+		{
+			const BlockHeaderPtr& pMarker = Genesis::MAINNET_GENESIS.GetHeader();
+			pConnectionManager->BroadcastMessage(HeaderMessage(pMarker), 0);
+
+			std::vector<Received> receivedByPeer;
+			for (auto& pClient : clients)
+			{
+				Received received;
+				while (true)
+				{
+					std::vector<unsigned char> headerBytes(11);
+					asio::read(*pClient, asio::buffer(headerBytes));
+					ByteBuffer headerBuffer(std::move(headerBytes));
+					const MessageHeader header = MessageHeader::Deserialize(headerBuffer);
+
+					std::vector<unsigned char> bodyBytes(header.GetMessageLength());
+					asio::read(*pClient, asio::buffer(bodyBytes));
+					ByteBuffer bodyBuffer(std::move(bodyBytes));
+
+					if (header.GetMessageType() == MessageTypes::Header)
+					{
+						const Hash headerHash = HeaderMessage::Deserialize(bodyBuffer).GetHeader()->GetHash();
+						if (headerHash == pMarker->GetHash())
+						{
+							break;
+						}
+
+						received.headers.push_back(headerHash);
+					}
+					else if (header.GetMessageType() == MessageTypes::TransactionKernelMsg)
+					{
+						received.kernels.push_back(TransactionKernelMessage::Deserialize(bodyBuffer).GetKernelHash());
+					}
+				}
+
+				receivedByPeer.push_back(std::move(received));
+			}
+
+			return receivedByPeer;
+		}
+
+		ConfigPtr pConfig;
+		SyncStatusPtr pSyncStatus;
+		std::shared_ptr<asio::io_context> pContext;
+		asio::ip::tcp::acceptor acceptor;
+		std::vector<std::unique_ptr<asio::ip::tcp::socket>> clients;
+		ConnectionManagerPtr pConnectionManager;
+	};
+}
+
+TEST_CASE("ConnectionManager - Blocks are broadcast to every peer but the source")
+{
+	BroadcastFixture fixture(5, 2);
+
+	const BlockHeaderPtr& pHeader = Genesis::FLOONET_GENESIS.GetHeader();
+	fixture.pConnectionManager->BroadcastMessage(HeaderMessage(pHeader), 1);
+
+	const std::vector<BroadcastFixture::Received> receivedByPeer = fixture.ReadUntilMarker();
+	REQUIRE(receivedByPeer.size() == 5);
+	REQUIRE(receivedByPeer[0].headers.empty());
+	for (size_t i = 1; i < receivedByPeer.size(); i++)
+	{
+		REQUIRE(receivedByPeer[i].headers == std::vector<Hash>({ pHeader->GetHash() }));
+		REQUIRE(receivedByPeer[i].kernels.empty());
+	}
+}
+
+TEST_CASE("ConnectionManager - Other messages are broadcast to a random subset of peers")
+{
+	BroadcastFixture fixture(5, 2);
+
+	// Peer 1 is the source, so each kernel goes to 2 of the other 4 peers.
+	const size_t numKernels = 40;
+	for (size_t i = 0; i < numKernels; i++)
+	{
+		fixture.pConnectionManager->BroadcastMessage(TransactionKernelMessage(Hash::ValueOf((unsigned char)i)), 1);
+	}
+
+	const std::vector<BroadcastFixture::Received> receivedByPeer = fixture.ReadUntilMarker();
+	REQUIRE(receivedByPeer.size() == 5);
+	REQUIRE(receivedByPeer[0].kernels.empty());
+
+	std::map<Hash, size_t> numRecipients;
+	for (size_t i = 1; i < receivedByPeer.size(); i++)
+	{
+		REQUIRE(receivedByPeer[i].headers.empty());
+
+		// Every peer is picked at some point, and never more than once for the same kernel.
+		const std::vector<Hash>& kernels = receivedByPeer[i].kernels;
+		REQUIRE_FALSE(kernels.empty());
+		REQUIRE(std::set<Hash>(kernels.cbegin(), kernels.cend()).size() == kernels.size());
+
+		for (const Hash& kernelHash : kernels)
+		{
+			numRecipients[kernelHash]++;
+		}
+	}
+
+	REQUIRE(numRecipients.size() == numKernels);
+	for (const auto& entry : numRecipients)
+	{
+		REQUIRE(entry.second == 2);
+	}
+}
+
+TEST_CASE("ConnectionManager - Broadcasts go to every peer when there are no more than the fan-out")
+{
+	BroadcastFixture fixture(3, 8);
+
+	const Hash kernelHash = Hash::ValueOf(1);
+	fixture.pConnectionManager->BroadcastMessage(TransactionKernelMessage(kernelHash), 2);
+
+	const std::vector<BroadcastFixture::Received> receivedByPeer = fixture.ReadUntilMarker();
+	REQUIRE(receivedByPeer.size() == 3);
+	REQUIRE(receivedByPeer[0].kernels == std::vector<Hash>({ kernelHash }));
+	REQUIRE(receivedByPeer[1].kernels.empty());
+	REQUIRE(receivedByPeer[2].kernels == std::vector<Hash>({ kernelHash }));
+}
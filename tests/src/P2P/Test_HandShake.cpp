@@ -0,0 +1,155 @@
+#include <catch.hpp>
+
+#include <TestServer.h>
+#include <P2P/Seed/HandShake.h>
+#include <P2P/Seed/Listener.h>
+#include <P2P/ConnectionManager.h>
+#include <P2P/Messages/HandMessage.h>
+#include <P2P/Messages/ShakeMessage.h>
+#include <P2P/Messages/PingMessage.h>
+#include <P2P/Messages/MessageHeader.h>
+#include <P2P/Messages/SerializedMessage.h>
+#include <chrono>
+#include <future>
+#include <thread>
+
+using namespace std::chrono;
+
+namespace
+{
+	//
+	// Accepts on loopback, and performs the async inbound handshake for each accepted socket
+	// on the single thread running the io_context, the same way the Seeder does.
+	//
+	struct HandShakeFixture
+	{
+		HandShakeFixture()
+			: pServer(TestServer::Create()),
+			pBlockChainServer(pServer, pServer->GetBlockChainServer()),
+			pConnectionManager(ConnectionManager::Create(*pServer->GetConfig())),
+			handShake(*pServer->GetConfig(), *pConnectionManager, pBlockChainServer),
+			pContext(std::make_shared<asio::io_context>()),
+			workGuard(asio::make_work_guard(*pContext))
+		{
+			pListener = Listener::Create(
+				pContext,
+				asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0),
+				ConnectionRateLimiter(10, 0),
+				[this](const std::shared_ptr<asio::ip::tcp::socket>& pSocket) {
+					ConnectedPeer connectedPeer(
+						std::make_shared<Peer>(IPAddress::CreateV4({ 127, 0, 0, 1 })),
+						EDirection::INBOUND,
+						pSocket->remote_endpoint().port()
+					);
+					handShake.PerformInboundHandshakeAsync(pSocket, connectedPeer, [this](const ConnectedPeer& peer) {
+						handshakePromise.set_value(peer);
+					});
+				}
+			);
+			thread = std::thread([this]() { pContext->run(); });
+		}
+
+		~HandShakeFixture()
+		{
+			asio::post(*pContext, [this]() { pListener->Stop(); });
+			workGuard.reset();
+			pContext->stop();
+			thread.join();
+		}
+
+		std::unique_ptr<asio::ip::tcp::socket> Connect(asio::io_context& clientContext) const
+		{
+			auto pClient = std::make_unique<asio::ip::tcp::socket>(clientContext);
+			pClient->connect(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), pListener->GetPort()));
+			return pClient;
+		}
+
+		void Send(asio::ip::tcp::socket& client, const IMessage& message) const
+		{
+			const std::vector<unsigned char> serialized = SerializedMessage::Serialize(
+				pServer->GetConfig()->GetEnvironment().GetMagicBytes(),
+				message,
+				EProtocolVersion::V2
+			);
+			asio::write(client, asio::buffer(serialized));
+		}
+
+		TestServer::Ptr pServer;
+		IBlockChainServerPtr pBlockChainServer;
+		ConnectionManagerPtr pConnectionManager;
+		HandShake handShake;
+
+		std::shared_ptr<asio::io_context> pContext;
+		asio::executor_work_guard<asio::io_context::executor_type> workGuard;
+		Listener::Ptr pListener;
+		std::thread thread;
+
+		std::promise<ConnectedPeer> handshakePromise;
+	};
+
+	HandMessage BuildHandMessage(const Config& config, const std::string& userAgent)
+	{
+		const IPAddress localHostIP = IPAddress::CreateV4({ 127, 0, 0, 1 });
+
+		return HandMessage(
+			P2P::PROTOCOL_VERSION,
+			Capabilities(Capabilities::FAST_SYNC_NODE),
+			12345,
+			Hash(config.GetEnvironment().GetGenesisHash()),
+			1000,
+			SocketAddress(localHostIP, 13414),
+			SocketAddress(localHostIP, config.GetEnvironment().GetP2PPort()),
+			userAgent
+		);
+	}
+}
+
+TEST_CASE("HandShake - Async inbound handshake")
+{
+	HandShakeFixture fixture;
+	std::future<ConnectedPeer> handshakeFuture = fixture.handshakePromise.get_future();
+
+	asio::io_context clientContext;
+	auto pClient = fixture.Connect(clientContext);
+	fixture.Send(*pClient, BuildHandMessage(*fixture.pServer->GetConfig(), "Test Peer 1.0"));
+
+	// The node answers with a shake message for the negotiated version.
+	std::vector<unsigned char> headerBytes(11);
+	asio::read(*pClient, asio::buffer(headerBytes));
+	ByteBuffer headerBuffer(std::move(headerBytes));
+	const MessageHeader header = MessageHeader::Deserialize(headerBuffer);
+	REQUIRE(header.IsValid(*fixture.pServer->GetConfig()));
+	REQUIRE(header.GetMessageType() == MessageTypes::Shake);
+
+	std::vector<unsigned char> bodyBytes(header.GetMessageLength());
+	asio::read(*pClient, asio::buffer(bodyBytes));
+	ByteBuffer bodyBuffer(std::move(bodyBytes));
+	const ShakeMessage shakeMessage = ShakeMessage::Deserialize(bodyBuffer);
+	REQUIRE(shakeMessage.GetVersion() == P2P::PROTOCOL_VERSION);
+	REQUIRE(shakeMessage.GetHash() == fixture.pServer->GetConfig()->GetEnvironment().GetGenesisHash());
+
+	// The callback only fires after the shake message was written, with the peer updated from the hand message.
+	REQUIRE(handshakeFuture.wait_for(seconds(10)) == std::future_status::ready);
+	const ConnectedPeer connectedPeer = handshakeFuture.get();
+	REQUIRE(connectedPeer.GetPeer()->GetUserAgent() == "Test Peer 1.0");
+	REQUIRE(connectedPeer.GetProtocolVersion() == P2P::PROTOCOL_VERSION);
+	REQUIRE(connectedPeer.GetTotalDifficulty() == 1000);
+}
+
+TEST_CASE("HandShake - Async inbound handshake must start with a hand message")
+{
+	HandShakeFixture fixture;
+	std::future<ConnectedPeer> handshakeFuture = fixture.handshakePromise.get_future();
+
+	asio::io_context clientContext;
+	auto pClient = fixture.Connect(clientContext);
+	fixture.Send(*pClient, PingMessage(1000, 10));
+
+	// The node closes the socket without answering.
+	std::vector<unsigned char> buffer(1);
+	asio::error_code ec;
+	asio::read(*pClient, asio::buffer(buffer), ec);
+	REQUIRE((ec == asio::error::eof || ec == asio::error::connection_reset));
+
+	REQUIRE(handshakeFuture.wait_for(milliseconds(0)) == std::future_status::timeout);
+}
@@ -0,0 +1,172 @@
+#include <catch.hpp>
+
+#include <P2P/Seed/Listener.h>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace std::chrono;
+
+namespace
+{
+	// Runs the io_context on a single thread for the lifetime of the test.
+	struct ListenerFixture
+	{
+		ListenerFixture(ConnectionRateLimiter&& rateLimiter)
+			: pContext(std::make_shared<asio::io_context>()), workGuard(asio::make_work_guard(*pContext))
+		{
+			pListener = Listener::Create(
+				pContext,
+				asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0),
+				std::move(rateLimiter),
+				[this](const std::shared_ptr<asio::ip::tcp::socket>& pSocket) {
+					std::unique_lock<std::mutex> lock(mutex);
+					handlerThreads.insert(std::this_thread::get_id());
+					handledSockets.push_back(pSocket);
+				}
+			);
+			thread = std::thread([this]() { pContext->run(); });
+		}
+
+		~ListenerFixture()
+		{
+			asio::post(*pContext, [this]() { pListener->Stop(); });
+			workGuard.reset();
+			pContext->stop();
+			thread.join();
+		}
+
+		bool WaitForConnections(const size_t numConnections, const seconds& timeout) const
+		{
+			const auto deadline = steady_clock::now() + timeout;
+			while (pListener->GetNumAccepted() + pListener->GetNumRejected() < numConnections)
+			{
+				if (steady_clock::now() > deadline)
+				{
+					return false;
+				}
+
+				std::this_thread::sleep_for(milliseconds(1));
+			}
+
+			return true;
+		}
+
+		std::shared_ptr<asio::io_context> pContext;
+		asio::executor_work_guard<asio::io_context::executor_type> workGuard;
+		Listener::Ptr pListener;
+		std::thread thread;
+
+		std::mutex mutex;
+		std::set<std::thread::id> handlerThreads;
+
+		// Kept open, like inbound connections still waiting on their handshake.
+		std::vector<std::shared_ptr<asio::ip::tcp::socket>> handledSockets;
+	};
+
+	std::vector<std::unique_ptr<asio::ip::tcp::socket>> OpenConnections(asio::io_context& clientContext, const uint16_t port, const size_t numConnections)
+	{
+		const asio::ip::tcp::endpoint endpoint(asio::ip::address_v4::loopback(), port);
+
+		std::vector<std::unique_ptr<asio::ip::tcp::socket>> clients;
+		for (size_t i = 0; i < numConnections; i++)
+		{
+			auto pClient = std::make_unique<asio::ip::tcp::socket>(clientContext);
+			pClient->connect(endpoint);
+			clients.push_back(std::move(pClient));
+		}
+
+		return clients;
+	}
+}
+
+TEST_CASE("Listener - Accepts while earlier connections are still pending")
+{
+	const size_t numConnections = 500;
+	ListenerFixture fixture(ConnectionRateLimiter(numConnections, 0));
+
+	// None of the clients ever sends a handshake, and every connection stays open on both ends,
+	// so each accept must go ahead without waiting on the connections before it.
+	asio::io_context clientContext;
+	auto clients = OpenConnections(clientContext, fixture.pListener->GetPort(), numConnections);
+	REQUIRE(fixture.WaitForConnections(numConnections, seconds(30)));
+
+	REQUIRE(fixture.pListener->GetNumAccepted() == numConnections);
+	REQUIRE(fixture.pListener->GetNumRejected() == 0);
+
+	// Every connection was accepted on the single io_context thread, rather than a thread per connection.
+	std::unique_lock<std::mutex> lock(fixture.mutex);
+	REQUIRE(fixture.handledSockets.size() == numConnections);
+	for (const auto& pSocket : fixture.handledSockets)
+	{
+		REQUIRE(pSocket->is_open());
+	}
+
+	REQUIRE(fixture.handlerThreads.size() == 1);
+	REQUIRE(*fixture.handlerThreads.begin() == fixture.thread.get_id());
+}
+
+TEST_CASE("Listener - Per-IP token bucket")
+{
+	// Burst of 10, and no refill during the test.
+	ListenerFixture fixture(ConnectionRateLimiter(10, 0));
+
+	asio::io_context clientContext;
+	auto clients = OpenConnections(clientContext, fixture.pListener->GetPort(), 50);
+	REQUIRE(fixture.WaitForConnections(50, seconds(30)));
+
+	REQUIRE(fixture.pListener->GetNumAccepted() == 10);
+	REQUIRE(fixture.pListener->GetNumRejected() == 40);
+}
+
+TEST_CASE("ConnectionRateLimiter")
+{
+	using Clock = ConnectionRateLimiter::Clock;
+
+	const IPAddress address1 = IPAddress::CreateV4({ 10, 0, 0, 1 });
+	const IPAddress address2 = IPAddress::CreateV4({ 10, 0, 0, 2 });
+	const Clock::time_point start = Clock::now();
+
+	ConnectionRateLimiter limiter(3, 6); // 1 token every 10 seconds
+	REQUIRE(limiter.TryAcquire(address1, start));
+	REQUIRE(limiter.TryAcquire(address1, start));
+	REQUIRE(limiter.TryAcquire(address1, start));
+	REQUIRE_FALSE(limiter.TryAcquire(address1, start + seconds(5)));
+
+	// Other IPs have their own bucket.
+	REQUIRE(limiter.TryAcquire(address2, start + seconds(5)));
+
+	REQUIRE(limiter.TryAcquire(address1, start + seconds(15)));
+	REQUIRE_FALSE(limiter.TryAcquire(address1, start + seconds(16)));
+
+	// Buckets refill up to the burst size only.
+	REQUIRE(limiter.TryAcquire(address1, start + seconds(1000)));
+	REQUIRE(limiter.TryAcquire(address1, start + seconds(1000)));
+	REQUIRE(limiter.TryAcquire(address1, start + seconds(1000)));
+	REQUIRE_FALSE(limiter.TryAcquire(address1, start + seconds(1000)));
+}
+
+TEST_CASE("ConnectionRateLimiter - Tracked addresses are bounded")
+{
+	using Clock = ConnectionRateLimiter::Clock;
+
+	const Clock::time_point start = Clock::now();
+	ConnectionRateLimiter limiter(1, 0, 100);
+
+	// Every address spends its only token, so none of their buckets would ever be pruned as full.
+	for (uint8_t i = 0; i < 250; i++)
+	{
+		REQUIRE(limiter.TryAcquire(IPAddress::CreateV4({ 10, 0, 1, i }), start));
+		REQUIRE(limiter.GetNumTrackedAddresses() <= 100);
+	}
+
+	REQUIRE(limiter.GetNumTrackedAddresses() == 100);
+
+	// The most recently used addresses are still tracked.
+	REQUIRE_FALSE(limiter.TryAcquire(IPAddress::CreateV4({ 10, 0, 1, 249 }), start));
+
+	// The least recently used was forgotten, so it starts over with a full bucket.
+	REQUIRE(limiter.TryAcquire(IPAddress::CreateV4({ 10, 0, 1, 0 }), start));
+	REQUIRE(limiter.GetNumTrackedAddresses() == 100);
+}
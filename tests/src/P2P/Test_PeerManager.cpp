@@ -0,0 +1,128 @@
+#include <catch.hpp>
+
+#include <TestHelper.h>
+#include <P2P/Seed/PeerManager.h>
+#include <Common/Util/TimeUtil.h>
+#include <set>
+
+class MockPeerDB : public IPeerDB
+{
+public:
+	MockPeerDB(const std::vector<PeerPtr>& peers) : m_peers(peers) { }
+
+	std::vector<PeerPtr> LoadAllPeers() const final { return m_peers; }
+	std::optional<PeerPtr> GetPeer(const IPAddress&, const std::optional<uint16_t>&) const final { return std::nullopt; }
+	void SavePeers(const std::vector<PeerPtr>&) final { }
+	void DeletePeers(const std::vector<PeerPtr>&) final { }
+
+	void Commit() final { }
+	void Rollback() noexcept final { }
+
+private:
+	std::vector<PeerPtr> m_peers;
+};
+
+static IPAddress SyntheticAddress(const size_t i)
+{
+	return IPAddress::CreateV4({ 10, (uint8_t)(i >> 16), (uint8_t)(i >> 8), (uint8_t)i });
+}
+
+TEST_CASE("PeerManager - Selection with 100k peers")
+{
+	const size_t numPeers = 100'000;
+	const time_t now = TimeUtil::Now();
+	const Capabilities::ECapability capabilities[] = {
+		Capabilities::FAST_SYNC_NODE,
+		Capabilities::ARCHIVE_NODE,
+		Capabilities::PEER_LIST,
+		Capabilities::UNKNOWN
+	};
+
+	// Every 10th peer is banned, and every 7th peer is already connected.
+	std::vector<PeerPtr> peers;
+	std::set<IPAddress> connectable;
+	std::set<IPAddress> connectableFastSync;
+	for (size_t i = 0; i < numPeers; i++)
+	{
+		const bool banned = (i % 10 == 0);
+		PeerPtr pPeer = std::make_shared<Peer>(
+			SyntheticAddress(i),
+			2,
+			Capabilities(capabilities[i % 4]),
+			"synthetic",
+			now,
+			banned ? now : 0,
+			banned ? EBanReason::BadBlock : EBanReason::None
+		);
+
+		if (i % 7 == 0)
+		{
+			pPeer->SetConnected(true);
+		}
+		else if (!banned)
+		{
+			connectable.insert(pPeer->GetIPAddress());
+			if (pPeer->GetCapabilities().HasCapability(Capabilities::FAST_SYNC_NODE))
+			{
+				connectableFastSync.insert(pPeer->GetIPAddress());
+			}
+		}
+
+		peers.push_back(pPeer);
+	}
+
+	auto pContext = std::make_shared<Context>(TestHelper::GetTestConfig(), std::make_shared<Bosma::Scheduler>(1), nullptr);
+	auto pPeerDB = std::make_shared<Locked<IPeerDB>>(std::make_shared<MockPeerDB>(peers));
+	auto pLockedPeerManager = PeerManager::Create(pContext, pPeerDB);
+	auto pPeerManager = pLockedPeerManager->Write();
+
+	REQUIRE_FALSE(pPeerManager->ArePeersNeeded(Capabilities::FAST_SYNC_NODE));
+
+	// Peers with the preferred capability are handed out first, and no peer is handed out twice within the retry window.
+	std::set<IPAddress> selected;
+	while (true)
+	{
+		PeerPtr pPeer = pPeerManager->GetNewPeer(Capabilities::FAST_SYNC_NODE);
+		if (pPeer == nullptr)
+		{
+			break;
+		}
+
+		REQUIRE(connectable.count(pPeer->GetIPAddress()) == 1);
+		REQUIRE(selected.insert(pPeer->GetIPAddress()).second);
+		if (selected.size() <= connectableFastSync.size())
+		{
+			REQUIRE(connectableFastSync.count(pPeer->GetIPAddress()) == 1);
+		}
+	}
+
+	REQUIRE(selected == connectable);
+	REQUIRE(pPeerManager->ArePeersNeeded(Capabilities::FAST_SYNC_NODE));
+
+	// Once every peer is waiting out its retry window, none are handed out.
+	for (size_t i = 0; i < 10'000; i++)
+	{
+		REQUIRE(pPeerManager->GetNewPeer(Capabilities::FAST_SYNC_NODE) == nullptr);
+	}
+
+	// Unbanned peers are connectable again right away.
+	const IPAddress bannedAddress = SyntheticAddress(10);
+	REQUIRE(connectable.count(bannedAddress) == 0);
+	pPeerManager->UnbanPeer(bannedAddress);
+	PeerPtr pUnbanned = pPeerManager->GetNewPeer(Capabilities::PEER_LIST);
+	REQUIRE(pUnbanned != nullptr);
+	REQUIRE(pUnbanned->GetIPAddress() == bannedAddress);
+
+	// Peer lists are random samples of peers with the requested capability, banned or not.
+	const std::vector<PeerPtr> peerList = pPeerManager->GetPeers(Capabilities::PEER_LIST, 256);
+	REQUIRE(peerList.size() == 256);
+
+	std::set<IPAddress> uniqueAddresses;
+	for (const PeerPtr& pPeer : peerList)
+	{
+		REQUIRE(pPeer->GetCapabilities().HasCapability(Capabilities::PEER_LIST));
+		uniqueAddresses.insert(pPeer->GetIPAddress());
+	}
+
+	REQUIRE(uniqueAddresses.size() == 256);
+}
@@ -0,0 +1,68 @@
+#include <catch.hpp>
+
+#include <P2P/Messages/SerializedMessage.h>
+#include <P2P/Messages/PingMessage.h>
+#include <atomic>
+#include <thread>
+
+//
+// Wraps a PingMessage, counting how many times it gets serialized.
+//
+class CountingMessage : public IMessage
+{
+public:
+	CountingMessage(std::atomic<size_t>& numSerializations)
+		: m_numSerializations(numSerializations), m_ping(1000, 50) { }
+
+	IMessagePtr Clone() const final { return IMessagePtr(new CountingMessage(*this)); }
+	MessageTypes::EMessageType GetMessageType() const final { return m_ping.GetMessageType(); }
+
+	void SerializeBody(Serializer& serializer) const final
+	{
+		++m_numSerializations;
+		static_cast<const IMessage&>(m_ping).SerializeBody(serializer);
+	}
+
+private:
+	std::atomic<size_t>& m_numSerializations;
+	PingMessage m_ping;
+};
+
+TEST_CASE("SerializedMessage - Serializes once per broadcast")
+{
+	const std::vector<uint8_t> magicBytes{ 97, 61 };
+	std::atomic<size_t> numSerializations = 0;
+
+	const CountingMessage message(numSerializations);
+	const SerializedMessage::Ptr pBroadcast = std::make_shared<const SerializedMessage>(message.Clone());
+
+	// Simulate 100 peers, each sending from its own connection thread.
+	std::vector<std::shared_ptr<const std::vector<unsigned char>>> sent(100);
+	std::vector<std::thread> peers;
+	for (size_t i = 0; i < sent.size(); i++)
+	{
+		peers.emplace_back([&sent, &magicBytes, pBroadcast, i]() {
+			sent[i] = pBroadcast->GetBytes(magicBytes, EProtocolVersion::V1);
+		});
+	}
+
+	for (std::thread& peer : peers)
+	{
+		peer.join();
+	}
+
+	REQUIRE(numSerializations == 1);
+	for (const auto& pBytes : sent)
+	{
+		REQUIRE(pBytes == sent.front());
+	}
+
+	const std::vector<unsigned char> expected = SerializedMessage::Serialize(magicBytes, message, EProtocolVersion::V1);
+	REQUIRE(*sent.front() == expected);
+	numSerializations = 0;
+
+	// Peers using a different protocol version get their own (single) serialization.
+	pBroadcast->GetBytes(magicBytes, EProtocolVersion::V2);
+	pBroadcast->GetBytes(magicBytes, EProtocolVersion::V2);
+	REQUIRE(numSerializations == 1);
+}
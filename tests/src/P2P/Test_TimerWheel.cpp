@@ -0,0 +1,104 @@
+#include <catch.hpp>
+
+#include <Common/TimerWheel.h>
+#include <chrono>
+#include <random>
+#include <unordered_map>
+
+using namespace std::chrono;
+
+TEST_CASE("TimerWheel - Schedule & Advance")
+{
+	const system_clock::time_point start(seconds(1'600'000'000));
+	TimerWheel<int> wheel(start, 8);
+
+	REQUIRE_FALSE(wheel.GetNextDeadline().has_value());
+
+	wheel.Schedule(start + seconds(3), 3);
+	wheel.Schedule(start + milliseconds(1500), 2);	// Rounded up to start + 2s
+	wheel.Schedule(start + seconds(20), 20);		// More than one rotation away
+	wheel.Schedule(start - seconds(5), 0);			// Already due
+	REQUIRE(wheel.Size() == 4);
+	REQUIRE(wheel.GetNextDeadline() == start);
+
+	REQUIRE(wheel.Advance(start) == std::vector<int>{ 0 });
+	REQUIRE(wheel.Advance(start + milliseconds(1999)).empty());
+	REQUIRE(wheel.GetNextDeadline() == start + seconds(2));
+	REQUIRE(wheel.Advance(start + seconds(10)) == std::vector<int>{ 2, 3 });
+	REQUIRE(wheel.GetNextDeadline() == start + seconds(20));
+
+	// Jumping ahead more than a full rotation visits each slot only once.
+	REQUIRE(wheel.Advance(start + seconds(100)) == std::vector<int>{ 20 });
+	REQUIRE(wheel.GetNumVisited() == 1);
+	REQUIRE(wheel.IsEmpty());
+}
+
+//
+// Simulates a busy stempool: thousands of stem txs arriving over time, each with its own
+// patience & embargo deadline, while the clock is advanced 1 second at a time.
+// The work done on each tick must match the number of timers that were actually due, regardless of the pool size.
+//
+TEST_CASE("TimerWheel - Dandelion stempool with simulated clock")
+{
+	const seconds patience(10);
+	const seconds embargo(180);
+	const size_t txsPerSecond = 50;
+	const size_t numSeconds = 300;
+
+	const system_clock::time_point start(seconds(1'600'000'000));
+	TimerWheel<uint64_t> patienceTimers(start);
+	TimerWheel<uint64_t> embargoTimers(start);
+
+	std::unordered_map<uint64_t, system_clock::time_point> embargoDeadlines;
+	size_t maxPoolSize = 0;
+	size_t numExpired = 0;
+	uint64_t nextTxId = 0;
+
+	std::mt19937 rng(12345);
+	std::uniform_int_distribution<int> receivedMs(1, 999);
+	std::uniform_int_distribution<int> embargoJitter(0, 30);
+
+	for (size_t second = 1; second <= numSeconds; second++)
+	{
+		const system_clock::time_point now = start + seconds(second);
+
+		// New stem txs arrive at random points during the previous second.
+		for (size_t i = 0; i < txsPerSecond; i++)
+		{
+			const system_clock::time_point received = now - milliseconds(receivedMs(rng));
+			const system_clock::time_point embargoDeadline = received + embargo + seconds(embargoJitter(rng));
+
+			patienceTimers.Schedule(received + patience, nextTxId);
+			embargoTimers.Schedule(embargoDeadline, nextTxId);
+			embargoDeadlines[nextTxId] = embargoDeadline;
+			++nextTxId;
+		}
+
+		maxPoolSize = (std::max)(maxPoolSize, embargoTimers.Size());
+
+		const std::vector<uint64_t> duePatience = patienceTimers.Advance(now);
+		REQUIRE(patienceTimers.GetNumVisited() == duePatience.size());
+
+		// Txs received during a single second all share the same (rounded) patience deadline.
+		REQUIRE(duePatience.size() == (second > (size_t)patience.count() ? txsPerSecond : 0));
+
+		const std::vector<uint64_t> dueEmbargo = embargoTimers.Advance(now);
+		REQUIRE(embargoTimers.GetNumVisited() == dueEmbargo.size());
+		for (const uint64_t txId : dueEmbargo)
+		{
+			// Never fired early, and never more than one tick late.
+			REQUIRE(embargoDeadlines.at(txId) <= now);
+			REQUIRE(now - embargoDeadlines.at(txId) < seconds(1));
+			embargoDeadlines.erase(txId);
+		}
+
+		numExpired += dueEmbargo.size();
+	}
+
+	REQUIRE(maxPoolSize >= 9000);
+	REQUIRE(numExpired + embargoTimers.Size() == nextTxId);
+
+	// Every tx left has an embargo deadline still in the future.
+	REQUIRE(embargoTimers.GetNextDeadline() > start + seconds(numSeconds));
+	REQUIRE(embargoDeadlines.size() == embargoTimers.Size());
+}
@@ -0,0 +1,124 @@
+#include <catch.hpp>
+
+#include <TestFileUtil.h>
+#include <PMMR/Common/PruneableMMR.h>
+#include <PMMR/Common/MMRPeaks.h>
+#include <Core/Models/OutputIdentifier.h>
+#include <random>
+
+namespace
+{
+	using TestPMMR = PruneableMMR<34, OutputIdentifier>;
+
+	OutputIdentifier RandomOutput(std::mt19937& rng)
+	{
+		std::vector<unsigned char> bytes(33);
+		for (unsigned char& byte : bytes)
+		{
+			byte = (unsigned char)rng();
+		}
+
+		return OutputIdentifier(EOutputFeatures::DEFAULT, Commitment(CBigInteger<33>(std::move(bytes))));
+	}
+
+	// Rebuilds the MMR from its leaves with the original hash file based AddHashes, and computes the root by reading the peaks back.
+	Hash RootFromScratch(const fs::path& path, const std::vector<OutputIdentifier>& leaves)
+	{
+		std::shared_ptr<HashFile> pHashFile = HashFile::Load(path);
+		pHashFile->Rewind(0);
+
+		for (const OutputIdentifier& leaf : leaves)
+		{
+			Serializer serializer;
+			leaf.Serialize(serializer);
+			MMRHashUtil::AddHashes(pHashFile, serializer.GetBytes(), nullptr);
+		}
+
+		return MMRHashUtil::Root(pHashFile, pHashFile->GetSize(), nullptr);
+	}
+}
+
+TEST_CASE("MMRPeaks - Cached roots match from-scratch roots after random appends and rewinds")
+{
+	TemporaryFile::Ptr pDir = TestFileUtil::CreateTempFile();
+	fs::create_directories(pDir->GetPath());
+
+	std::shared_ptr<HashFile> pHashFile = HashFile::Load(pDir->GetPath() / "pmmr_hash.bin");
+	TestPMMR mmr(
+		pHashFile,
+		LeafSet::Load(pDir->GetPath() / "pmmr_leafset.bin"),
+		PruneList::Load(pDir->GetPath() / "pmmr_prun.bin"),
+		DataFile<34>::Load(pDir->GetPath() / "pmmr_data.bin")
+	);
+
+	std::mt19937 rng(42);
+	std::vector<OutputIdentifier> leaves;
+	std::vector<OutputIdentifier> committedLeaves;
+
+	for (size_t round = 0; round < 200; round++)
+	{
+		const uint32_t action = rng() % 10;
+		if (action < 6)
+		{
+			const size_t numToAppend = 1 + (rng() % 20);
+			for (size_t i = 0; i < numToAppend; i++)
+			{
+				leaves.push_back(RandomOutput(rng));
+				mmr.Append(leaves.back());
+			}
+		}
+		else if (action < 8 && !leaves.empty())
+		{
+			const size_t numLeaves = rng() % (leaves.size() + 1);
+			leaves.resize(numLeaves);
+			mmr.Rewind(numLeaves == 0 ? 0 : MMRUtil::GetNumNodes(MMRUtil::GetPMMRIndex(numLeaves - 1)), {});
+		}
+		else if (action == 8)
+		{
+			mmr.Commit();
+			committedLeaves = leaves;
+		}
+		else
+		{
+			mmr.Rollback();
+			leaves = committedLeaves;
+		}
+
+		const uint64_t size = mmr.GetSize();
+		REQUIRE(size == (leaves.empty() ? 0 : MMRUtil::GetNumNodes(MMRUtil::GetPMMRIndex(leaves.size() - 1))));
+
+		const Hash expected = RootFromScratch(pDir->GetPath() / "scratch_hash.bin", leaves);
+		REQUIRE(mmr.Root(size) == expected);
+		REQUIRE(MMRHashUtil::Root(pHashFile, size, nullptr) == expected);
+		REQUIRE(MMRPeaks::Load(pHashFile, size, nullptr).Root() == expected);
+	}
+}
+
+TEST_CASE("MMRPeaks - Root at earlier sizes still reads the hash file")
+{
+	TemporaryFile::Ptr pDir = TestFileUtil::CreateTempFile();
+	fs::create_directories(pDir->GetPath());
+
+	std::shared_ptr<HashFile> pHashFile = HashFile::Load(pDir->GetPath() / "pmmr_hash.bin");
+	TestPMMR mmr(
+		pHashFile,
+		LeafSet::Load(pDir->GetPath() / "pmmr_leafset.bin"),
+		PruneList::Load(pDir->GetPath() / "pmmr_prun.bin"),
+		DataFile<34>::Load(pDir->GetPath() / "pmmr_data.bin")
+	);
+
+	std::mt19937 rng(7);
+	std::vector<OutputIdentifier> leaves;
+	for (size_t i = 0; i < 50; i++)
+	{
+		leaves.push_back(RandomOutput(rng));
+		mmr.Append(leaves.back());
+	}
+
+	for (size_t numLeaves = 1; numLeaves <= leaves.size(); numLeaves++)
+	{
+		const uint64_t size = MMRUtil::GetNumNodes(MMRUtil::GetPMMRIndex(numLeaves - 1));
+		const std::vector<OutputIdentifier> prefix(leaves.cbegin(), leaves.cbegin() + numLeaves);
+		REQUIRE(mmr.Root(size) == RootFromScratch(pDir->GetPath() / "scratch_hash.bin", prefix));
+	}
+}
@@ -0,0 +1,48 @@
+#include <catch.hpp>
+
+#include <TestServer.h>
+#include <PMMR/TxHashSetManager.h>
+#include <PMMR/Zip/Zipper.h>
+#include <P2P/SyncStatus.h>
+#include <Core/Exceptions/FileException.h>
+
+namespace
+{
+	void AddEntry(zipFile zf, const std::string& entryName, const std::vector<uint8_t>& contents)
+	{
+		zip_fileinfo zfi{};
+		REQUIRE(zipOpenNewFileInZip(zf, entryName.c_str(), &zfi, nullptr, 0, nullptr, 0, nullptr, Z_DEFLATED, Z_DEFAULT_COMPRESSION) == ZIP_OK);
+		REQUIRE(zipWriteInFileInZip(zf, contents.data(), (unsigned int)contents.size()) == ZIP_OK);
+		REQUIRE(zipCloseFileInZip(zf) == ZIP_OK);
+	}
+}
+
+TEST_CASE("TxHashSetReceiver - Repeated entries are rejected")
+{
+	TestServer::Ptr pServer = TestServer::Create();
+	SyncStatus syncStatus;
+
+	// A second copy of a kernel file must not be able to replace the first, which may already be validated.
+	const fs::path zipPath = pServer->GenerateTempDir() / "duplicate.zip";
+	{
+		zipFile zf = zipOpen(zipPath.u8string().c_str(), APPEND_STATUS_CREATE);
+		REQUIRE(zf != nullptr);
+
+		AddEntry(zf, "kernel/pmmr_data.bin", std::vector<uint8_t>(100, 1));
+		AddEntry(zf, "kernel\\pmmr_data.bin", std::vector<uint8_t>(100, 2));
+
+		REQUIRE(zipClose(zf, nullptr) == ZIP_OK);
+	}
+
+	std::vector<uint8_t> archive;
+	REQUIRE(FileUtil::ReadFile(zipPath, archive));
+
+	ITxHashSetReceiverPtr pReceiver = TxHashSetManager::CreateReceiver(
+		*pServer->GetConfig(),
+		pServer->GetGenesisHeader(),
+		*pServer->GetBlockChainServer(),
+		syncStatus
+	);
+	REQUIRE_THROWS_AS(pReceiver->Receive(archive.data(), archive.size()), FileException);
+	REQUIRE_FALSE(pReceiver->IsComplete());
+}
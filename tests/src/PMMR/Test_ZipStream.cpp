@@ -0,0 +1,170 @@
+#include <catch.hpp>
+
+#include <TestFileUtil.h>
+#include <PMMR/Zip/ZipStream.h>
+#include <PMMR/Zip/ZipFile.h>
+#include <PMMR/Zip/Zipper.h>
+#include <Core/Exceptions/FileException.h>
+#include <map>
+#include <random>
+#include <set>
+
+namespace
+{
+	const std::vector<std::string> ENTRY_NAMES = {
+		"kernel/pmmr_data.bin",
+		"kernel/pmmr_hash.bin",
+		"output/pmmr_data.bin",
+		"output/pmmr_prun.bin",
+		"rangeproof/pmmr_data.bin"
+	};
+
+	std::vector<uint8_t> GenerateContents(std::mt19937& rng, const size_t size)
+	{
+		// Half random, half repeated, so deflate has something to compress.
+		std::vector<uint8_t> contents(size);
+		for (size_t i = 0; i < size; i++)
+		{
+			contents[i] = (i < size / 2) ? (uint8_t)rng() : (uint8_t)(i % 7);
+		}
+
+		return contents;
+	}
+
+	std::map<std::string, std::vector<uint8_t>> WriteSourceFiles(const fs::path& dir)
+	{
+		std::mt19937 rng(42);
+		const std::vector<size_t> sizes = { 1'000'000, 65, 0, 300'000, 1 };
+
+		std::map<std::string, std::vector<uint8_t>> files;
+		for (size_t i = 0; i < ENTRY_NAMES.size(); i++)
+		{
+			files[ENTRY_NAMES[i]] = GenerateContents(rng, sizes[i]);
+
+			fs::create_directories((dir / ENTRY_NAMES[i]).parent_path());
+			FileUtil::SafeWriteToFile(dir / ENTRY_NAMES[i], files[ENTRY_NAMES[i]]);
+		}
+
+		return files;
+	}
+
+	void CreateDeflatedZip(const fs::path& destination, const std::map<std::string, std::vector<uint8_t>>& files)
+	{
+		zipFile zf = zipOpen(destination.u8string().c_str(), APPEND_STATUS_CREATE);
+		REQUIRE(zf != nullptr);
+
+		for (const auto& file : files)
+		{
+			zip_fileinfo zfi{};
+			REQUIRE(zipOpenNewFileInZip(zf, file.first.c_str(), &zfi, nullptr, 0, nullptr, 0, nullptr, Z_DEFLATED, Z_DEFAULT_COMPRESSION) == ZIP_OK);
+			REQUIRE(zipWriteInFileInZip(zf, file.second.data(), (unsigned int)file.second.size()) == ZIP_OK);
+			REQUIRE(zipCloseFileInZip(zf) == ZIP_OK);
+		}
+
+		REQUIRE(zipClose(zf, nullptr) == ZIP_OK);
+	}
+
+	// Feeds the archive to a ZipStream in uneven chunks, like they'd arrive from a socket.
+	std::vector<std::string> StreamArchive(const fs::path& zipPath, const fs::path& destDir)
+	{
+		std::vector<uint8_t> archive;
+		REQUIRE(FileUtil::ReadFile(zipPath, archive));
+
+		std::vector<std::string> extracted;
+		ZipStream stream(
+			[&destDir](const std::string& entryName) -> std::optional<fs::path> {
+				const fs::path destination = destDir / entryName;
+				fs::create_directories(destination.parent_path());
+				return destination;
+			},
+			[&extracted](const std::string& entryName) { extracted.push_back(entryName); }
+		);
+
+		const std::vector<size_t> chunkSizes = { 1, 3, 29, 4096, 256 * 1024 };
+		size_t offset = 0;
+		for (size_t i = 0; offset < archive.size(); i++)
+		{
+			REQUIRE_FALSE(stream.IsComplete());
+
+			const size_t chunkSize = (std::min)(chunkSizes[i % chunkSizes.size()], archive.size() - offset);
+			stream.Write(archive.data() + offset, chunkSize);
+			offset += chunkSize;
+		}
+
+		REQUIRE(stream.IsComplete());
+		return extracted;
+	}
+
+	void RequireExtracted(const fs::path& dir, const std::map<std::string, std::vector<uint8_t>>& files)
+	{
+		for (const auto& file : files)
+		{
+			std::vector<uint8_t> contents;
+			REQUIRE(FileUtil::ReadFile(dir / file.first, contents));
+			REQUIRE(contents == file.second);
+		}
+	}
+}
+
+TEST_CASE("ZipStream - Stored entries match ZipFile extraction")
+{
+	TemporaryFile::Ptr pWorkDir = TestFileUtil::CreateTempFile();
+	const fs::path sourceDir = pWorkDir->GetPath() / "source";
+	const auto files = WriteSourceFiles(sourceDir);
+
+	const fs::path zipPath = pWorkDir->GetPath() / "stored.zip";
+	Zipper::CreateZipFile(zipPath, { sourceDir / "kernel", sourceDir / "output", sourceDir / "rangeproof" });
+
+	// Serial path
+	const fs::path serialDir = pWorkDir->GetPath() / "serial";
+	{
+		std::shared_ptr<ZipFile> pZipFile = ZipFile::Load(zipPath);
+		for (const std::string& entryName : ENTRY_NAMES)
+		{
+			fs::create_directories((serialDir / entryName).parent_path());
+			pZipFile->ExtractFile(entryName, serialDir / entryName);
+		}
+	}
+
+	// Streaming path
+	const fs::path streamedDir = pWorkDir->GetPath() / "streamed";
+	const std::vector<std::string> extracted = StreamArchive(zipPath, streamedDir);
+
+	REQUIRE(std::set<std::string>(extracted.begin(), extracted.end()) == std::set<std::string>(ENTRY_NAMES.begin(), ENTRY_NAMES.end()));
+	RequireExtracted(serialDir, files);
+	RequireExtracted(streamedDir, files);
+}
+
+TEST_CASE("ZipStream - Deflated entries")
+{
+	TemporaryFile::Ptr pWorkDir = TestFileUtil::CreateTempFile();
+	const auto files = WriteSourceFiles(pWorkDir->GetPath() / "source");
+
+	const fs::path zipPath = pWorkDir->GetPath() / "deflated.zip";
+	CreateDeflatedZip(zipPath, files);
+
+	const fs::path streamedDir = pWorkDir->GetPath() / "streamed";
+	const std::vector<std::string> extracted = StreamArchive(zipPath, streamedDir);
+
+	REQUIRE(extracted.size() == files.size());
+	RequireExtracted(streamedDir, files);
+}
+
+TEST_CASE("ZipStream - Corrupt data")
+{
+	TemporaryFile::Ptr pWorkDir = TestFileUtil::CreateTempFile();
+	const auto files = WriteSourceFiles(pWorkDir->GetPath() / "source");
+
+	const fs::path zipPath = pWorkDir->GetPath() / "corrupt.zip";
+	CreateDeflatedZip(zipPath, files);
+
+	std::vector<uint8_t> archive;
+	REQUIRE(FileUtil::ReadFile(zipPath, archive));
+	archive[archive.size() / 2] ^= 0xFF;
+
+	ZipStream stream(
+		[](const std::string&) -> std::optional<fs::path> { return std::nullopt; },
+		[](const std::string&) { }
+	);
+	REQUIRE_THROWS_AS(stream.Write(archive.data(), archive.size()), FileException);
+}
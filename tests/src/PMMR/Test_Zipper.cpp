@@ -0,0 +1,149 @@
+#include <catch.hpp>
+
+#include <TestFileUtil.h>
+#include <PMMR/Zip/ZipFile.h>
+#include <PMMR/Zip/ZipStream.h>
+#include <PMMR/Zip/Zipper.h>
+#include <map>
+#include <random>
+
+namespace
+{
+	using TxHashSetFiles = std::map<std::string, std::vector<uint8_t>>;
+
+	// Builds a directory shaped like a TxHashSet, with random hash/rangeproof data,
+	// compressible leafset and prune list files, and an empty file.
+	TxHashSetFiles WriteTxHashSet(const fs::path& txHashSetDir)
+	{
+		std::mt19937 rng(1234);
+		auto randomBytes = [&rng](const size_t size) {
+			std::vector<uint8_t> bytes(size);
+			for (uint8_t& byte : bytes)
+			{
+				byte = (uint8_t)rng();
+			}
+
+			return bytes;
+		};
+
+		auto sparseBytes = [&rng](const size_t size) {
+			std::vector<uint8_t> bytes(size, 0);
+			for (size_t i = 0; i < size; i += 97)
+			{
+				bytes[i] = (uint8_t)rng();
+			}
+
+			return bytes;
+		};
+
+		TxHashSetFiles files;
+		files["kernel/pmmr_data.bin"] = randomBytes(114 * 2'000);
+		files["kernel/pmmr_hash.bin"] = randomBytes(32 * 4'000);
+		files["output/pmmr_data.bin"] = randomBytes(34 * 5'000);
+		files["output/pmmr_hash.bin"] = randomBytes(32 * 10'000);
+		files["output/pmmr_prun.bin"] = {};
+		files["output/pmmr_leaf.bin.abcdef"] = sparseBytes(3'000'000);
+		files["rangeproof/pmmr_data.bin"] = randomBytes(683 * 5'000);
+		files["rangeproof/pmmr_hash.bin"] = randomBytes(32 * 10'000);
+		files["rangeproof/pmmr_prun.bin"] = sparseBytes(800);
+		files["rangeproof/pmmr_leaf.bin.abcdef"] = sparseBytes(3'000'000);
+
+		for (const auto& file : files)
+		{
+			fs::create_directories((txHashSetDir / file.first).parent_path());
+			FileUtil::SafeWriteToFile(txHashSetDir / file.first, file.second);
+		}
+
+		return files;
+	}
+
+	void RequireExtracted(const fs::path& dir, const TxHashSetFiles& files)
+	{
+		for (const auto& file : files)
+		{
+			std::vector<uint8_t> contents;
+			REQUIRE(FileUtil::ReadFile(dir / file.first, contents));
+			REQUIRE(fs::file_size(dir / file.first) == file.second.size());
+			REQUIRE(contents == file.second);
+		}
+	}
+}
+
+TEST_CASE("Zipper - Parallel round trip matches serial extraction")
+{
+	TemporaryFile::Ptr pWorkDir = TestFileUtil::CreateTempFile();
+	const fs::path txHashSetDir = pWorkDir->GetPath() / "txhashset";
+	const TxHashSetFiles files = WriteTxHashSet(txHashSetDir);
+
+	const fs::path zipPath = pWorkDir->GetPath() / "txhashset.zip";
+	Zipper::CreateZipFile(zipPath, { txHashSetDir / "kernel", txHashSetDir / "output", txHashSetDir / "rangeproof" });
+
+	// The compressible files should actually be compressed.
+	uint64_t totalSize = 0;
+	for (const auto& file : files)
+	{
+		totalSize += file.second.size();
+	}
+	REQUIRE(fs::file_size(zipPath) < totalSize);
+
+	std::shared_ptr<ZipFile> pZipFile = ZipFile::Load(zipPath);
+	const std::vector<std::string> entries = pZipFile->ListFiles();
+	REQUIRE(entries.size() == files.size());
+	REQUIRE(entries.front().rfind("kernel", 0) == 0);
+
+	// Serial path
+	const fs::path serialDir = pWorkDir->GetPath() / "serial";
+	for (const std::string& entry : entries)
+	{
+		fs::create_directories((serialDir / entry).parent_path());
+		pZipFile->ExtractFile(entry, serialDir / entry);
+	}
+
+	// Parallel path
+	const fs::path parallelDir = pWorkDir->GetPath() / "parallel";
+	std::vector<std::pair<std::string, fs::path>> toExtract;
+	for (const std::string& entry : entries)
+	{
+		fs::create_directories((parallelDir / entry).parent_path());
+		toExtract.push_back({ entry, parallelDir / entry });
+	}
+	pZipFile->ExtractFiles(toExtract);
+
+	RequireExtracted(serialDir, files);
+	RequireExtracted(parallelDir, files);
+
+	// Streaming path
+	std::vector<uint8_t> archive;
+	REQUIRE(FileUtil::ReadFile(zipPath, archive));
+
+	const fs::path streamedDir = pWorkDir->GetPath() / "streamed";
+	ZipStream stream(
+		[&streamedDir](const std::string& entryName) -> std::optional<fs::path> {
+			fs::create_directories((streamedDir / entryName).parent_path());
+			return streamedDir / entryName;
+		},
+		[](const std::string&) { }
+	);
+	stream.Write(archive.data(), archive.size());
+	REQUIRE(stream.IsComplete());
+	RequireExtracted(streamedDir, files);
+}
+
+TEST_CASE("Zipper - Missing entry fails parallel extraction")
+{
+	TemporaryFile::Ptr pWorkDir = TestFileUtil::CreateTempFile();
+	const fs::path txHashSetDir = pWorkDir->GetPath() / "txhashset";
+	WriteTxHashSet(txHashSetDir);
+
+	const fs::path zipPath = pWorkDir->GetPath() / "txhashset.zip";
+	Zipper::CreateZipFile(zipPath, { txHashSetDir / "kernel" });
+
+	const fs::path extractDir = pWorkDir->GetPath() / "extracted";
+	fs::create_directories(extractDir);
+
+	std::shared_ptr<ZipFile> pZipFile = ZipFile::Load(zipPath);
+	REQUIRE_THROWS(pZipFile->ExtractFiles({
+		{ "kernel/pmmr_data.bin", extractDir / "pmmr_data.bin" },
+		{ "output/pmmr_data.bin", extractDir / "output_data.bin" }
+	}));
+}
@@ -0,0 +1,250 @@
+#include <catch.hpp>
+
+#include <Wallet/SlateBuilder/CoinSelection.h>
+#include <Wallet/WalletUtil.h>
+#include <Wallet/Exceptions/InsufficientFundsException.h>
+#include <Crypto/RandomNumberGenerator.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <unordered_set>
+
+namespace
+{
+	const uint64_t FEE_BASE = 500'000;
+	const int64_t NUM_KERNELS = 1;
+
+	OutputDataEntity CreateCoin(const uint64_t amount)
+	{
+		// Selection only looks at the amount, so the proof is left empty.
+		return OutputDataEntity(
+			KeyChainPath({ 0, 0 }),
+			SecretKey(RandomNumberGenerator::GenerateRandom32()),
+			TransactionOutput(
+				EOutputFeatures::DEFAULT,
+				Commitment(CBigInteger<33>(RandomNumberGenerator::GenerateRandomBytes(33).data())),
+				RangeProof(std::vector<unsigned char>())
+			),
+			amount,
+			EOutputStatus::SPENDABLE,
+			std::nullopt,
+			std::nullopt
+		);
+	}
+
+	CoinIndex CreateCoinIndex(const std::vector<uint64_t>& amounts)
+	{
+		std::vector<OutputDataEntity> coins;
+		for (const uint64_t amount : amounts)
+		{
+			coins.push_back(CreateCoin(amount));
+		}
+
+		return CoinIndex(std::move(coins));
+	}
+
+	uint64_t Total(const std::vector<OutputDataEntity>& coins)
+	{
+		return std::accumulate(
+			coins.cbegin(), coins.cend(), (uint64_t)0,
+			[](const uint64_t sum, const OutputDataEntity& coin) { return sum + coin.GetAmount(); }
+		);
+	}
+
+	uint64_t Fee(const size_t numInputs, const int64_t numOutputs)
+	{
+		return WalletUtil::CalculateFee(FEE_BASE, numInputs, numOutputs, NUM_KERNELS);
+	}
+
+	std::vector<uint64_t> RandomAmounts(std::mt19937_64& rng, const size_t numCoins)
+	{
+		// A mix of dust-sized coins, where fees matter, and larger coins.
+		std::uniform_int_distribution<uint64_t> small(1, 10 * FEE_BASE);
+		std::uniform_int_distribution<uint64_t> large(1, 60'000'000'000);
+
+		std::vector<uint64_t> amounts;
+		for (size_t i = 0; i < numCoins; i++)
+		{
+			amounts.push_back(rng() % 3 == 0 ? small(rng) : large(rng));
+		}
+
+		// Some repeated amounts, as in wallets paid the same amount over and over.
+		if (numCoins > 1 && rng() % 2 == 0)
+		{
+			amounts[1] = amounts[0];
+		}
+
+		return amounts;
+	}
+
+	// Checks the selection is made of distinct coins from the index, and covers the amount plus the fee it'll be sent with.
+	void CheckSelection(
+		const CoinIndex& coinIndex,
+		const ESelectionStrategy strategy,
+		const std::vector<OutputDataEntity>& selected,
+		const uint64_t amount,
+		const int64_t numChangeOutputs)
+	{
+		std::unordered_set<Commitment> available;
+		for (const OutputDataEntity& coin : coinIndex.GetCoins())
+		{
+			available.insert(coin.GetOutput().GetCommitment());
+		}
+
+		std::unordered_set<Commitment> selectedCommitments;
+		for (const OutputDataEntity& coin : selected)
+		{
+			REQUIRE(available.count(coin.GetOutput().GetCommitment()) == 1);
+			REQUIRE(selectedCommitments.insert(coin.GetOutput().GetCommitment()).second);
+		}
+
+		const int64_t numOutputs = 1 + numChangeOutputs;
+		if (CoinSelection::ShouldAvoidChange(strategy, selected, amount, FEE_BASE, numOutputs, numChangeOutputs, NUM_KERNELS))
+		{
+			REQUIRE(Total(selected) >= amount + Fee(selected.size(), 1));
+			REQUIRE(Total(selected) - (amount + Fee(selected.size(), 1)) <= Fee(0, numOutputs) - Fee(0, 1));
+		}
+		else
+		{
+			REQUIRE(Total(selected) >= amount + Fee(selected.size(), numOutputs));
+		}
+	}
+}
+
+TEST_CASE("CoinIndex - Sorted by amount")
+{
+	CoinIndex coinIndex = CreateCoinIndex({ 5, 1, 3, 3, 2 });
+
+	std::vector<uint64_t> amounts;
+	for (const OutputDataEntity& coin : coinIndex.GetCoins())
+	{
+		amounts.push_back(coin.GetAmount());
+	}
+
+	REQUIRE(amounts == std::vector<uint64_t>({ 1, 2, 3, 3, 5 }));
+	REQUIRE(coinIndex.GetTotal() == 14);
+}
+
+TEST_CASE("CoinSelection - BRANCH_AND_BOUND avoids change")
+{
+	const uint64_t grin = 1'000'000'000;
+	CoinIndex coinIndex = CreateCoinIndex({ 1 * grin, 2 * grin, 5 * grin, 10 * grin });
+
+	// 2 + 5 exactly covers the amount and the fee without change.
+	const uint64_t amount = 7 * grin - Fee(2, 1);
+
+	std::vector<OutputDataEntity> smallest = CoinSelection::SelectCoinsToSpend(
+		coinIndex, amount, FEE_BASE, ESelectionStrategy::SMALLEST, {}, 2, 1, NUM_KERNELS
+	);
+	REQUIRE(smallest.size() == 3);
+	REQUIRE_FALSE(CoinSelection::CanAvoidChange(smallest, amount, FEE_BASE, 2, 1, NUM_KERNELS));
+
+	std::vector<OutputDataEntity> changeless = CoinSelection::SelectCoinsToSpend(
+		coinIndex, amount, FEE_BASE, ESelectionStrategy::BRANCH_AND_BOUND, {}, 2, 1, NUM_KERNELS
+	);
+	REQUIRE(changeless.size() == 2);
+	REQUIRE(Total(changeless) == 7 * grin);
+	REQUIRE(CoinSelection::CanAvoidChange(changeless, amount, FEE_BASE, 2, 1, NUM_KERNELS));
+
+	// No subset lands close enough, so it falls back to the smallest inputs.
+	const uint64_t unmatched = 4 * grin;
+	std::vector<OutputDataEntity> fallback = CoinSelection::SelectCoinsToSpend(
+		coinIndex, unmatched, FEE_BASE, ESelectionStrategy::BRANCH_AND_BOUND, {}, 2, 1, NUM_KERNELS
+	);
+	REQUIRE(Total(fallback) == 8 * grin);
+	REQUIRE_FALSE(CoinSelection::CanAvoidChange(fallback, unmatched, FEE_BASE, 2, 1, NUM_KERNELS));
+}
+
+TEST_CASE("CoinSelection - Only BRANCH_AND_BOUND pays the leftover as fee")
+{
+	const uint64_t grin = 1'000'000'000;
+	CoinIndex coinIndex = CreateCoinIndex({ 2 * grin, 5 * grin });
+
+	// SMALLEST needs both coins, leaving exactly the change output's share of the fee over.
+	const uint64_t amount = 7 * grin - Fee(2, 2);
+	std::vector<OutputDataEntity> smallest = CoinSelection::SelectCoinsToSpend(
+		coinIndex, amount, FEE_BASE, ESelectionStrategy::SMALLEST, {}, 2, 1, NUM_KERNELS
+	);
+	REQUIRE(Total(smallest) == 7 * grin);
+	REQUIRE(CoinSelection::CanAvoidChange(smallest, amount, FEE_BASE, 2, 1, NUM_KERNELS));
+
+	// The other strategies keep their change, rather than silently raising the fee.
+	REQUIRE_FALSE(CoinSelection::ShouldAvoidChange(ESelectionStrategy::SMALLEST, smallest, amount, FEE_BASE, 2, 1, NUM_KERNELS));
+	REQUIRE_FALSE(CoinSelection::ShouldAvoidChange(ESelectionStrategy::CUSTOM, smallest, amount, FEE_BASE, 2, 1, NUM_KERNELS));
+	REQUIRE_FALSE(CoinSelection::ShouldAvoidChange(ESelectionStrategy::ALL, smallest, amount, FEE_BASE, 2, 1, NUM_KERNELS));
+	REQUIRE(CoinSelection::ShouldAvoidChange(ESelectionStrategy::BRANCH_AND_BOUND, smallest, amount, FEE_BASE, 2, 1, NUM_KERNELS));
+}
+
+TEST_CASE("CoinSelection - Selections always cover the amount plus fee")
+{
+	std::mt19937_64 rng(20201018);
+
+	for (size_t iteration = 0; iteration < 500; iteration++)
+	{
+		const size_t numCoins = 1 + (rng() % 40);
+		const int64_t numChangeOutputs = rng() % 3;
+		CoinIndex coinIndex = CreateCoinIndex(RandomAmounts(rng, numCoins));
+
+		const uint64_t amount = 1 + (rng() % coinIndex.GetTotal());
+		const bool sufficientFunds = coinIndex.GetTotal() >= amount + Fee(numCoins, 1 + numChangeOutputs);
+
+		for (const ESelectionStrategy strategy : { ESelectionStrategy::SMALLEST, ESelectionStrategy::ALL, ESelectionStrategy::BRANCH_AND_BOUND })
+		{
+			INFO("Iteration " << iteration << ", strategy " << SelectionStrategy::ToString(strategy));
+
+			std::vector<OutputDataEntity> selected;
+			try
+			{
+				selected = CoinSelection::SelectCoinsToSpend(
+					coinIndex, amount, FEE_BASE, strategy, {}, 1 + numChangeOutputs, numChangeOutputs, NUM_KERNELS
+				);
+			}
+			catch (const InsufficientFundsException&)
+			{
+				REQUIRE_FALSE(sufficientFunds);
+				continue;
+			}
+
+			// Without change, the fee is lower, so BRANCH_AND_BOUND can succeed where the others can't.
+			REQUIRE((sufficientFunds || strategy == ESelectionStrategy::BRANCH_AND_BOUND));
+			CheckSelection(coinIndex, strategy, selected, amount, numChangeOutputs);
+		}
+	}
+}
+
+TEST_CASE("CoinSelection - BRANCH_AND_BOUND finds a changeless selection when one exists")
+{
+	std::mt19937_64 rng(20201019);
+
+	for (size_t iteration = 0; iteration < 500; iteration++)
+	{
+		// Small enough for the search to be exhaustive within its budget.
+		const size_t numCoins = 1 + (rng() % 12);
+		CoinIndex coinIndex = CreateCoinIndex(RandomAmounts(rng, numCoins));
+
+		// Pay exactly what a random subset of the coins is worth, less its fee.
+		std::vector<OutputDataEntity> subset;
+		for (const OutputDataEntity& coin : coinIndex.GetCoins())
+		{
+			if (rng() % 2 == 0)
+			{
+				subset.push_back(coin);
+			}
+		}
+
+		if (subset.empty() || Total(subset) <= Fee(subset.size(), 1))
+		{
+			continue;
+		}
+
+		const uint64_t amount = Total(subset) - Fee(subset.size(), 1);
+
+		INFO("Iteration " << iteration);
+		std::vector<OutputDataEntity> selected = CoinSelection::SelectCoinsToSpend(
+			coinIndex, amount, FEE_BASE, ESelectionStrategy::BRANCH_AND_BOUND, {}, 2, 1, NUM_KERNELS
+		);
+		CheckSelection(coinIndex, ESelectionStrategy::BRANCH_AND_BOUND, selected, amount, 1);
+		REQUIRE(CoinSelection::CanAvoidChange(selected, amount, FEE_BASE, 2, 1, NUM_KERNELS));
+	}
+}
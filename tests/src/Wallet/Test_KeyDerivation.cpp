@@ -15,4 +15,33 @@ TEST_CASE("KeyChain::KeyDerivation")
 	const CBigInteger<32> expected1234 = CBigInteger<32>::FromHex("f0953d1c040d179ce0c25d0dc9485a0f14761dbdd2ad90af12a9a77fe050df7e");
 
 	REQUIRE(key1234.GetBytes() == expected1234);
-}
\ No newline at end of file
+}
+TEST_CASE("KeyChain::KeyDerivation - Cached")
+{
+	ConfigPtr pConfig = ConfigLoader().Load(EEnvironmentType::MAINNET);
+	std::vector<unsigned char> masterSeed = CBigInteger<64>::FromHex("b873212f885ccffbf4692afcb84bc2e55886de2dfa07d90f5c3c239abc31c0a6ce047e30fd8bf6a281e71389aa82d73df74c7bbfb3b06b4639a5cee775cccd3c").GetData();
+
+	auto pCache = std::make_shared<KeyChainCache>();
+	KeyChain cachedKeyChain = KeyChain::FromSeed(*pConfig, (const SecureVector&)masterSeed, pCache);
+
+	// Deriving twice should hit the cache for the parent, and still produce the expected key.
+	const CBigInteger<32> expected1234 = CBigInteger<32>::FromHex("f0953d1c040d179ce0c25d0dc9485a0f14761dbdd2ad90af12a9a77fe050df7e");
+	REQUIRE(cachedKeyChain.DerivePrivateKey(KeyChainPath::FromString("m/1/2/3/4"), 1234).GetBytes() == expected1234);
+	REQUIRE(pCache->Size() == 3);
+	REQUIRE(cachedKeyChain.DerivePrivateKey(KeyChainPath::FromString("m/1/2/3/4"), 1234).GetBytes() == expected1234);
+	REQUIRE(pCache->Size() == 3);
+
+	// Sibling ranges should match individually derived keys from an uncached KeyChain.
+	KeyChain uncachedKeyChain = KeyChain::FromSeed(*pConfig, (const SecureVector&)masterSeed);
+	const KeyChainPath parentPath = KeyChainPath::FromString("m/0/0");
+	std::vector<SecretKey> siblings = cachedKeyChain.DerivePrivateKeys(parentPath, 5, 10);
+	REQUIRE(siblings.size() == 10);
+	for (uint32_t i = 0; i < 10; i++)
+	{
+		REQUIRE(siblings[i] == uncachedKeyChain.DerivePrivateKey(parentPath.GetChild(5 + i)));
+	}
+
+	pCache->Clear();
+	REQUIRE(pCache->Size() == 0);
+	REQUIRE(cachedKeyChain.DerivePrivateKey(KeyChainPath::FromString("m/1/2/3/4"), 1234).GetBytes() == expected1234);
+}
@@ -0,0 +1,212 @@
+#include <catch.hpp>
+
+#include <TestServer.h>
+#include <TestMiner.h>
+#include <TxBuilder.h>
+
+#include <Wallet/WalletRefresher.h>
+#include <Wallet/WalletDB/WalletStore.h>
+#include <Core/Util/TransactionUtil.h>
+#include <Crypto/RandomNumberGenerator.h>
+#include <uuid.h>
+
+#include <atomic>
+#include <unordered_map>
+
+namespace
+{
+	// Forwards to the node, keeping track of how the refresher used it.
+	class CountingNodeClient : public INodeClient
+	{
+	public:
+		CountingNodeClient(const INodeClientPtr& pNodeClient)
+			: m_pNodeClient(pNodeClient), m_numDeltaRequests(0), m_numCommitmentsLookedUp(0) { }
+
+		uint64_t GetChainHeight() const final { return m_pNodeClient->GetChainHeight(); }
+		BlockHeaderPtr GetBlockHeader(const uint64_t height) const final { return m_pNodeClient->GetBlockHeader(height); }
+
+		std::map<Commitment, OutputLocation> GetOutputsByCommitment(const std::vector<Commitment>& commitments) const final
+		{
+			m_numCommitmentsLookedUp += commitments.size();
+			return m_pNodeClient->GetOutputsByCommitment(commitments);
+		}
+
+		OutputLocations GetOutputLocations(const std::vector<Commitment>& commitments) const final
+		{
+			m_numCommitmentsLookedUp += commitments.size();
+			return m_pNodeClient->GetOutputLocations(commitments);
+		}
+
+		std::vector<BlockWithOutputs> GetBlockOutputs(const uint64_t startHeight, const uint64_t maxHeight) const final
+		{
+			return m_pNodeClient->GetBlockOutputs(startHeight, maxHeight);
+		}
+
+		std::vector<BlockDelta> GetBlockDeltas(const uint64_t startHeight, const uint64_t maxHeight) const final
+		{
+			++m_numDeltaRequests;
+			return m_pNodeClient->GetBlockDeltas(startHeight, maxHeight);
+		}
+
+		std::unique_ptr<OutputRange> GetOutputsByLeafIndex(const uint64_t startIndex, const uint64_t maxNumOutputs) const final
+		{
+			return m_pNodeClient->GetOutputsByLeafIndex(startIndex, maxNumOutputs);
+		}
+
+		bool PostTransaction(TransactionPtr pTransaction, const EPoolType poolType) final
+		{
+			return m_pNodeClient->PostTransaction(pTransaction, poolType);
+		}
+
+		size_t GetNumDeltaRequests() const { return m_numDeltaRequests; }
+		size_t GetNumCommitmentsLookedUp() const { return m_numCommitmentsLookedUp; }
+
+		void ResetCounts()
+		{
+			m_numDeltaRequests = 0;
+			m_numCommitmentsLookedUp = 0;
+		}
+
+	private:
+		INodeClientPtr m_pNodeClient;
+		mutable std::atomic<size_t> m_numDeltaRequests;
+		mutable std::atomic<size_t> m_numCommitmentsLookedUp;
+	};
+
+	struct SavedOutput
+	{
+		EOutputStatus status;
+		std::optional<uint64_t> blockHeight;
+
+		bool operator==(const SavedOutput& other) const { return status == other.status && blockHeight == other.blockHeight; }
+	};
+
+	// Reads back what's saved, so the comparison covers the database and not just what Refresh returned.
+	std::unordered_map<Commitment, SavedOutput> GetSavedOutputs(Locked<IWalletDB> walletDB, const SecureVector& masterSeed)
+	{
+		std::unordered_map<Commitment, SavedOutput> saved;
+		for (const OutputDataEntity& output : walletDB.Read()->GetOutputs(masterSeed))
+		{
+			saved[output.GetOutput().GetCommitment()] = SavedOutput{ output.GetStatus(), output.GetBlockHeight() };
+		}
+
+		return saved;
+	}
+}
+
+//
+// 29 - 30 - 31 - 32 - 33
+//   \
+//    - 30b - 31b - 32b - 33b - 34b
+//
+// Block 30 spends the wallet's coinbase from block 1, creating 2 new wallet outputs.
+// The fork doesn't include that spend, or any wallet outputs of its own.
+//
+TEST_CASE("WalletRefresher - Refreshing from block deltas matches a full refresh")
+{
+	TestServer::Ptr pTestServer = TestServer::Create();
+	const Config& config = *pTestServer->GetConfig();
+	auto pBlockChainServer = pTestServer->GetBlockChainServer();
+	auto pNodeClient = std::make_shared<CountingNodeClient>(pTestServer->GetNodeClient());
+
+	const SecureVector masterSeed = RandomNumberGenerator::GenerateRandomBytes(32);
+	KeyChain keyChain = KeyChain::FromSeed(config, masterSeed);
+	TxBuilder txBuilder(keyChain);
+	TestMiner miner(pTestServer);
+
+	const std::string username = uuids::to_string(uuids::uuid_system_generator()());
+	std::shared_ptr<IWalletStore> pWalletStore = WalletDBAPI::OpenWalletDB(config);
+	Locked<IWalletDB> walletDB = pWalletStore->CreateWallet(
+		username,
+		EncryptedSeed(CBigInteger<16>(), CBigInteger<8>(), std::vector<unsigned char>(32), ScryptParameters(1, 1, 1))
+	);
+
+	auto refresh = [&config, &pNodeClient, &masterSeed, &walletDB](const bool fullRefresh) {
+		pNodeClient->ResetCounts();
+		WalletRefresher(config, pNodeClient).Refresh(masterSeed, walletDB, fullRefresh);
+		return GetSavedOutputs(walletDB, masterSeed);
+	};
+
+	std::vector<MinedBlock> minedChain = miner.MineChain(keyChain, 30);
+	REQUIRE(pBlockChainServer->GetHeight(EChainType::CONFIRMED) == 29);
+
+	// Nothing has been refreshed yet, so the first refresh has to look up every output.
+	std::unordered_map<Commitment, SavedOutput> saved = refresh(false);
+	REQUIRE(saved.size() == 29);
+	REQUIRE(pNodeClient->GetNumDeltaRequests() == 0);
+	REQUIRE(pNodeClient->GetNumCommitmentsLookedUp() == 29);
+
+	// Spend the coinbase from block 1 in block 30, then mine a few blocks on top.
+	TransactionOutput outputToSpend = minedChain[1].block.GetOutputs().front();
+	Test::Input input({
+		{ outputToSpend.GetFeatures(), outputToSpend.GetCommitment() },
+		minedChain[1].coinbasePath.value(),
+		minedChain[1].coinbaseAmount
+	});
+	Test::Output newOutput({ KeyChainPath({ 1, 0 }), (uint64_t)10'000'000 });
+	Test::Output changeOutput({ KeyChainPath({ 1, 1 }), (uint64_t)(minedChain[1].coinbaseAmount - 10'000'000) });
+	Transaction spendTransaction = txBuilder.BuildTx(0, { input }, { newOutput, changeOutput });
+
+	BlockHeaderPtr pTipHeader = minedChain.back().block.GetBlockHeader();
+	for (uint32_t height = 30; height <= 33; height++)
+	{
+		Test::Tx coinbaseTx = txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, height }));
+		TransactionPtr pTransaction = coinbaseTx.pTransaction;
+		if (height == 30)
+		{
+			pTransaction = TransactionUtil::Aggregate({ pTransaction, std::make_shared<Transaction>(spendTransaction) });
+		}
+
+		FullBlock block = miner.MineNextBlock(pTipHeader, *pTransaction);
+		REQUIRE(pBlockChainServer->AddBlock(block) == EBlockChainStatus::SUCCESS);
+		pTipHeader = block.GetBlockHeader();
+	}
+
+	// Blocks 30-33 are fetched as deltas, so the outputs they touched don't need looking up.
+	// Only the coinbases from blocks 4-29, which were still immature at height 29, are.
+	std::unordered_map<Commitment, SavedOutput> fromDeltas = refresh(false);
+	REQUIRE(fromDeltas.size() == 35);
+	REQUIRE(pNodeClient->GetNumDeltaRequests() == 1);
+	REQUIRE(pNodeClient->GetNumCommitmentsLookedUp() == 26);
+	REQUIRE(fromDeltas.at(outputToSpend.GetCommitment()).status == EOutputStatus::SPENT);
+	REQUIRE(fromDeltas.at(spendTransaction.GetOutputs()[0].GetCommitment()).blockHeight == std::make_optional<uint64_t>(30));
+
+	std::unordered_map<Commitment, SavedOutput> full = refresh(true);
+	REQUIRE(pNodeClient->GetNumDeltaRequests() == 0);
+	REQUIRE(full == fromDeltas);
+
+	// No blocks were added since the last refresh, so nothing changes.
+	// The outputs still immature at height 33 are looked up again, since their status depends on the tip:
+	// the coinbases from blocks 8-33, and the 2 outputs created in block 30, which need 10 confirmations.
+	REQUIRE(refresh(false) == full);
+	REQUIRE(pNodeClient->GetNumDeltaRequests() == 1);
+	REQUIRE(pNodeClient->GetNumCommitmentsLookedUp() == 28);
+
+	// Reorg from block 29, dropping block 30's spend. The fork's coinbases don't belong to the wallet.
+	KeyChain otherKeyChain = KeyChain::FromRandom(config);
+	TxBuilder otherTxBuilder(otherKeyChain);
+
+	std::vector<FullBlock> fork;
+	for (uint32_t height = 30; height <= 34; height++)
+	{
+		Test::Tx coinbaseTx = otherTxBuilder.BuildCoinbaseTx(KeyChainPath({ 2, height }));
+		fork.push_back(miner.MineNextBlock(minedChain.back().block.GetBlockHeader(), *coinbaseTx.pTransaction, fork));
+	}
+
+	for (const FullBlock& block : fork)
+	{
+		REQUIRE(pBlockChainServer->AddBlock(block) == EBlockChainStatus::SUCCESS);
+	}
+	REQUIRE(pBlockChainServer->GetBlockByHeight(33)->GetHash() == fork[3].GetHash());
+
+	// The block at the last refresh height was replaced, so the refresher falls back to looking up every output.
+	std::unordered_map<Commitment, SavedOutput> afterReorg = refresh(false);
+	REQUIRE(pNodeClient->GetNumDeltaRequests() == 0);
+	REQUIRE(pNodeClient->GetNumCommitmentsLookedUp() == afterReorg.size());
+	REQUIRE(afterReorg.at(outputToSpend.GetCommitment()).status == EOutputStatus::SPENDABLE);
+	REQUIRE(afterReorg.at(spendTransaction.GetOutputs()[0].GetCommitment()).status == EOutputStatus::SPENT);
+
+	REQUIRE(refresh(true) == afterReorg);
+
+	pWalletStore->DeleteWallet(username);
+}
@@ -0,0 +1,274 @@
+#include <catch.hpp>
+
+#include <TestHelper.h>
+#include <TestFileUtil.h>
+
+#include <Wallet/WalletDB/WalletDB.h>
+#include <Wallet/WalletDB/WalletStore.h>
+#include <Wallet/WalletDB/WalletEncryptionUtil.h>
+#include <Wallet/WalletDB/Sqlite/Tables/OutputsTable.h>
+#include <Crypto/RandomNumberGenerator.h>
+#include <libsqlite3/sqlite3.h>
+#include <uuid.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace
+{
+	const size_t NUM_OUTPUTS = 100'000;
+
+	std::vector<OutputDataEntity> CreateOutputs(const size_t numOutputs)
+	{
+		// Contents don't matter to the database, only their size, so a fixed proof is used.
+		const std::vector<unsigned char> proofBytes(675, 0x0F);
+
+		std::vector<OutputDataEntity> outputs;
+		outputs.reserve(numOutputs);
+		for (size_t i = 0; i < numOutputs; i++)
+		{
+			outputs.emplace_back(OutputDataEntity(
+				KeyChainPath({ 0, 0, (uint32_t)i }),
+				SecretKey(RandomNumberGenerator::GenerateRandom32()),
+				TransactionOutput(
+					EOutputFeatures::DEFAULT,
+					Commitment(CBigInteger<33>(RandomNumberGenerator::GenerateRandomBytes(33).data())),
+					RangeProof(std::vector<unsigned char>(proofBytes))
+				),
+				(uint64_t)i * 1000,
+				EOutputStatus::SPENDABLE,
+				i % 2 == 0 ? std::make_optional((uint32_t)i) : std::nullopt,
+				std::nullopt
+			));
+		}
+
+		return outputs;
+	}
+
+	std::vector<unsigned char> Serialize(const OutputDataEntity& output)
+	{
+		Serializer serializer;
+		output.Serialize(serializer);
+		return serializer.GetBytes();
+	}
+
+	void Exec(sqlite3* pDatabase, const std::string& sql)
+	{
+		REQUIRE(sqlite3_exec(pDatabase, sql.c_str(), NULL, NULL, NULL) == SQLITE_OK);
+	}
+
+	sqlite3* OpenDB(const fs::path& dbFile)
+	{
+		sqlite3* pDatabase = nullptr;
+		REQUIRE(sqlite3_open(dbFile.u8string().c_str(), &pDatabase) == SQLITE_OK);
+		return pDatabase;
+	}
+
+	// The statements compiled (and not yet finalized) on the connection whose SQL starts with the given prefix.
+	std::vector<sqlite3_stmt*> FindStatements(sqlite3* pDatabase, const std::string& sqlPrefix)
+	{
+		std::vector<sqlite3_stmt*> statements;
+		for (sqlite3_stmt* pStatement = sqlite3_next_stmt(pDatabase, nullptr); pStatement != nullptr; pStatement = sqlite3_next_stmt(pDatabase, pStatement))
+		{
+			if (std::string(sqlite3_sql(pStatement)).rfind(sqlPrefix, 0) == 0)
+			{
+				statements.push_back(pStatement);
+			}
+		}
+
+		return statements;
+	}
+
+	std::string GetJournalMode(const fs::path& dbFile)
+	{
+		sqlite3* pDatabase = OpenDB(dbFile);
+
+		sqlite3_stmt* stmt = nullptr;
+		REQUIRE(sqlite3_prepare_v2(pDatabase, "PRAGMA journal_mode", -1, &stmt, NULL) == SQLITE_OK);
+		REQUIRE(sqlite3_step(stmt) == SQLITE_ROW);
+		const std::string journalMode((const char*)sqlite3_column_text(stmt, 0));
+
+		sqlite3_finalize(stmt);
+		sqlite3_close(pDatabase);
+		return journalMode;
+	}
+}
+
+TEST_CASE("WalletSqlite - Saving 100k outputs")
+{
+	ConfigPtr pConfig = TestHelper::GetTestConfig();
+	const std::string username = uuids::to_string(uuids::uuid_system_generator()());
+	const SecureVector masterSeed = RandomNumberGenerator::GenerateRandomBytes(32);
+
+	std::shared_ptr<IWalletStore> pWalletStore = WalletDBAPI::OpenWalletDB(*pConfig);
+	Locked<IWalletDB> walletDB = pWalletStore->CreateWallet(
+		username,
+		EncryptedSeed(CBigInteger<16>(), CBigInteger<8>(), std::vector<unsigned char>(32), ScryptParameters(1, 1, 1))
+	);
+
+	const fs::path walletDir = pConfig->GetWalletConfig().GetWalletDirectory() / username;
+	REQUIRE(GetJournalMode(walletDir / "wallet.db") == "wal");
+
+	const std::vector<OutputDataEntity> outputs = CreateOutputs(NUM_OUTPUTS);
+
+	{
+		auto pBatch = walletDB.BatchWrite();
+		pBatch->AddOutputs(masterSeed, outputs);
+		pBatch->Commit();
+	}
+
+	// Outputs are read back unchanged.
+	// A separate store opens a new connection, so nothing comes from WalletSqlite's in-memory cache.
+	{
+		std::vector<OutputDataEntity> saved = WalletDBAPI::OpenWalletDB(*pConfig)
+			->OpenWallet(username, masterSeed)
+			.Read()->GetOutputs(masterSeed);
+		REQUIRE(saved.size() == NUM_OUTPUTS);
+
+		std::unordered_map<Commitment, const OutputDataEntity*> savedByCommitment;
+		for (const OutputDataEntity& output : saved)
+		{
+			savedByCommitment[output.GetOutput().GetCommitment()] = &output;
+		}
+
+		REQUIRE(savedByCommitment.size() == NUM_OUTPUTS);
+		for (const OutputDataEntity& output : outputs)
+		{
+			auto iter = savedByCommitment.find(output.GetOutput().GetCommitment());
+			REQUIRE(iter != savedByCommitment.end());
+			REQUIRE(Serialize(*iter->second) == Serialize(output));
+		}
+	}
+
+	// Existing outputs are updated in place, rather than duplicated.
+	{
+		std::vector<OutputDataEntity> updated(outputs.begin(), outputs.begin() + 250);
+		for (OutputDataEntity& output : updated)
+		{
+			output.SetStatus(EOutputStatus::SPENT);
+		}
+
+		auto pBatch = walletDB.BatchWrite();
+		pBatch->AddOutputs(masterSeed, updated);
+		pBatch->Commit();
+	}
+
+	{
+		std::vector<OutputDataEntity> saved = WalletDBAPI::OpenWalletDB(*pConfig)
+			->OpenWallet(username, masterSeed)
+			.Read()->GetOutputs(masterSeed);
+		REQUIRE(saved.size() == NUM_OUTPUTS);
+
+		const size_t numSpent = std::count_if(
+			saved.cbegin(),
+			saved.cend(),
+			[](const OutputDataEntity& output) { return output.GetStatus() == EOutputStatus::SPENT; }
+		);
+		REQUIRE(numSpent == 250);
+	}
+
+	pWalletStore->DeleteWallet(username);
+}
+
+TEST_CASE("OutputsTable - Every output is saved through the same cached statement")
+{
+	TemporaryFile::Ptr pTempDir = TestFileUtil::CreateTempFile();
+	fs::create_directories(pTempDir->GetPath());
+
+	const std::vector<OutputDataEntity> outputs = CreateOutputs(NUM_OUTPUTS);
+
+	std::vector<SecureVector> serializedOutputs;
+	for (const OutputDataEntity& output : outputs)
+	{
+		Serializer serializer;
+		output.Serialize(serializer);
+		serializedOutputs.push_back(serializer.GetSecureBytes());
+	}
+
+	const SecretKey encryptionKey(RandomNumberGenerator::GenerateRandom32());
+	const std::vector<std::vector<unsigned char>> encryptedOutputs = WalletEncryptionUtil::EncryptAll(encryptionKey, serializedOutputs);
+
+	const size_t half = NUM_OUTPUTS / 2;
+	const std::vector<OutputDataEntity> firstOutputs(outputs.begin(), outputs.begin() + half);
+	const std::vector<OutputDataEntity> secondOutputs(outputs.begin() + half, outputs.end());
+	const std::vector<std::vector<unsigned char>> firstEncrypted(encryptedOutputs.begin(), encryptedOutputs.begin() + half);
+	const std::vector<std::vector<unsigned char>> secondEncrypted(encryptedOutputs.begin() + half, encryptedOutputs.end());
+
+	sqlite3* pWalletDB = OpenDB(pTempDir->GetPath() / "wallet.db");
+	Exec(pWalletDB, "PRAGMA journal_mode=WAL; PRAGMA synchronous=NORMAL;");
+	OutputsTable::CreateTable(*pWalletDB);
+
+	{
+		SqliteStatementCache statements(*pWalletDB);
+
+		// The insert is compiled once, and re-run for every output.
+		OutputsTable::AddEncryptedOutputs(statements, firstOutputs, firstEncrypted);
+
+		const std::vector<sqlite3_stmt*> inserts = FindStatements(pWalletDB, "insert into outputs");
+		REQUIRE(inserts.size() == 1);
+		REQUIRE(sqlite3_stmt_status(inserts.front(), SQLITE_STMTSTATUS_RUN, 0) == (int)half);
+
+		// A later call reuses the same statement, rather than compiling another.
+		OutputsTable::AddEncryptedOutputs(statements, secondOutputs, secondEncrypted);
+
+		REQUIRE(FindStatements(pWalletDB, "insert into outputs") == inserts);
+		REQUIRE(sqlite3_stmt_status(inserts.front(), SQLITE_STMTSTATUS_RUN, 0) == (int)NUM_OUTPUTS);
+
+		std::vector<OutputDataEntity> saved = OutputsTable::GetOutputs(statements, encryptionKey);
+		REQUIRE(saved.size() == NUM_OUTPUTS);
+	}
+
+	// Clearing the cache finalizes its statements, so the connection can be closed.
+	REQUIRE(sqlite3_next_stmt(pWalletDB, nullptr) == nullptr);
+	REQUIRE(sqlite3_close(pWalletDB) == SQLITE_OK);
+}
+
+TEST_CASE("WalletSqlite - Outputs version")
+{
+	ConfigPtr pConfig = TestHelper::GetTestConfig();
+	const std::string username = uuids::to_string(uuids::uuid_system_generator()());
+	const SecureVector masterSeed = RandomNumberGenerator::GenerateRandomBytes(32);
+
+	std::shared_ptr<IWalletStore> pWalletStore = WalletDBAPI::OpenWalletDB(*pConfig);
+	Locked<IWalletDB> walletDB = pWalletStore->CreateWallet(
+		username,
+		EncryptedSeed(CBigInteger<16>(), CBigInteger<8>(), std::vector<unsigned char>(32), ScryptParameters(1, 1, 1))
+	);
+
+	const std::vector<OutputDataEntity> outputs = CreateOutputs(10);
+	const uint64_t initialVersion = walletDB.Read()->GetOutputsVersion();
+
+	// A refresh that finds nothing new writes no outputs, so it leaves the version alone.
+	{
+		auto pBatch = walletDB.BatchWrite();
+		pBatch->AddOutputs(masterSeed, std::vector<OutputDataEntity>());
+		pBatch->Commit();
+	}
+	REQUIRE(walletDB.Read()->GetOutputsVersion() == initialVersion);
+
+	{
+		auto pBatch = walletDB.BatchWrite();
+		pBatch->AddOutputs(masterSeed, outputs);
+		pBatch->Commit();
+	}
+	const uint64_t addedVersion = walletDB.Read()->GetOutputsVersion();
+	REQUIRE(addedVersion != initialVersion);
+
+	// Anything derived from outputs written before a rollback is stale too.
+	{
+		std::vector<OutputDataEntity> locked(outputs.begin(), outputs.begin() + 2);
+		for (OutputDataEntity& output : locked)
+		{
+			output.SetStatus(EOutputStatus::LOCKED);
+		}
+
+		auto pBatch = walletDB.BatchWrite();
+		pBatch->AddOutputs(masterSeed, locked);
+		pBatch->Rollback();
+	}
+	const uint64_t rolledBackVersion = walletDB.Read()->GetOutputsVersion();
+	REQUIRE(rolledBackVersion != addedVersion);
+	REQUIRE(walletDB.Read()->GetOutputs(masterSeed).size() == outputs.size());
+
+	pWalletStore->DeleteWallet(username);
+}